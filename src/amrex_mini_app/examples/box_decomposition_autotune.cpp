@@ -0,0 +1,106 @@
+#include <AMReX.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "grid.h"
+#include "tripolar_geometry.h"
+#include "tripolar_grid.h"
+
+// Times a halo exchange plus 7-point stencil update for a set of candidate box decompositions and records the fastest
+// one, so production runs can pick it up with BoxDecomposition::FromParmParse.
+//
+// Runtime parameters (AMReX ParmParse syntax, e.g. `./box_decomposition_autotune n_cell="360 180 22" tripolar=1`):
+//   n_cell       Number of cells in each direction (default 360 180 22, the benchmark example configuration)
+//   n_component  Number of components of the timed field (default 1)
+//   n_iteration  Number of timed iterations per candidate (default 20)
+//   tripolar     Use a TripolarGrid, so the halo exchange includes the fold (default 0)
+//   output_file  File the fastest decomposition is written to (default box_decomposition.inputs)
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::vector<int> n_cell = {360, 180, 22};
+        int n_component         = 1;
+        int n_iteration         = 20;
+        bool tripolar           = false;
+        std::string output_file = "box_decomposition.inputs";
+        {
+            amrex::ParmParse pp;
+            pp.queryarr("n_cell", n_cell);
+            pp.query("n_component", n_component);
+            pp.query("n_iteration", n_iteration);
+            pp.query("tripolar", tripolar);
+            pp.query("output_file", output_file);
+        }
+
+        std::shared_ptr<turbo::Grid> grid;
+        if (tripolar)
+        {
+            grid = std::make_shared<turbo::TripolarGrid>(
+                std::make_shared<turbo::TripolarGeometry>(0.0, 360.0, -80.0, 90.0, 0.0, 5000.0), n_cell[0], n_cell[1],
+                n_cell[2]);
+        }
+        else
+        {
+            grid = std::make_shared<turbo::CartesianGrid>(
+                std::make_shared<turbo::CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), n_cell[0], n_cell[1],
+                n_cell[2]);
+        }
+
+        const int n_rank = amrex::ParallelDescriptor::NProcs();
+        const std::vector<turbo::BoxDecomposition> candidates =
+            turbo::CandidateBoxDecompositions(turbo::CellDomain(*grid), n_rank);
+
+        amrex::Print() << "Box decomposition autotune: " << n_cell[0] << " x " << n_cell[1] << " x " << n_cell[2]
+                       << (tripolar ? " tripolar" : " cartesian") << " cells, " << n_component << " component(s), "
+                       << n_rank << " rank(s), " << candidates.size() << " candidates" << std::endl;
+
+        const std::vector<turbo::BoxDecompositionTiming> timings =
+            turbo::TimeBoxDecompositions(grid, candidates, n_component, n_iteration);
+
+        for (const turbo::BoxDecompositionTiming& timing : timings)
+        {
+            amrex::Print() << "  " << timing.box_decomposition << " (" << timing.n_box
+                           << " boxes): " << timing.seconds_per_iteration << " s per iteration" << std::endl;
+        }
+
+        const turbo::BoxDecompositionTiming& best =
+            *std::min_element(timings.begin(), timings.end(),
+                              [](const turbo::BoxDecompositionTiming& a, const turbo::BoxDecompositionTiming& b)
+                              { return a.seconds_per_iteration < b.seconds_per_iteration; });
+        amrex::Print() << "Fastest: " << best.box_decomposition << std::endl;
+
+        // Record the winner in ParmParse syntax, readable by BoxDecomposition::FromParmParse
+        if (amrex::ParallelDescriptor::IOProcessor())
+        {
+            std::ofstream output(output_file);
+            const turbo::BoxDecomposition& box_decomposition = best.box_decomposition;
+            if (box_decomposition.UsesLayout())
+            {
+                output << "box_decomposition.layout = " << box_decomposition.layout[0] << " "
+                       << box_decomposition.layout[1] << "\n";
+            }
+            else
+            {
+                const amrex::IntVect& max_box_size    = box_decomposition.max_box_size;
+                const amrex::IntVect& blocking_factor = box_decomposition.blocking_factor;
+                output << "box_decomposition.max_box_size = " << max_box_size[0] << " " << max_box_size[1] << " "
+                       << max_box_size[2] << "\n";
+                output << "box_decomposition.blocking_factor = " << blocking_factor[0] << " " << blocking_factor[1]
+                       << " " << blocking_factor[2] << "\n";
+            }
+            amrex::Print() << "Wrote " << output_file << std::endl;
+        }
+    }
+    amrex::Finalize();
+    return 0;
+}
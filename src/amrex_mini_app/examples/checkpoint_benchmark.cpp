@@ -0,0 +1,146 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "domain.h"
+#include "field.h"
+
+namespace
+{
+
+/**
+ * @brief Create the fields of a MOM6-style restart: u, v, h, T, S and a number of passive tracers.
+ */
+void CreateRestartFields(turbo::Domain& domain, const int n_tracer, const int n_ghost)
+{
+    domain.CreateField("u", turbo::FieldGridStagger::IFace, 1, n_ghost, turbo::FoldParity::Vector);
+    domain.CreateField("v", turbo::FieldGridStagger::JFace, 1, n_ghost, turbo::FoldParity::Vector);
+    domain.CreateField("h", turbo::FieldGridStagger::CellCentered, 1, n_ghost);
+    domain.CreateField("T", turbo::FieldGridStagger::CellCentered, 1, n_ghost);
+    domain.CreateField("S", turbo::FieldGridStagger::CellCentered, 1, n_ghost);
+    for (int tracer = 0; tracer < n_tracer; ++tracer)
+    {
+        domain.CreateField("tracer_" + std::to_string(tracer), turbo::FieldGridStagger::CellCentered, 1, n_ghost);
+    }
+}
+
+}  // namespace
+
+// Times Domain::WriteCheckpoint and Domain::ReadCheckpoint for the fields of a MOM6-style restart, against a
+// Domain::WriteHDF5 with a file per rank, the fastest HDF5 output. The checkpoint is read back on the layout it was
+// written with, a straight read of every rank's file, and on another box decomposition, which redistributes the
+// blocks. To time a restart on a different number of ranks, write with one job and read with read_only=1 in a second
+// job on another number of ranks.
+//
+// Runtime parameters (AMReX ParmParse syntax, e.g. `./checkpoint_benchmark n_tracer=50 write_ghost=1`):
+//   n_cell       Number of cells in each direction (default 360 180 22, the benchmark example configuration)
+//   n_tracer     Number of passive tracers in addition to T and S (default 20)
+//   n_ghost      Number of ghost cells of every field (default 2)
+//   n_iteration  Number of timed writes and reads (default 3)
+//   write_ghost  Also write the ghost cells (default 0)
+//   directory    Directory of the checkpoint (default checkpoint_benchmark_chk)
+//   read_only    Only time reading an existing checkpoint of the same fields, e.g. written on other ranks (default 0)
+//   box_decomposition.*  Box decomposition of the fields, see BoxDecomposition::FromParmParse (default 32^3 chunks)
+//   restart_box_decomposition.*  Box decomposition of the redistributed read (default 32^3 chunks)
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::vector<int> n_cell = {360, 180, 22};
+        int n_tracer            = 20;
+        int n_ghost             = 2;
+        int n_iteration         = 3;
+        bool write_ghost        = false;
+        std::string directory   = "checkpoint_benchmark_chk";
+        bool read_only          = false;
+        {
+            amrex::ParmParse pp;
+            pp.queryarr("n_cell", n_cell);
+            pp.query("n_tracer", n_tracer);
+            pp.query("n_ghost", n_ghost);
+            pp.query("n_iteration", n_iteration);
+            pp.query("write_ghost", write_ghost);
+            pp.query("directory", directory);
+            pp.query("read_only", read_only);
+        }
+
+        const std::shared_ptr<turbo::CartesianGrid> grid = std::make_shared<turbo::CartesianGrid>(
+            std::make_shared<turbo::CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), n_cell[0], n_cell[1], n_cell[2]);
+        turbo::Domain domain(grid, turbo::BoxDecomposition::FromParmParse());
+        CreateRestartFields(domain, n_tracer, n_ghost);
+
+        double megabytes = 0.0;
+        for (const std::shared_ptr<turbo::Field>& field : domain.GetFields())
+        {
+            amrex::MultiFab& mf = *field->multifab;
+            for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+                amrex::ParallelFor(mfi.fabbox(), mf.nComp(),
+                                   [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   { array(i, j, k, n) = std::sin(0.05 * i) * std::cos(0.07 * j) - 0.5 * k + n; });
+            }
+            megabytes += static_cast<double>(mf.boxArray().numPts()) * mf.nComp() * sizeof(double) / (1024.0 * 1024.0);
+        }
+
+        const int n_box = domain.GetBoxArray(turbo::FieldGridStagger::CellCentered).size();
+        amrex::Print() << "Checkpoint benchmark: " << n_cell[0] << " x " << n_cell[1] << " x " << n_cell[2]
+                       << " cells, " << domain.GetFields().size() << " fields, " << megabytes
+                       << " MiB of valid cells per checkpoint, " << n_box << " boxes, "
+                       << amrex::ParallelDescriptor::NProcs() << " rank(s)" << std::endl;
+
+        auto time_iterations = [n_iteration](auto&& function)
+        {
+            amrex::ParallelDescriptor::Barrier();
+            const double start_time = amrex::second();
+            for (int iteration = 0; iteration < n_iteration; ++iteration)
+            {
+                function();
+            }
+            amrex::ParallelDescriptor::Barrier();
+            double seconds_per_iteration = (amrex::second() - start_time) / n_iteration;
+            amrex::ParallelDescriptor::ReduceRealMax(seconds_per_iteration);
+            return seconds_per_iteration;
+        };
+
+        if (!read_only)
+        {
+            const double checkpoint_seconds = time_iterations(
+                [&domain, &directory, write_ghost]() { domain.WriteCheckpoint(directory, write_ghost); });
+            const double hdf5_seconds = time_iterations(
+                [&domain]() { domain.WriteHDF5("checkpoint_benchmark.h5", turbo::HDF5WriteMode::FilePerRank); });
+
+            amrex::Print() << "  Write checkpoint" << (write_ghost ? " with ghost cells" : "") << ": "
+                           << checkpoint_seconds << " s per write, " << megabytes / checkpoint_seconds << " MiB/s"
+                           << std::endl;
+            amrex::Print() << "  Write HDF5 " << turbo::HDF5WriteModeToString(turbo::HDF5WriteMode::FilePerRank)
+                           << ": " << hdf5_seconds << " s per write, " << megabytes / hdf5_seconds
+                           << " MiB/s, speedup of the checkpoint " << hdf5_seconds / checkpoint_seconds << std::endl;
+        }
+
+        // On the layout of the checkpoint only when it was written with the same decomposition and number of ranks
+        const double read_seconds = time_iterations([&domain, &directory]() { domain.ReadCheckpoint(directory); });
+        amrex::Print() << "  Read checkpoint: " << read_seconds << " s per read, " << megabytes / read_seconds
+                       << " MiB/s" << std::endl;
+
+        turbo::Domain restart_domain(grid, turbo::BoxDecomposition::FromParmParse("restart_box_decomposition"));
+        CreateRestartFields(restart_domain, n_tracer, n_ghost);
+        const double redistribute_seconds =
+            time_iterations([&restart_domain, &directory]() { restart_domain.ReadCheckpoint(directory); });
+        amrex::Print() << "  Read checkpoint into "
+                       << restart_domain.GetBoxArray(turbo::FieldGridStagger::CellCentered).size()
+                       << " boxes: " << redistribute_seconds << " s per read, " << megabytes / redistribute_seconds
+                       << " MiB/s" << std::endl;
+    }
+    amrex::Finalize();
+    return 0;
+}
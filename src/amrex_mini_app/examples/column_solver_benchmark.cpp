@@ -0,0 +1,134 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <memory>
+#include <vector>
+
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "column_utils.h"
+#include "column_solver.h"
+#include "domain.h"
+#include "field.h"
+#include "staggered_field.h"
+
+namespace
+{
+
+/**
+ * @brief Set the coefficients of implicit vertical diffusion with a diffusivity that varies in all directions, a
+ * right-hand side, and a mask with a band of land columns.
+ */
+void FillSystem(const turbo::Field& lower, const turbo::Field& diagonal, const turbo::Field& upper,
+                const turbo::Field& solution, const turbo::Field& mask)
+{
+    for (amrex::MFIter mfi(*solution.multifab); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real> a = lower.multifab->array(mfi);
+        const amrex::Array4<amrex::Real> b = diagonal.multifab->array(mfi);
+        const amrex::Array4<amrex::Real> c = upper.multifab->array(mfi);
+        const amrex::Array4<amrex::Real> x = solution.multifab->array(mfi);
+        const amrex::Array4<amrex::Real> m = mask.multifab->array(mfi);
+        amrex::ParallelFor(mfi.validbox(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k)
+                           {
+                               const amrex::Real kappa = 1.0 + 0.01 * ((i + 2 * j + k) % 50);
+                               a(i, j, k)              = -kappa;
+                               b(i, j, k)              = 1.0 + 2.0 * kappa;
+                               c(i, j, k)              = -kappa;
+                               m(i, j, k)              = (i % 10 < 3) ? 0.0 : 1.0;
+                           });
+        amrex::ParallelFor(mfi.validbox(), solution.multifab->nComp(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) { x(i, j, k, n) = 1.0 + 0.1 * k + n; });
+    }
+}
+
+}  // namespace
+
+// Times the batched tridiagonal column solver of column_solver.h, e.g. implicit vertical diffusion of n_component
+// tracers, for ocean columns of 22 and 75 levels, with and without a land mask that makes 30% of the columns dry. The
+// result is reported as columns solved per second, counting every column of the grid, wet or dry, once per component.
+//
+// The solver needs boxes that contain whole columns, so the box decomposition is made by WholeColumnDecomposition.
+//
+// Runtime parameters (AMReX ParmParse syntax, e.g. `./column_solver_benchmark n_level=75 n_component=4`):
+//   n_cell       Number of cells in i and j, the third value is replaced by n_level (default 360 180 22)
+//   n_level      Number of levels of the columns, one run per value (default 22 75)
+//   n_component  Number of components solved at once, e.g. tracers with the same diffusivity (default 1)
+//   n_iteration  Number of timed solves per run (default 20)
+//   box_decomposition.*  Box decomposition of the fields, see BoxDecomposition::FromParmParse (default 32^3 chunks)
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::vector<int> n_cell  = {360, 180, 22};
+        std::vector<int> n_level = {22, 75};
+        int n_component          = 1;
+        int n_iteration          = 20;
+        {
+            amrex::ParmParse pp;
+            pp.queryarr("n_cell", n_cell);
+            pp.queryarr("n_level", n_level);
+            pp.query("n_component", n_component);
+            pp.query("n_iteration", n_iteration);
+        }
+
+        auto time_iterations = [n_iteration](auto&& function)
+        {
+            amrex::ParallelDescriptor::Barrier();
+            const double start_time = amrex::second();
+            for (int iteration = 0; iteration < n_iteration; ++iteration)
+            {
+                function();
+            }
+            amrex::ParallelDescriptor::Barrier();
+            double seconds_per_iteration = (amrex::second() - start_time) / n_iteration;
+            amrex::ParallelDescriptor::ReduceRealMax(seconds_per_iteration);
+            return seconds_per_iteration;
+        };
+
+        using turbo::FieldGridStagger;
+        for (const int levels : n_level)
+        {
+            const turbo::BoxDecomposition box_decomposition =
+                turbo::WholeColumnDecomposition(turbo::BoxDecomposition::FromParmParse(), levels);
+
+            const std::shared_ptr<turbo::CartesianGrid> grid = std::make_shared<turbo::CartesianGrid>(
+                std::make_shared<turbo::CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), n_cell[0], n_cell[1], levels);
+            turbo::Domain domain(grid, box_decomposition);
+
+            const int n_ghost   = 0;
+            const auto lower    = domain.CreateField<FieldGridStagger::CellCentered>("lower", 1, n_ghost);
+            const auto diagonal = domain.CreateField<FieldGridStagger::CellCentered>("diagonal", 1, n_ghost);
+            const auto upper    = domain.CreateField<FieldGridStagger::CellCentered>("upper", 1, n_ghost);
+            const auto solution = domain.CreateField<FieldGridStagger::CellCentered>("solution", n_component, n_ghost);
+            const auto mask     = domain.CreateField<FieldGridStagger::CellCentered>("mask", 1, n_ghost);
+            FillSystem(*lower.GetField(), *diagonal.GetField(), *upper.GetField(), *solution.GetField(),
+                       *mask.GetField());
+
+            const int n_box = domain.GetBoxArray(FieldGridStagger::CellCentered).size();
+            amrex::Print() << "Column solver benchmark: " << n_cell[0] << " x " << n_cell[1] << " columns of " << levels
+                           << " levels, " << n_component << " component(s), " << n_box << " boxes, "
+                           << amrex::ParallelDescriptor::NProcs() << " rank(s)" << std::endl;
+
+            // Every solve overwrites the solution with the solution of the previous right-hand side, which stays
+            // bounded because the systems are diagonally dominant
+            const double n_column = static_cast<double>(n_cell[0]) * n_cell[1] * n_component;
+            auto report           = [&time_iterations, n_column](const char* name, auto&& function)
+            {
+                const double seconds = time_iterations(function);
+                amrex::Print() << "  " << name << ": " << seconds << " s per solve, " << n_column / seconds
+                               << " columns/s" << std::endl;
+            };
+            report("Unmasked", [&lower, &diagonal, &upper, &solution]()
+                   { turbo::SolveTridiagonalColumns(lower, diagonal, upper, solution); });
+            report("Masked", [&lower, &diagonal, &upper, &solution, &mask]()
+                   { turbo::SolveTridiagonalColumns(lower, diagonal, upper, solution, mask); });
+        }
+    }
+    amrex::Finalize();
+    return 0;
+}
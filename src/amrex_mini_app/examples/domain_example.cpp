@@ -10,6 +10,8 @@
 #include "cartesian_geometry.h"
 #include "cartesian_grid.h"
 #include "field.h"
+#include "field_handle.h"
+#include "staggered_field.h"
 
 int main(int argc, char* argv[])
 {
@@ -131,21 +133,29 @@ int main(int argc, char* argv[])
         amrex::Print() << "Number of y-face fields: " << std::ranges::distance(j_face_fields) << std::endl;
         amrex::Print() << "Number of z-face fields: " << std::ranges::distance(k_face_fields) << std::endl;
 
+        // Code that runs every timestep looks its fields up by handle, an array access instead of a search by name.
+        // Get the handles once at setup and keep them, they stay valid for the lifetime of the domain.
+        const turbo::FieldHandle cell_scalar_handle = domain.GetFieldHandle("cell_scalar");
+        const turbo::Field& cell_scalar             = domain.GetFieldByHandle(cell_scalar_handle);
+        amrex::Print() << "Field from handle " << cell_scalar_handle.index << ": " << cell_scalar.name << std::endl;
+
         /////////////////////////////////////////////////////////////////////////////////////////////////
         //  Initialize all the scalar and vector MultiFabs in the Domain - Alternative approach without using
         //  Field::Initialize
         /////////////////////////////////////////////////////////////////////////////////////////////////
 
+        // The kernels capture a trivially-copyable view of the field's grid location, not the field itself
         for (const auto& field : scalar_fields)
         {
-            amrex::MultiFab& mf = *(field->multifab);
+            amrex::MultiFab& mf                      = *(field->multifab);
+            const turbo::CartesianGridView grid_view = field->GetGridView();
             for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
             {
                 const amrex::Array4<amrex::Real>& array = mf.array(mfi);
                 amrex::ParallelFor(mfi.validbox(),
                                    [=] AMREX_GPU_DEVICE(int i, int j, int k)
                                    {
-                                       const turbo::Grid::Point grid_point = field->GetGridPoint(i, j, k);
+                                       const turbo::Grid::Point grid_point = grid_view(i, j, k);
                                        array(i, j, k) =
                                            grid_point.x;  // Example: initialize scalar field with x-coordinate
                                    });
@@ -154,7 +164,8 @@ int main(int argc, char* argv[])
 
         for (const auto& field : vector_fields)
         {
-            amrex::MultiFab& mf = *(field->multifab);
+            amrex::MultiFab& mf                      = *(field->multifab);
+            const turbo::CartesianGridView grid_view = field->GetGridView();
             for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
             {
                 const amrex::Array4<amrex::Real>& array = mf.array(mfi);
@@ -162,7 +173,7 @@ int main(int argc, char* argv[])
                     mfi.validbox(),
                     [=] AMREX_GPU_DEVICE(int i, int j, int k)
                     {
-                        const turbo::Grid::Point grid_point = field->GetGridPoint(i, j, k);
+                        const turbo::Grid::Point grid_point = grid_view(i, j, k);
                         array(i, j, k, 0) =
                             grid_point.x;  // Example: initialize vector field component 0 with x-coordinate
                         array(i, j, k, 1) =
@@ -173,6 +184,26 @@ int main(int argc, char* argv[])
             }
         }
 
+        /////////////////////////////////////////////////////////////////////////////////////////////////
+        //  Fields with the stagger in their type - no runtime dispatch on the stagger
+        /////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // The grid view of a StaggeredField has its stagger offsets as compile-time constants, and operations between
+        // fields of different staggers, e.g. Copy(x_face_tendency, cell_scalar), do not compile
+        const turbo::StaggeredField<turbo::FieldGridStagger::IFace> x_face_tendency =
+            domain.CreateField<turbo::FieldGridStagger::IFace>("x_face_tendency", n_component_scalar, 0);
+        {
+            const turbo::StaggeredGridView<turbo::FieldGridStagger::IFace> grid_view = x_face_tendency.GetGridView();
+            for (amrex::MFIter mfi(x_face_tendency.GetMultiFab()); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<amrex::Real>& array = x_face_tendency.GetMultiFab().array(mfi);
+                amrex::ParallelFor(mfi.validbox(),
+                                   [=] AMREX_GPU_DEVICE(int i, int j, int k) { array(i, j, k) = grid_view.X(i); });
+            }
+        }
+        turbo::Saxpy(turbo::StaggeredField<turbo::FieldGridStagger::IFace>(domain.GetField("x_face_scalar")), 0.1,
+                     x_face_tendency);
+
         /////////////////////////////////////////////////////////////////////////////////////////////////
         //  Write output
         /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,131 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "domain.h"
+#include "field.h"
+#include "halo_exchange.h"
+#include "tripolar_geometry.h"
+#include "tripolar_grid.h"
+
+// Compares one Field::FillBoundary call per field against the fused Domain::FillBoundary for the fields of a
+// MOM6-style timestep: u, v, h, T, S and a number of passive tracers.
+//
+// Runtime parameters (AMReX ParmParse syntax, e.g. `./halo_exchange_benchmark n_tracer=50 tripolar=1`):
+//   n_cell       Number of cells in each direction (default 360 180 22, the benchmark example configuration)
+//   n_tracer     Number of passive tracers in addition to T and S (default 20)
+//   n_ghost      Number of ghost cells of every field (default 2)
+//   n_iteration  Number of timed exchanges per method (default 20)
+//   tripolar     Use a TripolarGrid, so every exchange includes the fold (default 0)
+//   box_decomposition.*  Box decomposition of the fields, see BoxDecomposition::FromParmParse (default 32^3 chunks)
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::vector<int> n_cell = {360, 180, 22};
+        int n_tracer            = 20;
+        int n_ghost             = 2;
+        int n_iteration         = 20;
+        bool tripolar           = false;
+        {
+            amrex::ParmParse pp;
+            pp.queryarr("n_cell", n_cell);
+            pp.query("n_tracer", n_tracer);
+            pp.query("n_ghost", n_ghost);
+            pp.query("n_iteration", n_iteration);
+            pp.query("tripolar", tripolar);
+        }
+
+        std::shared_ptr<turbo::Grid> grid;
+        if (tripolar)
+        {
+            grid = std::make_shared<turbo::TripolarGrid>(
+                std::make_shared<turbo::TripolarGeometry>(0.0, 360.0, -80.0, 90.0, 0.0, 5000.0), n_cell[0], n_cell[1],
+                n_cell[2]);
+        }
+        else
+        {
+            grid = std::make_shared<turbo::CartesianGrid>(
+                std::make_shared<turbo::CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), n_cell[0], n_cell[1],
+                n_cell[2]);
+        }
+        turbo::Domain domain(grid, turbo::BoxDecomposition::FromParmParse());
+
+        domain.CreateField("u", turbo::FieldGridStagger::IFace, 1, n_ghost, turbo::FoldParity::Vector);
+        domain.CreateField("v", turbo::FieldGridStagger::JFace, 1, n_ghost, turbo::FoldParity::Vector);
+        domain.CreateField("h", turbo::FieldGridStagger::CellCentered, 1, n_ghost);
+        domain.CreateField("T", turbo::FieldGridStagger::CellCentered, 1, n_ghost);
+        domain.CreateField("S", turbo::FieldGridStagger::CellCentered, 1, n_ghost);
+        for (int tracer = 0; tracer < n_tracer; ++tracer)
+        {
+            domain.CreateField("tracer_" + std::to_string(tracer), turbo::FieldGridStagger::CellCentered, 1, n_ghost);
+        }
+
+        std::vector<turbo::Field::NameType> field_names;
+        std::vector<std::shared_ptr<turbo::Field>> fields;
+        for (const std::shared_ptr<turbo::Field>& field : domain.GetFields())
+        {
+            field->multifab->setVal(1.0);
+            field_names.push_back(field->name);
+            fields.push_back(field);
+        }
+
+        const int n_box = domain.GetBoxArray(turbo::FieldGridStagger::CellCentered).size();
+        amrex::Print() << "Halo exchange benchmark: " << n_cell[0] << " x " << n_cell[1] << " x " << n_cell[2]
+                       << (tripolar ? " tripolar" : " cartesian") << " cells, " << fields.size() << " fields, "
+                       << n_ghost << " ghost cells, " << n_box << " boxes, " << amrex::ParallelDescriptor::NProcs()
+                       << " rank(s)" << std::endl;
+
+        // Per exchange, the busiest rank's number of messages and bytes sent
+        for (const bool fused : {false, true})
+        {
+            const turbo::HaloExchangeStatistics statistics = turbo::GetHaloExchangeStatistics(fields, fused);
+            amrex::Long n_message                          = static_cast<amrex::Long>(statistics.n_message);
+            amrex::Long n_byte                             = static_cast<amrex::Long>(statistics.n_byte);
+            amrex::ParallelDescriptor::ReduceLongMax(n_message);
+            amrex::ParallelDescriptor::ReduceLongMax(n_byte);
+            amrex::Print() << "  " << (fused ? "Fused" : "Per field") << ": " << n_message << " messages, "
+                           << n_byte / (1024.0 * 1024.0) << " MiB sent per exchange by the busiest rank" << std::endl;
+        }
+
+        auto time_exchange = [n_iteration](auto&& exchange)
+        {
+            // Warm up, which also builds the communication metadata that is cached for the later exchanges
+            exchange();
+
+            amrex::ParallelDescriptor::Barrier();
+            const double start_time = amrex::second();
+            for (int iteration = 0; iteration < n_iteration; ++iteration)
+            {
+                exchange();
+            }
+            double seconds_per_exchange = (amrex::second() - start_time) / n_iteration;
+            amrex::ParallelDescriptor::ReduceRealMax(seconds_per_exchange);
+            return seconds_per_exchange;
+        };
+
+        const double per_field_seconds = time_exchange(
+            [&fields]()
+            {
+                for (const std::shared_ptr<turbo::Field>& field : fields)
+                {
+                    field->FillBoundary();
+                }
+            });
+        const double fused_seconds = time_exchange([&domain, &field_names]() { domain.FillBoundary(field_names); });
+
+        amrex::Print() << "  Per field: " << per_field_seconds << " s per exchange" << std::endl;
+        amrex::Print() << "  Fused: " << fused_seconds << " s per exchange, speedup "
+                       << per_field_seconds / fused_seconds << std::endl;
+    }
+    amrex::Finalize();
+    return 0;
+}
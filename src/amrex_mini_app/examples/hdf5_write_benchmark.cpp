@@ -0,0 +1,184 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <hdf5.h>
+
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "async_hdf5_writer.h"
+#include "box_decomposition.h"
+#include "cartesian_domain.h"
+#include "field.h"
+#include "hdf5_options.h"
+
+// Times Field::WriteHDF5 for each of the available HDF5WriteModes and a range of HDF5Options: contiguous, chunked,
+// both again in column-major order (written without packing), shuffle + deflate and bit rounding + shuffle + deflate.
+// Reports the write throughput (of the uncompressed data) and the compression ratio. The field is smooth with a third
+// of the points set to zero, like a land-masked ocean field. Each file is then read back with Field::ReadHDF5 in each
+// available HDF5ReadMode, as at a restart, reporting the read throughput.
+// Then times Domain::WriteHDF5 with an AsyncHDF5Writer for the same options, reporting the time the caller is blocked
+// per write (the snapshot, plus waiting for a staging buffer once all are in use) and the total time until Flush.
+// With enough work between writes to cover the background write, the blocked time is all the model pays for output.
+//
+// Runtime parameters (AMReX ParmParse syntax, e.g. `./hdf5_write_benchmark n_cell="360 180 22" n_iteration=5`):
+//   n_cell         Number of cells in each direction (default 360 180 22, the benchmark example configuration)
+//   n_component    Number of components of the written field (default 1)
+//   n_iteration    Number of timed writes per mode and options (default 3)
+//   deflate_level  Deflate level of the compressed options (default 4)
+//   mantissa_bits  Number of mantissa bits kept by bit rounding (default 12)
+//   n_buffer       Number of staging buffers of the asynchronous writer (default 2)
+//   box_decomposition.*  Box decomposition of the field, see BoxDecomposition::FromParmParse (default 32^3 chunks)
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::vector<int> n_cell = {360, 180, 22};
+        int n_component         = 1;
+        int n_iteration         = 3;
+        int deflate_level       = 4;
+        int mantissa_bits       = 12;
+        int n_buffer            = 2;
+        {
+            amrex::ParmParse pp;
+            pp.queryarr("n_cell", n_cell);
+            pp.query("n_component", n_component);
+            pp.query("n_iteration", n_iteration);
+            pp.query("deflate_level", deflate_level);
+            pp.query("mantissa_bits", mantissa_bits);
+            pp.query("n_buffer", n_buffer);
+        }
+
+        turbo::CartesianDomain domain(0.0, 1.0, 0.0, 1.0, 0.0, 1.0, n_cell[0], n_cell[1], n_cell[2],
+                                      turbo::BoxDecomposition::FromParmParse());
+        const std::shared_ptr<turbo::Field> field =
+            domain.CreateField("benchmark_field", turbo::FieldGridStagger::CellCentered, n_component, 0);
+
+        for (amrex::MFIter mfi(*field->multifab); mfi.isValid(); ++mfi)
+        {
+            const amrex::Array4<amrex::Real>& array = field->multifab->array(mfi);
+            amrex::ParallelFor(mfi.validbox(), n_component,
+                               [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                               {
+                                   const double value = 20.0 * std::sin(0.05 * i) * std::cos(0.07 * j) -
+                                                        0.5 * k + 35.0 * n + 0.001 * std::sin(1.3 * i * j);
+                                   array(i, j, k, n) = (std::sin(0.03 * i + 0.02 * j) > 0.5) ? 0.0 : value;
+                               });
+        }
+
+        std::vector<turbo::HDF5WriteMode> modes     = {turbo::HDF5WriteMode::Gather, turbo::HDF5WriteMode::FilePerRank};
+        std::vector<turbo::HDF5ReadMode> read_modes = {turbo::HDF5ReadMode::Independent};
+#ifdef H5_HAVE_PARALLEL
+        modes.push_back(turbo::HDF5WriteMode::Collective);
+        read_modes.push_back(turbo::HDF5ReadMode::Collective);
+#endif
+
+        const double megabytes = static_cast<double>(field->multifab->boxArray().numPts()) * n_component *
+                                 sizeof(double) / (1024.0 * 1024.0);
+
+        amrex::Print() << "HDF5 write benchmark: " << n_cell[0] << " x " << n_cell[1] << " x " << n_cell[2]
+                       << " cells, " << n_component << " component(s), " << megabytes << " MiB per write, "
+                       << amrex::ParallelDescriptor::NProcs() << " rank(s), " << field->multifab->boxArray().size()
+                       << " box(es)" << std::endl;
+
+        turbo::HDF5Options chunked;
+        chunked.chunked = true;
+        turbo::HDF5Options column_major;
+        column_major.data_layout = turbo::HDF5DataLayout::ColumnMajor;
+        turbo::HDF5Options column_major_chunked = chunked;
+        column_major_chunked.data_layout        = turbo::HDF5DataLayout::ColumnMajor;
+        const std::vector<std::pair<std::string, turbo::HDF5Options>> all_hdf5_options = {
+            {"contiguous", turbo::HDF5Options()},
+            {"chunked", chunked},
+            {"column-major contiguous", column_major},
+            {"column-major chunked", column_major_chunked},
+            {"shuffle+deflate", turbo::HDF5Options::Compressed(deflate_level)},
+            {"bitround+shuffle+deflate", turbo::HDF5Options::Compressed(deflate_level, mantissa_bits)}};
+
+        for (const turbo::HDF5WriteMode mode : modes)
+        {
+            for (const auto& [label, hdf5_options] : all_hdf5_options)
+            {
+                const std::string filename = "hdf5_write_benchmark_" + turbo::HDF5WriteModeToString(mode) + ".h5";
+                field->hdf5_options        = hdf5_options;
+
+                amrex::ParallelDescriptor::Barrier();
+                const double start_time = amrex::second();
+                for (int iteration = 0; iteration < n_iteration; ++iteration)
+                {
+                    field->WriteHDF5(filename, mode);
+                }
+                amrex::ParallelDescriptor::Barrier();
+                double seconds_per_write = (amrex::second() - start_time) / n_iteration;
+                amrex::ParallelDescriptor::ReduceRealMax(seconds_per_write);
+
+                if (amrex::ParallelDescriptor::IOProcessor())
+                {
+                    // A file per rank also counts the files of the ranks, on top of the master file
+                    double file_megabytes = std::filesystem::file_size(filename) / (1024.0 * 1024.0);
+                    if (mode == turbo::HDF5WriteMode::FilePerRank)
+                    {
+                        for (int rank = 0; rank < amrex::ParallelDescriptor::NProcs(); ++rank)
+                        {
+                            file_megabytes +=
+                                std::filesystem::file_size(turbo::HDF5RankFilename(filename, rank)) / (1024.0 * 1024.0);
+                        }
+                    }
+                    amrex::Print() << "  " << turbo::HDF5WriteModeToString(mode) << ", " << label << " ("
+                                   << hdf5_options << "): " << seconds_per_write << " s per write, "
+                                   << megabytes / seconds_per_write << " MiB/s, compression ratio "
+                                   << megabytes / file_megabytes << std::endl;
+                }
+
+                for (const turbo::HDF5ReadMode read_mode : read_modes)
+                {
+                    amrex::ParallelDescriptor::Barrier();
+                    const double read_start_time = amrex::second();
+                    for (int iteration = 0; iteration < n_iteration; ++iteration)
+                    {
+                        field->ReadHDF5(filename, read_mode);
+                    }
+                    amrex::ParallelDescriptor::Barrier();
+                    double seconds_per_read = (amrex::second() - read_start_time) / n_iteration;
+                    amrex::ParallelDescriptor::ReduceRealMax(seconds_per_read);
+
+                    amrex::Print() << "    read " << turbo::HDF5ReadModeToString(read_mode) << ": " << seconds_per_read
+                                   << " s per read, " << megabytes / seconds_per_read << " MiB/s" << std::endl;
+                }
+            }
+        }
+
+        turbo::AsyncHDF5Writer writer(n_buffer);
+        for (const auto& [label, hdf5_options] : all_hdf5_options)
+        {
+            const std::string filename = "hdf5_write_benchmark_Async.h5";
+            field->hdf5_options        = hdf5_options;
+
+            amrex::ParallelDescriptor::Barrier();
+            const double start_time = amrex::second();
+            double blocked_seconds  = 0.0;
+            for (int iteration = 0; iteration < n_iteration; ++iteration)
+            {
+                const double write_start_time = amrex::second();
+                domain.WriteHDF5(filename, writer);
+                blocked_seconds += amrex::second() - write_start_time;
+            }
+            writer.Flush();
+            double seconds_per_write = (amrex::second() - start_time) / n_iteration;
+            amrex::ParallelDescriptor::ReduceRealMax(seconds_per_write);
+            double blocked_seconds_per_write = blocked_seconds / n_iteration;
+            amrex::ParallelDescriptor::ReduceRealMax(blocked_seconds_per_write);
+
+            amrex::Print() << "  Async (" << n_buffer << " buffers), " << label << " (" << hdf5_options
+                           << "): " << blocked_seconds_per_write << " s blocked per write, " << seconds_per_write
+                           << " s per write until flushed" << std::endl;
+        }
+    }
+    amrex::Finalize();
+    return 0;
+}
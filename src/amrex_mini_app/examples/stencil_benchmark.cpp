@@ -0,0 +1,178 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "domain.h"
+#include "field.h"
+#include "field_expression.h"
+#include "staggered_field.h"
+#include "stencil_operators.h"
+
+namespace
+{
+
+/**
+ * @brief Set all points of a field, ghost cells included, to a smooth function of the indices.
+ */
+void Fill(const turbo::Field& field)
+{
+    amrex::MultiFab& mf = *field.multifab;
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+        amrex::ParallelFor(mfi.fabbox(), mf.nComp(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                           { array(i, j, k, n) = std::sin(0.05 * i) * std::cos(0.07 * j) - 0.5 * k + n; });
+    }
+}
+
+/**
+ * @brief STREAM triad a = b + scalar * c over the valid points, with the tiling of the stencil operators.
+ */
+void Triad(amrex::MultiFab& a, const amrex::MultiFab& b, const amrex::MultiFab& c, const amrex::Real scalar)
+{
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(a, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real> a_array       = a.array(mfi);
+        const amrex::Array4<const amrex::Real> b_array = b.const_array(mfi);
+        const amrex::Array4<const amrex::Real> c_array = c.const_array(mfi);
+        amrex::ParallelFor(mfi.tilebox(), a.nComp(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                           { a_array(i, j, k, n) = b_array(i, j, k, n) + scalar * c_array(i, j, k, n); });
+    }
+}
+
+/**
+ * @brief Get the number of valid points of a field on all ranks times its number of components.
+ */
+double NumberOfValues(const turbo::Field& field)
+{
+    return static_cast<double>(field.multifab->boxArray().numPts()) * field.multifab->nComp();
+}
+
+}  // namespace
+
+// Times the C-grid stencil operators of stencil_operators.h on the fields of a MOM6-style layer, against the STREAM
+// triad on the same layout as the attainable memory bandwidth. The bandwidth of an operator counts the compulsory
+// traffic only: every input read once over the valid points of the output and the output written once. A fused
+// stencil that reaches a large fraction of the triad is limited by memory, not by its arithmetic. A multi-term tendency
+// update is timed as a fused field expression and as chained Copy and Saxpy calls.
+//
+// Runtime parameters (AMReX ParmParse syntax, e.g. `./stencil_benchmark n_cell=1440 1080 75 n_component=2`):
+//   n_cell       Number of cells in each direction (default 360 180 22, the benchmark example configuration)
+//   n_component  Number of components of every field, e.g. layers of tracers operated on at once (default 1)
+//   n_iteration  Number of timed calls per operator (default 20)
+//   box_decomposition.*  Box decomposition of the fields, see BoxDecomposition::FromParmParse (default 32^3 chunks)
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::vector<int> n_cell = {360, 180, 22};
+        int n_component         = 1;
+        int n_iteration         = 20;
+        {
+            amrex::ParmParse pp;
+            pp.queryarr("n_cell", n_cell);
+            pp.query("n_component", n_component);
+            pp.query("n_iteration", n_iteration);
+        }
+
+        using turbo::FieldGridStagger;
+        const std::shared_ptr<turbo::CartesianGrid> grid = std::make_shared<turbo::CartesianGrid>(
+            std::make_shared<turbo::CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), n_cell[0], n_cell[1], n_cell[2]);
+        turbo::Domain domain(grid, turbo::BoxDecomposition::FromParmParse());
+
+        const int n_ghost   = 2;
+        const auto h        = domain.CreateField<FieldGridStagger::CellCentered>("h", n_component, n_ghost);
+        const auto h_out    = domain.CreateField<FieldGridStagger::CellCentered>("h_out", n_component, n_ghost);
+        const auto tracer   = domain.CreateField<FieldGridStagger::CellCentered>("tracer", n_component, n_ghost);
+        const auto tendency = domain.CreateField<FieldGridStagger::CellCentered>("tendency", n_component, n_ghost);
+        const auto u        = domain.CreateField<FieldGridStagger::IFace>("u", n_component, n_ghost);
+        const auto v        = domain.CreateField<FieldGridStagger::JFace>("v", n_component, n_ghost);
+        const auto w        = domain.CreateField<FieldGridStagger::KFace>("w", n_component, n_ghost);
+        const auto zeta     = domain.CreateField<FieldGridStagger::Nodal>("zeta", n_component, n_ghost);
+        for (const std::shared_ptr<turbo::Field>& field : domain.GetFields())
+        {
+            Fill(*field);
+        }
+
+        const int n_box = domain.GetBoxArray(FieldGridStagger::CellCentered).size();
+        amrex::Print() << "Stencil benchmark: " << n_cell[0] << " x " << n_cell[1] << " x " << n_cell[2] << " cells, "
+                       << n_component << " component(s), " << n_box << " boxes, "
+                       << amrex::ParallelDescriptor::NProcs() << " rank(s)" << std::endl;
+
+        auto time_iterations = [n_iteration](auto&& function)
+        {
+            amrex::ParallelDescriptor::Barrier();
+            const double start_time = amrex::second();
+            for (int iteration = 0; iteration < n_iteration; ++iteration)
+            {
+                function();
+            }
+            amrex::ParallelDescriptor::Barrier();
+            double seconds_per_iteration = (amrex::second() - start_time) / n_iteration;
+            amrex::ParallelDescriptor::ReduceRealMax(seconds_per_iteration);
+            return seconds_per_iteration;
+        };
+
+        const double triad_seconds = time_iterations(
+            [&h, &h_out, &tracer]() { Triad(h_out.GetMultiFab(), h.GetMultiFab(), tracer.GetMultiFab(), 3.0); });
+        const double triad_bandwidth =
+            3.0 * NumberOfValues(*h.GetField()) * sizeof(amrex::Real) / 1.0e9 / triad_seconds;
+        amrex::Print() << "  STREAM triad: " << triad_seconds << " s per call, " << triad_bandwidth << " GB/s"
+                       << std::endl;
+
+        // n_array is the number of arrays moved per value of the output, the inputs and the output
+        auto report = [&time_iterations, triad_bandwidth](const std::string& name, const turbo::Field& output,
+                                                          const int n_array, auto&& function)
+        {
+            const double seconds   = time_iterations(function);
+            const double bandwidth = n_array * NumberOfValues(output) * sizeof(amrex::Real) / 1.0e9 / seconds;
+            amrex::Print() << "  " << name << ": " << seconds << " s per call, " << bandwidth << " GB/s, "
+                           << 100.0 * bandwidth / triad_bandwidth << " % of STREAM triad" << std::endl;
+        };
+
+        report("Gradient I", *u.GetField(), 2, [&u, &h]() { turbo::Gradient(u, h); });
+        report("Gradient J", *v.GetField(), 2, [&v, &h]() { turbo::Gradient(v, h); });
+        report("Gradient K", *w.GetField(), 2, [&w, &h]() { turbo::Gradient(w, h); });
+        report("Divergence", *h_out.GetField(), 4, [&h_out, &u, &v, &w]() { turbo::Divergence(h_out, u, v, w); });
+        report("HorizontalDivergence", *h_out.GetField(), 3,
+               [&h_out, &u, &v]() { turbo::HorizontalDivergence(h_out, u, v); });
+        report("HorizontalLaplacian", *h_out.GetField(), 2, [&h_out, &h]() { turbo::HorizontalLaplacian(h_out, h); });
+        report("HorizontalBiharmonic", *h_out.GetField(), 2,
+               [&h_out, &h]() { turbo::HorizontalBiharmonic(h_out, h); });
+        report("Vorticity", *zeta.GetField(), 3, [&zeta, &u, &v]() { turbo::Vorticity(zeta, u, v); });
+        report("CellToFace I", *u.GetField(), 2, [&u, &h]() { turbo::CellToFace(u, h); });
+        report("FaceToCell I", *h_out.GetField(), 2, [&h_out, &u]() { turbo::FaceToCell(h_out, u); });
+
+        // A tendency update h_out = h + dt * (a * f + b * g), fused by field_expression.h into one sweep over the four
+        // arrays, against the chained Copy and Saxpy calls, which sweep over eight. Both count the fused traffic.
+        const double dt = 0.1;
+        const double a  = 1.5;
+        const double b  = -0.5;
+        report("Fused tendency update", *h_out.GetField(), 4,
+               [&h_out, &h, &tracer, &tendency, dt, a, b]()
+               { turbo::Assign(h_out, h + dt * (a * tracer + b * tendency)); });
+        report("Chained tendency update", *h_out.GetField(), 4,
+               [&h_out, &h, &tracer, &tendency, dt, a, b]()
+               {
+                   turbo::Copy(h_out, h);
+                   turbo::Saxpy(h_out, dt * a, tracer);
+                   turbo::Saxpy(h_out, dt * b, tendency);
+               });
+    }
+    amrex::Finalize();
+    return 0;
+}
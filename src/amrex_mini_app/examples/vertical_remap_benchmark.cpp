@@ -0,0 +1,162 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "column_utils.h"
+#include "domain.h"
+#include "field.h"
+#include "staggered_field.h"
+#include "vertical_remap.h"
+
+namespace
+{
+
+/**
+ * @brief Set the source thickness to layers that thicken with depth, the target thickness to uniform layers with the
+ * same column total, as a z* coordinate would after a change of the free surface, and the tracers to a thermocline.
+ */
+void FillColumns(const turbo::Field& source_thickness, const turbo::Field& target_thickness,
+                 const std::vector<std::shared_ptr<turbo::Field>>& tracers)
+{
+    for (amrex::MFIter mfi(*source_thickness.multifab); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box box                    = mfi.validbox();
+        const amrex::Array4<amrex::Real> source = source_thickness.multifab->array(mfi);
+        const amrex::Array4<amrex::Real> target = target_thickness.multifab->array(mfi);
+        const int k_first                       = box.smallEnd(2);
+        const int k_last                        = box.bigEnd(2);
+        amrex::Box columns                      = box;
+        columns.setBig(2, k_first);
+        amrex::ParallelFor(columns,
+                           [=] AMREX_GPU_DEVICE(int i, int j, int)
+                           {
+                               amrex::Real total = 0.0;
+                               for (int k = k_first; k <= k_last; ++k)
+                               {
+                                   source(i, j, k) = (1.0 + 0.1 * k) * (1.0 + 0.05 * std::sin(0.1 * i + 0.2 * j));
+                                   total += source(i, j, k);
+                               }
+                               for (int k = k_first; k <= k_last; ++k)
+                               {
+                                   target(i, j, k) = total / (k_last - k_first + 1);
+                               }
+                           });
+        for (const std::shared_ptr<turbo::Field>& tracer : tracers)
+        {
+            const amrex::Array4<amrex::Real> x = tracer->multifab->array(mfi);
+            amrex::ParallelFor(box, tracer->multifab->nComp(),
+                               [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                               { x(i, j, k, n) = 20.0 * std::tanh(0.3 * (k - 8)) + 0.01 * i - 0.02 * j + n; });
+        }
+    }
+}
+
+}  // namespace
+
+// Times the vertical remapping of vertical_remap.h, the ALE step of MOM6 that remaps every column of n_tracer tracers
+// from the old to the new layer thicknesses, with PLM and PPM reconstruction for ocean columns of 22 and 75 levels.
+// The tracers are remapped in one call, which computes the geometry of every column once for all tracers, and in one
+// call per tracer, which recomputes it for each. The result is reported as tracer columns remapped per second.
+//
+// The remapping needs boxes that contain whole columns, so the box decomposition is made by WholeColumnDecomposition.
+//
+// Runtime parameters (AMReX ParmParse syntax, e.g. `./vertical_remap_benchmark n_level=75 n_tracer=10`):
+//   n_cell       Number of cells in i and j, the third value is replaced by n_level (default 360 180 22)
+//   n_level      Number of levels of the columns, one run per value (default 22 75)
+//   n_tracer     Number of tracers remapped at once, e.g. temperature and salinity (default 2)
+//   n_iteration  Number of timed remaps per run (default 20)
+//   box_decomposition.*  Box decomposition of the fields, see BoxDecomposition::FromParmParse (default 32^3 chunks)
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::vector<int> n_cell  = {360, 180, 22};
+        std::vector<int> n_level = {22, 75};
+        int n_tracer             = 2;
+        int n_iteration          = 20;
+        {
+            amrex::ParmParse pp;
+            pp.queryarr("n_cell", n_cell);
+            pp.queryarr("n_level", n_level);
+            pp.query("n_tracer", n_tracer);
+            pp.query("n_iteration", n_iteration);
+        }
+
+        auto time_iterations = [n_iteration](auto&& function)
+        {
+            amrex::ParallelDescriptor::Barrier();
+            const double start_time = amrex::second();
+            for (int iteration = 0; iteration < n_iteration; ++iteration)
+            {
+                function();
+            }
+            amrex::ParallelDescriptor::Barrier();
+            double seconds_per_iteration = (amrex::second() - start_time) / n_iteration;
+            amrex::ParallelDescriptor::ReduceRealMax(seconds_per_iteration);
+            return seconds_per_iteration;
+        };
+
+        using turbo::FieldGridStagger;
+        for (const int levels : n_level)
+        {
+            const turbo::BoxDecomposition box_decomposition =
+                turbo::WholeColumnDecomposition(turbo::BoxDecomposition::FromParmParse(), levels);
+
+            const std::shared_ptr<turbo::CartesianGrid> grid = std::make_shared<turbo::CartesianGrid>(
+                std::make_shared<turbo::CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), n_cell[0], n_cell[1], levels);
+            turbo::Domain domain(grid, box_decomposition);
+
+            const int n_ghost           = 0;
+            const auto source_thickness = domain.CreateField<FieldGridStagger::CellCentered>("h_source", 1, n_ghost);
+            const auto target_thickness = domain.CreateField<FieldGridStagger::CellCentered>("h_target", 1, n_ghost);
+            std::vector<std::shared_ptr<turbo::Field>> tracers;
+            for (int tracer = 0; tracer < n_tracer; ++tracer)
+            {
+                tracers.push_back(
+                    domain.CreateField<FieldGridStagger::CellCentered>("tracer_" + std::to_string(tracer), 1, n_ghost)
+                        .GetField());
+            }
+            FillColumns(*source_thickness.GetField(), *target_thickness.GetField(), tracers);
+
+            const int n_box = domain.GetBoxArray(FieldGridStagger::CellCentered).size();
+            amrex::Print() << "Vertical remap benchmark: " << n_cell[0] << " x " << n_cell[1] << " columns of "
+                           << levels << " levels, " << n_tracer << " tracer(s), " << n_box << " boxes, "
+                           << amrex::ParallelDescriptor::NProcs() << " rank(s)" << std::endl;
+
+            // Every remap moves the tracers from the source to the target layers again, so the tracers get smoother
+            // but the work per remap stays the same
+            const double n_column = static_cast<double>(n_cell[0]) * n_cell[1] * n_tracer;
+            for (const turbo::RemapScheme scheme : {turbo::RemapScheme::PLM, turbo::RemapScheme::PPM})
+            {
+                const double shared_seconds = time_iterations(
+                    [&source_thickness, &target_thickness, &tracers, scheme]()
+                    { turbo::RemapColumns(source_thickness, target_thickness, tracers, scheme); });
+                const double separate_seconds = time_iterations(
+                    [&source_thickness, &target_thickness, &tracers, scheme]()
+                    {
+                        for (const std::shared_ptr<turbo::Field>& tracer : tracers)
+                        {
+                            turbo::RemapColumns(source_thickness, target_thickness, {tracer}, scheme);
+                        }
+                    });
+                amrex::Print() << "  " << turbo::RemapSchemeToString(scheme) << " all tracers in one call: "
+                               << shared_seconds << " s per remap, " << n_column / shared_seconds << " columns/s"
+                               << std::endl;
+                amrex::Print() << "  " << turbo::RemapSchemeToString(scheme) << " one call per tracer: "
+                               << separate_seconds << " s per remap, " << n_column / separate_seconds << " columns/s"
+                               << std::endl;
+            }
+        }
+    }
+    amrex::Finalize();
+    return 0;
+}
@@ -12,8 +12,14 @@ data_dict = {}
 with h5py.File(args.filename, "r") as f:
     print("Datasets found in file:")
     for name in f:
-        arr = f[name][:]
-        data_dict[name] = np.array(arr)
+        if isinstance(f[name], h5py.Group):
+            # Cartesian grid locations are stored as 1D x, y, z coordinate axes; expand them to the full
+            # (ni, nj, nk, 3) coordinate array the plotting functions below expect.
+            x, y, z = (np.array(f[name][axis][:]) for axis in ("x", "y", "z"))
+            arr = np.stack(np.meshgrid(x, y, z, indexing="ij"), axis=-1)
+        else:
+            arr = np.array(f[name][:])
+        data_dict[name] = arr
         print(f"  {name}: shape={arr.shape}, dtype={arr.dtype}")
 
 # Get data as numpy arrays
@@ -0,0 +1,495 @@
+#include "diag_table.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace turbo
+{
+
+namespace
+{
+
+/**
+ * @brief Days of each month of the 365 day (noleap) calendar.
+ */
+constexpr std::array<int, 12> kDaysPerMonth = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+constexpr int kDaysPerYear      = 365;
+constexpr double kSecondsPerDay = 86400.0;
+
+/**
+ * @brief Remove leading and trailing white space.
+ */
+std::string Trim(const std::string& text)
+{
+    const auto is_space = [](unsigned char c) { return std::isspace(c) != 0; };
+    const auto begin    = std::find_if_not(text.begin(), text.end(), is_space);
+    const auto end      = std::find_if_not(text.rbegin(), text.rend(), is_space).base();
+    return begin < end ? std::string(begin, end) : std::string();
+}
+
+/**
+ * @brief Convert to lower case.
+ */
+std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+/**
+ * @brief A comma separated value of a diag_table line, with its quotes removed.
+ */
+struct Token
+{
+    std::string text;
+    bool quoted = false;
+};
+
+/**
+ * @brief Split a diag_table line at the commas outside of quotes. A trailing empty value is dropped.
+ */
+std::vector<Token> Tokenize(const std::string& line, const int line_number)
+{
+    std::vector<Token> tokens;
+    std::string current;
+    char quote     = '\0';
+    bool in_quotes = false;
+    bool quoted    = false;
+    for (const char c : line)
+    {
+        if ((c == '"' || c == '\'') && !in_quotes && !quoted)
+        {
+            if (!Trim(current).empty())
+            {
+                throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) +
+                                            ": Unexpected text before a quoted value.");
+            }
+            current.clear();
+            quote     = c;
+            in_quotes = true;
+            quoted    = true;
+        }
+        else if (in_quotes && c == quote)
+        {
+            in_quotes = false;
+        }
+        else if (c == ',' && !in_quotes)
+        {
+            tokens.push_back({quoted ? current : Trim(current), quoted});
+            current.clear();
+            quoted = false;
+        }
+        else if (!in_quotes && quoted && std::isspace(static_cast<unsigned char>(c)) == 0)
+        {
+            throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) +
+                                        ": Unexpected text after a quoted value.");
+        }
+        else if (in_quotes || !quoted)
+        {
+            current += c;
+        }
+    }
+    if (in_quotes)
+    {
+        throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) + ": Unterminated quote.");
+    }
+    if (quoted || !Trim(current).empty())
+    {
+        tokens.push_back({quoted ? current : Trim(current), quoted});
+    }
+    return tokens;
+}
+
+/**
+ * @brief Parse a number of a diag_table line.
+ */
+double ParseNumber(const Token& token, const int line_number)
+{
+    std::size_t n_parsed = 0;
+    double value         = 0.0;
+    try
+    {
+        value = std::stod(token.text, &n_parsed);
+    }
+    catch (const std::exception&)
+    {
+        n_parsed = 0;
+    }
+    if (token.quoted || n_parsed == 0 || n_parsed != token.text.size())
+    {
+        throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) +
+                                    ": Expected a number, got '" + token.text + "'.");
+    }
+    return value;
+}
+
+/**
+ * @brief Parse the time_avg column of a field entry.
+ */
+DiagnosticReduction ParseReduction(const Token& token, const int line_number)
+{
+    const std::string text = ToLower(token.text);
+    if (text == ".true." || text == "mean" || text == "average" || text == "avg")
+    {
+        return DiagnosticReduction::Mean;
+    }
+    if (text == ".false." || text == "none" || text == "last")
+    {
+        return DiagnosticReduction::Last;
+    }
+    if (text == "min")
+    {
+        return DiagnosticReduction::Min;
+    }
+    if (text == "max")
+    {
+        return DiagnosticReduction::Max;
+    }
+    throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) + ": Unknown reduction '" +
+                                token.text + "'.");
+}
+
+/**
+ * @brief Parse an interval from a number and a unit column.
+ */
+DiagnosticInterval ParseInterval(const Token& value, const Token& unit, const int line_number)
+{
+    DiagnosticInterval interval;
+    interval.value = ParseNumber(value, line_number);
+    try
+    {
+        interval.unit = ParseDiagnosticTimeUnit(unit.text);
+    }
+    catch (const std::invalid_argument& error)
+    {
+        throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) + ": " + error.what());
+    }
+    return interval;
+}
+
+/**
+ * @brief Check a date and return the day of the year of its month and day, starting at 0.
+ */
+int DayOfYear(const DiagnosticDate& date, const std::string& function_name)
+{
+    const auto [year, month, day, hour, minute, second] = date;
+    if (year < 0 || month < 1 || month > 12 || day < 1 || day > kDaysPerMonth[month - 1] || hour < 0 || hour > 23 ||
+        minute < 0 || minute > 59 || second < 0 || second > 59)
+    {
+        throw std::invalid_argument(function_name + ": Invalid base date.");
+    }
+    int day_of_year = day - 1;
+    for (int m = 0; m < month - 1; ++m)
+    {
+        day_of_year += kDaysPerMonth[m];
+    }
+    return day_of_year;
+}
+
+/**
+ * @brief Seconds from the start of year 0 to a date.
+ */
+double DateToSeconds(const DiagnosticDate& date, const std::string& function_name)
+{
+    const double days = static_cast<double>(date[0]) * kDaysPerYear + DayOfYear(date, function_name);
+    return days * kSecondsPerDay + date[3] * 3600.0 + date[4] * 60.0 + date[5];
+}
+
+/**
+ * @brief A date with fractional seconds, from the seconds since the start of year 0.
+ */
+struct CalendarTime
+{
+    long long year = 0;
+    int month      = 1; /**< 1 to 12. */
+    int day        = 1; /**< 1 to the days of the month. */
+    double seconds = 0; /**< Seconds since the start of the day. */
+
+    explicit CalendarTime(const double absolute_seconds)
+    {
+        const double days         = std::floor(absolute_seconds / kSecondsPerDay);
+        seconds                   = absolute_seconds - days * kSecondsPerDay;
+        const long long day_count = static_cast<long long>(days);
+        year                      = day_count / kDaysPerYear;
+        int day_of_year           = static_cast<int>(day_count % kDaysPerYear);
+        month                     = 1;
+        while (day_of_year >= kDaysPerMonth[month - 1])
+        {
+            day_of_year -= kDaysPerMonth[month - 1];
+            ++month;
+        }
+        day = day_of_year + 1;
+    }
+
+    double ToSeconds() const
+    {
+        long long days = year * kDaysPerYear + day - 1;
+        for (int m = 0; m < month - 1; ++m)
+        {
+            days += kDaysPerMonth[m];
+        }
+        return static_cast<double>(days) * kSecondsPerDay + seconds;
+    }
+};
+
+}  // namespace
+
+DiagTable DiagTable::Parse(std::istream& input)
+{
+    DiagTable table;
+    std::vector<std::pair<DiagnosticFieldEntry, int>> fields;
+    std::set<std::string> file_names;
+    bool has_title     = false;
+    bool has_base_date = false;
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(input, line))
+    {
+        ++line_number;
+        const std::string trimmed = Trim(line);
+        if (trimmed.empty() || trimmed.front() == '#')
+        {
+            continue;
+        }
+
+        if (!has_title)
+        {
+            const std::vector<Token> tokens = Tokenize(trimmed, line_number);
+            table.title                     = tokens.empty() ? std::string() : tokens.front().text;
+            has_title                       = true;
+            continue;
+        }
+        if (!has_base_date)
+        {
+            std::istringstream stream(trimmed);
+            for (int& value : table.base_date)
+            {
+                if (!(stream >> value))
+                {
+                    throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) +
+                                                ": Expected the base date 'year month day hour minute second'.");
+                }
+            }
+            DayOfYear(table.base_date, "DiagTable::Parse");
+            has_base_date = true;
+            continue;
+        }
+
+        const std::vector<Token> tokens = Tokenize(trimmed, line_number);
+        if (tokens.size() >= 2 && !tokens[1].quoted)
+        {
+            // File entry: "name", output_freq, "units", format, "time_units", "long_name"[, new_file_freq, "units"]
+            if (tokens.size() != 6 && tokens.size() != 8)
+            {
+                throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) +
+                                            ": A file entry has 6 or 8 values.");
+            }
+            DiagnosticFileEntry file;
+            file.name            = tokens[0].text;
+            file.output_interval = ParseInterval(tokens[1], tokens[2], line_number);
+            if (tokens.size() == 8)
+            {
+                file.new_file_interval = ParseInterval(tokens[6], tokens[7], line_number);
+            }
+            if (!file_names.insert(file.name).second)
+            {
+                throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) + ": File '" +
+                                            file.name + "' appears more than once.");
+            }
+            table.files.push_back(file);
+        }
+        else
+        {
+            // Field entry: "module", "field", "output_name", "file", "sampling", time_avg, "options", packing
+            if (tokens.size() != 8)
+            {
+                throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(line_number) +
+                                            ": A field entry has 8 values.");
+            }
+            DiagnosticFieldEntry field;
+            field.module_name = tokens[0].text;
+            field.field_name  = tokens[1].text;
+            field.output_name = tokens[2].text;
+            field.file_name   = tokens[3].text;
+            field.reduction   = ParseReduction(tokens[5], line_number);
+            fields.emplace_back(field, line_number);
+        }
+    }
+
+    if (!has_base_date)
+    {
+        throw std::invalid_argument("DiagTable::Parse: The table has no title and base date.");
+    }
+    // Files can be listed after the fields that refer to them
+    for (const auto& [field, field_line_number] : fields)
+    {
+        if (!file_names.contains(field.file_name))
+        {
+            throw std::invalid_argument("DiagTable::Parse: Line " + std::to_string(field_line_number) + ": File '" +
+                                        field.file_name + "' of field '" + field.field_name + "' is not in the table.");
+        }
+        table.fields.push_back(field);
+    }
+    return table;
+}
+
+DiagTable DiagTable::FromFile(const std::string& filename)
+{
+    std::ifstream input(filename);
+    if (!input)
+    {
+        throw std::runtime_error("DiagTable::FromFile: Failed to open file: " + filename);
+    }
+    return Parse(input);
+}
+
+DiagnosticTimeUnit ParseDiagnosticTimeUnit(const std::string& unit)
+{
+    std::string name = ToLower(Trim(unit));
+    if (!name.empty() && name.back() == 's')
+    {
+        name.pop_back();
+    }
+    if (name == "second")
+    {
+        return DiagnosticTimeUnit::Seconds;
+    }
+    if (name == "minute")
+    {
+        return DiagnosticTimeUnit::Minutes;
+    }
+    if (name == "hour")
+    {
+        return DiagnosticTimeUnit::Hours;
+    }
+    if (name == "day")
+    {
+        return DiagnosticTimeUnit::Days;
+    }
+    if (name == "month")
+    {
+        return DiagnosticTimeUnit::Months;
+    }
+    if (name == "year")
+    {
+        return DiagnosticTimeUnit::Years;
+    }
+    throw std::invalid_argument("ParseDiagnosticTimeUnit: Unknown time unit '" + unit + "'.");
+}
+
+double AdvanceDiagnosticTime(const DiagnosticDate& base_date, const double time, const DiagnosticInterval& interval,
+                             const int n_interval)
+{
+    const double base_seconds = DateToSeconds(base_date, "AdvanceDiagnosticTime");
+    const double value        = interval.value * n_interval;
+    switch (interval.unit)
+    {
+        case DiagnosticTimeUnit::Seconds:
+            return time + value;
+        case DiagnosticTimeUnit::Minutes:
+            return time + value * 60.0;
+        case DiagnosticTimeUnit::Hours:
+            return time + value * 3600.0;
+        case DiagnosticTimeUnit::Days:
+            return time + value * kSecondsPerDay;
+        case DiagnosticTimeUnit::Months:
+        case DiagnosticTimeUnit::Years:
+        {
+            if (interval.value != std::round(interval.value))
+            {
+                throw std::invalid_argument("AdvanceDiagnosticTime: Intervals of months and years must be whole.");
+            }
+            const long long n_month =
+                static_cast<long long>(value) * (interval.unit == DiagnosticTimeUnit::Years ? 12 : 1);
+            CalendarTime date(base_seconds + time);
+            const long long month_count = date.year * 12 + (date.month - 1) + n_month;
+            date.year                   = month_count / 12;
+            date.month                  = static_cast<int>(month_count % 12) + 1;
+            date.day                    = std::min(date.day, kDaysPerMonth[date.month - 1]);
+            return date.ToSeconds() - base_seconds;
+        }
+        default:
+            throw std::invalid_argument("AdvanceDiagnosticTime: Invalid DiagnosticTimeUnit specified.");
+    }
+}
+
+std::string ExpandDiagnosticFilename(const std::string& name_template, const DiagnosticDate& base_date,
+                                     const double time)
+{
+    const CalendarTime date(DateToSeconds(base_date, "ExpandDiagnosticFilename") + time);
+    const long long second_of_day = static_cast<long long>(std::floor(date.seconds));
+
+    std::string filename;
+    for (std::size_t position = 0; position < name_template.size(); ++position)
+    {
+        if (name_template[position] != '%')
+        {
+            filename += name_template[position];
+            continue;
+        }
+
+        std::size_t end = position + 1;
+        while (end < name_template.size() && std::isdigit(static_cast<unsigned char>(name_template[end])) != 0)
+        {
+            ++end;
+        }
+        if (end == position + 1 || end + 2 > name_template.size())
+        {
+            throw std::invalid_argument("ExpandDiagnosticFilename: Malformed date token in '" + name_template + "'.");
+        }
+        const int width         = std::stoi(name_template.substr(position + 1, end - position - 1));
+        const std::string field = name_template.substr(end, 2);
+
+        long long value = 0;
+        if (field == "yr")
+        {
+            value = date.year;
+        }
+        else if (field == "mo")
+        {
+            value = date.month;
+        }
+        else if (field == "dy")
+        {
+            value = date.day;
+        }
+        else if (field == "hr")
+        {
+            value = second_of_day / 3600;
+        }
+        else if (field == "mi")
+        {
+            value = second_of_day / 60 % 60;
+        }
+        else if (field == "sc")
+        {
+            value = second_of_day % 60;
+        }
+        else
+        {
+            throw std::invalid_argument("ExpandDiagnosticFilename: Unknown date token '%" +
+                                        name_template.substr(position + 1, end + 1 - position) + "' in '" +
+                                        name_template + "'.");
+        }
+
+        const std::string digits = std::to_string(value);
+        filename += std::string(std::max(0, width - static_cast<int>(digits.size())), '0') + digits;
+        position = end + 1;
+    }
+    return filename;
+}
+
+}  // namespace turbo
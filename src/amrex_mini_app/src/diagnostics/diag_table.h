@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace turbo
+{
+
+/**
+ * @enum DiagnosticReduction
+ * @brief How the samples of a field over an output interval are reduced to the value written at the end of it.
+ */
+enum class DiagnosticReduction
+{
+    Last, /**< Value at the end of the interval, i.e. instantaneous output. */
+    Mean, /**< Mean of the samples, each weighted by its time step. */
+    Min,  /**< Minimum of the samples. */
+    Max   /**< Maximum of the samples. */
+};
+
+/**
+ * @brief Convert a DiagnosticReduction enum value to a string. Useful for debugging and logging.
+ * @param reduction The DiagnosticReduction value to convert.
+ * @return String representation of the reduction.
+ * @throws std::invalid_argument if the value is invalid.
+ */
+inline std::string DiagnosticReductionToString(DiagnosticReduction reduction)
+{
+    switch (reduction)
+    {
+        case DiagnosticReduction::Last:
+            return "Last";
+        case DiagnosticReduction::Mean:
+            return "Mean";
+        case DiagnosticReduction::Min:
+            return "Min";
+        case DiagnosticReduction::Max:
+            return "Max";
+        default:
+            throw std::invalid_argument("DiagnosticReductionToString Invalid DiagnosticReduction specified.");
+    }
+}
+
+/**
+ * @enum DiagnosticTimeUnit
+ * @brief Unit of a diag_table time interval.
+ */
+enum class DiagnosticTimeUnit
+{
+    Seconds, /**< 1 second. */
+    Minutes, /**< 60 seconds. */
+    Hours,   /**< 3600 seconds. */
+    Days,    /**< 86400 seconds. */
+    Months,  /**< Calendar month, 28 to 31 days. */
+    Years    /**< Calendar year, 365 days. */
+};
+
+/**
+ * @brief Convert a DiagnosticTimeUnit enum value to a string. Useful for debugging and logging.
+ * @param unit The DiagnosticTimeUnit value to convert.
+ * @return String representation of the unit, as written in a diag_table.
+ * @throws std::invalid_argument if the value is invalid.
+ */
+inline std::string DiagnosticTimeUnitToString(DiagnosticTimeUnit unit)
+{
+    switch (unit)
+    {
+        case DiagnosticTimeUnit::Seconds:
+            return "seconds";
+        case DiagnosticTimeUnit::Minutes:
+            return "minutes";
+        case DiagnosticTimeUnit::Hours:
+            return "hours";
+        case DiagnosticTimeUnit::Days:
+            return "days";
+        case DiagnosticTimeUnit::Months:
+            return "months";
+        case DiagnosticTimeUnit::Years:
+            return "years";
+        default:
+            throw std::invalid_argument("DiagnosticTimeUnitToString Invalid DiagnosticTimeUnit specified.");
+    }
+}
+
+/**
+ * @brief Date of the start of the model time, as year, month, day, hour, minute and second.
+ */
+using DiagnosticDate = std::array<int, 6>;
+
+/**
+ * @brief Default base date, the start of year 1.
+ */
+inline constexpr DiagnosticDate kDefaultBaseDate = {1, 1, 1, 0, 0, 0};
+
+/**
+ * @brief A time interval of a diag_table, e.g. 5 days.
+ */
+struct DiagnosticInterval
+{
+    double value            = 0.0;                         /**< Number of units, whole for months and years. */
+    DiagnosticTimeUnit unit = DiagnosticTimeUnit::Seconds; /**< Unit of the interval. */
+};
+
+/**
+ * @brief A file entry of a diag_table: an output stream written at a fixed interval.
+ */
+struct DiagnosticFileEntry
+{
+    std::string name;                      /**< File name, a template expanded by ExpandDiagnosticFilename. */
+    DiagnosticInterval output_interval;    /**< Between writes, 0 for every update, negative for the end of run. */
+    DiagnosticInterval new_file_interval;  /**< Between new files, 0 for one file for the whole run. */
+};
+
+/**
+ * @brief A field entry of a diag_table: a field written to a file with a reduction.
+ */
+struct DiagnosticFieldEntry
+{
+    std::string module_name;                                   /**< Module of the field, e.g. "ocean_model". */
+    std::string field_name;                                    /**< Name of the field in the model. */
+    std::string output_name;                                   /**< Name of the dataset in the file. */
+    std::string file_name;                                     /**< Name of the file entry to write to. */
+    DiagnosticReduction reduction = DiagnosticReduction::Last; /**< Reduction over the output interval. */
+};
+
+/**
+ * @class DiagTable
+ * @brief The output requests of a run, read from an FMS diag_table as used by the MOM6 examples.
+ *
+ * The table starts with a title line and a base date line ("year month day hour minute second"), followed by file and
+ * field entries in any order. Lines starting with # are comments. A file entry is
+ *
+ *     "file_name", output_freq, "output_units", format, "time_units", "time_long_name"[, new_file_freq,
+ *     "new_file_freq_units"]
+ *
+ * where output_freq 0 writes at every update and -1 at the end of the run, and a field entry is
+ *
+ *     "module_name", "field_name", "output_name", "file_name", "time_sampling", time_avg, "other_opts", packing
+ *
+ * where time_avg is .true. (or "mean"/"average") for time averages, .false. (or "none") for instantaneous values, or
+ * "min"/"max". Units are seconds, minutes, hours, days, months or years of a 365 day (noleap) calendar. The format,
+ * time units and long name, time sampling, options and packing are ignored.
+ */
+struct DiagTable
+{
+    //-----------------------------------------------------------------------//
+    // Public Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Title of the experiment.
+     */
+    std::string title;
+
+    /**
+     * @brief Date of model time 0, used to expand the file names.
+     */
+    DiagnosticDate base_date = kDefaultBaseDate;
+
+    /**
+     * @brief File entries, in the order of the table.
+     */
+    std::vector<DiagnosticFileEntry> files;
+
+    /**
+     * @brief Field entries, in the order of the table.
+     */
+    std::vector<DiagnosticFieldEntry> fields;
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Parse a diag_table.
+     * @param input Stream with the contents of the table.
+     * @return The table.
+     * @throws std::invalid_argument if a line cannot be parsed, or a field entry refers to a file that is not in the
+     * table.
+     */
+    static DiagTable Parse(std::istream& input);
+
+    /**
+     * @brief Read and parse a diag_table file.
+     * @param filename Name of the file.
+     * @return The table.
+     * @throws std::runtime_error if the file cannot be opened.
+     * @throws std::invalid_argument if the file cannot be parsed, see Parse.
+     */
+    static DiagTable FromFile(const std::string& filename);
+};
+
+/**
+ * @brief Parse a diag_table time unit.
+ * @param unit "seconds", "minutes", "hours", "days", "months" or "years", singular or plural, case insensitive.
+ * @return The unit.
+ * @throws std::invalid_argument if the unit is unknown.
+ */
+DiagnosticTimeUnit ParseDiagnosticTimeUnit(const std::string& unit);
+
+/**
+ * @brief Advance a model time by a number of intervals, using a 365 day (noleap) calendar.
+ *
+ * Months and years are calendar months and years, so the result depends on the date: one month after the 31st of
+ * January is the 28th of February. Advancing by n intervals at once instead of one interval n times keeps the day of
+ * the month and avoids accumulating rounding errors.
+ *
+ * @param base_date Date of model time 0.
+ * @param time Model time in seconds to advance from.
+ * @param interval Interval to advance by.
+ * @param n_interval Number of intervals to advance by.
+ * @return The advanced model time in seconds.
+ * @throws std::invalid_argument if the base date is invalid, or a month or year interval is not whole.
+ */
+double AdvanceDiagnosticTime(const DiagnosticDate& base_date, const double time, const DiagnosticInterval& interval,
+                             const int n_interval = 1);
+
+/**
+ * @brief Expand the date tokens of a diag_table file name, using a 365 day (noleap) calendar.
+ *
+ * A token is % followed by a field width and one of yr, mo, dy, hr, mi or sc, e.g. "prog_%4yr_%3dy" becomes
+ * "prog_0001_006" on the 6th of January of year 1. The values are zero padded to the width.
+ *
+ * @param name_template File name with date tokens.
+ * @param base_date Date of model time 0.
+ * @param time Model time in seconds of the date to expand.
+ * @return The file name.
+ * @throws std::invalid_argument if a token is malformed or the base date is invalid.
+ */
+std::string ExpandDiagnosticFilename(const std::string& name_template, const DiagnosticDate& base_date,
+                                     const double time);
+
+}  // namespace turbo
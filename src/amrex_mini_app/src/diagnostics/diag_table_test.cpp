@@ -0,0 +1,159 @@
+#include "diag_table.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace turbo;
+
+namespace
+{
+
+/**
+ * @brief Parse a diag_table from a string.
+ */
+DiagTable ParseString(const std::string& text)
+{
+    std::istringstream input(text);
+    return DiagTable::Parse(input);
+}
+
+constexpr double kSecondsPerDay = 86400.0;
+
+}  // namespace
+
+//---------------------------------------------------------------------------//
+// DiagTable tests
+//---------------------------------------------------------------------------//
+
+TEST(DiagTableTest, Parse)
+{
+    const DiagTable table = ParseString(R"(
+"MOM Experiment"
+1 2 3 4 5 6
+# Comment before the files
+"prog_%4yr_%3dy",     5,"days",1,"days","Time",365,"days"
+  "h.z%4yr-%2mo",     12, "hours", 1, "days", "time", 1, "months"
+"static",           -1, "days", 1, "days", "time",
+
+#"ocean_model","temp","temp","prog_%4yr_%3dy","all",.false.,"none",2
+"ocean_model","u","u_out","prog_%4yr_%3dy","all",.false.,"none",2
+"ocean_model_z", "thetao",   "thetao",   "h.z%4yr-%2mo", "all", "mean", "none", 1
+"ocean_model","h","h","static","all",.TRUE.,"none",1
+"ocean_model","e","e_min","prog_%4yr_%3dy","all",min,"none",1
+"ocean_model","e","e_max","prog_%4yr_%3dy","all","max","none",1
+)");
+
+    EXPECT_EQ(table.title, "MOM Experiment");
+    EXPECT_EQ(table.base_date, (DiagnosticDate{1, 2, 3, 4, 5, 6}));
+
+    ASSERT_EQ(table.files.size(), 3);
+    EXPECT_EQ(table.files[0].name, "prog_%4yr_%3dy");
+    EXPECT_EQ(table.files[0].output_interval.value, 5.0);
+    EXPECT_EQ(table.files[0].output_interval.unit, DiagnosticTimeUnit::Days);
+    EXPECT_EQ(table.files[0].new_file_interval.value, 365.0);
+    EXPECT_EQ(table.files[0].new_file_interval.unit, DiagnosticTimeUnit::Days);
+    EXPECT_EQ(table.files[1].name, "h.z%4yr-%2mo");
+    EXPECT_EQ(table.files[1].output_interval.unit, DiagnosticTimeUnit::Hours);
+    EXPECT_EQ(table.files[1].new_file_interval.unit, DiagnosticTimeUnit::Months);
+    EXPECT_EQ(table.files[2].output_interval.value, -1.0);
+    EXPECT_EQ(table.files[2].new_file_interval.value, 0.0);
+
+    ASSERT_EQ(table.fields.size(), 5);
+    EXPECT_EQ(table.fields[0].module_name, "ocean_model");
+    EXPECT_EQ(table.fields[0].field_name, "u");
+    EXPECT_EQ(table.fields[0].output_name, "u_out");
+    EXPECT_EQ(table.fields[0].file_name, "prog_%4yr_%3dy");
+    EXPECT_EQ(table.fields[0].reduction, DiagnosticReduction::Last);
+    EXPECT_EQ(table.fields[1].file_name, "h.z%4yr-%2mo");
+    EXPECT_EQ(table.fields[1].reduction, DiagnosticReduction::Mean);
+    EXPECT_EQ(table.fields[2].reduction, DiagnosticReduction::Mean);
+    EXPECT_EQ(table.fields[3].reduction, DiagnosticReduction::Min);
+    EXPECT_EQ(table.fields[4].reduction, DiagnosticReduction::Max);
+}
+
+TEST(DiagTableTest, ParseErrors)
+{
+    const std::string header = "\"title\"\n1 1 1 0 0 0\n";
+    EXPECT_THROW(ParseString(""), std::invalid_argument);
+    EXPECT_THROW(ParseString("\"title\"\n1 1 1 0 0\n"), std::invalid_argument);
+    EXPECT_THROW(ParseString("\"title\"\n1 2 30 0 0 0\n"), std::invalid_argument);
+    EXPECT_THROW(ParseString(header + "\"prog\", 5, \"days\", 1, \"days\"\n"), std::invalid_argument);
+    EXPECT_THROW(ParseString(header + "\"prog\", 5, \"fortnights\", 1, \"days\", \"time\"\n"), std::invalid_argument);
+    EXPECT_THROW(ParseString(header + "\"prog\", 5x, \"days\", 1, \"days\", \"time\"\n"), std::invalid_argument);
+    EXPECT_THROW(ParseString(header + "\"prog\", 5, \"days\", 1, \"days\", \"time\n"), std::invalid_argument);
+    EXPECT_THROW(ParseString(header + "\"prog\", 5, \"days\", 1, \"days\", \"time\"\n"
+                                      "\"prog\", 1, \"days\", 1, \"days\", \"time\"\n"),
+                 std::invalid_argument);
+
+    const std::string file = "\"prog\", 5, \"days\", 1, \"days\", \"time\"\n";
+    EXPECT_NO_THROW(ParseString(header + file + "\"m\", \"u\", \"u\", \"prog\", \"all\", .true., \"none\", 2\n"));
+    EXPECT_THROW(ParseString(header + file + "\"m\", \"u\", \"u\", \"prog\", \"all\", .true., \"none\"\n"),
+                 std::invalid_argument);
+    EXPECT_THROW(ParseString(header + file + "\"m\", \"u\", \"u\", \"prog\", \"all\", .maybe., \"none\", 2\n"),
+                 std::invalid_argument);
+    EXPECT_THROW(ParseString(header + file + "\"m\", \"u\", \"u\", \"other\", \"all\", .true., \"none\", 2\n"),
+                 std::invalid_argument);
+
+    EXPECT_THROW(DiagTable::FromFile("Test_Input_DiagTable_Missing"), std::runtime_error);
+}
+
+TEST(DiagTableTest, ParseDiagnosticTimeUnit)
+{
+    EXPECT_EQ(ParseDiagnosticTimeUnit("seconds"), DiagnosticTimeUnit::Seconds);
+    EXPECT_EQ(ParseDiagnosticTimeUnit("Minute"), DiagnosticTimeUnit::Minutes);
+    EXPECT_EQ(ParseDiagnosticTimeUnit("HOURS"), DiagnosticTimeUnit::Hours);
+    EXPECT_EQ(ParseDiagnosticTimeUnit(" days "), DiagnosticTimeUnit::Days);
+    EXPECT_EQ(ParseDiagnosticTimeUnit("month"), DiagnosticTimeUnit::Months);
+    EXPECT_EQ(ParseDiagnosticTimeUnit("years"), DiagnosticTimeUnit::Years);
+    EXPECT_THROW(ParseDiagnosticTimeUnit("weeks"), std::invalid_argument);
+    EXPECT_THROW(ParseDiagnosticTimeUnit(""), std::invalid_argument);
+}
+
+TEST(DiagTableTest, AdvanceDiagnosticTime)
+{
+    const DiagnosticDate base_date = kDefaultBaseDate;
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 10.0, {30.0, DiagnosticTimeUnit::Seconds}), 40.0);
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 0.0, {2.0, DiagnosticTimeUnit::Minutes}, 3), 360.0);
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 0.0, {6.0, DiagnosticTimeUnit::Hours}), 21600.0);
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 0.0, {5.0, DiagnosticTimeUnit::Days}, 2), 10 * kSecondsPerDay);
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 0.0, {1.0, DiagnosticTimeUnit::Days}, 0), 0.0);
+
+    // Calendar months of a 365 day year
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 0.0, {1.0, DiagnosticTimeUnit::Months}), 31 * kSecondsPerDay);
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 0.0, {1.0, DiagnosticTimeUnit::Months}, 2),
+                     59 * kSecondsPerDay);
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 0.0, {1.0, DiagnosticTimeUnit::Years}, 3),
+                     3 * 365 * kSecondsPerDay);
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(base_date, 100.0, {12.0, DiagnosticTimeUnit::Months}),
+                     365 * kSecondsPerDay + 100.0);
+
+    // The day is clamped to the end of shorter months
+    const DiagnosticDate end_of_january = {1, 1, 31, 0, 0, 0};
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(end_of_january, 0.0, {1.0, DiagnosticTimeUnit::Months}),
+                     28 * kSecondsPerDay);
+    EXPECT_DOUBLE_EQ(AdvanceDiagnosticTime(end_of_january, 0.0, {1.0, DiagnosticTimeUnit::Months}, 2),
+                     59 * kSecondsPerDay);
+
+    EXPECT_THROW(AdvanceDiagnosticTime(base_date, 0.0, {0.5, DiagnosticTimeUnit::Months}), std::invalid_argument);
+    EXPECT_THROW(AdvanceDiagnosticTime({1, 13, 1, 0, 0, 0}, 0.0, {1.0, DiagnosticTimeUnit::Days}),
+                 std::invalid_argument);
+}
+
+TEST(DiagTableTest, ExpandDiagnosticFilename)
+{
+    const DiagnosticDate base_date = kDefaultBaseDate;
+    EXPECT_EQ(ExpandDiagnosticFilename("prog_%4yr_%3dy", base_date, 5 * kSecondsPerDay), "prog_0001_006");
+    EXPECT_EQ(ExpandDiagnosticFilename("h.z%4yr-%2mo", base_date, 59 * kSecondsPerDay), "h.z0001-03");
+    EXPECT_EQ(ExpandDiagnosticFilename("static", base_date, 1000.0), "static");
+    EXPECT_EQ(ExpandDiagnosticFilename("%2hr%2mi%2sc", base_date, 3723.5), "010203");
+    EXPECT_EQ(ExpandDiagnosticFilename("%1yr", base_date, 365 * kSecondsPerDay * 11), "12");
+    EXPECT_EQ(ExpandDiagnosticFilename("%4yr-%2mo-%2dy", {2000, 12, 31, 23, 0, 0}, 3600.0), "2001-01-01");
+
+    EXPECT_THROW(ExpandDiagnosticFilename("prog_%yr", base_date, 0.0), std::invalid_argument);
+    EXPECT_THROW(ExpandDiagnosticFilename("prog_%4wk", base_date, 0.0), std::invalid_argument);
+    EXPECT_THROW(ExpandDiagnosticFilename("prog_%4", base_date, 0.0), std::invalid_argument);
+    EXPECT_THROW(ExpandDiagnosticFilename("prog", {1, 1, 0, 0, 0, 0}, 0.0), std::invalid_argument);
+}
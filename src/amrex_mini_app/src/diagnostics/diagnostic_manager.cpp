@@ -0,0 +1,449 @@
+#include "diagnostic_manager.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "diag_table.h"
+#include "domain.h"
+#include "field.h"
+#include "grid.h"
+#include "hdf5_time_series.h"
+
+namespace turbo
+{
+
+namespace
+{
+
+/**
+ * @brief Maximum number of accumulators updated by one kernel. Sources with more accumulators take several passes.
+ */
+constexpr int kMaxFusedAccumulators = 4;
+
+/**
+ * @brief Relative tolerance of the comparison of model times with interval boundaries.
+ */
+constexpr double kTimeTolerance = 1.0e-9;
+
+/**
+ * @brief How a sample is folded into an accumulator.
+ */
+enum class AccumulateOp
+{
+    Assign, /**< First sample of the interval. */
+    Add,    /**< Sum, divided by the time covered by the samples when written. */
+    Min,    /**< Running minimum. */
+    Max     /**< Running maximum. */
+};
+
+/**
+ * @brief An accumulator and how to fold the next sample into it.
+ */
+struct Accumulation
+{
+    amrex::MultiFab* accumulator;
+    AccumulateOp op;
+    amrex::Real weight; /**< Factor of the sample for Assign and Add, 1 for the reductions that are not means. */
+};
+
+/**
+ * @brief Absolute tolerance of a comparison with a model time.
+ */
+double TimeTolerance(const double time) { return kTimeTolerance * std::max(1.0, std::abs(time)); }
+
+/**
+ * @brief Fold the valid points of a source into up to kMaxFusedAccumulators accumulators on its layout, reading the
+ * source once.
+ */
+void Accumulate(const amrex::MultiFab& source, const Accumulation* accumulations, const int n_accumulation)
+{
+    const int n_component = source.nComp();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(source, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box& box                         = mfi.tilebox();
+        const amrex::Array4<const amrex::Real> values = source.const_array(mfi);
+        std::array<amrex::Array4<amrex::Real>, kMaxFusedAccumulators> accumulators;
+        std::array<AccumulateOp, kMaxFusedAccumulators> ops;
+        std::array<amrex::Real, kMaxFusedAccumulators> weights;
+        for (int member = 0; member < n_accumulation; ++member)
+        {
+            accumulators[member] = accumulations[member].accumulator->array(mfi);
+            ops[member]          = accumulations[member].op;
+            weights[member]      = accumulations[member].weight;
+        }
+
+        amrex::ParallelFor(box, n_component,
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                           {
+                               const amrex::Real value = values(i, j, k, n);
+                               for (int member = 0; member < n_accumulation; ++member)
+                               {
+                                   amrex::Real& result = accumulators[member](i, j, k, n);
+                                   switch (ops[member])
+                                   {
+                                       case AccumulateOp::Assign:
+                                           result = weights[member] * value;
+                                           break;
+                                       case AccumulateOp::Add:
+                                           result += weights[member] * value;
+                                           break;
+                                       case AccumulateOp::Min:
+                                           result = value < result ? value : result;
+                                           break;
+                                       case AccumulateOp::Max:
+                                           result = value > result ? value : result;
+                                           break;
+                                   }
+                               }
+                           });
+    }
+}
+
+}  // namespace
+
+DiagnosticManager::DiagnosticManager(const std::shared_ptr<Grid>& grid, const HDF5WriteMode mode,
+                                     const double start_time, const DiagnosticDate& base_date)
+    : grid_(grid), mode_(mode), start_time_(start_time), base_date_(base_date), time_(start_time)
+{
+    if (!grid_)
+    {
+        throw std::invalid_argument("DiagnosticManager::DiagnosticManager: Invalid grid pointer.");
+    }
+    if (mode_ != HDF5WriteMode::Gather && mode_ != HDF5WriteMode::Collective)
+    {
+        throw std::invalid_argument(
+            "DiagnosticManager::DiagnosticManager: Diagnostics support the Gather and Collective HDF5WriteModes only.");
+    }
+    // Checks the base date
+    ExpandDiagnosticFilename("", base_date_, start_time_);
+}
+
+void DiagnosticManager::AddStream(const DiagnosticFileEntry& file)
+{
+    if (n_update_ > 0)
+    {
+        throw std::logic_error("DiagnosticManager::AddStream: Streams must be added before the first Update.");
+    }
+    if (file.name.empty())
+    {
+        throw std::invalid_argument("DiagnosticManager::AddStream: The stream name is empty.");
+    }
+    if (streams_.contains(file.name))
+    {
+        throw std::invalid_argument("DiagnosticManager::AddStream: Stream '" + file.name + "' already exists.");
+    }
+    if (file.new_file_interval.value < 0.0)
+    {
+        throw std::invalid_argument("DiagnosticManager::AddStream: The new file interval of stream '" + file.name +
+                                    "' is negative.");
+    }
+    // Checks that month and year intervals are whole and that the name template expands
+    AdvanceDiagnosticTime(base_date_, start_time_, file.output_interval);
+    AdvanceDiagnosticTime(base_date_, start_time_, file.new_file_interval);
+    ExpandDiagnosticFilename(file.name, base_date_, start_time_);
+
+    streams_[file.name].file = file;
+}
+
+void DiagnosticManager::AddOutput(const std::string& stream_name, const std::shared_ptr<Field>& field,
+                                  const Field::NameType& output_name, const DiagnosticReduction reduction)
+{
+    if (n_update_ > 0)
+    {
+        throw std::logic_error("DiagnosticManager::AddOutput: Outputs must be added before the first Update.");
+    }
+    const auto stream = streams_.find(stream_name);
+    if (stream == streams_.end())
+    {
+        throw std::invalid_argument("DiagnosticManager::AddOutput: Stream '" + stream_name + "' does not exist.");
+    }
+    if (!field)
+    {
+        throw std::invalid_argument("DiagnosticManager::AddOutput: Invalid field pointer.");
+    }
+    if (field->grid != grid_)
+    {
+        throw std::invalid_argument("DiagnosticManager::AddOutput: Field '" + field->name +
+                                    "' is not on the grid of the diagnostic manager.");
+    }
+    std::vector<Output>& outputs = stream->second.outputs;
+    if (std::ranges::any_of(outputs, [&output_name](const Output& output)
+                            { return output.accumulator->name == output_name; }))
+    {
+        throw std::invalid_argument("DiagnosticManager::AddOutput: Stream '" + stream_name +
+                                    "' already has an output named '" + output_name + "'.");
+    }
+
+    const amrex::MultiFab& source = *field->multifab;
+    const std::size_t n_ghost     = 0;
+    const auto n_component        = static_cast<std::size_t>(source.nComp());
+
+    auto accumulator = std::make_shared<Field>(output_name, grid_, field->field_grid_stagger, n_component, n_ghost,
+                                               source.boxArray(), source.DistributionMap(), field->fold_parity);
+    accumulator->hdf5_options = field->hdf5_options;
+    outputs.push_back({field, accumulator, reduction});
+}
+
+std::vector<Field::NameType> DiagnosticManager::AddDiagTable(const Domain& domain, const DiagTable& table)
+{
+    if (domain.GetGrid() != grid_)
+    {
+        throw std::invalid_argument(
+            "DiagnosticManager::AddDiagTable: The domain is not on the grid of the diagnostic manager.");
+    }
+    if (table.base_date != base_date_)
+    {
+        throw std::invalid_argument(
+            "DiagnosticManager::AddDiagTable: The base date of the table differs from the base date of the manager.");
+    }
+
+    for (const DiagnosticFileEntry& file : table.files)
+    {
+        AddStream(file);
+    }
+    std::vector<Field::NameType> skipped;
+    for (const DiagnosticFieldEntry& entry : table.fields)
+    {
+        if (!domain.HasField(entry.field_name))
+        {
+            skipped.push_back(entry.field_name);
+            continue;
+        }
+        AddOutput(entry.file_name, domain.GetField(entry.field_name), entry.output_name, entry.reduction);
+    }
+    return skipped;
+}
+
+void DiagnosticManager::Update(const double time)
+{
+    if (finalized_)
+    {
+        throw std::logic_error("DiagnosticManager::Update: The diagnostic manager is finalized.");
+    }
+    if (time <= time_)
+    {
+        throw std::invalid_argument("DiagnosticManager::Update: Time " + std::to_string(time) +
+                                    " is not later than the previous time " + std::to_string(time_) + ".");
+    }
+    // The values at this time stand for the time step that ends here
+    const double time_step = time - time_;
+    time_                  = time;
+    ++n_update_;
+
+    Sample(time_step);
+    for (auto& [stream_name, stream] : streams_)
+    {
+        if (!IsOutputTime(stream, time))
+        {
+            continue;
+        }
+        // A long time step can cross several boundaries, the skipped intervals are not written and the record is
+        // stamped with the end of the last interval crossed
+        const DiagnosticInterval& interval = stream.file.output_interval;
+        do
+        {
+            ++stream.n_output_interval;
+        } while (interval.value > 0.0 && IsOutputTime(stream, time));
+        const double end_time =
+            interval.value > 0.0 ? AdvanceDiagnosticTime(base_date_, start_time_, interval, stream.n_output_interval)
+                                 : time;
+        Write(stream, end_time);
+    }
+}
+
+void DiagnosticManager::Finalize(const double time)
+{
+    if (finalized_)
+    {
+        throw std::logic_error("DiagnosticManager::Finalize: The diagnostic manager is already finalized.");
+    }
+    finalized_ = true;
+
+    for (auto& [stream_name, stream] : streams_)
+    {
+        if (stream.file.output_interval.value < 0.0 && stream.n_sample > 0)
+        {
+            Write(stream, time);
+        }
+        if (stream.time_series)
+        {
+            stream.time_series->Close();
+            stream.time_series.reset();
+        }
+    }
+}
+
+std::vector<std::string> DiagnosticManager::GetStreamNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(streams_.size());
+    for (const auto& [stream_name, stream] : streams_)
+    {
+        names.push_back(stream_name);
+    }
+    return names;
+}
+
+const std::string& DiagnosticManager::GetFilename(const std::string& stream_name) const
+{
+    return GetStream(stream_name, "DiagnosticManager::GetFilename").filename;
+}
+
+std::size_t DiagnosticManager::GetNSample(const std::string& stream_name) const
+{
+    return GetStream(stream_name, "DiagnosticManager::GetNSample").n_sample;
+}
+
+void DiagnosticManager::Sample(const double time_step)
+{
+    // Group the accumulators by source, so each source is read once for all the streams that reduce it
+    std::map<const Field*, std::vector<Accumulation>> accumulations;
+    for (auto& [stream_name, stream] : streams_)
+    {
+        const bool first_sample = stream.n_sample == 0;
+        for (Output& output : stream.outputs)
+        {
+            AccumulateOp op    = AccumulateOp::Assign;
+            amrex::Real weight = 1.0;
+            switch (output.reduction)
+            {
+                case DiagnosticReduction::Last:
+                    // Copied from the source when written
+                    continue;
+                case DiagnosticReduction::Mean:
+                    op     = AccumulateOp::Add;
+                    weight = time_step;
+                    break;
+                case DiagnosticReduction::Min:
+                    op = AccumulateOp::Min;
+                    break;
+                case DiagnosticReduction::Max:
+                    op = AccumulateOp::Max;
+                    break;
+            }
+            accumulations[output.source.get()].push_back(
+                {output.accumulator->multifab.get(), first_sample ? AccumulateOp::Assign : op, weight});
+        }
+        ++stream.n_sample;
+        stream.sampled_time += time_step;
+    }
+
+    for (const auto& [source, source_accumulations] : accumulations)
+    {
+        for (std::size_t first = 0; first < source_accumulations.size(); first += kMaxFusedAccumulators)
+        {
+            const int n_accumulation =
+                static_cast<int>(std::min<std::size_t>(kMaxFusedAccumulators, source_accumulations.size() - first));
+            Accumulate(*source->multifab, source_accumulations.data() + first, n_accumulation);
+        }
+    }
+}
+
+bool DiagnosticManager::IsOutputTime(const Stream& stream, const double time) const
+{
+    const DiagnosticInterval& interval = stream.file.output_interval;
+    if (interval.value < 0.0)
+    {
+        return false;
+    }
+    if (interval.value == 0.0)
+    {
+        return true;
+    }
+    const double end_time = AdvanceDiagnosticTime(base_date_, start_time_, interval, stream.n_output_interval + 1);
+    return time >= end_time - TimeTolerance(end_time);
+}
+
+void DiagnosticManager::Write(Stream& stream, const double time)
+{
+    if (stream.outputs.empty())
+    {
+        stream.n_sample     = 0;
+        stream.sampled_time = 0.0;
+        return;
+    }
+
+    // Finish the reductions
+    for (Output& output : stream.outputs)
+    {
+        amrex::MultiFab& accumulator = *output.accumulator->multifab;
+        const int n_component        = accumulator.nComp();
+        const int n_ghost            = 0;
+        if (output.reduction == DiagnosticReduction::Mean)
+        {
+            accumulator.mult(1.0 / stream.sampled_time, 0, n_component, n_ghost);
+        }
+        else if (output.reduction == DiagnosticReduction::Last)
+        {
+            amrex::MultiFab::Copy(accumulator, *output.source->multifab, 0, 0, n_component, n_ghost);
+        }
+    }
+
+    // An output at the end of a file interval belongs to that interval, the new file starts with the next output
+    const DiagnosticInterval& new_file_interval = stream.file.new_file_interval;
+    int n_file_interval                         = 0;
+    if (new_file_interval.value > 0.0)
+    {
+        n_file_interval = std::max(stream.n_file_interval, 0);
+        while (true)
+        {
+            const double end_time =
+                AdvanceDiagnosticTime(base_date_, start_time_, new_file_interval, n_file_interval + 1);
+            if (time <= end_time + TimeTolerance(end_time))
+            {
+                break;
+            }
+            ++n_file_interval;
+        }
+    }
+    if (!stream.time_series || n_file_interval != stream.n_file_interval)
+    {
+        if (stream.time_series)
+        {
+            stream.time_series->Close();
+            stream.time_series.reset();
+        }
+        const double file_start_time =
+            AdvanceDiagnosticTime(base_date_, start_time_, new_file_interval, n_file_interval);
+        stream.filename = ExpandDiagnosticFilename(stream.file.name, base_date_, file_start_time) + ".h5";
+        std::vector<std::shared_ptr<Field>> accumulators;
+        accumulators.reserve(stream.outputs.size());
+        for (const Output& output : stream.outputs)
+        {
+            accumulators.push_back(output.accumulator);
+        }
+        stream.time_series     = std::make_unique<HDF5TimeSeries>(stream.filename, grid_, accumulators, mode_);
+        stream.n_file_interval = n_file_interval;
+    }
+
+    stream.time_series->Append(time);
+    stream.n_sample     = 0;
+    stream.sampled_time = 0.0;
+}
+
+const DiagnosticManager::Stream& DiagnosticManager::GetStream(const std::string& stream_name,
+                                                              const std::string& function_name) const
+{
+    const auto stream = streams_.find(stream_name);
+    if (stream == streams_.end())
+    {
+        throw std::invalid_argument(function_name + ": Stream '" + stream_name + "' does not exist.");
+    }
+    return stream->second;
+}
+
+}  // namespace turbo
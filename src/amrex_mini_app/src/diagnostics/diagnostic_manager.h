@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "diag_table.h"
+#include "domain.h"
+#include "field.h"
+#include "grid.h"
+#include "hdf5_time_series.h"
+
+namespace turbo
+{
+
+/**
+ * @class DiagnosticManager
+ * @brief Writes reductions over time of fields to output streams at fixed intervals, e.g. as requested by a
+ * diag_table.
+ *
+ * Each output of a stream owns an accumulator field on the layout of its source field. Every Update folds the
+ * current value of the sources into the accumulators in place, with one fused kernel per source field and box for all
+ * the means, minima and maxima of that field, so no snapshot is kept and nothing is written between the output
+ * times. The means weight each sample by its time step, the time since the previous Update, so they are time means
+ * also with a variable time step. At the end of each output interval of a stream the means are divided by the time
+ * the samples cover, the last values are copied from the sources and the accumulators are appended to the stream's
+ * HDF5TimeSeries, stamped with the time at the end of the interval, not the time of the Update that crossed it. The
+ * accumulation then restarts. A time step that crosses the end of an interval is a sample of that interval.
+ *
+ * A stream writes into one file, or into a new file every new file interval, named by expanding the date tokens of
+ * the stream name at the start of the file interval (see ExpandDiagnosticFilename) and appending ".h5". Streams with
+ * an output interval of 0 write at every Update, and streams with a negative output interval write once, in
+ * Finalize, the reduction over the whole run.
+ */
+class DiagnosticManager
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct a diagnostic manager without streams.
+     * @param grid Grid of the fields to write, written into every file.
+     * @param mode How the distributed field data gets into the files, HDF5WriteMode::Gather or
+     * HDF5WriteMode::Collective.
+     * @param start_time Model time in seconds at the start of the run, where the first output interval starts.
+     * @param base_date Date of model time 0, used for calendar intervals and file names.
+     * @throws std::invalid_argument if the grid is null, the mode is not supported by HDF5TimeSeries, or the base date
+     * is invalid.
+     */
+    DiagnosticManager(const std::shared_ptr<Grid>& grid, const HDF5WriteMode mode = HDF5WriteMode::Gather,
+                      const double start_time = 0.0, const DiagnosticDate& base_date = kDefaultBaseDate);
+
+    /**
+     * @brief Add an output stream without outputs.
+     * @param file Name template and intervals of the stream.
+     * @throws std::invalid_argument if a stream with the same name exists, or an interval is invalid.
+     * @throws std::logic_error if Update was already called.
+     */
+    void AddStream(const DiagnosticFileEntry& file);
+
+    /**
+     * @brief Add an output of a field to a stream, allocating its accumulator.
+     * @param stream_name Name of the stream, as given to AddStream.
+     * @param field Field to sample at each Update. Must be defined on the grid of the manager.
+     * @param output_name Name of the dataset in the files of the stream.
+     * @param reduction Reduction of the samples over each output interval.
+     * @throws std::invalid_argument if the stream does not exist, the field is null or on another grid, or the stream
+     * already has an output with the same name.
+     * @throws std::logic_error if Update was already called.
+     */
+    void AddOutput(const std::string& stream_name, const std::shared_ptr<Field>& field,
+                   const Field::NameType& output_name, const DiagnosticReduction reduction);
+
+    /**
+     * @brief Add the streams and outputs of a diag_table, sampling the fields of a domain.
+     *
+     * Field entries naming a field the domain does not have are skipped, since a table usually lists more fields than
+     * a model configuration computes.
+     *
+     * @param domain Domain whose fields are sampled. Must be on the grid of the manager.
+     * @param table Parsed diag_table, with the base date of the manager.
+     * @return Names of the fields of the skipped entries, in the order of the table.
+     * @throws std::invalid_argument if the domain is on another grid, the base dates differ, or an entry is invalid,
+     * see AddStream and AddOutput.
+     * @throws std::logic_error if Update was already called.
+     */
+    std::vector<Field::NameType> AddDiagTable(const Domain& domain, const DiagTable& table);
+
+    /**
+     * @brief Sample all outputs and write the streams whose output interval ends at this time. Must be called by all
+     * ranks, after each time step.
+     * @param time Model time in seconds of the current values of the fields, later than the previous Update.
+     * @throws std::invalid_argument if the time is not later than the previous Update or the start time.
+     * @throws std::logic_error if Finalize was already called.
+     * @throws std::runtime_error if a file cannot be created or written.
+     */
+    void Update(const double time);
+
+    /**
+     * @brief Write the streams with a negative output interval and close all files. Samples of incomplete output
+     * intervals of the other streams are dropped. Must be called by all ranks, once.
+     * @param time Model time in seconds at the end of the run, the time stamp of the end of run output.
+     * @throws std::logic_error if Finalize was already called.
+     * @throws std::runtime_error if a file cannot be created or written.
+     */
+    void Finalize(const double time);
+
+    /**
+     * @brief Get the names of the streams.
+     * @return Names of the streams, in alphabetical order.
+     */
+    std::vector<std::string> GetStreamNames() const;
+
+    /**
+     * @brief Get the name of the file a stream currently writes into.
+     * @param stream_name Name of the stream.
+     * @return Name of the file, empty if the stream has not written yet.
+     * @throws std::invalid_argument if the stream does not exist.
+     */
+    const std::string& GetFilename(const std::string& stream_name) const;
+
+    /**
+     * @brief Get the number of samples accumulated in the current output interval of a stream.
+     * @param stream_name Name of the stream.
+     * @return Number of Update calls since the last write of the stream.
+     * @throws std::invalid_argument if the stream does not exist.
+     */
+    std::size_t GetNSample(const std::string& stream_name) const;
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Types
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief A field written by a stream, with the accumulator of its reduction.
+     */
+    struct Output
+    {
+        std::shared_ptr<Field> source;      /**< Field sampled at each Update. */
+        std::shared_ptr<Field> accumulator; /**< Reduction of the samples, on the layout of source, without ghosts. */
+        DiagnosticReduction reduction;      /**< Reduction of the samples. */
+    };
+
+    /**
+     * @brief An output stream and the state of its current output and file intervals.
+     */
+    struct Stream
+    {
+        DiagnosticFileEntry file;                    /**< Name template and intervals. */
+        std::vector<Output> outputs;                 /**< Fields written by the stream. */
+        std::size_t n_sample  = 0;                   /**< Samples in the current output interval. */
+        double sampled_time   = 0.0;                 /**< Sum of the time steps of the samples, in seconds. */
+        int n_output_interval = 0;                   /**< Output intervals since the start time. */
+        int n_file_interval   = -1;                  /**< File interval of the open file, -1 if none is open. */
+        std::string filename;                        /**< Name of the open or last file. */
+        std::unique_ptr<HDF5TimeSeries> time_series; /**< Open file, null until the first write. */
+    };
+
+    //-----------------------------------------------------------------------//
+    // Private Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Fold the current values of the sources into the accumulators of all streams.
+     * @param time_step Time in seconds since the previous Update, the weight of the sample in the means.
+     */
+    void Sample(const double time_step);
+
+    /**
+     * @brief Check if an output interval of a stream ends at a time.
+     */
+    bool IsOutputTime(const Stream& stream, const double time) const;
+
+    /**
+     * @brief Finish the reductions of a stream, append them to its file, opening a new file if needed, and restart
+     * the accumulation.
+     * @param time Time stamp of the record, the end of the output interval or the end of the run.
+     */
+    void Write(Stream& stream, const double time);
+
+    /**
+     * @brief Get a stream by name.
+     * @throws std::invalid_argument if the stream does not exist.
+     */
+    const Stream& GetStream(const std::string& stream_name, const std::string& function_name) const;
+
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Grid of the fields, written into every file.
+     */
+    const std::shared_ptr<Grid> grid_;
+
+    /**
+     * @brief How the distributed field data gets into the files.
+     */
+    const HDF5WriteMode mode_;
+
+    /**
+     * @brief Model time in seconds where the first output and file intervals start.
+     */
+    const double start_time_;
+
+    /**
+     * @brief Date of model time 0.
+     */
+    const DiagnosticDate base_date_;
+
+    /**
+     * @brief Streams by name.
+     */
+    std::map<std::string, Stream> streams_;
+
+    /**
+     * @brief Number of Update calls.
+     */
+    std::size_t n_update_ = 0;
+
+    /**
+     * @brief Model time of the last Update, or the start time.
+     */
+    double time_;
+
+    /**
+     * @brief Whether Finalize was called.
+     */
+    bool finalized_ = false;
+};
+
+}  // namespace turbo
@@ -0,0 +1,327 @@
+#include "diagnostic_manager.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <gtest/gtest.h>
+#include <hdf5.h>
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_domain.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "diag_table.h"
+#include "field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+namespace
+{
+
+constexpr double kSecondsPerDay = 86400.0;
+
+/**
+ * @brief Read a whole dataset of doubles and its dimensions from a file, on the IO processor.
+ */
+std::vector<double> ReadDataset(const std::string& filename, const std::string& dataset_name,
+                                std::vector<hsize_t>& dims)
+{
+    const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset_id = H5Dopen2(file_id, dataset_name.c_str(), H5P_DEFAULT);
+    const hid_t space_id   = H5Dget_space(dataset_id);
+    dims.resize(H5Sget_simple_extent_ndims(space_id));
+    H5Sget_simple_extent_dims(space_id, dims.data(), NULL);
+    std::vector<double> data(H5Sget_simple_extent_npoints(space_id));
+    if (!data.empty())
+    {
+        H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+    }
+    H5Sclose(space_id);
+    H5Dclose(dataset_id);
+    H5Fclose(file_id);
+    return data;
+}
+
+/**
+ * @brief Check that every point of each snapshot of a dataset has the expected value.
+ */
+void ExpectSnapshots(const std::string& filename, const std::string& dataset_name,
+                     const std::vector<double>& expected)
+{
+    std::vector<hsize_t> dims;
+    const std::vector<double> data = ReadDataset(filename, dataset_name, dims);
+    ASSERT_FALSE(dims.empty());
+    ASSERT_EQ(dims[0], expected.size());
+    const std::size_t n_point = data.size() / expected.size();
+    for (std::size_t snapshot = 0; snapshot < expected.size(); ++snapshot)
+    {
+        for (std::size_t index = 0; index < n_point; ++index)
+        {
+            ASSERT_DOUBLE_EQ(data[snapshot * n_point + index], expected[snapshot]) << dataset_name;
+        }
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------//
+// DiagnosticManager tests
+//---------------------------------------------------------------------------//
+
+class DiagnosticManagerTest : public ::testing::Test
+{
+   protected:
+    std::shared_ptr<CartesianGrid> grid;
+    std::shared_ptr<Field> scalar;
+    std::shared_ptr<Field> vector;
+
+    void SetUp() override
+    {
+        grid = std::make_shared<CartesianGrid>(std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 10,
+                                               6, 4);
+        const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(4, 4, 4)));
+        scalar = std::make_shared<Field>("scalar", grid, FieldGridStagger::CellCentered, 1, 1, FoldParity::Scalar,
+                                         box_decomposition);
+        vector = std::make_shared<Field>("vector", grid, FieldGridStagger::KFace, 2, 0, FoldParity::Scalar,
+                                         box_decomposition);
+    }
+
+    /**
+     * @brief Set the scalar to value and the vector to -value, ghost cells included.
+     */
+    void SetValues(const double value)
+    {
+        scalar->multifab->setVal(value);
+        vector->multifab->setVal(-value);
+    }
+};
+
+TEST_F(DiagnosticManagerTest, InvalidArguments)
+{
+    EXPECT_THROW(DiagnosticManager(nullptr), std::invalid_argument);
+    EXPECT_THROW(DiagnosticManager(grid, HDF5WriteMode::FilePerRank), std::invalid_argument);
+    EXPECT_THROW(DiagnosticManager(grid, HDF5WriteMode::Gather, 0.0, {1, 2, 29, 0, 0, 0}), std::invalid_argument);
+
+    DiagnosticManager manager(grid);
+    const std::string stream_name = "Test_Output_Diagnostics_Invalid";
+    manager.AddStream({stream_name, {1.0, DiagnosticTimeUnit::Days}, {}});
+    EXPECT_THROW(manager.AddStream({stream_name, {1.0, DiagnosticTimeUnit::Days}, {}}), std::invalid_argument);
+    EXPECT_THROW(manager.AddStream({"", {1.0, DiagnosticTimeUnit::Days}, {}}), std::invalid_argument);
+    EXPECT_THROW(manager.AddStream({"negative", {1.0, DiagnosticTimeUnit::Days}, {-1.0, DiagnosticTimeUnit::Days}}),
+                 std::invalid_argument);
+    EXPECT_THROW(manager.AddStream({"fraction", {0.5, DiagnosticTimeUnit::Months}, {}}), std::invalid_argument);
+    EXPECT_THROW(manager.AddStream({"token_%4wk", {1.0, DiagnosticTimeUnit::Days}, {}}), std::invalid_argument);
+
+    const auto other_grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 10, 6, 4);
+    const auto other_field = std::make_shared<Field>("other", other_grid, FieldGridStagger::CellCentered, 1, 0);
+    EXPECT_THROW(manager.AddOutput("missing", scalar, "scalar", DiagnosticReduction::Mean), std::invalid_argument);
+    EXPECT_THROW(manager.AddOutput(stream_name, nullptr, "scalar", DiagnosticReduction::Mean), std::invalid_argument);
+    EXPECT_THROW(manager.AddOutput(stream_name, other_field, "other", DiagnosticReduction::Mean),
+                 std::invalid_argument);
+    manager.AddOutput(stream_name, scalar, "scalar", DiagnosticReduction::Mean);
+    EXPECT_THROW(manager.AddOutput(stream_name, vector, "scalar", DiagnosticReduction::Max), std::invalid_argument);
+
+    EXPECT_THROW(manager.GetFilename("missing"), std::invalid_argument);
+    EXPECT_THROW(manager.GetNSample("missing"), std::invalid_argument);
+    EXPECT_TRUE(manager.GetFilename(stream_name).empty());
+
+    // Times must increase and the streams are fixed once sampling started
+    EXPECT_THROW(manager.Update(0.0), std::invalid_argument);
+    manager.Update(1.0);
+    EXPECT_THROW(manager.Update(1.0), std::invalid_argument);
+    EXPECT_THROW(manager.AddStream({"late", {1.0, DiagnosticTimeUnit::Days}, {}}), std::logic_error);
+    EXPECT_THROW(manager.AddOutput(stream_name, vector, "vector", DiagnosticReduction::Max), std::logic_error);
+
+    manager.Finalize(2.0);
+    EXPECT_THROW(manager.Update(3.0), std::logic_error);
+    EXPECT_THROW(manager.Finalize(3.0), std::logic_error);
+}
+
+TEST_F(DiagnosticManagerTest, Reductions)
+{
+    const std::string stream_name = "Test_Output_Diagnostics_Reductions";
+    vector->hdf5_options.data_layout = HDF5DataLayout::ColumnMajor;
+    {
+        DiagnosticManager manager(grid);
+        manager.AddStream({stream_name, {2.0, DiagnosticTimeUnit::Seconds}, {}});
+        manager.AddOutput(stream_name, scalar, "scalar_last", DiagnosticReduction::Last);
+        manager.AddOutput(stream_name, scalar, "scalar_mean", DiagnosticReduction::Mean);
+        manager.AddOutput(stream_name, scalar, "scalar_min", DiagnosticReduction::Min);
+        manager.AddOutput(stream_name, scalar, "scalar_max", DiagnosticReduction::Max);
+        // More accumulators of one source than fit in one kernel
+        manager.AddOutput(stream_name, scalar, "scalar_mean_2", DiagnosticReduction::Mean);
+        manager.AddOutput(stream_name, vector, "vector_mean", DiagnosticReduction::Mean);
+        manager.AddOutput(stream_name, vector, "vector_min", DiagnosticReduction::Min);
+
+        // Values equal to the time, sampled at 1, 2, 3 and 4 and written at 2 and 4
+        for (int step = 1; step <= 4; ++step)
+        {
+            SetValues(step);
+            manager.Update(step);
+            EXPECT_EQ(manager.GetNSample(stream_name), step % 2);
+        }
+        EXPECT_EQ(manager.GetFilename(stream_name), stream_name + ".h5");
+
+        // An incomplete interval is dropped
+        SetValues(5.0);
+        manager.Update(5.0);
+        manager.Finalize(5.0);
+    }
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        const std::string filename = stream_name + ".h5";
+        ExpectSnapshots(filename, "time", {2.0, 4.0});
+        ExpectSnapshots(filename, "scalar_last", {2.0, 4.0});
+        ExpectSnapshots(filename, "scalar_mean", {1.5, 3.5});
+        ExpectSnapshots(filename, "scalar_min", {1.0, 3.0});
+        ExpectSnapshots(filename, "scalar_max", {2.0, 4.0});
+        ExpectSnapshots(filename, "scalar_mean_2", {1.5, 3.5});
+        ExpectSnapshots(filename, "vector_mean", {-1.5, -3.5});
+        ExpectSnapshots(filename, "vector_min", {-2.0, -4.0});
+
+        // The accumulators are written without ghosts, in the layout of their source
+        std::vector<hsize_t> dims;
+        ReadDataset(filename, "scalar_mean", dims);
+        EXPECT_EQ(dims, (std::vector<hsize_t>{2, 10, 6, 4}));
+        ReadDataset(filename, "vector_mean", dims);
+        EXPECT_EQ(dims, (std::vector<hsize_t>{2, 2, 5, 6, 10}));
+    }
+}
+
+TEST_F(DiagnosticManagerTest, VariableTimeStep)
+{
+    const std::string stream_name = "Test_Output_Diagnostics_Variable_Step";
+    {
+        DiagnosticManager manager(grid);
+        manager.AddStream({stream_name, {2.0, DiagnosticTimeUnit::Seconds}, {}});
+        manager.AddOutput(stream_name, scalar, "scalar_mean", DiagnosticReduction::Mean);
+        manager.AddOutput(stream_name, scalar, "scalar_max", DiagnosticReduction::Max);
+
+        // Steps of 0.5 and 1.75 s, crossing the end of the first interval at 2 s, then 0.75 and 1.5 s, then one step
+        // of 4.5 s across the ends at 6 and 8 s
+        const std::vector<double> times  = {0.5, 2.25, 3.0, 4.5, 9.0};
+        const std::vector<double> values = {1.0, 3.0, 2.0, 4.0, 1.0};
+        for (std::size_t step = 0; step < times.size(); ++step)
+        {
+            SetValues(values[step]);
+            manager.Update(times[step]);
+        }
+        manager.Finalize(9.0);
+    }
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        const std::string filename = stream_name + ".h5";
+        // Stamped with the end of the interval, not the time of the Update that crossed it
+        ExpectSnapshots(filename, "time", {2.0, 4.0, 8.0});
+        // Each sample weighted by its time step
+        ExpectSnapshots(filename, "scalar_mean",
+                        {(0.5 * 1.0 + 1.75 * 3.0) / 2.25, (0.75 * 2.0 + 1.5 * 4.0) / 2.25, 1.0});
+        ExpectSnapshots(filename, "scalar_max", {3.0, 4.0, 1.0});
+    }
+}
+
+TEST_F(DiagnosticManagerTest, Streams)
+{
+    const std::string daily_name = "Test_Output_Diagnostics_Daily_%3dy";
+    const std::string every_name = "Test_Output_Diagnostics_Every";
+    const std::string run_name   = "Test_Output_Diagnostics_Run";
+    {
+        DiagnosticManager manager(grid);
+        manager.AddStream({daily_name, {1.0, DiagnosticTimeUnit::Days}, {2.0, DiagnosticTimeUnit::Days}});
+        manager.AddStream({every_name, {0.0, DiagnosticTimeUnit::Days}, {}});
+        manager.AddStream({run_name, {-1.0, DiagnosticTimeUnit::Days}, {}});
+        manager.AddOutput(daily_name, scalar, "scalar", DiagnosticReduction::Mean);
+        manager.AddOutput(every_name, scalar, "scalar", DiagnosticReduction::Last);
+        manager.AddOutput(run_name, scalar, "scalar", DiagnosticReduction::Mean);
+        manager.AddOutput(run_name, vector, "vector", DiagnosticReduction::Max);
+        EXPECT_EQ(manager.GetStreamNames(), (std::vector<std::string>{daily_name, every_name, run_name}));
+
+        // Two time steps per day
+        for (int step = 1; step <= 8; ++step)
+        {
+            const double time = step * 0.5 * kSecondsPerDay;
+            SetValues(step);
+            manager.Update(time);
+            if (step == 4)
+            {
+                EXPECT_EQ(manager.GetFilename(daily_name), "Test_Output_Diagnostics_Daily_001.h5");
+            }
+        }
+        // A new file every two days, named after the first day of the file
+        EXPECT_EQ(manager.GetFilename(daily_name), "Test_Output_Diagnostics_Daily_003.h5");
+        EXPECT_EQ(manager.GetNSample(run_name), 8);
+        manager.Finalize(4.0 * kSecondsPerDay);
+    }
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        ExpectSnapshots("Test_Output_Diagnostics_Daily_001.h5", "time", {kSecondsPerDay, 2.0 * kSecondsPerDay});
+        ExpectSnapshots("Test_Output_Diagnostics_Daily_001.h5", "scalar", {1.5, 3.5});
+        ExpectSnapshots("Test_Output_Diagnostics_Daily_003.h5", "time", {3.0 * kSecondsPerDay, 4.0 * kSecondsPerDay});
+        ExpectSnapshots("Test_Output_Diagnostics_Daily_003.h5", "scalar", {5.5, 7.5});
+        ExpectSnapshots(every_name + ".h5", "scalar", {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0});
+        ExpectSnapshots(run_name + ".h5", "time", {4.0 * kSecondsPerDay});
+        ExpectSnapshots(run_name + ".h5", "scalar", {4.5});
+        ExpectSnapshots(run_name + ".h5", "vector", {-1.0});
+    }
+}
+
+TEST(DiagnosticManagerDomainTest, AddDiagTable)
+{
+    CartesianDomain domain(0.0, 1.0, 0.0, 1.0, 0.0, 1.0, 4, 3, 2);
+    domain.CreateField("u", FieldGridStagger::IFace, 1, 1);
+    domain.CreateField("h", FieldGridStagger::CellCentered, 1, 1);
+
+    std::istringstream input(R"(
+"Test"
+1 1 1 0 0 0
+"Test_Output_Diagnostics_Table_prog", 1, "hours", 1, "days", "time"
+"Test_Output_Diagnostics_Table_ave",  2, "hours", 1, "days", "time"
+"ocean_model", "u", "u", "Test_Output_Diagnostics_Table_prog", "all", .false., "none", 2
+"ocean_model", "temp", "temp", "Test_Output_Diagnostics_Table_prog", "all", .false., "none", 2
+"ocean_model", "h", "h", "Test_Output_Diagnostics_Table_ave", "all", .true., "none", 2
+"ocean_model", "h", "h_max", "Test_Output_Diagnostics_Table_ave", "all", "max", "none", 2
+)");
+    const DiagTable table = DiagTable::Parse(input);
+
+    DiagnosticManager other_date(domain.GetGrid(), HDF5WriteMode::Gather, 0.0, {2000, 1, 1, 0, 0, 0});
+    EXPECT_THROW(other_date.AddDiagTable(domain, table), std::invalid_argument);
+    const auto other_grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 4, 3, 2);
+    DiagnosticManager other_grid_manager(other_grid);
+    EXPECT_THROW(other_grid_manager.AddDiagTable(domain, table), std::invalid_argument);
+
+    {
+        DiagnosticManager manager(domain.GetGrid());
+        EXPECT_EQ(manager.AddDiagTable(domain, table), (std::vector<Field::NameType>{"temp"}));
+        EXPECT_EQ(manager.GetStreamNames(), (std::vector<std::string>{"Test_Output_Diagnostics_Table_ave",
+                                                                      "Test_Output_Diagnostics_Table_prog"}));
+        for (int step = 1; step <= 4; ++step)
+        {
+            domain.GetField("u")->multifab->setVal(step);
+            domain.GetField("h")->multifab->setVal(10.0 * step);
+            manager.Update(step * 3600.0);
+        }
+        manager.Finalize(4 * 3600.0);
+    }
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        ExpectSnapshots("Test_Output_Diagnostics_Table_prog.h5", "u", {1.0, 2.0, 3.0, 4.0});
+        ExpectSnapshots("Test_Output_Diagnostics_Table_ave.h5", "h", {15.0, 35.0});
+        ExpectSnapshots("Test_Output_Diagnostics_Table_ave.h5", "h_max", {20.0, 40.0});
+    }
+}
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <memory>
 
+#include "box_decomposition.h"
 #include "cartesian_geometry.h"
 #include "cartesian_grid.h"
 #include "domain.h"
@@ -11,9 +12,12 @@ namespace turbo
 {
 
 CartesianDomain::CartesianDomain(double x_min, double x_max, double y_min, double y_max, double z_min, double z_max,
-                                 std::size_t n_cell_x, std::size_t n_cell_y, std::size_t n_cell_z)
-    : Domain(std::make_shared<CartesianGrid>(
-          std::make_shared<CartesianGeometry>(x_min, x_max, y_min, y_max, z_min, z_max), n_cell_x, n_cell_y, n_cell_z))
+                                 std::size_t n_cell_x, std::size_t n_cell_y, std::size_t n_cell_z,
+                                 const BoxDecomposition& box_decomposition)
+    : Domain(std::make_shared<CartesianGrid>(std::make_shared<CartesianGeometry>(x_min, x_max, y_min, y_max, z_min,
+                                                                                 z_max),
+                                             n_cell_x, n_cell_y, n_cell_z),
+             box_decomposition)
 {
 }
 
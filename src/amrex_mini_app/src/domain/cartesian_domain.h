@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <memory>
 
+#include "box_decomposition.h"
 #include "cartesian_geometry.h"
 #include "cartesian_grid.h"
 #include "domain.h"
@@ -28,9 +29,11 @@ class CartesianDomain : public Domain
      * @param n_cell_x Number of cells in X direction
      * @param n_cell_y Number of cells in Y direction
      * @param n_cell_z Number of cells in Z direction
+     * @param box_decomposition How the grid is split into boxes and distributed over the ranks for all fields
      */
     CartesianDomain(double x_min, double x_max, double y_min, double y_max, double z_min, double z_max,
-                    std::size_t n_cell_x, std::size_t n_cell_y, std::size_t n_cell_z);
+                    std::size_t n_cell_x, std::size_t n_cell_y, std::size_t n_cell_z,
+                    const BoxDecomposition& box_decomposition = BoxDecomposition());
 
     /**
      * @brief Get the geometry associated with the Cartesian domain.
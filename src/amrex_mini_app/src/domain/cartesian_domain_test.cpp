@@ -2,15 +2,21 @@
 
 #include <AMReX.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <gtest/gtest.h>
+#include <hdf5.h>
 
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "amrex_test_environment.h"
+#include "async_hdf5_writer.h"
 #include "cartesian_geometry.h"
 #include "cartesian_grid.h"
+#include "field_handle.h"
+#include "hdf5_time_series.h"
 
 using namespace turbo;
 
@@ -122,6 +128,40 @@ TEST_F(CartesianDomainTest, CreateAndGetField)
                  std::invalid_argument);
 }
 
+TEST_F(CartesianDomainTest, FieldHandles)
+{
+    const std::shared_ptr<Field> h = cartesian_domain->CreateField("h", FieldGridStagger::CellCentered, 1, 1);
+    const FieldHandle h_handle     = cartesian_domain->GetFieldHandle("h");
+    EXPECT_EQ(&cartesian_domain->GetFieldByHandle(h_handle), h.get());
+
+    // Handles stay valid while more fields are created, and the registry keeps the order of creation
+    const std::shared_ptr<Field> u = cartesian_domain->CreateField("u", FieldGridStagger::IFace, 1, 1);
+    const std::shared_ptr<Field> a = cartesian_domain->CreateField("a", FieldGridStagger::Nodal, 2, 0);
+    const FieldHandle u_handle     = cartesian_domain->GetFieldHandle("u");
+    EXPECT_EQ(&cartesian_domain->GetFieldByHandle(h_handle), h.get());
+    EXPECT_EQ(&cartesian_domain->GetFieldByHandle(u_handle), u.get());
+    EXPECT_EQ(&cartesian_domain->GetFieldByHandle(cartesian_domain->GetFieldHandle("a")), a.get());
+    EXPECT_NE(h_handle, u_handle);
+    EXPECT_EQ(u_handle, cartesian_domain->GetFieldHandle("u"));
+    EXPECT_EQ(std::vector<std::shared_ptr<Field>>(cartesian_domain->GetFields().begin(),
+                                                  cartesian_domain->GetFields().end()),
+              (std::vector<std::shared_ptr<Field>>{h, u, a}));
+
+    // Setting through the handle changes the field itself
+    cartesian_domain->GetFieldByHandle(u_handle).multifab->setVal(3.0);
+    EXPECT_EQ(cartesian_domain->GetField("u")->multifab->min(0), 3.0);
+
+    // A field created with its handle is registered like any other field
+    const FieldHandle v_handle = cartesian_domain->CreateFieldHandle("v", FieldGridStagger::JFace, 1, 1);
+    EXPECT_EQ(v_handle, cartesian_domain->GetFieldHandle("v"));
+    EXPECT_EQ(&cartesian_domain->GetFieldByHandle(v_handle), cartesian_domain->GetField("v").get());
+
+    EXPECT_THROW(cartesian_domain->GetFieldHandle("does_not_exist"), std::invalid_argument);
+    EXPECT_THROW(cartesian_domain->CreateField("h", FieldGridStagger::CellCentered, 1, 1), std::invalid_argument);
+    EXPECT_THROW(cartesian_domain->CreateFieldHandle("u", FieldGridStagger::IFace, 1, 1), std::invalid_argument);
+    EXPECT_EQ(cartesian_domain->GetFields().size(), 4);
+}
+
 TEST_F(CartesianDomainTest, FieldView)
 {
     EXPECT_TRUE(cartesian_domain->GetFields().empty());
@@ -136,6 +176,84 @@ TEST_F(CartesianDomainTest, FieldView)
     EXPECT_EQ(cartesian_domain->GetFields().size(), 2);
 }
 
+TEST_F(CartesianDomainTest, SharedLayout)
+{
+    const std::size_t n_component = 1;
+    const std::size_t n_ghost     = 1;
+
+    const std::shared_ptr<Field> tracer_1 =
+        cartesian_domain->CreateField("tracer_1", FieldGridStagger::CellCentered, n_component, n_ghost);
+    const std::shared_ptr<Field> tracer_2 =
+        cartesian_domain->CreateField("tracer_2", FieldGridStagger::CellCentered, n_component + 1, n_ghost + 1);
+    const std::shared_ptr<Field> u = cartesian_domain->CreateField("u", FieldGridStagger::IFace, n_component, n_ghost);
+
+    // Fields with the same stagger use the domain's layout objects, so AMReX sees them as the same layout
+    EXPECT_EQ(tracer_1->multifab->boxArray(), cartesian_domain->GetBoxArray(FieldGridStagger::CellCentered));
+    EXPECT_EQ(tracer_1->multifab->boxArray(), tracer_2->multifab->boxArray());
+    EXPECT_EQ(tracer_1->multifab->DistributionMap(), tracer_2->multifab->DistributionMap());
+    EXPECT_EQ(tracer_1->multifab->DistributionMap(), cartesian_domain->GetDistributionMapping());
+
+    // All staggers share the cell centered boxes and the distribution
+    EXPECT_EQ(u->multifab->boxArray(), cartesian_domain->GetBoxArray(FieldGridStagger::IFace));
+    EXPECT_TRUE(u->multifab->boxArray().CellEqual(tracer_1->multifab->boxArray()));
+    EXPECT_EQ(u->multifab->DistributionMap(), tracer_1->multifab->DistributionMap());
+
+    for (const FieldGridStagger stagger : {FieldGridStagger::Nodal, FieldGridStagger::CellCentered,
+                                           FieldGridStagger::IFace, FieldGridStagger::JFace, FieldGridStagger::KFace})
+    {
+        const amrex::BoxArray& box_array = cartesian_domain->GetBoxArray(stagger);
+        EXPECT_EQ(box_array.ixType(), Field::FieldGridStaggerToAMReXIndexType(stagger));
+        EXPECT_TRUE(box_array.CellEqual(cartesian_domain->GetBoxArray(FieldGridStagger::CellCentered)));
+    }
+
+    // Same layout, so the copy is local
+    tracer_1->multifab->setVal(2.0);
+    amrex::MultiFab::Copy(*tracer_2->multifab, *tracer_1->multifab, 0, 1, n_component, n_ghost);
+    EXPECT_EQ(tracer_2->multifab->min(1), 2.0);
+}
+
+TEST_F(CartesianDomainTest, FillBoundary)
+{
+    const std::shared_ptr<Field> h = cartesian_domain->CreateField("h", FieldGridStagger::CellCentered, 1, 1);
+    const std::shared_ptr<Field> u = cartesian_domain->CreateField("u", FieldGridStagger::IFace, 2, 1);
+    h->multifab->setVal(1.0);
+    u->multifab->setVal(2.0);
+    h->multifab->setBndry(-1.0);
+    u->multifab->setBndry(-1.0);
+
+    cartesian_domain->FillBoundary({"h", "u"});
+
+    // Ghost cells between boxes are filled, ghost cells outside the (non-periodic) domain are not
+    for (const std::shared_ptr<Field>& field : {h, u})
+    {
+        const amrex::Box domain_box = field->multifab->boxArray().minimalBox();
+        for (amrex::MFIter mfi(*field->multifab); mfi.isValid(); ++mfi)
+        {
+            const amrex::Array4<const amrex::Real>& array = field->multifab->const_array(mfi);
+            const amrex::Real value                       = field == h ? 1.0 : 2.0;
+            amrex::ParallelFor(mfi.fabbox(), field->multifab->nComp(),
+                               [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                               {
+                                   const bool inside = domain_box.contains(amrex::IntVect(AMREX_D_DECL(i, j, k)));
+                                   EXPECT_EQ(array(i, j, k, n), inside ? value : -1.0);
+                               });
+        }
+    }
+
+    EXPECT_THROW(cartesian_domain->FillBoundary({"h", "does_not_exist"}), std::invalid_argument);
+    EXPECT_THROW(cartesian_domain->FillBoundary({"h", "h"}), std::invalid_argument);
+    EXPECT_NO_THROW(cartesian_domain->FillBoundary());
+
+    // Split-phase fill
+    EXPECT_THROW(cartesian_domain->FillBoundaryFinish(), std::logic_error);
+    cartesian_domain->FillBoundaryStart({"h", "u"});
+    EXPECT_THROW(cartesian_domain->FillBoundaryStart(), std::logic_error);
+    cartesian_domain->FillBoundaryFinish();
+    EXPECT_THROW(cartesian_domain->FillBoundaryStart({"does_not_exist"}), std::invalid_argument);
+    cartesian_domain->FillBoundaryStart();
+    cartesian_domain->FillBoundaryFinish();
+}
+
 TEST_F(CartesianDomainTest, WriteHDF5)
 {
     const std::string field_name  = "test_field";
@@ -159,4 +277,158 @@ TEST_F(CartesianDomainTest, WriteHDF5)
     }
 
     cartesian_domain->WriteHDF5("Test_Output_CartesianDomain_WriteHDF5.h5");
+
+#ifdef H5_HAVE_PARALLEL
+    cartesian_domain->WriteHDF5("Test_Output_CartesianDomain_WriteHDF5_Collective.h5", HDF5WriteMode::Collective);
+
+    // Only the IO processor writes the grid data with MPI-IO, and it must match the gathered write
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        auto ReadAxis = [](const std::string& filename, const std::string& axis_name) -> std::vector<double>
+        {
+            const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            const hid_t dataset_id = H5Dopen2(file_id, axis_name.c_str(), H5P_DEFAULT);
+            const hid_t space_id   = H5Dget_space(dataset_id);
+            std::vector<double> data(H5Sget_simple_extent_npoints(space_id));
+            H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+            H5Sclose(space_id);
+            H5Dclose(dataset_id);
+            H5Fclose(file_id);
+            return data;
+        };
+        for (const std::string axis_name : {"cell_center/x", "node/y", "z_face/z"})
+        {
+            EXPECT_EQ(ReadAxis("Test_Output_CartesianDomain_WriteHDF5.h5", axis_name),
+                      ReadAxis("Test_Output_CartesianDomain_WriteHDF5_Collective.h5", axis_name))
+                << "Collective write of the grid axis " << axis_name << " does not match the gathered write";
+        }
+    }
+#endif
+}
+
+TEST_F(CartesianDomainTest, HDF5Options)
+{
+    EXPECT_EQ(cartesian_domain->GetHDF5Options(), HDF5Options());
+
+    const std::shared_ptr<Field> before = cartesian_domain->CreateField("before", FieldGridStagger::CellCentered, 1, 0);
+    const HDF5Options compressed        = HDF5Options::Compressed(4, 12);
+    cartesian_domain->SetHDF5Options(compressed);
+    const std::shared_ptr<Field> after = cartesian_domain->CreateField("after", FieldGridStagger::Nodal, 1, 0);
+
+    EXPECT_EQ(cartesian_domain->GetHDF5Options(), compressed);
+    EXPECT_EQ(before->hdf5_options, compressed);
+    EXPECT_EQ(after->hdf5_options, compressed);
+
+    // A single field can still use its own options
+    after->hdf5_options = HDF5Options();
+    before->multifab->setVal(1.0);
+    after->multifab->setVal(2.0);
+    cartesian_domain->WriteHDF5("Test_Output_CartesianDomain_HDF5Options.h5");
+
+    HDF5Options invalid   = compressed;
+    invalid.deflate_level = 10;
+    EXPECT_THROW(cartesian_domain->SetHDF5Options(invalid), std::invalid_argument);
+    EXPECT_EQ(cartesian_domain->GetHDF5Options(), compressed);
+}
+
+TEST_F(CartesianDomainTest, WriteHDF5Async)
+{
+    const std::shared_ptr<Field> field =
+        cartesian_domain->CreateField("async_field", FieldGridStagger::CellCentered, 1, 0);
+
+    AsyncHDF5Writer writer;
+    field->multifab->setVal(1.0);
+    cartesian_domain->WriteHDF5("Test_Output_CartesianDomain_WriteHDF5Async.h5", writer);
+
+    // The field can be updated while the file is written
+    field->multifab->setVal(2.0);
+    writer.Flush();
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        const hid_t file_id    = H5Fopen("Test_Output_CartesianDomain_WriteHDF5Async.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        const hid_t dataset_id = H5Dopen2(file_id, field->name.c_str(), H5P_DEFAULT);
+        std::vector<double> data(n_cell_x * n_cell_y * n_cell_z);
+        H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+        H5Dclose(dataset_id);
+        H5Fclose(file_id);
+        EXPECT_EQ(data, std::vector<double>(data.size(), 1.0));
+    }
+}
+
+TEST_F(CartesianDomainTest, CreateHDF5TimeSeries)
+{
+    const std::shared_ptr<Field> field =
+        cartesian_domain->CreateField("series_field", FieldGridStagger::CellCentered, 1, 0);
+
+    {
+        const std::unique_ptr<HDF5TimeSeries> time_series =
+            cartesian_domain->CreateHDF5TimeSeries("Test_Output_CartesianDomain_CreateHDF5TimeSeries.h5");
+        field->multifab->setVal(1.0);
+        time_series->Append(0.5);
+        field->multifab->setVal(2.0);
+        time_series->Append(1.5);
+        EXPECT_EQ(time_series->GetNSnapshot(), 2);
+    }
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        const hid_t file_id =
+            H5Fopen("Test_Output_CartesianDomain_CreateHDF5TimeSeries.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        const hid_t dataset_id = H5Dopen2(file_id, field->name.c_str(), H5P_DEFAULT);
+        std::vector<double> data(2 * n_cell_x * n_cell_y * n_cell_z);
+        H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+        H5Dclose(dataset_id);
+        H5Fclose(file_id);
+        EXPECT_EQ(data.front(), 1.0);
+        EXPECT_EQ(data.back(), 2.0);
+    }
+}
+
+TEST_F(CartesianDomainTest, ReadHDF5)
+{
+    const std::shared_ptr<Field> scalar =
+        cartesian_domain->CreateField("restart_scalar", FieldGridStagger::CellCentered, 1, 0);
+    const std::shared_ptr<Field> vector =
+        cartesian_domain->CreateField("restart_vector", FieldGridStagger::Nodal, 3, 1);
+    scalar->multifab->setVal(1.0);
+    vector->multifab->setVal(2.0);
+    cartesian_domain->WriteHDF5("Test_Output_CartesianDomain_ReadHDF5.h5");
+
+    scalar->multifab->setVal(0.0);
+    vector->multifab->setVal(0.0);
+    cartesian_domain->ReadHDF5("Test_Output_CartesianDomain_ReadHDF5.h5");
+    EXPECT_EQ(scalar->multifab->min(0), 1.0);
+    EXPECT_EQ(scalar->multifab->max(0), 1.0);
+    for (int component = 0; component < 3; ++component)
+    {
+        EXPECT_EQ(vector->multifab->min(component), 2.0);
+        EXPECT_EQ(vector->multifab->max(component), 2.0);
+    }
+
+    // A field that is not in the file
+    cartesian_domain->CreateField("new_field", FieldGridStagger::CellCentered, 1, 0);
+    EXPECT_THROW(cartesian_domain->ReadHDF5("Test_Output_CartesianDomain_ReadHDF5.h5"), std::runtime_error);
+}
+
+TEST_F(CartesianDomainTest, WriteHDF5FilePerRank)
+{
+    const std::shared_ptr<Field> field =
+        cartesian_domain->CreateField("file_per_rank_field", FieldGridStagger::CellCentered, 2, 0);
+    field->multifab->setVal(3.0);
+    cartesian_domain->WriteHDF5("Test_Output_CartesianDomain_WriteHDF5FilePerRank.h5", HDF5WriteMode::FilePerRank);
+
+    // The master file has the grid and a virtual dataset of the whole field
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        const hid_t file_id =
+            H5Fopen("Test_Output_CartesianDomain_WriteHDF5FilePerRank.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        EXPECT_GT(H5Lexists(file_id, "cell_center", H5P_DEFAULT), 0);
+        const hid_t dataset_id = H5Dopen2(file_id, field->name.c_str(), H5P_DEFAULT);
+        std::vector<double> data(n_cell_x * n_cell_y * n_cell_z * 2);
+        H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+        H5Dclose(dataset_id);
+        H5Fclose(file_id);
+        EXPECT_EQ(data, std::vector<double>(data.size(), 3.0));
+    }
 }
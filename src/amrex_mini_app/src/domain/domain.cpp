@@ -1,37 +1,105 @@
 #include "domain.h"
 
 #include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
 #include <hdf5.h>
 
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "async_hdf5_writer.h"
+#include "box_decomposition.h"
+#include "checkpoint.h"
 #include "field.h"
 #include "geometry.h"
 #include "grid.h"
+#include "halo_exchange.h"
+#include "hdf5_time_series.h"
 
 namespace turbo
 {
 
-Domain::Domain(const std::shared_ptr<Grid>& grid) : grid_(grid), field_container_({}) {}
+namespace
+{
+
+/**
+ * @brief Convert one cell centered BoxArray to every stagger. The copies share the box list of the original.
+ */
+std::map<FieldGridStagger, amrex::BoxArray> MakeStaggeredBoxArrays(const amrex::BoxArray& cell_box_array)
+{
+    std::map<FieldGridStagger, amrex::BoxArray> box_arrays;
+    for (const FieldGridStagger stagger : {FieldGridStagger::Nodal, FieldGridStagger::CellCentered,
+                                           FieldGridStagger::IFace, FieldGridStagger::JFace, FieldGridStagger::KFace})
+    {
+        box_arrays.emplace(stagger, amrex::convert(cell_box_array, Field::FieldGridStaggerToAMReXIndexType(stagger)));
+    }
+    return box_arrays;
+}
+
+/**
+ * @brief Decompose the cell centered index space of a grid.
+ * @throws std::invalid_argument if the grid is null or the decomposition does not fit the grid.
+ */
+amrex::BoxArray MakeCellBoxArray(const std::shared_ptr<Grid>& grid, const BoxDecomposition& box_decomposition)
+{
+    if (!grid)
+    {
+        throw std::invalid_argument("Domain::Domain: Invalid grid pointer.");
+    }
+    return box_decomposition.MakeBoxArray(CellDomain(*grid));
+}
+
+}  // namespace
+
+Domain::Domain(const std::shared_ptr<Grid>& grid, const BoxDecomposition& box_decomposition)
+    : grid_(grid),
+      box_decomposition_(box_decomposition),
+      box_arrays_(MakeStaggeredBoxArrays(MakeCellBoxArray(grid, box_decomposition))),
+      distribution_mapping_(box_decomposition.MakeDistributionMapping(box_arrays_.at(FieldGridStagger::CellCentered))),
+      field_registry_({}),
+      field_handles_({})
+{
+}
 
 std::shared_ptr<Geometry> Domain::GetGeometry() const noexcept { return grid_->GetGeometry(); }
 
 std::shared_ptr<Grid> Domain::GetGrid() const noexcept { return grid_; }
 
+const BoxDecomposition& Domain::GetBoxDecomposition() const noexcept { return box_decomposition_; }
+
+const amrex::BoxArray& Domain::GetBoxArray(const FieldGridStagger stagger) const
+{
+    auto it = box_arrays_.find(stagger);
+    if (it != box_arrays_.end())
+    {
+        return it->second;
+    }
+    throw std::invalid_argument("Domain::GetBoxArray: Invalid FieldGridStagger specified.");
+}
+
+const amrex::DistributionMapping& Domain::GetDistributionMapping() const noexcept { return distribution_mapping_; }
+
 std::shared_ptr<Field> Domain::CreateField(const Field::NameType& name, const FieldGridStagger stagger,
-                                           const std::size_t n_component, const std::size_t n_ghost)
+                                           const std::size_t n_component, const std::size_t n_ghost,
+                                           const FoldParity fold_parity)
 {
-    if (field_container_.contains(name))
+    if (field_handles_.contains(name))
     {
         throw std::invalid_argument("Domain::CreateField failed because field with name '" + name +
                                     "' already exists.");
     }
 
-    const std::shared_ptr<Field> field = std::make_shared<Field>(name, grid_, stagger, n_component, n_ghost);
-    auto [iter, inserted]              = field_container_.insert({name, field});
+    const std::shared_ptr<Field> field =
+        std::make_shared<Field>(name, grid_, stagger, n_component, n_ghost, GetBoxArray(stagger),
+                                distribution_mapping_, fold_parity);
+    field->hdf5_options   = hdf5_options_;
+    auto [iter, inserted] = field_handles_.insert({name, FieldHandle{field_registry_.size()}});
     if (!inserted)
     {
         // Since we already checked that no value with this key exist in the map and created the field pointer,
@@ -40,47 +108,142 @@ std::shared_ptr<Field> Domain::CreateField(const Field::NameType& name, const Fi
             "Domain::CreateField failed to insert field. Somehow it was not inserted into the map used under the "
             "hood of Domain. This should never happen.");
     }
+    field_registry_.push_back(field);
 
     return field;
 }
 
+FieldHandle Domain::CreateFieldHandle(const Field::NameType& field_name, const FieldGridStagger stagger,
+                                      const std::size_t n_component, const std::size_t n_ghost,
+                                      const FoldParity fold_parity)
+{
+    CreateField(field_name, stagger, n_component, n_ghost, fold_parity);
+    return FieldHandle{field_registry_.size() - 1};
+}
+
 std::shared_ptr<Field> Domain::GetField(const Field::NameType& name) const
 {
-    auto it = field_container_.find(name);
-    if (it != field_container_.end())
+    auto it = field_handles_.find(name);
+    if (it != field_handles_.end())
     {
-        return it->second;
+        return field_registry_[it->second.index];
     }
     throw std::invalid_argument("Domain::GetField: Field with name '" + name + "' does not exist.");
 }
 
-bool Domain::HasField(const Field::NameType& field_name) const { return field_container_.contains(field_name); }
+FieldHandle Domain::GetFieldHandle(const Field::NameType& field_name) const
+{
+    auto it = field_handles_.find(field_name);
+    if (it != field_handles_.end())
+    {
+        return it->second;
+    }
+    throw std::invalid_argument("Domain::GetFieldHandle: Field with name '" + field_name + "' does not exist.");
+}
+
+bool Domain::HasField(const Field::NameType& field_name) const { return field_handles_.contains(field_name); }
+
+namespace
+{
 
-void Domain::WriteHDF5(const std::string& filename) const
+/**
+ * @brief Look up the fields with the given names in a domain.
+ */
+std::vector<std::shared_ptr<Field>> GetFieldsByName(const Domain& domain,
+                                                    const std::vector<Field::NameType>& field_names)
 {
-    hid_t file_id;
-    if (amrex::ParallelDescriptor::IOProcessor())
+    std::vector<std::shared_ptr<Field>> fields;
+    fields.reserve(field_names.size());
+    for (const Field::NameType& field_name : field_names)
     {
-        file_id = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-        if (file_id < 0)
-        {
-            throw std::runtime_error("Domain::WriteHDF5: Failed to create HDF5 file: " + filename);
-        }
+        fields.push_back(domain.GetField(field_name));
     }
+    return fields;
+}
 
-    // All ranks need to call because fields will require passing data between ranks.
-    WriteHDF5(file_id);
+}  // namespace
+
+void Domain::FillBoundary(const std::vector<Field::NameType>& field_names) const
+{
+    turbo::FillBoundary(GetFieldsByName(*this, field_names));
+}
+
+void Domain::FillBoundary() const
+{
+    const auto all_fields = GetFields();
+    turbo::FillBoundary(std::vector<std::shared_ptr<Field>>(all_fields.begin(), all_fields.end()));
+}
 
-    if (amrex::ParallelDescriptor::IOProcessor())
+void Domain::FillBoundaryStart(const std::vector<Field::NameType>& field_names)
+{
+    if (halo_exchange_)
     {
-        H5Fclose(file_id);
+        throw std::logic_error(
+            "Domain::FillBoundaryStart: Fill is already in progress, call FillBoundaryFinish first.");
     }
+
+    auto halo_exchange = std::make_unique<HaloExchange>(GetFieldsByName(*this, field_names));
+    halo_exchange->Start();
+    halo_exchange_ = std::move(halo_exchange);
 }
 
-void Domain::WriteHDF5(const hid_t file_id) const
+void Domain::FillBoundaryStart()
 {
-    // Only the IO processor needs to write the grid
-    if (amrex::ParallelDescriptor::IOProcessor())
+    std::vector<Field::NameType> field_names;
+    for (const std::shared_ptr<Field>& field : GetFields())
+    {
+        field_names.push_back(field->name);
+    }
+    FillBoundaryStart(field_names);
+}
+
+void Domain::FillBoundaryFinish()
+{
+    if (!halo_exchange_)
+    {
+        throw std::logic_error("Domain::FillBoundaryFinish: No fill in progress, call FillBoundaryStart first.");
+    }
+
+    // Release the exchange even if finishing throws, so the domain can start a new fill
+    const std::unique_ptr<HaloExchange> halo_exchange = std::move(halo_exchange_);
+    halo_exchange->Finish();
+}
+
+void Domain::SetHDF5Options(const HDF5Options& hdf5_options)
+{
+    hdf5_options.Validate();
+    hdf5_options_ = hdf5_options;
+    for (const auto& field : GetFields())
+    {
+        field->hdf5_options = hdf5_options;
+    }
+}
+
+const HDF5Options& Domain::GetHDF5Options() const noexcept { return hdf5_options_; }
+
+void Domain::WriteHDF5(const std::string& filename, const HDF5WriteMode mode) const
+{
+    // All ranks need to call because fields will require passing data between ranks.
+    WriteHDF5File(
+        filename, mode, [this, mode](const hid_t file_id) { WriteHDF5(file_id, mode); },
+        [this, &filename](const hid_t master_file_id)
+        {
+            // The master file holds the grid and a virtual dataset per field, stitched from the files of the ranks
+            GetGrid()->WriteHDF5(master_file_id);
+            for (const auto& field : GetFields())
+            {
+                field->CreateHDF5VirtualDataset(master_file_id, filename);
+            }
+        });
+}
+
+void Domain::WriteHDF5(const hid_t file_id, const HDF5WriteMode mode) const
+{
+    // In gather mode only the IO processor needs to write the grid. With MPI-IO, creating datasets is collective so
+    // every rank creates the grid datasets, but only the IO processor writes their data (see Grid::WriteHDF5Data).
+    // With a file per rank the grid goes into the master file instead.
+    if (mode == HDF5WriteMode::Collective ||
+        (mode == HDF5WriteMode::Gather && amrex::ParallelDescriptor::IOProcessor()))
     {
         GetGrid()->WriteHDF5(file_id);
     }
@@ -88,8 +251,57 @@ void Domain::WriteHDF5(const hid_t file_id) const
     // All ranks need to call WriteHDF5 because this passes data between ranks
     for (const auto& field : GetFields())
     {
-        field->WriteHDF5(file_id);
+        field->WriteHDF5(file_id, mode);
+    }
+}
+
+void Domain::WriteHDF5(const std::string& filename, AsyncHDF5Writer& writer) const
+{
+    const std::vector<std::shared_ptr<Field>> fields(GetFields().begin(), GetFields().end());
+    writer.Write(filename, GetGrid(), fields);
+}
+
+void Domain::ReadHDF5(const std::string& filename, const HDF5ReadMode mode, const bool read_ghost)
+{
+    const hid_t file_id = OpenHDF5File(filename, mode);
+    try
+    {
+        ReadHDF5(file_id, mode, read_ghost);
+    }
+    catch (...)
+    {
+        H5Fclose(file_id);
+        throw;
+    }
+    H5Fclose(file_id);
+}
+
+void Domain::ReadHDF5(const hid_t file_id, const HDF5ReadMode mode, const bool read_ghost)
+{
+    // Every rank reads its own boxes, there is no communication between the ranks
+    for (const auto& field : GetFields())
+    {
+        field->ReadHDF5(file_id, mode, read_ghost);
     }
 }
 
+void Domain::WriteCheckpoint(const std::string& directory, const bool write_ghost) const
+{
+    const std::vector<std::shared_ptr<Field>> fields(GetFields().begin(), GetFields().end());
+    turbo::WriteCheckpoint(directory, fields, write_ghost);
+}
+
+void Domain::ReadCheckpoint(const std::string& directory)
+{
+    const std::vector<std::shared_ptr<Field>> fields(GetFields().begin(), GetFields().end());
+    turbo::ReadCheckpoint(directory, fields);
+}
+
+std::unique_ptr<HDF5TimeSeries> Domain::CreateHDF5TimeSeries(const std::string& filename, const HDF5WriteMode mode,
+                                                             const std::size_t flush_interval) const
+{
+    const std::vector<std::shared_ptr<Field>> fields(GetFields().begin(), GetFields().end());
+    return std::make_unique<HDF5TimeSeries>(filename, GetGrid(), fields, mode, flush_interval);
+}
+
 }  // namespace turbo
@@ -1,15 +1,27 @@
 #pragma once
 
+#include <AMReX_BLassert.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+
 #include <cstddef>
 #include <map>
 #include <memory>
 #include <ranges>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "async_hdf5_writer.h"
+#include "box_decomposition.h"
 #include "field.h"
+#include "field_handle.h"
 #include "geometry.h"
 #include "grid.h"
+#include "halo_exchange.h"
+#include "hdf5_options.h"
+#include "hdf5_time_series.h"
+#include "staggered_field.h"
 
 namespace turbo
 {
@@ -24,8 +36,9 @@ class Domain
     /**
      * @brief Constructor for Domain.
      * @param grid Shared pointer to the Grid associated with the domain.
+     * @param box_decomposition How the grid is split into boxes and distributed over the ranks for all fields.
      */
-    Domain(const std::shared_ptr<Grid>& grid);
+    Domain(const std::shared_ptr<Grid>& grid, const BoxDecomposition& box_decomposition = BoxDecomposition());
 
     /**
      * @brief Virtual destructor for Domain.
@@ -48,25 +61,81 @@ class Domain
     std::shared_ptr<Grid> GetGrid() const noexcept;
 
     /**
-     * @brief Get a view of all fields in the domain's field container.
+     * @brief Get the box decomposition used for the fields of the domain.
+     * @return The box decomposition.
+     */
+    const BoxDecomposition& GetBoxDecomposition() const noexcept;
+
+    /**
+     * @brief Get the layout shared by all fields of the domain with the given stagger.
+     * @param stagger Field grid staggering type.
+     * @return Boxes of the fields with the stagger. All staggers share the same (cell centered) decomposition.
+     * @throws std::invalid_argument if the stagger is invalid.
+     */
+    const amrex::BoxArray& GetBoxArray(const FieldGridStagger stagger) const;
+
+    /**
+     * @brief Get the distribution of the boxes over the ranks, shared by all fields of the domain.
+     * @return The distribution mapping.
+     */
+    const amrex::DistributionMapping& GetDistributionMapping() const noexcept;
+
+    /**
+     * @brief Get a view of all fields in the domain's field registry, in order of creation.
      * @return A range view of shared pointers to Fields.
      */
     // Have to inline the definition in the header file so that the return type can be deduced properly by auto
-    std::ranges::view auto GetFields() const noexcept { return std::views::values(field_container_); }
+    std::ranges::view auto GetFields() const noexcept { return std::views::all(field_registry_); }
 
     /**
      * @brief Create a field to the domain's field container.
+     *
+     * All fields with the same stagger share the same BoxArray and DistributionMapping, see GetBoxArray.
+     *
      * @param name Name of the field.
      * @param stagger Field grid staggering type.
      * @param n_component Number of components (e.g., 1 for scalar fields).
      * @param n_ghost Number of ghost cells.
-     * @return Shared pointer to the newly created field.
+     * @param fold_parity How the field transforms across the fold of a TripolarGrid. Ignored on other grids.
+     * @return Shared pointer to the newly created field. See CreateFieldHandle to get its FieldHandle instead.
      * @throws std::invalid_argument if invalid input (name already exists in container, invalid number of components or
      * ghost cells, invalid stagger type, etc.).
      * @throws std::logic_error if the field cannot be inserted into the container given valid input.
      */
     std::shared_ptr<Field> CreateField(const Field::NameType& field_name, const FieldGridStagger stagger,
-                                       const std::size_t n_component, const std::size_t n_ghost);
+                                       const std::size_t n_component, const std::size_t n_ghost,
+                                       const FoldParity fold_parity = FoldParity::Scalar);
+
+    /**
+     * @brief Create a field like CreateField above and get its handle, to look the field up in the timestep.
+     * @param field_name Name of the field.
+     * @param stagger Field grid staggering type.
+     * @param n_component Number of components (e.g., 1 for scalar fields).
+     * @param n_ghost Number of ghost cells.
+     * @param fold_parity How the field transforms across the fold of a TripolarGrid. Ignored on other grids.
+     * @return Handle of the newly created field, see GetFieldByHandle.
+     * @throws std::invalid_argument if invalid input, see CreateField.
+     */
+    FieldHandle CreateFieldHandle(const Field::NameType& field_name, const FieldGridStagger stagger,
+                                  const std::size_t n_component, const std::size_t n_ghost,
+                                  const FoldParity fold_parity = FoldParity::Scalar);
+
+    /**
+     * @brief Create a field with its stagger in its type, see StaggeredField and CreateField above.
+     * @tparam S Field grid staggering type.
+     * @param field_name Name of the field.
+     * @param n_component Number of components (e.g., 1 for scalar fields).
+     * @param n_ghost Number of ghost cells.
+     * @param fold_parity How the field transforms across the fold of a TripolarGrid. Ignored on other grids.
+     * @return The newly created field, sharing its data with the type-erased field in the domain's field registry.
+     * @throws std::invalid_argument if the name already exists or the number of components is invalid.
+     */
+    template <FieldGridStagger S>
+    StaggeredField<S> CreateField(const Field::NameType& field_name, const std::size_t n_component,
+                                  const std::size_t n_ghost, const FoldParity fold_parity = FoldParity::Scalar)
+    {
+        return StaggeredField<S>(CreateField(field_name, S, n_component, n_ghost, fold_parity));
+    }
 
     /**
      * @brief Get a field by name from the domain's field container.
@@ -76,6 +145,26 @@ class Domain
      */
     std::shared_ptr<Field> GetField(const Field::NameType& field_name) const;
 
+    /**
+     * @brief Get the handle of a field by name, to look the field up with GetFieldByHandle in the timestep.
+     * @param field_name Name of the field.
+     * @return Handle of the field, valid for the lifetime of the domain.
+     * @throws std::invalid_argument if the field does not exist.
+     */
+    FieldHandle GetFieldHandle(const Field::NameType& field_name) const;
+
+    /**
+     * @brief Get a field by handle from the domain's field registry, an O(1) lookup without reference counting.
+     * @param handle Handle from GetFieldHandle or CreateFieldHandle of this domain. Only checked in debug builds.
+     * @return Reference to the Field, valid for the lifetime of the domain.
+     */
+    // Inlined in the header file so the lookup compiles down to an array access at the call site
+    Field& GetFieldByHandle(const FieldHandle handle) const noexcept
+    {
+        AMREX_ASSERT(handle.index < field_registry_.size());
+        return *field_registry_[handle.index];
+    }
+
     /**
      * @brief Check if a field with the given name exists in the domain's field container.
      * @param field_name Name of the field to check.
@@ -84,16 +173,155 @@ class Domain
     bool HasField(const Field::NameType& field_name) const;
 
     /**
-     * @brief Write the domain data to an HDF5 file.
+     * @brief Fill the ghost cells of the named fields with one fused halo exchange. Must be called by all ranks with
+     * the same names in the same order.
+     *
+     * Sends one message per neighbor rank for all the fields together instead of one per field, see
+     * turbo::FillBoundary.
+     *
+     * @param field_names Names of the fields to fill, of any stagger and number of components.
+     * @throws std::invalid_argument if a field does not exist or a name appears more than once.
+     */
+    void FillBoundary(const std::vector<Field::NameType>& field_names) const;
+
+    /**
+     * @brief Fill the ghost cells of all fields of the domain with one fused halo exchange. Must be called by all
+     * ranks.
+     */
+    void FillBoundary() const;
+
+    /**
+     * @brief Start filling the ghost cells of the named fields with one fused halo exchange and return without
+     * waiting for the messages, see HaloExchange::Start. Must be called by all ranks with the same names in the same
+     * order.
+     *
+     * Work that only reads valid data of the fields, e.g. updating Field::InteriorBox of each box, can overlap with the
+     * communication until FillBoundaryFinish is called. The fields must not be written in between.
+     *
+     * @param field_names Names of the fields to fill, of any stagger and number of components.
+     * @throws std::invalid_argument if a field does not exist or a name appears more than once.
+     * @throws std::logic_error if a fill started by the domain is already in progress.
+     */
+    void FillBoundaryStart(const std::vector<Field::NameType>& field_names);
+
+    /**
+     * @brief Start filling the ghost cells of all fields of the domain, see FillBoundaryStart above.
+     * @throws std::logic_error if a fill started by the domain is already in progress.
+     */
+    void FillBoundaryStart();
+
+    /**
+     * @brief Finish the fill started by FillBoundaryStart. Must be called by all ranks.
+     * @throws std::logic_error if no fill started by the domain is in progress.
+     */
+    void FillBoundaryFinish();
+
+    /**
+     * @brief Set the HDF5 storage options of all fields of the domain, including fields created later.
+     * @param hdf5_options Storage options of the field datasets.
+     * @throws std::invalid_argument if the options are invalid.
+     */
+    void SetHDF5Options(const HDF5Options& hdf5_options);
+
+    /**
+     * @brief Get the HDF5 storage options given to fields created by the domain.
+     * @return The options set by SetHDF5Options, contiguous and uncompressed by default.
+     */
+    const HDF5Options& GetHDF5Options() const noexcept;
+
+    /**
+     * @brief Write the domain data to an HDF5 file. Must be called by all ranks.
+     *
+     * With HDF5WriteMode::FilePerRank every rank writes the boxes of all fields into its own file and the file named
+     * filename is a master file with the grid and a virtual dataset per field, see Field::CreateHDF5VirtualDataset.
+     * The call returns once all files are closed, so any rank can read them right away.
+     *
+     * @param filename Name of the HDF5 file to write.
+     * @param mode How the distributed field data gets into the file.
+     */
+    void WriteHDF5(const std::string& filename, const HDF5WriteMode mode = HDF5WriteMode::Gather) const;
+
+    /**
+     * @brief Write the domain data to an HDF5 file. Must be called by all ranks.
+     * @param file_id HDF5 file identifier. See Field::WriteHDF5 for the requirements of each mode. With
+     * HDF5WriteMode::FilePerRank only the files of the ranks are written, without the grid.
+     * @param mode How the distributed field data gets into the file.
+     */
+    void WriteHDF5(const hid_t file_id, const HDF5WriteMode mode = HDF5WriteMode::Gather) const;
+
+    /**
+     * @brief Write the domain data to an HDF5 file in the background and return once the fields are snapshotted, see
+     * AsyncHDF5Writer::Write. Must be called by all ranks.
+     *
+     * The file is the same as written by HDF5WriteMode::Gather. The fields can be updated as soon as this returns, call
+     * AsyncHDF5Writer::Flush at the end of the run.
+     *
      * @param filename Name of the HDF5 file to write.
+     * @param writer Writer doing the HDF5 work on its I/O thread, reusing its staging buffers between writes.
+     */
+    void WriteHDF5(const std::string& filename, AsyncHDF5Writer& writer) const;
+
+    /**
+     * @brief Read the data of all fields of the domain from an HDF5 file written by WriteHDF5, e.g. to restart. Must be
+     * called by all ranks.
+     * @param filename Name of the HDF5 file to read.
+     * @param mode How the ranks read their part of the datasets, see Field::ReadHDF5.
+     * @param read_ghost Also read the ghost cells that lie inside the domain.
+     * @throws std::runtime_error if a field of the domain is missing from the file or does not match its dataset.
+     */
+    void ReadHDF5(const std::string& filename, const HDF5ReadMode mode = HDF5ReadMode::Independent,
+                  const bool read_ghost = false);
+
+    /**
+     * @brief Read the data of all fields of the domain from an open HDF5 file. Must be called by all ranks.
+     * @param file_id HDF5 file identifier, open on every rank (see OpenHDF5File).
+     * @param mode How the ranks read their part of the datasets, see Field::ReadHDF5.
+     * @param read_ghost Also read the ghost cells that lie inside the domain.
+     * @throws std::runtime_error if a field of the domain is missing from the file or does not match its dataset.
+     */
+    void ReadHDF5(const hid_t file_id, const HDF5ReadMode mode = HDF5ReadMode::Independent,
+                  const bool read_ghost = false);
+
+    /**
+     * @brief Write a binary checkpoint of all fields of the domain, for a fast restart with ReadCheckpoint. Must be
+     * called by all ranks.
+     *
+     * Every rank writes its own file without communication, see WriteCheckpoint, so this is much faster than
+     * WriteHDF5 with HDF5WriteMode::Gather for frequent checkpoints.
+     *
+     * @param directory Directory of the checkpoint, created if needed.
+     * @param write_ghost Also write the ghost cells, so a restart on the same layout needs no FillBoundary.
+     * @throws std::runtime_error if a file cannot be written.
      */
-    void WriteHDF5(const std::string& filename) const;
+    void WriteCheckpoint(const std::string& directory, const bool write_ghost = false) const;
 
     /**
-     * @brief Write the domain data to an HDF5 file.
-     * @param file_id HDF5 file identifier.
+     * @brief Read all fields of the domain from a checkpoint written by WriteCheckpoint, e.g. to restart. Must be
+     * called by all ranks.
+     *
+     * A checkpoint written on the same number of ranks with the same box decomposition is read straight into the
+     * fields. Otherwise it is redistributed, which only fills the valid cells, so FillBoundary has to follow.
+     *
+     * @param directory Directory of the checkpoint.
+     * @throws std::runtime_error if a field of the domain is missing from the checkpoint or does not match, a file
+     * cannot be read or a checksum does not match.
      */
-    void WriteHDF5(const hid_t file_id) const;
+    void ReadCheckpoint(const std::string& directory);
+
+    /**
+     * @brief Create an HDF5 file that stays open to append a snapshot of the domain's fields at each output time, see
+     * HDF5TimeSeries. The grid is written once. Must be called by all ranks.
+     *
+     * The time series writes the fields of the domain at the time of the call, fields created later are not included.
+     *
+     * @param filename Name of the HDF5 file to create.
+     * @param mode How the distributed field data gets into the file.
+     * @param flush_interval Number of snapshots between flushes of the file, 0 to only flush when it is closed.
+     * @return The open time series, closed when destroyed.
+     */
+    std::unique_ptr<HDF5TimeSeries> CreateHDF5TimeSeries(const std::string& filename,
+                                                         const HDF5WriteMode mode = HDF5WriteMode::Gather,
+                                                         const std::size_t flush_interval = 1) const;
 
    protected:
     /**
@@ -102,9 +330,39 @@ class Domain
     const std::shared_ptr<Grid> grid_;
 
     /**
-     * @brief Container for the fields defined on the domain.
+     * @brief Box decomposition used for the fields of the domain.
+     */
+    const BoxDecomposition box_decomposition_;
+
+    /**
+     * @brief Boxes of the fields of each stagger, all converted from one cell centered BoxArray.
+     */
+    const std::map<FieldGridStagger, amrex::BoxArray> box_arrays_;
+
+    /**
+     * @brief Distribution of the boxes over the ranks, shared by all fields so AMReX sees them as one layout.
+     */
+    const amrex::DistributionMapping distribution_mapping_;
+
+    /**
+     * @brief Registry of the fields defined on the domain, in order of creation and indexed by FieldHandle.
+     */
+    std::vector<std::shared_ptr<Field>> field_registry_;
+
+    /**
+     * @brief Handles of the fields by name, for setup-time lookups.
+     */
+    std::map<Field::NameType, FieldHandle> field_handles_;
+
+    /**
+     * @brief Halo exchange started by FillBoundaryStart, null if no fill is in progress.
+     */
+    std::unique_ptr<HaloExchange> halo_exchange_;
+
+    /**
+     * @brief HDF5 storage options of the fields, see SetHDF5Options.
      */
-    std::map<Field::NameType, std::shared_ptr<Field>> field_container_;
+    HDF5Options hdf5_options_;
 };
 
 }  // namespace turbo
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace turbo
+{
+
+/**
+ * @brief Stable, trivially-copyable handle of a field of a Domain, for fast lookups in the timestep.
+ *
+ * Indexes the flat field registry of the domain that created the field, so Domain::GetFieldByHandle is an O(1) array
+ * access without string compares or shared_ptr reference counting. A handle stays valid for the lifetime of its domain,
+ * fields are never removed. Get the handle once at setup from Domain::CreateFieldHandle or Domain::GetFieldHandle and
+ * keep it. A handle must only be used with the domain it came from, which is not checked.
+ */
+struct FieldHandle
+{
+    std::size_t index; /**< Position of the field in the registry of its domain, in order of creation */
+
+    bool operator==(const FieldHandle& other) const noexcept = default;
+};
+
+static_assert(std::is_trivially_copyable_v<FieldHandle>, "FieldHandle must be trivially copyable to be cheap to pass.");
+
+}  // namespace turbo
@@ -0,0 +1,230 @@
+#include "async_hdf5_writer.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <hdf5.h>
+
+#ifdef AMREX_USE_OMP
+#include <omp.h>
+#endif
+
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "field.h"
+#include "grid.h"
+#include "hdf5_options.h"
+
+namespace turbo
+{
+
+AsyncHDF5Writer::AsyncHDF5Writer(const std::size_t n_buffer)
+{
+    if (n_buffer == 0)
+    {
+        throw std::invalid_argument(
+            "AsyncHDF5Writer::AsyncHDF5Writer: Number of staging buffers must be greater than zero.");
+    }
+
+    for (std::size_t buffer_idx = 0; buffer_idx < n_buffer; ++buffer_idx)
+    {
+        buffers_.push_back(std::make_unique<StagingBuffer>());
+        free_buffers_.push_back(buffers_.back().get());
+    }
+
+    // Only the IO processor writes files, the other ranks just take part in the gathers
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        thread_ = std::thread(&AsyncHDF5Writer::Run, this);
+    }
+}
+
+AsyncHDF5Writer::~AsyncHDF5Writer()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    job_queued_.notify_one();
+
+    // The I/O thread finishes the queued writes before it stops
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+void AsyncHDF5Writer::Write(const std::string& filename, const std::shared_ptr<Grid>& grid,
+                            const std::vector<std::shared_ptr<Field>>& fields)
+{
+    if (!grid)
+    {
+        throw std::invalid_argument("AsyncHDF5Writer::Write: Invalid grid pointer.");
+    }
+    std::set<Field::NameType> field_names;
+    for (const std::shared_ptr<Field>& field : fields)
+    {
+        if (!field)
+        {
+            throw std::invalid_argument("AsyncHDF5Writer::Write: Invalid field pointer.");
+        }
+        if (!field_names.insert(field->name).second)
+        {
+            throw std::invalid_argument("AsyncHDF5Writer::Write: Field '" + field->name +
+                                        "' appears more than once.");
+        }
+    }
+
+    // Take a free staging buffer, waiting for the oldest pending write to finish if there is none. Only the IO
+    // processor has pending writes, so the other ranks never wait here.
+    StagingBuffer* buffer = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        job_done_.wait(lock, [this] { return !free_buffers_.empty(); });
+        buffer = free_buffers_.back();
+        free_buffers_.pop_back();
+    }
+
+    Job job;
+    job.filename = filename;
+    job.grid     = grid;
+    job.buffer   = buffer;
+    try
+    {
+        // Release the staging memory of fields that are not written anymore, and reuse the rest
+        std::erase_if(buffer->gathered,
+                      [&field_names](const auto& entry) { return !field_names.contains(entry.first); });
+        for (const std::shared_ptr<Field>& field : fields)
+        {
+            field->GatherToIOProcessor(buffer->gathered[field->name]);
+
+            // Everything the I/O thread needs from the field is copied here, as it may change once Write returns
+            if (amrex::ParallelDescriptor::IOProcessor())
+            {
+                job.datasets.push_back(field->GetHDF5DatasetLayout());
+            }
+        }
+    }
+    catch (...)
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        free_buffers_.push_back(buffer);
+        throw;
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (!amrex::ParallelDescriptor::IOProcessor())
+        {
+            // Not the IO processor, the gather was all there is to do
+            free_buffers_.push_back(buffer);
+            return;
+        }
+        jobs_.push_back(std::move(job));
+        ++n_pending_;
+    }
+    job_queued_.notify_one();
+}
+
+void AsyncHDF5Writer::Flush()
+{
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        job_done_.wait(lock, [this] { return n_pending_ == 0; });
+        error = std::exchange(error_, nullptr);
+    }
+
+    // Let every rank know if a write failed, so they all throw together
+    int failed = error ? 1 : 0;
+    amrex::ParallelDescriptor::Bcast(&failed, 1, amrex::ParallelDescriptor::IOProcessorNumber());
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    if (failed)
+    {
+        throw std::runtime_error("AsyncHDF5Writer::Flush: Writing an HDF5 file failed on the IO processor.");
+    }
+}
+
+std::size_t AsyncHDF5Writer::GetNPending() const
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return n_pending_;
+}
+
+std::size_t AsyncHDF5Writer::GetNBuffer() const noexcept { return buffers_.size(); }
+
+void AsyncHDF5Writer::Run()
+{
+#ifdef AMREX_USE_OMP
+    // Pack the data on this thread only, leaving the cores to the OpenMP threads of the model
+    omp_set_num_threads(1);
+#endif
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        job_queued_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+        if (jobs_.empty())
+        {
+            return;
+        }
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+
+        // Write without holding the lock, so Write can queue the next job meanwhile
+        lock.unlock();
+        std::exception_ptr error;
+        try
+        {
+            WriteJob(job);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error && !error_)
+        {
+            error_ = error;
+        }
+        free_buffers_.push_back(job.buffer);
+        --n_pending_;
+        job_done_.notify_all();
+    }
+}
+
+void AsyncHDF5Writer::WriteJob(Job& job) const
+{
+    const hid_t file_id = CreateHDF5File(job.filename, HDF5WriteMode::Gather);
+    try
+    {
+        job.grid->WriteHDF5(file_id);
+        for (const HDF5DatasetLayout& dataset : job.datasets)
+        {
+            Field::WriteHDF5Gathered(file_id, dataset, *job.buffer->gathered.at(dataset.name), job.buffer->data);
+        }
+    }
+    catch (...)
+    {
+        H5Fclose(file_id);
+        throw;
+    }
+    H5Fclose(file_id);
+}
+
+}  // namespace turbo
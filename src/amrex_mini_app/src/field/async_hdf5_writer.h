@@ -0,0 +1,190 @@
+#pragma once
+
+#include <AMReX_MultiFab.H>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "field.h"
+#include "grid.h"
+#include "hdf5_options.h"
+
+namespace turbo
+{
+
+/**
+ * @class AsyncHDF5Writer
+ * @brief Writes HDF5 files in the background on a dedicated I/O thread of the IO processor.
+ *
+ * Write snapshots the fields into staging buffers on the IO processor, the same gather as HDF5WriteMode::Gather, and
+ * returns without waiting for the file. The I/O thread then packs the data, applies the storage options of the
+ * fields and writes the file while the model keeps stepping. The staging buffers are a fixed pool reused between
+ * writes, which bounds the memory: when every buffer holds a write that has not finished yet, Write blocks until the
+ * oldest one is done (backpressure). Call Flush at the end of the run, or before reading the files.
+ *
+ * While writes are pending, other threads must not call the HDF5 library unless it is built thread-safe, since only
+ * the I/O thread is synchronized with the writer. Flush first, e.g. before a synchronous WriteHDF5.
+ */
+class AsyncHDF5Writer
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct a writer and start its I/O thread on the IO processor.
+     * @param n_buffer Number of staging buffers, the number of writes that can be pending before Write blocks.
+     * @throws std::invalid_argument if n_buffer is zero.
+     */
+    explicit AsyncHDF5Writer(const std::size_t n_buffer = 2);
+
+    /**
+     * @brief Wait for the pending writes and stop the I/O thread. Errors of the pending writes are dropped, call
+     * Flush to get them.
+     */
+    ~AsyncHDF5Writer();
+
+    AsyncHDF5Writer(const AsyncHDF5Writer&)            = delete;
+    AsyncHDF5Writer& operator=(const AsyncHDF5Writer&) = delete;
+
+    /**
+     * @brief Snapshot the grid and fields and write them to an HDF5 file (overwrites file if exists) in the
+     * background. Must be called by all ranks with the same fields in the same order.
+     *
+     * The file has the same layout as a Domain::WriteHDF5 in HDF5WriteMode::Gather. The field data and storage options
+     * are taken at the time of the call, so the fields can be updated as soon as Write returns. Errors while writing
+     * the file are reported by Flush.
+     *
+     * @param filename Name of the HDF5 file to write.
+     * @param grid Grid of the fields, written into the file.
+     * @param fields Fields to write, each as a dataset named after the field.
+     * @throws std::invalid_argument if the grid or a field is null, or two fields have the same name.
+     */
+    void Write(const std::string& filename, const std::shared_ptr<Grid>& grid,
+               const std::vector<std::shared_ptr<Field>>& fields);
+
+    /**
+     * @brief Wait until all pending writes have finished. Must be called by all ranks.
+     * @throws std::runtime_error on all ranks if a write since the last Flush failed. The IO processor rethrows the
+     * original error.
+     */
+    void Flush();
+
+    /**
+     * @brief Get the number of writes that have not finished yet.
+     * @return Number of pending writes, always 0 on ranks other than the IO processor.
+     */
+    std::size_t GetNPending() const;
+
+    /**
+     * @brief Get the number of staging buffers.
+     * @return The maximum number of pending writes.
+     */
+    std::size_t GetNBuffer() const noexcept;
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Types
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Staging memory of one pending write, kept for the next write once the file is done.
+     */
+    struct StagingBuffer
+    {
+        std::map<Field::NameType, std::shared_ptr<amrex::MultiFab>> gathered; /**< Gathered data of each field. */
+        std::vector<double> data;                                             /**< Row-major data being written. */
+    };
+
+    /**
+     * @brief A file to write, with the snapshot of its fields. Holds no fields, so the I/O thread never reads state
+     * that the model or AMReX may change meanwhile.
+     */
+    struct Job
+    {
+        std::string filename;                    /**< Name of the HDF5 file. */
+        std::shared_ptr<const Grid> grid;        /**< Grid of the fields, whose coordinates do not change. */
+        std::vector<HDF5DatasetLayout> datasets; /**< Dataset of each field at the time of Write, data in buffer. */
+        StagingBuffer* buffer = nullptr;         /**< Staging buffer holding the field data. */
+    };
+
+    //-----------------------------------------------------------------------//
+    // Private Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Loop of the I/O thread, writing the queued jobs until the writer is destroyed.
+     */
+    void Run();
+
+    /**
+     * @brief Write the file of a job. Runs on the I/O thread.
+     * @param job Job to write.
+     */
+    void WriteJob(Job& job) const;
+
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Pool of staging buffers.
+     */
+    std::vector<std::unique_ptr<StagingBuffer>> buffers_;
+
+    /**
+     * @brief Staging buffers not used by a pending write.
+     */
+    std::vector<StagingBuffer*> free_buffers_;
+
+    /**
+     * @brief Writes queued for the I/O thread, oldest first.
+     */
+    std::deque<Job> jobs_;
+
+    /**
+     * @brief Number of queued writes plus the write in progress on the I/O thread.
+     */
+    std::size_t n_pending_ = 0;
+
+    /**
+     * @brief Set by the destructor to stop the I/O thread once the queue is empty.
+     */
+    bool stop_ = false;
+
+    /**
+     * @brief First error of a write since the last Flush.
+     */
+    std::exception_ptr error_;
+
+    /**
+     * @brief Protects the members above, shared with the I/O thread.
+     */
+    mutable std::mutex mutex_;
+
+    /**
+     * @brief Signaled when a job is queued or the writer stops.
+     */
+    std::condition_variable job_queued_;
+
+    /**
+     * @brief Signaled when a write finishes and its staging buffer is free again.
+     */
+    std::condition_variable job_done_;
+
+    /**
+     * @brief The I/O thread, only started on the IO processor.
+     */
+    std::thread thread_;
+};
+
+}  // namespace turbo
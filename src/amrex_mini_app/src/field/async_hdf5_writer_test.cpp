@@ -0,0 +1,199 @@
+#include "async_hdf5_writer.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <gtest/gtest.h>
+#include <hdf5.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "hdf5_options.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+namespace
+{
+
+/**
+ * @brief Read a whole dataset of doubles from a file, on the IO processor.
+ */
+std::vector<double> ReadDataset(const std::string& filename, const std::string& dataset_name)
+{
+    const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset_id = H5Dopen2(file_id, dataset_name.c_str(), H5P_DEFAULT);
+    const hid_t space_id   = H5Dget_space(dataset_id);
+    std::vector<double> data(H5Sget_simple_extent_npoints(space_id));
+    H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+    H5Sclose(space_id);
+    H5Dclose(dataset_id);
+    H5Fclose(file_id);
+    return data;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------//
+// AsyncHDF5Writer tests
+//---------------------------------------------------------------------------//
+
+class AsyncHDF5WriterTest : public ::testing::Test
+{
+   protected:
+    std::shared_ptr<CartesianGrid> grid;
+    std::shared_ptr<Field> scalar;
+    std::shared_ptr<Field> vector;
+
+    void SetUp() override
+    {
+        grid = std::make_shared<CartesianGrid>(std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 16,
+                                               12, 4);
+        const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 4, 4)));
+        scalar = std::make_shared<Field>("scalar", grid, FieldGridStagger::CellCentered, 1, 1, FoldParity::Scalar,
+                                         box_decomposition);
+        vector = std::make_shared<Field>("vector", grid, FieldGridStagger::Nodal, 3, 0, FoldParity::Scalar,
+                                         box_decomposition);
+    }
+};
+
+TEST_F(AsyncHDF5WriterTest, Constructor)
+{
+    EXPECT_THROW(AsyncHDF5Writer(0), std::invalid_argument);
+
+    const AsyncHDF5Writer writer(3);
+    EXPECT_EQ(writer.GetNBuffer(), 3);
+    EXPECT_EQ(writer.GetNPending(), 0);
+}
+
+TEST_F(AsyncHDF5WriterTest, InvalidArguments)
+{
+    AsyncHDF5Writer writer;
+    EXPECT_THROW(writer.Write("Test_Output_AsyncHDF5Writer_Invalid.h5", nullptr, {scalar}), std::invalid_argument);
+    EXPECT_THROW(writer.Write("Test_Output_AsyncHDF5Writer_Invalid.h5", grid, {scalar, nullptr}),
+                 std::invalid_argument);
+    EXPECT_THROW(writer.Write("Test_Output_AsyncHDF5Writer_Invalid.h5", grid, {scalar, scalar}),
+                 std::invalid_argument);
+    EXPECT_EQ(writer.GetNPending(), 0);
+}
+
+TEST_F(AsyncHDF5WriterTest, WritesSnapshots)
+{
+    // More writes than buffers, so Write has to wait for the I/O thread to free a buffer
+    AsyncHDF5Writer writer(2);
+    vector->hdf5_options = HDF5Options::Compressed(4);
+    const int n_write    = 5;
+    for (int write_idx = 0; write_idx < n_write; ++write_idx)
+    {
+        scalar->multifab->setVal(write_idx);
+        vector->multifab->setVal(-write_idx);
+        writer.Write("Test_Output_AsyncHDF5Writer_" + std::to_string(write_idx) + ".h5", grid, {scalar, vector});
+        EXPECT_LE(writer.GetNPending(), writer.GetNBuffer());
+    }
+
+    // The snapshot is taken by Write, so changing the fields afterwards does not change the files
+    scalar->multifab->setVal(100.0);
+    vector->multifab->setVal(100.0);
+    writer.Flush();
+    EXPECT_EQ(writer.GetNPending(), 0);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        for (int write_idx = 0; write_idx < n_write; ++write_idx)
+        {
+            const std::string filename = "Test_Output_AsyncHDF5Writer_" + std::to_string(write_idx) + ".h5";
+
+            const std::vector<double> scalar_data = ReadDataset(filename, scalar->name);
+            ASSERT_EQ(scalar_data.size(), 16 * 12 * 4);
+            for (const double value : scalar_data)
+            {
+                EXPECT_EQ(value, write_idx);
+            }
+
+            const std::vector<double> vector_data = ReadDataset(filename, vector->name);
+            ASSERT_EQ(vector_data.size(), 17 * 13 * 5 * 3);
+            for (const double value : vector_data)
+            {
+                EXPECT_EQ(value, -write_idx);
+            }
+
+            // The grid is written too, like Domain::WriteHDF5
+            const hid_t file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            EXPECT_GT(H5Lexists(file_id, "cell_center", H5P_DEFAULT), 0);
+            H5Fclose(file_id);
+        }
+    }
+}
+
+TEST_F(AsyncHDF5WriterTest, SameFileAsGatherWrite)
+{
+    for (amrex::MFIter mfi(*scalar->multifab); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real>& array = scalar->multifab->array(mfi);
+        amrex::ParallelFor(mfi.validbox(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k) { array(i, j, k) = 100 * i + 10 * j + k; });
+    }
+    scalar->hdf5_options = HDF5Options::Compressed(2, 8);
+
+    AsyncHDF5Writer writer;
+    writer.Write("Test_Output_AsyncHDF5Writer_Async.h5", grid, {scalar});
+    writer.Flush();
+    scalar->WriteHDF5("Test_Output_AsyncHDF5Writer_Gather.h5");
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        EXPECT_EQ(ReadDataset("Test_Output_AsyncHDF5Writer_Async.h5", scalar->name),
+                  ReadDataset("Test_Output_AsyncHDF5Writer_Gather.h5", scalar->name));
+    }
+}
+
+TEST_F(AsyncHDF5WriterTest, ReducedOutputTakenAtWrite)
+{
+    scalar->multifab->setVal(2.0);
+    scalar->hdf5_options.region           = {{4, 0, 0, 11, 5, 3}};
+    scalar->hdf5_options.coarsening_ratio = {2, 3, 1};
+
+    // The dataset is written with the options of the time of the call, whatever they are when the file is written
+    AsyncHDF5Writer writer;
+    writer.Write("Test_Output_AsyncHDF5Writer_Reduced.h5", grid, {scalar});
+    scalar->hdf5_options = HDF5Options();
+    writer.Flush();
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        const std::vector<double> data = ReadDataset("Test_Output_AsyncHDF5Writer_Reduced.h5", scalar->name);
+        ASSERT_EQ(data.size(), 4 * 2 * 4);
+        for (const double value : data)
+        {
+            EXPECT_EQ(value, 2.0);
+        }
+
+        const hid_t file_id    = H5Fopen("Test_Output_AsyncHDF5Writer_Reduced.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        const hid_t dataset_id = H5Dopen2(file_id, scalar->name.c_str(), H5P_DEFAULT);
+        EXPECT_GT(H5Aexists(dataset_id, "region"), 0);
+        EXPECT_GT(H5Lexists(file_id, "cell_center_i4-11_j0-5_k0-3_r2x3x1", H5P_DEFAULT), 0);
+        H5Dclose(dataset_id);
+        H5Fclose(file_id);
+    }
+}
+
+TEST_F(AsyncHDF5WriterTest, FlushReportsErrors)
+{
+    AsyncHDF5Writer writer;
+    writer.Write("Test_Output_AsyncHDF5Writer_Missing_Directory/file.h5", grid, {scalar});
+    EXPECT_THROW(writer.Flush(), std::runtime_error);
+
+    // The error is reported once and the writer keeps working
+    writer.Write("Test_Output_AsyncHDF5Writer_After_Error.h5", grid, {scalar});
+    EXPECT_NO_THROW(writer.Flush());
+}
@@ -0,0 +1,323 @@
+#include "box_decomposition.h"
+
+#include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "field.h"
+#include "grid.h"
+
+namespace turbo
+{
+
+namespace
+{
+
+/**
+ * @brief Split n cells starting at lo into n_part contiguous ranges with sizes as even as possible.
+ * @return Inclusive (lo, hi) range of each part, the first n % n_part parts are one cell larger.
+ */
+std::vector<std::pair<int, int>> SplitExtent(const int lo, const int n, const int n_part)
+{
+    std::vector<std::pair<int, int>> parts;
+    parts.reserve(n_part);
+    int part_lo = lo;
+    for (int part = 0; part < n_part; ++part)
+    {
+        const int part_size = n / n_part + (part < n % n_part ? 1 : 0);
+        parts.emplace_back(part_lo, part_lo + part_size - 1);
+        part_lo += part_size;
+    }
+    return parts;
+}
+
+/**
+ * @brief Number of boxes the chunking of a decomposition produces for a domain, without building the BoxArray.
+ */
+std::size_t ChunkedBoxCount(const amrex::Box& cell_domain, const amrex::IntVect& max_box_size)
+{
+    std::size_t n_box = 1;
+    for (int direction = 0; direction < AMREX_SPACEDIM; ++direction)
+    {
+        const int length = cell_domain.length(direction);
+        n_box *= (length + max_box_size[direction] - 1) / max_box_size[direction];
+    }
+    return n_box;
+}
+
+/**
+ * @brief Read an IntVect runtime parameter given either as one integer for all directions or one per direction.
+ */
+void QueryIntVect(const amrex::ParmParse& pp, const char* name, amrex::IntVect& value)
+{
+    std::vector<int> values;
+    if (!pp.queryarr(name, values))
+    {
+        return;
+    }
+    if (values.size() == 1)
+    {
+        value = amrex::IntVect(AMREX_D_DECL(values[0], values[0], values[0]));
+    }
+    else if (values.size() == AMREX_SPACEDIM)
+    {
+        value = amrex::IntVect(AMREX_D_DECL(values[0], values[1], values[2]));
+    }
+    else
+    {
+        throw std::invalid_argument("BoxDecomposition::FromParmParse: Parameter '" + std::string(name) +
+                                    "' needs 1 or " + std::to_string(AMREX_SPACEDIM) + " values.");
+    }
+}
+
+}  // namespace
+
+BoxDecomposition BoxDecomposition::Chunked(const amrex::IntVect& max_box_size, const amrex::IntVect& blocking_factor)
+{
+    BoxDecomposition box_decomposition;
+    box_decomposition.max_box_size    = max_box_size;
+    box_decomposition.blocking_factor = blocking_factor;
+    return box_decomposition;
+}
+
+BoxDecomposition BoxDecomposition::Layout(const int n_box_i, const int n_box_j)
+{
+    BoxDecomposition box_decomposition;
+    box_decomposition.layout = {n_box_i, n_box_j};
+    return box_decomposition;
+}
+
+BoxDecomposition BoxDecomposition::FromParmParse(const std::string& prefix)
+{
+    BoxDecomposition box_decomposition;
+    const amrex::ParmParse pp(prefix);
+    QueryIntVect(pp, "max_box_size", box_decomposition.max_box_size);
+    QueryIntVect(pp, "blocking_factor", box_decomposition.blocking_factor);
+
+    std::vector<int> layout;
+    if (pp.queryarr("layout", layout))
+    {
+        if (layout.size() != 2)
+        {
+            throw std::invalid_argument("BoxDecomposition::FromParmParse: Parameter 'layout' needs 2 values.");
+        }
+        box_decomposition.layout = {layout[0], layout[1]};
+    }
+    return box_decomposition;
+}
+
+bool BoxDecomposition::UsesLayout() const noexcept { return layout[0] != 0 || layout[1] != 0; }
+
+amrex::BoxArray BoxDecomposition::MakeBoxArray(const amrex::Box& cell_domain) const
+{
+    if (UsesLayout())
+    {
+        const int n_i = cell_domain.length(0);
+        const int n_j = cell_domain.length(1);
+        if (layout[0] < 1 || layout[1] < 1 || layout[0] > n_i || layout[1] > n_j)
+        {
+            throw std::invalid_argument("BoxDecomposition::MakeBoxArray: Layout " + std::to_string(layout[0]) + "," +
+                                        std::to_string(layout[1]) + " does not fit a domain of " +
+                                        std::to_string(n_i) + " x " + std::to_string(n_j) + " cells.");
+        }
+
+        const std::vector<std::pair<int, int>> i_parts = SplitExtent(cell_domain.smallEnd(0), n_i, layout[0]);
+        const std::vector<std::pair<int, int>> j_parts = SplitExtent(cell_domain.smallEnd(1), n_j, layout[1]);
+
+        // Boxes are numbered fastest in i, like the ranks of a MOM layout
+        amrex::BoxList box_list;
+        for (const auto& [j_lo, j_hi] : j_parts)
+        {
+            for (const auto& [i_lo, i_hi] : i_parts)
+            {
+                box_list.push_back(amrex::Box(amrex::IntVect(AMREX_D_DECL(i_lo, j_lo, cell_domain.smallEnd(2))),
+                                              amrex::IntVect(AMREX_D_DECL(i_hi, j_hi, cell_domain.bigEnd(2)))));
+            }
+        }
+        return amrex::BoxArray(std::move(box_list));
+    }
+
+    for (int direction = 0; direction < AMREX_SPACEDIM; ++direction)
+    {
+        if (blocking_factor[direction] < 1 || max_box_size[direction] < 1)
+        {
+            throw std::invalid_argument(
+                "BoxDecomposition::MakeBoxArray: Maximum box size and blocking factor must be positive.");
+        }
+        if (max_box_size[direction] % blocking_factor[direction] != 0)
+        {
+            throw std::invalid_argument(
+                "BoxDecomposition::MakeBoxArray: Maximum box size must be a multiple of the blocking factor.");
+        }
+        if (cell_domain.length(direction) % blocking_factor[direction] != 0)
+        {
+            throw std::invalid_argument(
+                "BoxDecomposition::MakeBoxArray: Number of cells must be a multiple of the blocking factor.");
+        }
+    }
+
+    // Chunk the coarsened domain so every box size stays a multiple of the blocking factor
+    amrex::BoxArray box_array(cell_domain);
+    box_array.coarsen(blocking_factor);
+    box_array.maxSize(max_box_size / blocking_factor);
+    box_array.refine(blocking_factor);
+    return box_array;
+}
+
+amrex::DistributionMapping BoxDecomposition::MakeDistributionMapping(const amrex::BoxArray& box_array) const
+{
+    if (!UsesLayout())
+    {
+        return amrex::DistributionMapping(box_array);
+    }
+
+    const int n_rank = amrex::ParallelDescriptor::NProcs();
+    amrex::Vector<int> processor_map(box_array.size());
+    for (std::size_t box = 0; box < processor_map.size(); ++box)
+    {
+        processor_map[box] = static_cast<int>(box % n_rank);
+    }
+    return amrex::DistributionMapping(std::move(processor_map));
+}
+
+std::ostream& operator<<(std::ostream& os, const BoxDecomposition& box_decomposition)
+{
+    if (box_decomposition.UsesLayout())
+    {
+        os << "layout = " << box_decomposition.layout[0] << " " << box_decomposition.layout[1];
+        return os;
+    }
+
+    const amrex::IntVect& max_box_size    = box_decomposition.max_box_size;
+    const amrex::IntVect& blocking_factor = box_decomposition.blocking_factor;
+    os << "max_box_size = " << max_box_size[0] << " " << max_box_size[1] << " " << max_box_size[2]
+       << ", blocking_factor = " << blocking_factor[0] << " " << blocking_factor[1] << " " << blocking_factor[2];
+    return os;
+}
+
+amrex::Box CellDomain(const Grid& grid)
+{
+    return amrex::Box(amrex::IntVect(AMREX_D_DECL(0, 0, 0)),
+                      amrex::IntVect(AMREX_D_DECL(grid.NCellI() - 1, grid.NCellJ() - 1, grid.NCellK() - 1)));
+}
+
+std::vector<BoxDecomposition> CandidateBoxDecompositions(const amrex::Box& cell_domain, const int n_rank)
+{
+    const int n_i = cell_domain.length(0);
+    const int n_j = cell_domain.length(1);
+    const int n_k = cell_domain.length(2);
+
+    std::vector<BoxDecomposition> candidates = {BoxDecomposition()};
+    auto add_candidate = [&candidates](const BoxDecomposition& candidate)
+    {
+        if (std::find(candidates.begin(), candidates.end(), candidate) == candidates.end())
+        {
+            candidates.push_back(candidate);
+        }
+    };
+
+    // Boxes spanning the whole k extent, square and 2:1 in i and j. Skip the ones leaving ranks without a box.
+    for (const int size : {8, 16, 24, 32, 48, 64, 96, 128})
+    {
+        for (const auto& [size_i, size_j] :
+             {std::pair{size, size}, std::pair{2 * size, size}, std::pair{size, 2 * size}})
+        {
+            const amrex::IntVect max_box_size(AMREX_D_DECL(std::min(size_i, n_i), std::min(size_j, n_j), n_k));
+            if (ChunkedBoxCount(cell_domain, max_box_size) >= static_cast<std::size_t>(n_rank))
+            {
+                add_candidate(BoxDecomposition::Chunked(max_box_size));
+            }
+        }
+    }
+
+    // Every MOM-style layout with one box per rank
+    for (int n_box_i = 1; n_box_i <= n_rank; ++n_box_i)
+    {
+        const int n_box_j = n_rank / n_box_i;
+        if (n_box_i * n_box_j == n_rank && n_box_i <= n_i && n_box_j <= n_j)
+        {
+            add_candidate(BoxDecomposition::Layout(n_box_i, n_box_j));
+        }
+    }
+
+    return candidates;
+}
+
+std::vector<BoxDecompositionTiming> TimeBoxDecompositions(const std::shared_ptr<Grid>& grid,
+                                                          const std::vector<BoxDecomposition>& candidates,
+                                                          const int n_component, const int n_iteration)
+{
+    if (n_component < 1 || n_iteration < 1)
+    {
+        throw std::invalid_argument(
+            "TimeBoxDecompositions: Number of components and iterations must be greater than zero.");
+    }
+
+    std::vector<BoxDecompositionTiming> timings;
+    timings.reserve(candidates.size());
+    for (const BoxDecomposition& candidate : candidates)
+    {
+        Field field("box_decomposition_timing", grid, FieldGridStagger::CellCentered, n_component, 1,
+                    FoldParity::Scalar, candidate);
+        amrex::MultiFab& mf = *field.multifab;
+        amrex::MultiFab result(mf.boxArray(), mf.DistributionMap(), n_component, 0);
+
+        mf.setVal(0.0);
+        for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), n_component, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                               { array(i, j, k, n) = i + 2 * j + 3 * k + n; });
+        }
+
+        // One halo exchange plus a 7-point Laplacian, the typical pattern of a tracer or momentum update
+        auto iteration = [&field, &mf, &result]()
+        {
+            field.FillBoundary();
+            for (amrex::MFIter mfi(result, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const amrex::Box& box                         = mfi.tilebox();
+                const amrex::Array4<const amrex::Real>& input = mf.const_array(mfi);
+                const amrex::Array4<amrex::Real>& output      = result.array(mfi);
+                amrex::ParallelFor(box, mf.nComp(),
+                                   [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   {
+                                       output(i, j, k, n) = input(i - 1, j, k, n) + input(i + 1, j, k, n) +
+                                                            input(i, j - 1, k, n) + input(i, j + 1, k, n) +
+                                                            input(i, j, k - 1, n) + input(i, j, k + 1, n) -
+                                                            6.0 * input(i, j, k, n);
+                                   });
+            }
+        };
+
+        // Warm up, which also builds the communication metadata that is cached for the later iterations
+        iteration();
+
+        amrex::ParallelDescriptor::Barrier();
+        const double start_time = amrex::second();
+        for (int n = 0; n < n_iteration; ++n)
+        {
+            iteration();
+        }
+        double seconds_per_iteration = (amrex::second() - start_time) / n_iteration;
+        amrex::ParallelDescriptor::ReduceRealMax(seconds_per_iteration);
+
+        timings.push_back({candidate, static_cast<std::size_t>(mf.boxArray().size()), seconds_per_iteration});
+    }
+    return timings;
+}
+
+}  // namespace turbo
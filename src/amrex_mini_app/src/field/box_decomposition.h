@@ -0,0 +1,170 @@
+#pragma once
+
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_IntVect.H>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "grid.h"
+
+namespace turbo
+{
+
+/**
+ * @brief How the index space of a grid is split into boxes and how the boxes are distributed over the ranks.
+ *
+ * There are two ways to decompose the domain:
+ * - Chunking (the default): the domain is split into boxes no larger than max_box_size in each direction, with box
+ *   sizes that are multiples of blocking_factor, and AMReX distributes the boxes over the ranks.
+ * - MOM-style layout: with layout = {n_i, n_j} (e.g. MOM's LAYOUT = 12, 6) the domain is split into n_i x n_j boxes
+ *   that span the whole k extent, with extents as even as possible, and box b goes to rank b % n_rank, with the
+ *   boxes numbered fastest in i. max_box_size and blocking_factor are ignored.
+ *
+ * The decomposition is always made for the cell centered index space so that fields of all staggers share the same
+ * boxes and distribution.
+ */
+struct BoxDecomposition
+{
+    //-----------------------------------------------------------------------//
+    // Public Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Maximum number of cells of a box in each direction.
+     */
+    amrex::IntVect max_box_size = amrex::IntVect(AMREX_D_DECL(32, 32, 32));
+
+    /**
+     * @brief Box sizes (and box corners) are multiples of the blocking factor in each direction.
+     */
+    amrex::IntVect blocking_factor = amrex::IntVect(AMREX_D_DECL(1, 1, 1));
+
+    /**
+     * @brief MOM-style processor layout, number of boxes in i and j. {0, 0} to use chunking instead.
+     */
+    std::array<int, 2> layout = {0, 0};
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Make a decomposition that uses chunking with the given maximum box size and blocking factor.
+     * @param max_box_size Maximum number of cells of a box in each direction.
+     * @param blocking_factor Box sizes are multiples of the blocking factor in each direction.
+     * @return The box decomposition.
+     */
+    static BoxDecomposition Chunked(const amrex::IntVect& max_box_size,
+                                    const amrex::IntVect& blocking_factor = amrex::IntVect(AMREX_D_DECL(1, 1, 1)));
+
+    /**
+     * @brief Make a decomposition that uses a MOM-style processor layout.
+     * @param n_box_i Number of boxes in i.
+     * @param n_box_j Number of boxes in j.
+     * @return The box decomposition.
+     */
+    static BoxDecomposition Layout(const int n_box_i, const int n_box_j);
+
+    /**
+     * @brief Read a decomposition from the AMReX runtime parameters, starting from the default decomposition.
+     *
+     * Reads the optional parameters `<prefix>.max_box_size`, `<prefix>.blocking_factor` (three integers each, or one
+     * integer for all directions) and `<prefix>.layout` (two integers).
+     *
+     * @param prefix ParmParse prefix of the parameters.
+     * @return The box decomposition.
+     */
+    static BoxDecomposition FromParmParse(const std::string& prefix = "box_decomposition");
+
+    /**
+     * @brief Check if the decomposition uses a MOM-style processor layout.
+     * @return true if layout is set, false if chunking is used.
+     */
+    bool UsesLayout() const noexcept;
+
+    /**
+     * @brief Split a cell centered domain into boxes.
+     * @param cell_domain Cell centered index space of the whole grid.
+     * @return Cell centered BoxArray covering the domain.
+     * @throws std::invalid_argument if the decomposition does not fit the domain, e.g. the domain is not a multiple of
+     * the blocking factor, max_box_size is not a multiple of the blocking factor, or the layout has more boxes than
+     * cells.
+     */
+    amrex::BoxArray MakeBoxArray(const amrex::Box& cell_domain) const;
+
+    /**
+     * @brief Distribute the boxes of a BoxArray made by MakeBoxArray over the ranks.
+     * @param box_array Cell centered BoxArray.
+     * @return The distribution mapping.
+     */
+    amrex::DistributionMapping MakeDistributionMapping(const amrex::BoxArray& box_array) const;
+
+    /**
+     * @brief Equality operator for BoxDecomposition.
+     */
+    bool operator==(const BoxDecomposition&) const = default;
+
+    /**
+     * @brief Output stream operator for BoxDecomposition.
+     * @param os Output stream.
+     * @param box_decomposition Box decomposition to output.
+     * @return Reference to the output stream.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const BoxDecomposition& box_decomposition);
+};
+
+/**
+ * @brief Get the cell centered index space of a grid.
+ * @param grid Grid to get the index space of.
+ * @return Box from (0, 0, 0) to (NCellI() - 1, NCellJ() - 1, NCellK() - 1).
+ */
+amrex::Box CellDomain(const Grid& grid);
+
+/**
+ * @brief Timing of one candidate BoxDecomposition, see TimeBoxDecompositions.
+ */
+struct BoxDecompositionTiming
+{
+    BoxDecomposition box_decomposition; /**< The candidate decomposition. */
+    std::size_t n_box;                  /**< Number of boxes of the decomposition. */
+    double seconds_per_iteration;       /**< Slowest rank's time for one halo exchange plus stencil update. */
+};
+
+/**
+ * @brief Generate candidate decompositions of a cell domain for autotuning.
+ *
+ * The candidates are the default 32^3 chunking, chunking with boxes that span the whole k extent (the usual choice
+ * for thin-in-k ocean grids) for a range of box sizes in i and j, and every MOM-style layout n_i x n_j = n_rank that
+ * fits the domain.
+ *
+ * @param cell_domain Cell centered index space of the whole grid.
+ * @param n_rank Number of ranks the decomposition is for.
+ * @return Candidate decompositions, without duplicates.
+ */
+std::vector<BoxDecomposition> CandidateBoxDecompositions(const amrex::Box& cell_domain, const int n_rank);
+
+/**
+ * @brief Time a representative halo exchange plus 7-point stencil update for each candidate decomposition.
+ *
+ * For every candidate, a cell centered field with one ghost cell is created on the grid and each iteration fills its
+ * ghost cells with Field::FillBoundary (including the tripolar fold on a TripolarGrid) and applies a 7-point
+ * Laplacian into a second MultiFab. Must be called by all ranks.
+ *
+ * @param grid Grid to time the decompositions on.
+ * @param candidates Decompositions to time.
+ * @param n_component Number of components of the timed field.
+ * @param n_iteration Number of timed iterations per candidate, after one untimed warm up iteration.
+ * @return One timing per candidate, in the order of the candidates.
+ * @throws std::invalid_argument if n_component or n_iteration is not positive.
+ */
+std::vector<BoxDecompositionTiming> TimeBoxDecompositions(const std::shared_ptr<Grid>& grid,
+                                                          const std::vector<BoxDecomposition>& candidates,
+                                                          const int n_component, const int n_iteration);
+
+}  // namespace turbo
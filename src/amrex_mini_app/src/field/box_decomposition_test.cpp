@@ -0,0 +1,203 @@
+#include "box_decomposition.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for box decomposition tests
+//---------------------------------------------------------------------------//
+
+class BoxDecompositionTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        geometry = std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0);
+        grid     = std::make_shared<CartesianGrid>(geometry, n_cell_x, n_cell_y, n_cell_z);
+    }
+
+    // The benchmark example configuration
+    const int n_cell_x = 360;
+    const int n_cell_y = 180;
+    const int n_cell_z = 22;
+
+    std::shared_ptr<CartesianGeometry> geometry;
+    std::shared_ptr<CartesianGrid> grid;
+};
+
+//---------------------------------------------------------------------------//
+// Box decomposition tests
+//---------------------------------------------------------------------------//
+
+TEST_F(BoxDecompositionTest, CellDomain)
+{
+    const amrex::Box cell_domain = CellDomain(*grid);
+    EXPECT_EQ(cell_domain.smallEnd(), amrex::IntVect(AMREX_D_DECL(0, 0, 0)));
+    EXPECT_EQ(cell_domain.bigEnd(), amrex::IntVect(AMREX_D_DECL(n_cell_x - 1, n_cell_y - 1, n_cell_z - 1)));
+}
+
+TEST_F(BoxDecompositionTest, Chunked)
+{
+    const amrex::Box cell_domain = CellDomain(*grid);
+
+    // Default is 32^3 chunking, 12 x 6 x 1 boxes for 360 x 180 x 22 cells
+    const amrex::BoxArray default_box_array = BoxDecomposition().MakeBoxArray(cell_domain);
+    EXPECT_EQ(default_box_array.size(), 12 * 6 * 1);
+    EXPECT_EQ(default_box_array.minimalBox(), cell_domain);
+
+    // Boxes spanning the whole k extent, with sizes that are multiples of the blocking factor
+    const BoxDecomposition blocked = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(40, 40, n_cell_z)),
+                                                               amrex::IntVect(AMREX_D_DECL(20, 20, 1)));
+    const amrex::BoxArray blocked_box_array = blocked.MakeBoxArray(cell_domain);
+    EXPECT_EQ(blocked_box_array.minimalBox(), cell_domain);
+    EXPECT_EQ(blocked_box_array.numPts(), cell_domain.numPts());
+    for (int box = 0; box < static_cast<int>(blocked_box_array.size()); ++box)
+    {
+        const amrex::Box& b = blocked_box_array[box];
+        EXPECT_EQ(b.length(0) % 20, 0);
+        EXPECT_EQ(b.length(1) % 20, 0);
+        EXPECT_LE(b.length(0), 40);
+        EXPECT_LE(b.length(1), 40);
+        EXPECT_EQ(b.length(2), n_cell_z);
+    }
+
+    // Maximum box size not a multiple of the blocking factor
+    const BoxDecomposition bad_max_box_size =
+        BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(30, 30, 30)), amrex::IntVect(AMREX_D_DECL(8, 1, 1)));
+    EXPECT_THROW(bad_max_box_size.MakeBoxArray(cell_domain), std::invalid_argument);
+    // Number of cells in k (22) not a multiple of the blocking factor
+    const BoxDecomposition bad_blocking_factor =
+        BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(32, 32, 32)), amrex::IntVect(AMREX_D_DECL(1, 1, 8)));
+    EXPECT_THROW(bad_blocking_factor.MakeBoxArray(cell_domain), std::invalid_argument);
+    // Non-positive maximum box size
+    EXPECT_THROW(BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(0, 32, 32))).MakeBoxArray(cell_domain),
+                 std::invalid_argument);
+}
+
+TEST_F(BoxDecompositionTest, Layout)
+{
+    const amrex::Box cell_domain = CellDomain(*grid);
+
+    // MOM's LAYOUT = 12, 6 on the benchmark grid gives 72 boxes of 30 x 30 cells spanning the whole k extent
+    const BoxDecomposition layout = BoxDecomposition::Layout(12, 6);
+    EXPECT_TRUE(layout.UsesLayout());
+    EXPECT_FALSE(BoxDecomposition().UsesLayout());
+
+    const amrex::BoxArray box_array = layout.MakeBoxArray(cell_domain);
+    ASSERT_EQ(box_array.size(), 72);
+    for (int box = 0; box < static_cast<int>(box_array.size()); ++box)
+    {
+        EXPECT_EQ(box_array[box].size(), amrex::IntVect(AMREX_D_DECL(30, 30, n_cell_z)));
+    }
+    // Numbered fastest in i
+    EXPECT_EQ(box_array[1].smallEnd(), amrex::IntVect(AMREX_D_DECL(30, 0, 0)));
+    EXPECT_EQ(box_array[12].smallEnd(), amrex::IntVect(AMREX_D_DECL(0, 30, 0)));
+
+    // Uneven extents differ by at most one cell
+    const amrex::BoxArray uneven_box_array = BoxDecomposition::Layout(7, 4).MakeBoxArray(cell_domain);
+    ASSERT_EQ(uneven_box_array.size(), 28);
+    EXPECT_EQ(uneven_box_array.minimalBox(), cell_domain);
+    EXPECT_EQ(uneven_box_array.numPts(), cell_domain.numPts());
+    for (int box = 0; box < static_cast<int>(uneven_box_array.size()); ++box)
+    {
+        EXPECT_GE(uneven_box_array[box].length(0), n_cell_x / 7);
+        EXPECT_LE(uneven_box_array[box].length(0), n_cell_x / 7 + 1);
+        EXPECT_GE(uneven_box_array[box].length(1), n_cell_y / 4);
+        EXPECT_LE(uneven_box_array[box].length(1), n_cell_y / 4 + 1);
+    }
+
+    // Box b goes to rank b % n_rank
+    const amrex::DistributionMapping distribution_mapping = layout.MakeDistributionMapping(box_array);
+    const int n_rank                                      = amrex::ParallelDescriptor::NProcs();
+    for (int box = 0; box < static_cast<int>(box_array.size()); ++box)
+    {
+        EXPECT_EQ(distribution_mapping[box], box % n_rank);
+    }
+
+    // More boxes than cells
+    EXPECT_THROW(BoxDecomposition::Layout(n_cell_x + 1, 1).MakeBoxArray(cell_domain), std::invalid_argument);
+    EXPECT_THROW(BoxDecomposition::Layout(0, 6).MakeBoxArray(cell_domain), std::invalid_argument);
+}
+
+TEST_F(BoxDecompositionTest, Field)
+{
+    // All staggers share the boxes and distribution of the cell centered decomposition
+    const BoxDecomposition layout = BoxDecomposition::Layout(12, 6);
+    Field cell_field("cell_field", grid, FieldGridStagger::CellCentered, 1, 1, FoldParity::Scalar, layout);
+    Field node_field("node_field", grid, FieldGridStagger::Nodal, 1, 1, FoldParity::Scalar, layout);
+
+    EXPECT_EQ(cell_field.multifab->boxArray().size(), 72);
+    EXPECT_EQ(cell_field.multifab->boxArray(), layout.MakeBoxArray(CellDomain(*grid)));
+    EXPECT_EQ(node_field.multifab->boxArray(),
+              amrex::convert(cell_field.multifab->boxArray(), amrex::IndexType::TheNodeType()));
+    EXPECT_EQ(node_field.multifab->DistributionMap(), cell_field.multifab->DistributionMap());
+    EXPECT_EQ(node_field.multifab->boxArray().minimalBox().bigEnd(),
+              amrex::IntVect(AMREX_D_DECL(n_cell_x, n_cell_y, n_cell_z)));
+}
+
+TEST_F(BoxDecompositionTest, CandidateBoxDecompositions)
+{
+    const amrex::Box cell_domain = CellDomain(*grid);
+    const int n_rank             = 6;
+
+    const std::vector<BoxDecomposition> candidates = CandidateBoxDecompositions(cell_domain, n_rank);
+    ASSERT_FALSE(candidates.empty());
+    EXPECT_EQ(candidates.front(), BoxDecomposition());
+
+    auto contains = [&candidates](const BoxDecomposition& box_decomposition)
+    { return std::find(candidates.begin(), candidates.end(), box_decomposition) != candidates.end(); };
+
+    // Every layout with n_rank boxes
+    EXPECT_TRUE(contains(BoxDecomposition::Layout(1, 6)));
+    EXPECT_TRUE(contains(BoxDecomposition::Layout(2, 3)));
+    EXPECT_TRUE(contains(BoxDecomposition::Layout(3, 2)));
+    EXPECT_TRUE(contains(BoxDecomposition::Layout(6, 1)));
+    EXPECT_FALSE(contains(BoxDecomposition::Layout(4, 2)));
+
+    // Chunking with boxes spanning the whole k extent
+    EXPECT_TRUE(contains(BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(64, 64, n_cell_z)))));
+
+    // No duplicates, and every candidate fits the domain with at least one box per rank
+    for (std::size_t a = 0; a < candidates.size(); ++a)
+    {
+        for (std::size_t b = a + 1; b < candidates.size(); ++b)
+        {
+            EXPECT_FALSE(candidates[a] == candidates[b]) << candidates[a];
+        }
+        EXPECT_GE(candidates[a].MakeBoxArray(cell_domain).size(), n_rank) << candidates[a];
+    }
+}
+
+TEST_F(BoxDecompositionTest, TimeBoxDecompositions)
+{
+    const std::vector<BoxDecomposition> candidates = {BoxDecomposition(), BoxDecomposition::Layout(2, 2)};
+    const std::vector<BoxDecompositionTiming> timings = TimeBoxDecompositions(grid, candidates, 1, 1);
+
+    ASSERT_EQ(timings.size(), candidates.size());
+    for (std::size_t candidate = 0; candidate < candidates.size(); ++candidate)
+    {
+        EXPECT_EQ(timings[candidate].box_decomposition, candidates[candidate]);
+        EXPECT_GE(timings[candidate].seconds_per_iteration, 0.0);
+    }
+    EXPECT_EQ(timings[0].n_box, 72);
+    EXPECT_EQ(timings[1].n_box, 4);
+
+    EXPECT_THROW(TimeBoxDecompositions(grid, candidates, 0, 1), std::invalid_argument);
+    EXPECT_THROW(TimeBoxDecompositions(grid, candidates, 1, 0), std::invalid_argument);
+}
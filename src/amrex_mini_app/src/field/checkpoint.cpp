@@ -0,0 +1,660 @@
+#include "checkpoint.h"
+
+#include <AMReX.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "field.h"
+
+namespace turbo
+{
+
+namespace
+{
+
+/**
+ * @brief First line of the Header of a checkpoint, with the version of the format.
+ */
+constexpr const char* kCheckpointHeaderVersion = "turbo_checkpoint 1";
+
+/**
+ * @brief Layout of the blocks of one field in a checkpoint.
+ */
+struct CheckpointFieldLayout
+{
+    Field::NameType name;                   /**< Name of the field. */
+    FieldGridStagger stagger;               /**< Stagger of the field, which gives the index type of the boxes. */
+    int n_component;                        /**< Number of components. */
+    int n_ghost;                            /**< Number of ghost cells written around each box. */
+    std::vector<amrex::Box> boxes;          /**< Valid boxes of the field. */
+    std::vector<int> ranks;                 /**< Rank that wrote each box. */
+    std::vector<std::uint64_t> offsets;     /**< Byte offset of the block of each box in the file of its rank. */
+    std::vector<std::size_t> block_indices; /**< Position of the block of each box among the blocks of its rank. */
+};
+
+/**
+ * @brief Layout of all blocks of a checkpoint, see WriteCheckpoint.
+ */
+struct CheckpointLayout
+{
+    int n_rank = 0;                              /**< Number of ranks that wrote the checkpoint. */
+    std::vector<CheckpointFieldLayout> fields;   /**< Fields in the order of the blocks in the files. */
+    std::vector<std::uint64_t> checksum_offsets; /**< Byte offset of the checksums in the file of each rank. */
+    std::vector<std::size_t> n_blocks;           /**< Number of blocks in the file of each rank. */
+};
+
+/**
+ * @brief Round a byte offset up to the next multiple of kCheckpointAlignment.
+ */
+std::uint64_t AlignOffset(const std::uint64_t offset)
+{
+    return (offset + kCheckpointAlignment - 1) / kCheckpointAlignment * kCheckpointAlignment;
+}
+
+/**
+ * @brief Number of values in the block of a box, including the written ghost cells.
+ */
+std::size_t BlockSize(const CheckpointFieldLayout& field_layout, const int box_index)
+{
+    return static_cast<std::size_t>(amrex::grow(field_layout.boxes[box_index], field_layout.n_ghost).numPts()) *
+           field_layout.n_component;
+}
+
+/**
+ * @brief Place the blocks of every rank one after the other, field by field and box by box, each at an aligned
+ * offset, followed by the checksums of the blocks. The positions follow from the layout alone, so the writer and the
+ * reader agree on them without storing them.
+ */
+void AssignBlockOffsets(CheckpointLayout& layout)
+{
+    std::vector<std::uint64_t> next_offsets(layout.n_rank, 0);
+    layout.n_blocks.assign(layout.n_rank, 0);
+    for (CheckpointFieldLayout& field_layout : layout.fields)
+    {
+        field_layout.offsets.resize(field_layout.boxes.size());
+        field_layout.block_indices.resize(field_layout.boxes.size());
+        for (int box_index = 0; box_index < static_cast<int>(field_layout.boxes.size()); ++box_index)
+        {
+            const int rank                        = field_layout.ranks[box_index];
+            const std::uint64_t block_bytes       = BlockSize(field_layout, box_index) * sizeof(double);
+            field_layout.offsets[box_index]       = next_offsets[rank];
+            field_layout.block_indices[box_index] = layout.n_blocks[rank]++;
+            next_offsets[rank]                    = AlignOffset(next_offsets[rank] + block_bytes);
+        }
+    }
+    layout.checksum_offsets = next_offsets;
+}
+
+/**
+ * @brief Write the layout of a checkpoint as the text of its Header.
+ */
+std::string FormatHeader(const CheckpointLayout& layout)
+{
+    std::ostringstream header;
+    header << kCheckpointHeaderVersion << "\n";
+    header << "alignment " << kCheckpointAlignment << "\n";
+    header << "n_rank " << layout.n_rank << "\n";
+    header << "n_field " << layout.fields.size() << "\n";
+    for (const CheckpointFieldLayout& field_layout : layout.fields)
+    {
+        header << "field " << field_layout.name << " " << FieldGridStaggerToString(field_layout.stagger) << " "
+               << field_layout.n_component << " " << field_layout.n_ghost << " " << field_layout.boxes.size() << "\n";
+        for (std::size_t box_index = 0; box_index < field_layout.boxes.size(); ++box_index)
+        {
+            const amrex::Box& box = field_layout.boxes[box_index];
+            header << field_layout.ranks[box_index];
+            for (int direction = 0; direction < AMREX_SPACEDIM; ++direction)
+            {
+                header << " " << box.smallEnd(direction);
+            }
+            for (int direction = 0; direction < AMREX_SPACEDIM; ++direction)
+            {
+                header << " " << box.bigEnd(direction);
+            }
+            header << "\n";
+        }
+    }
+    return header.str();
+}
+
+/**
+ * @brief Read the layout of a checkpoint from the text of its Header.
+ * @throws std::runtime_error if the Header is malformed or of another version.
+ */
+CheckpointLayout ParseHeader(const std::string& text, const std::string& header_filename)
+{
+    const std::string error_prefix = "ReadCheckpoint: Malformed checkpoint Header '" + header_filename + "': ";
+    std::istringstream header(text);
+
+    std::string version;
+    std::getline(header, version);
+    if (version != kCheckpointHeaderVersion)
+    {
+        throw std::runtime_error(error_prefix + "expected '" + kCheckpointHeaderVersion + "' on the first line.");
+    }
+
+    // Reads "<keyword> <value>"
+    auto read_entry = [&header, &error_prefix](const std::string& keyword)
+    {
+        std::string actual_keyword;
+        long long value = -1;
+        if (!(header >> actual_keyword >> value) || actual_keyword != keyword || value < 0)
+        {
+            throw std::runtime_error(error_prefix + "expected '" + keyword + "' and a count.");
+        }
+        return value;
+    };
+
+    if (read_entry("alignment") != static_cast<long long>(kCheckpointAlignment))
+    {
+        throw std::runtime_error(error_prefix + "unsupported alignment.");
+    }
+
+    CheckpointLayout layout;
+    layout.n_rank = static_cast<int>(read_entry("n_rank"));
+    if (layout.n_rank == 0)
+    {
+        throw std::runtime_error(error_prefix + "no ranks.");
+    }
+
+    const long long n_field = read_entry("n_field");
+    for (long long field_index = 0; field_index < n_field; ++field_index)
+    {
+        CheckpointFieldLayout field_layout;
+        std::string keyword;
+        std::string stagger;
+        std::size_t n_box = 0;
+        if (!(header >> keyword >> field_layout.name >> stagger >> field_layout.n_component >> field_layout.n_ghost >>
+              n_box) ||
+            keyword != "field" || field_layout.n_component <= 0 || field_layout.n_ghost < 0)
+        {
+            throw std::runtime_error(error_prefix + "expected 'field <name> <stagger> <n_component> <n_ghost> "
+                                                    "<n_box>'.");
+        }
+
+        bool known_stagger = false;
+        for (const FieldGridStagger field_grid_stagger :
+             {FieldGridStagger::Nodal, FieldGridStagger::CellCentered, FieldGridStagger::IFace,
+              FieldGridStagger::JFace, FieldGridStagger::KFace})
+        {
+            if (FieldGridStaggerToString(field_grid_stagger) == stagger)
+            {
+                field_layout.stagger = field_grid_stagger;
+                known_stagger        = true;
+            }
+        }
+        if (!known_stagger)
+        {
+            throw std::runtime_error(error_prefix + "unknown stagger '" + stagger + "' of field '" +
+                                     field_layout.name + "'.");
+        }
+
+        const amrex::IndexType index_type = Field::FieldGridStaggerToAMReXIndexType(field_layout.stagger);
+        for (std::size_t box_index = 0; box_index < n_box; ++box_index)
+        {
+            int rank = -1;
+            std::array<int, 3> lo;
+            std::array<int, 3> hi;
+            if (!(header >> rank >> lo[0] >> lo[1] >> lo[2] >> hi[0] >> hi[1] >> hi[2]) || rank < 0 ||
+                rank >= layout.n_rank)
+            {
+                throw std::runtime_error(error_prefix + "expected '<rank> <lo> <hi>' for box " +
+                                         std::to_string(box_index) + " of field '" + field_layout.name + "'.");
+            }
+            field_layout.boxes.emplace_back(amrex::IntVect(lo[0], lo[1], lo[2]), amrex::IntVect(hi[0], hi[1], hi[2]),
+                                            index_type);
+            field_layout.ranks.push_back(rank);
+        }
+        layout.fields.push_back(std::move(field_layout));
+    }
+
+    AssignBlockOffsets(layout);
+    return layout;
+}
+
+/**
+ * @brief Read a file on the IO processor and broadcast its contents to all ranks, so a restart on many ranks does not
+ * open the file on every rank.
+ * @throws std::runtime_error if the file cannot be read, on all ranks.
+ */
+std::string ReadAndBroadcastFile(const std::string& filename)
+{
+    const int io_rank = amrex::ParallelDescriptor::IOProcessorNumber();
+    std::string text;
+    long long length = -1;
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (file)
+        {
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            text   = contents.str();
+            length = static_cast<long long>(text.size());
+        }
+    }
+    amrex::ParallelDescriptor::Bcast(&length, 1, io_rank);
+    if (length < 0)
+    {
+        throw std::runtime_error("ReadCheckpoint: Cannot read checkpoint Header '" + filename + "'.");
+    }
+    text.resize(length);
+    if (length > 0)
+    {
+        amrex::ParallelDescriptor::Bcast(text.data(), text.size(), io_rank);
+    }
+    return text;
+}
+
+/**
+ * @brief Copy the values of a box of a FAB into a block, in the order of the FAB memory (i fastest, components last).
+ */
+void PackBlock(const amrex::Array4<const amrex::Real>& array, const amrex::Box& box, const int n_component,
+               std::vector<double>& data)
+{
+    data.resize(static_cast<std::size_t>(box.numPts()) * n_component);
+    std::size_t index = 0;
+    for (int n = 0; n < n_component; ++n)
+    {
+        for (int k = box.smallEnd(2); k <= box.bigEnd(2); ++k)
+        {
+            for (int j = box.smallEnd(1); j <= box.bigEnd(1); ++j)
+            {
+                for (int i = box.smallEnd(0); i <= box.bigEnd(0); ++i)
+                {
+                    data[index++] = array(i, j, k, n);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Copy the values of a block of block_box into the part of a FAB that the block covers.
+ */
+void UnpackBlock(const std::vector<double>& data, const amrex::Box& block_box, const int n_component,
+                 const amrex::Array4<amrex::Real>& array, const amrex::Box& fab_box)
+{
+    const amrex::Box box    = block_box & fab_box;
+    const std::size_t n_i   = block_box.length(0);
+    const std::size_t n_ij  = n_i * block_box.length(1);
+    const std::size_t n_ijk = n_ij * block_box.length(2);
+    for (int n = 0; n < n_component; ++n)
+    {
+        for (int k = box.smallEnd(2); k <= box.bigEnd(2); ++k)
+        {
+            for (int j = box.smallEnd(1); j <= box.bigEnd(1); ++j)
+            {
+                std::size_t index = n * n_ijk + (k - block_box.smallEnd(2)) * n_ij +
+                                    (j - block_box.smallEnd(1)) * n_i + (box.smallEnd(0) - block_box.smallEnd(0));
+                for (int i = box.smallEnd(0); i <= box.bigEnd(0); ++i)
+                {
+                    array(i, j, k, n) = data[index++];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Files of the writing ranks opened by a reading rank, with their checksums.
+ */
+class CheckpointFiles
+{
+   public:
+    CheckpointFiles(const std::string& directory, const CheckpointLayout& layout)
+        : directory_(directory), layout_(layout)
+    {
+    }
+
+    /**
+     * @brief Read a block from the file of a rank and check it against its checksum.
+     * @return false if the block cannot be read or does not match its checksum.
+     */
+    bool ReadBlock(const int rank, const std::uint64_t offset, const std::size_t block_index, double* data,
+                   const std::size_t n_value)
+    {
+        auto it = files_.find(rank);
+        if (it == files_.end())
+        {
+            it                                    = files_.try_emplace(rank).first;
+            std::ifstream& file                   = it->second.file;
+            std::vector<std::uint64_t>& checksums = it->second.checksums;
+            file.open(CheckpointRankFilename(directory_, rank), std::ios::binary);
+            checksums.resize(layout_.n_blocks[rank]);
+            file.seekg(static_cast<std::streamoff>(layout_.checksum_offsets[rank]));
+            file.read(reinterpret_cast<char*>(checksums.data()),
+                      static_cast<std::streamsize>(checksums.size() * sizeof(std::uint64_t)));
+        }
+
+        std::ifstream& file = it->second.file;
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(n_value * sizeof(double)));
+        if (!file)
+        {
+            return false;
+        }
+        return CheckpointChecksum(data, n_value) == it->second.checksums[block_index];
+    }
+
+   private:
+    struct RankFile
+    {
+        std::ifstream file;                   /**< Open file of the rank. */
+        std::vector<std::uint64_t> checksums; /**< Checksums of the blocks of the rank. */
+    };
+
+    const std::string directory_;
+    const CheckpointLayout& layout_;
+    std::map<int, RankFile> files_;
+};
+
+/**
+ * @brief Check on every rank whether any rank failed.
+ */
+bool AnyRankFailed(const bool failed)
+{
+    int any_failed = failed ? 1 : 0;
+    amrex::ParallelDescriptor::ReduceIntMax(any_failed);
+    return any_failed != 0;
+}
+
+}  // namespace
+
+void WriteCheckpoint(const std::string& directory, const std::vector<std::shared_ptr<Field>>& fields,
+                     const bool write_ghost)
+{
+    CheckpointLayout layout;
+    layout.n_rank = amrex::ParallelDescriptor::NProcs();
+    std::set<Field::NameType> names;
+    for (const std::shared_ptr<Field>& field : fields)
+    {
+        if (!field)
+        {
+            throw std::invalid_argument("WriteCheckpoint: Invalid field pointer.");
+        }
+        if (field->name.empty() ||
+            std::any_of(field->name.begin(), field->name.end(), [](unsigned char c) { return std::isspace(c); }))
+        {
+            throw std::invalid_argument("WriteCheckpoint: Field name '" + field->name +
+                                        "' is empty or contains white space.");
+        }
+        if (!names.insert(field->name).second)
+        {
+            throw std::invalid_argument("WriteCheckpoint: Field '" + field->name + "' is given more than once.");
+        }
+
+        CheckpointFieldLayout field_layout;
+        field_layout.name                              = field->name;
+        field_layout.stagger                           = field->field_grid_stagger;
+        field_layout.n_component                       = field->multifab->nComp();
+        field_layout.n_ghost                           = write_ghost ? field->multifab->nGrow() : 0;
+        const amrex::BoxArray& box_array               = field->multifab->boxArray();
+        const amrex::DistributionMapping& distribution = field->multifab->DistributionMap();
+        for (int box_index = 0; box_index < static_cast<int>(box_array.size()); ++box_index)
+        {
+            field_layout.boxes.push_back(box_array[box_index]);
+            field_layout.ranks.push_back(distribution[box_index]);
+        }
+        layout.fields.push_back(std::move(field_layout));
+    }
+    AssignBlockOffsets(layout);
+
+    // Without a Header the directory does not hold a complete checkpoint, until the new one is written
+    const std::string header_filename = directory + "/Header";
+    bool failed                       = false;
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        std::filesystem::remove(header_filename, error);
+        failed = std::filesystem::exists(header_filename) || !std::filesystem::is_directory(directory);
+    }
+    if (AnyRankFailed(failed))
+    {
+        throw std::runtime_error("WriteCheckpoint: Cannot create checkpoint directory '" + directory + "'.");
+    }
+
+    const int rank = amrex::ParallelDescriptor::MyProc();
+    {
+        std::ofstream file(CheckpointRankFilename(directory, rank), std::ios::binary | std::ios::trunc);
+        std::vector<std::uint64_t> checksums(layout.n_blocks[rank]);
+        std::vector<double> buffer;
+        for (std::size_t field_index = 0; field_index < fields.size(); ++field_index)
+        {
+            const amrex::MultiFab& multifab           = *fields[field_index]->multifab;
+            const CheckpointFieldLayout& field_layout = layout.fields[field_index];
+            for (amrex::MFIter mfi(multifab); mfi.isValid(); ++mfi)
+            {
+                const int box_index         = mfi.index();
+                const amrex::FArrayBox& fab = multifab[mfi];
+                const amrex::Box block_box  = amrex::grow(mfi.validbox(), field_layout.n_ghost);
+                const std::size_t n_value   = BlockSize(field_layout, box_index);
+
+                // A block of the whole FAB is its memory, otherwise the valid box is packed first
+                const double* block_data;
+                if (block_box == fab.box())
+                {
+                    block_data = fab.dataPtr();
+                }
+                else
+                {
+                    PackBlock(fab.const_array(), block_box, field_layout.n_component, buffer);
+                    block_data = buffer.data();
+                }
+
+                checksums[field_layout.block_indices[box_index]] = CheckpointChecksum(block_data, n_value);
+                file.seekp(static_cast<std::streamoff>(field_layout.offsets[box_index]));
+                file.write(reinterpret_cast<const char*>(block_data),
+                           static_cast<std::streamsize>(n_value * sizeof(double)));
+            }
+        }
+        file.seekp(static_cast<std::streamoff>(layout.checksum_offsets[rank]));
+        file.write(reinterpret_cast<const char*>(checksums.data()),
+                   static_cast<std::streamsize>(checksums.size() * sizeof(std::uint64_t)));
+        file.close();
+        failed = !file;
+    }
+    if (AnyRankFailed(failed))
+    {
+        throw std::runtime_error("WriteCheckpoint: Failed to write the checkpoint files in '" + directory + "'.");
+    }
+
+    // All data is on disk, so the Header completes the checkpoint
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        std::ofstream header(header_filename);
+        header << FormatHeader(layout);
+        header.close();
+        failed = !header;
+    }
+    if (AnyRankFailed(failed))
+    {
+        throw std::runtime_error("WriteCheckpoint: Failed to write checkpoint Header '" + header_filename + "'.");
+    }
+}
+
+void ReadCheckpoint(const std::string& directory, const std::vector<std::shared_ptr<Field>>& fields)
+{
+    for (const std::shared_ptr<Field>& field : fields)
+    {
+        if (!field)
+        {
+            throw std::invalid_argument("ReadCheckpoint: Invalid field pointer.");
+        }
+    }
+
+    const std::string header_filename = directory + "/Header";
+    const CheckpointLayout layout     = ParseHeader(ReadAndBroadcastFile(header_filename), header_filename);
+    const int n_rank                  = amrex::ParallelDescriptor::NProcs();
+    CheckpointFiles files(directory, layout);
+
+    for (const std::shared_ptr<Field>& field : fields)
+    {
+        // The Header is the same on every rank, so every rank throws the same errors
+        const auto field_layout_it = std::find_if(layout.fields.begin(), layout.fields.end(),
+                                                  [&field](const CheckpointFieldLayout& field_layout)
+                                                  { return field_layout.name == field->name; });
+        if (field_layout_it == layout.fields.end())
+        {
+            throw std::runtime_error("ReadCheckpoint: Field '" + field->name + "' is not in the checkpoint in '" +
+                                     directory + "'.");
+        }
+        const CheckpointFieldLayout& field_layout = *field_layout_it;
+        amrex::MultiFab& multifab                 = *field->multifab;
+        if (field_layout.stagger != field->field_grid_stagger || field_layout.n_component != multifab.nComp())
+        {
+            throw std::runtime_error("ReadCheckpoint: Field '" + field->name + "' has stagger " +
+                                     FieldGridStaggerToString(field->field_grid_stagger) + " and " +
+                                     std::to_string(multifab.nComp()) + " components, the checkpoint has " +
+                                     FieldGridStaggerToString(field_layout.stagger) + " and " +
+                                     std::to_string(field_layout.n_component) + ".");
+        }
+
+        amrex::BoxList box_list(Field::FieldGridStaggerToAMReXIndexType(field_layout.stagger));
+        for (const amrex::Box& box : field_layout.boxes)
+        {
+            box_list.push_back(box);
+        }
+        const amrex::BoxArray checkpoint_box_array(box_list);
+        const amrex::BoxArray& box_array = multifab.boxArray();
+        if (checkpoint_box_array.minimalBox() != box_array.minimalBox() ||
+            checkpoint_box_array.numPts() != box_array.numPts())
+        {
+            throw std::runtime_error("ReadCheckpoint: The checkpoint of field '" + field->name +
+                                     "' does not cover the domain of the field.");
+        }
+
+        bool same_layout = layout.n_rank == n_rank && field_layout.boxes.size() == box_array.size();
+        for (int box_index = 0; same_layout && box_index < static_cast<int>(box_array.size()); ++box_index)
+        {
+            same_layout = field_layout.boxes[box_index] == box_array[box_index] &&
+                          field_layout.ranks[box_index] == multifab.DistributionMap()[box_index];
+        }
+
+        bool failed = false;
+        if (same_layout)
+        {
+            // Every rank reads the blocks it wrote, straight into the FABs where they cover them exactly
+            std::vector<double> buffer;
+            for (amrex::MFIter mfi(multifab); mfi.isValid(); ++mfi)
+            {
+                const int box_index        = mfi.index();
+                amrex::FArrayBox& fab      = multifab[mfi];
+                const amrex::Box block_box = amrex::grow(mfi.validbox(), field_layout.n_ghost);
+                const std::size_t n_value  = BlockSize(field_layout, box_index);
+                const int rank             = field_layout.ranks[box_index];
+                const std::uint64_t offset = field_layout.offsets[box_index];
+                const std::size_t block    = field_layout.block_indices[box_index];
+                if (block_box == fab.box())
+                {
+                    failed = !files.ReadBlock(rank, offset, block, fab.dataPtr(), n_value) || failed;
+                }
+                else
+                {
+                    buffer.resize(n_value);
+                    failed = !files.ReadBlock(rank, offset, block, buffer.data(), n_value) || failed;
+                    UnpackBlock(buffer, block_box, field_layout.n_component, fab.array(), fab.box());
+                }
+            }
+        }
+        else
+        {
+            // The files of the writing ranks are split into contiguous groups, one per reading rank, and the blocks
+            // are read into a MultiFab with the boxes of the checkpoint before they move to the layout of the field
+            amrex::Vector<int> reading_ranks;
+            for (const int rank : field_layout.ranks)
+            {
+                reading_ranks.push_back(static_cast<int>(static_cast<long long>(rank) * n_rank / layout.n_rank));
+            }
+            const amrex::DistributionMapping checkpoint_distribution(reading_ranks);
+            amrex::MultiFab checkpoint(checkpoint_box_array, checkpoint_distribution, field_layout.n_component,
+                                       field_layout.n_ghost);
+            for (amrex::MFIter mfi(checkpoint); mfi.isValid(); ++mfi)
+            {
+                const int box_index = mfi.index();
+                failed = !files.ReadBlock(field_layout.ranks[box_index], field_layout.offsets[box_index],
+                                          field_layout.block_indices[box_index], checkpoint[mfi].dataPtr(),
+                                          BlockSize(field_layout, box_index)) ||
+                         failed;
+            }
+            const int comp_src_start  = 0;
+            const int comp_dest_start = 0;
+            multifab.ParallelCopy(checkpoint, comp_src_start, comp_dest_start, field_layout.n_component);
+        }
+
+        if (AnyRankFailed(failed))
+        {
+            throw std::runtime_error("ReadCheckpoint: Failed to read field '" + field->name +
+                                     "' from the checkpoint in '" + directory +
+                                     "': a file cannot be read or a checksum does not match.");
+        }
+    }
+}
+
+std::string CheckpointRankFilename(const std::string& directory, const int rank)
+{
+    // Zero padded, so the files of the ranks sort in rank order
+    constexpr std::size_t kNDigit = 5;
+    std::string rank_str          = std::to_string(rank);
+    if (rank_str.size() < kNDigit)
+    {
+        rank_str.insert(0, kNDigit - rank_str.size(), '0');
+    }
+    return (std::filesystem::path(directory) / ("rank" + rank_str + ".bin")).string();
+}
+
+std::uint64_t CheckpointChecksum(const double* data, const std::size_t n_value) noexcept
+{
+    constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+    constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+
+    // Four lanes of four consecutive values each, so the multiplications of the lanes run in parallel
+    std::array<std::uint64_t, 4> lanes = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+    std::size_t index                  = 0;
+    for (; index + 4 <= n_value; index += 4)
+    {
+        for (std::size_t lane = 0; lane < 4; ++lane)
+        {
+            const std::uint64_t word = std::bit_cast<std::uint64_t>(data[index + lane]);
+            lanes[lane]              = std::rotl(lanes[lane] + word * kPrime2, 31) * kPrime1;
+        }
+    }
+
+    std::uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) +
+                         std::rotl(lanes[3], 18) + static_cast<std::uint64_t>(n_value);
+    for (; index < n_value; ++index)
+    {
+        const std::uint64_t word = std::bit_cast<std::uint64_t>(data[index]);
+        hash                     = std::rotl(hash ^ (std::rotl(word * kPrime2, 31) * kPrime1), 27) * kPrime1 + kPrime4;
+    }
+
+    // Mix all bits of the state into every bit of the result
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+}  // namespace turbo
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "field.h"
+
+namespace turbo
+{
+
+/**
+ * @brief Alignment in bytes of the blocks of field data in the checkpoint files of the ranks, a multiple of the block
+ * size of common file systems.
+ */
+inline constexpr std::size_t kCheckpointAlignment = 4096;
+
+/**
+ * @brief Write a checkpoint of fields into a directory, for a fast restart with ReadCheckpoint. Must be called by all
+ * ranks.
+ *
+ * Every rank writes the FABs of its boxes as raw binary into its own file (see CheckpointRankFilename), one block
+ * per field and box, each block starting at a multiple of kCheckpointAlignment so every FAB goes to disk in one large
+ * aligned write. Without ghost cells, or with all ghost cells of a field, the blocks are written straight from FAB
+ * memory. The checksum of every block (see CheckpointChecksum) is stored at the end of the file of its rank. The
+ * IO processor writes the layout of the fields (BoxArrays and DistributionMappings) into a text file named "Header",
+ * from which the position of every block follows. The Header is written last and removed first, so a directory with a
+ * Header holds a complete checkpoint. Files of ranks not in the Header, e.g. of an earlier checkpoint on more ranks,
+ * are left in place and ignored.
+ *
+ * @param directory Directory of the checkpoint, created if needed.
+ * @param fields Fields to write, with unique names without white space.
+ * @param write_ghost Also write the ghost cells, so a restart on the same layout needs no FillBoundary.
+ * @throws std::invalid_argument if a field is null, two fields have the same name or a name contains white space.
+ * @throws std::runtime_error if a file cannot be written, on all ranks.
+ */
+void WriteCheckpoint(const std::string& directory, const std::vector<std::shared_ptr<Field>>& fields,
+                     const bool write_ghost = false);
+
+/**
+ * @brief Read fields from a checkpoint written by WriteCheckpoint, e.g. to restart. Must be called by all ranks.
+ *
+ * The IO processor reads the Header and broadcasts it. If a field has the layout it was written with, on the same
+ * number of ranks, every rank reads its blocks straight into its FABs, including the written ghost cells. Otherwise
+ * the blocks of the files of the writing ranks are split over the reading ranks, each reading whole files, and
+ * redistributed to the layout of the field with a ParallelCopy, which fills the valid cells only. Every block read is
+ * checked against its checksum.
+ *
+ * @param directory Directory of the checkpoint.
+ * @param fields Fields to read, each stored in the checkpoint with the same stagger, number of components and domain.
+ * Fields of the checkpoint that are not given are skipped.
+ * @throws std::invalid_argument if a field is null.
+ * @throws std::runtime_error if the Header is missing or malformed, a field is missing or does not match, a file
+ * cannot be read or a checksum does not match, on all ranks.
+ */
+void ReadCheckpoint(const std::string& directory, const std::vector<std::shared_ptr<Field>>& fields);
+
+/**
+ * @brief Get the name of the file a rank writes in a checkpoint directory.
+ * @param directory Directory of the checkpoint, e.g. "chk00100".
+ * @param rank Rank writing the file.
+ * @return Name of the file of the rank, e.g. "chk00100/rank00003.bin".
+ */
+std::string CheckpointRankFilename(const std::string& directory, const int rank);
+
+/**
+ * @brief Compute the checksum of a block of checkpoint data.
+ *
+ * A 64-bit hash in the style of xxHash64 over the bit patterns of the values, with four independent lanes so it runs
+ * at memory speed. It detects corrupted and misplaced data, it is not meant to be cryptographically secure.
+ *
+ * @param data Values to hash.
+ * @param n_value Number of values.
+ * @return Checksum of the values, which depends on their order.
+ */
+std::uint64_t CheckpointChecksum(const double* data, const std::size_t n_value) noexcept;
+
+}  // namespace turbo
@@ -0,0 +1,229 @@
+#include "checkpoint.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for checkpoint tests
+//---------------------------------------------------------------------------//
+
+class CheckpointTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        grid = std::make_shared<CartesianGrid>(std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 20,
+                                               12, 8);
+    }
+
+    /**
+     * @brief Make a mix of fields with a value unique to every point, component and field, ghost cells included.
+     */
+    std::vector<std::shared_ptr<Field>> MakeFields(const BoxDecomposition& box_decomposition, const bool fill) const
+    {
+        std::vector<std::shared_ptr<Field>> fields = {
+            std::make_shared<Field>("u", grid, FieldGridStagger::IFace, 1, 2, FoldParity::Vector, box_decomposition),
+            std::make_shared<Field>("tracers", grid, FieldGridStagger::CellCentered, 3, 1, FoldParity::Scalar,
+                                    box_decomposition),
+            std::make_shared<Field>("vorticity", grid, FieldGridStagger::Nodal, 1, 0, FoldParity::Scalar,
+                                    box_decomposition)};
+
+        for (const std::shared_ptr<Field>& field : fields)
+        {
+            amrex::MultiFab& mf = *field->multifab;
+            mf.setVal(-1.0);
+            if (!fill)
+            {
+                continue;
+            }
+            const double offset = FieldOffset(field->name);
+            for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+                amrex::ParallelFor(mfi.fabbox(), mf.nComp(),
+                                   [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   { array(i, j, k, n) = offset + i + 100.0 * j + 10000.0 * k + 1000000.0 * n; });
+            }
+        }
+        return fields;
+    }
+
+    /**
+     * @brief Offset of the values of a field, so the values of every field are unique.
+     */
+    static double FieldOffset(const Field::NameType& name)
+    {
+        return name == "u" ? 1.0e7 : (name == "tracers" ? 2.0e7 : 3.0e7);
+    }
+
+    /**
+     * @brief Count the points of the fields that differ from the values of MakeFields, within n_ghost of the valid
+     * boxes, on all ranks.
+     */
+    static int CountMismatches(const std::vector<std::shared_ptr<Field>>& fields, const int n_ghost)
+    {
+        int n_mismatch = 0;
+        for (const std::shared_ptr<Field>& field : fields)
+        {
+            const amrex::MultiFab& mf = *field->multifab;
+            const double offset       = FieldOffset(field->name);
+            for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<const amrex::Real>& array = mf.const_array(mfi);
+                const amrex::Box box = amrex::grow(mfi.validbox(), std::min(n_ghost, mf.nGrow()));
+                for (int n = 0; n < mf.nComp(); ++n)
+                {
+                    for (int k = box.smallEnd(2); k <= box.bigEnd(2); ++k)
+                    {
+                        for (int j = box.smallEnd(1); j <= box.bigEnd(1); ++j)
+                        {
+                            for (int i = box.smallEnd(0); i <= box.bigEnd(0); ++i)
+                            {
+                                const double expected = offset + i + 100.0 * j + 10000.0 * k + 1000000.0 * n;
+                                n_mismatch += (array(i, j, k, n) != expected) ? 1 : 0;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        amrex::ParallelDescriptor::ReduceIntSum(n_mismatch);
+        return n_mismatch;
+    }
+
+    std::shared_ptr<CartesianGrid> grid;
+    const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 4, 8)));
+};
+
+//---------------------------------------------------------------------------//
+// Checkpoint tests
+//---------------------------------------------------------------------------//
+
+TEST(CheckpointChecksumTest, Checksum)
+{
+    std::vector<double> data(1001);
+    for (std::size_t index = 0; index < data.size(); ++index)
+    {
+        data[index] = 0.1 * index;
+    }
+    const std::uint64_t checksum = CheckpointChecksum(data.data(), data.size());
+    EXPECT_EQ(CheckpointChecksum(data.data(), data.size()), checksum);
+
+    // Any changed bit, order or length changes the checksum, in the lanes and in the tail
+    for (const std::size_t index : {0, 5, 998, 1000})
+    {
+        std::vector<double> changed = data;
+        changed[index]              = std::nextafter(changed[index], 1.0e9);
+        EXPECT_NE(CheckpointChecksum(changed.data(), changed.size()), checksum) << "Value " << index;
+    }
+    std::vector<double> swapped = data;
+    std::swap(swapped[1], swapped[2]);
+    EXPECT_NE(CheckpointChecksum(swapped.data(), swapped.size()), checksum);
+    EXPECT_NE(CheckpointChecksum(data.data(), data.size() - 1), checksum);
+    EXPECT_NE(CheckpointChecksum(data.data(), 0), CheckpointChecksum(data.data(), 1));
+
+    EXPECT_EQ(CheckpointRankFilename("chk00100", 3), "chk00100/rank00003.bin");
+    EXPECT_EQ(CheckpointRankFilename("run/chk", 123456), "run/chk/rank123456.bin");
+}
+
+TEST_F(CheckpointTest, WriteRead)
+{
+    const std::string directory = "Test_Output_Checkpoint_WriteRead";
+    for (const bool write_ghost : {false, true})
+    {
+        WriteCheckpoint(directory, MakeFields(box_decomposition, true), write_ghost);
+        EXPECT_TRUE(std::filesystem::exists(directory + "/Header"));
+
+        // Read on the same layout, with the written ghost cells
+        const std::vector<std::shared_ptr<Field>> fields = MakeFields(box_decomposition, false);
+        ReadCheckpoint(directory, fields);
+        EXPECT_EQ(CountMismatches(fields, write_ghost ? 2 : 0), 0);
+        if (!write_ghost)
+        {
+            EXPECT_GT(CountMismatches(fields, 1), 0);
+        }
+
+        // Read into other boxes, redistributing the valid cells
+        const std::vector<std::shared_ptr<Field>> redistributed =
+            MakeFields(BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(5, 5, 8))), false);
+        ReadCheckpoint(directory, redistributed);
+        EXPECT_EQ(CountMismatches(redistributed, 0), 0);
+
+        // Fields can be read on their own
+        const std::vector<std::shared_ptr<Field>> some_fields = {MakeFields(box_decomposition, false)[1]};
+        ReadCheckpoint(directory, some_fields);
+        EXPECT_EQ(CountMismatches(some_fields, 0), 0);
+        amrex::ParallelDescriptor::Barrier();
+    }
+}
+
+TEST_F(CheckpointTest, Errors)
+{
+    const std::vector<std::shared_ptr<Field>> fields = MakeFields(box_decomposition, true);
+    const std::string directory                      = "Test_Output_Checkpoint_Errors";
+
+    EXPECT_THROW(WriteCheckpoint(directory, {fields[0], nullptr}), std::invalid_argument);
+    EXPECT_THROW(WriteCheckpoint(directory, {fields[0], fields[0]}), std::invalid_argument);
+    EXPECT_THROW(WriteCheckpoint(directory, {std::make_shared<Field>("sea level", grid, FieldGridStagger::CellCentered,
+                                                                     1, 0)}),
+                 std::invalid_argument);
+    EXPECT_THROW(ReadCheckpoint("Test_Output_Checkpoint_Missing", fields), std::runtime_error);
+
+    WriteCheckpoint(directory, fields);
+    EXPECT_THROW(ReadCheckpoint(directory, {nullptr}), std::invalid_argument);
+    EXPECT_THROW(ReadCheckpoint(directory, {std::make_shared<Field>("h", grid, FieldGridStagger::CellCentered, 1, 0)}),
+                 std::runtime_error);
+    EXPECT_THROW(ReadCheckpoint(directory, {std::make_shared<Field>("u", grid, FieldGridStagger::JFace, 1, 0)}),
+                 std::runtime_error);
+    EXPECT_THROW(ReadCheckpoint(directory, {std::make_shared<Field>("tracers", grid, FieldGridStagger::CellCentered,
+                                                                    1, 0)}),
+                 std::runtime_error);
+    const std::shared_ptr<CartesianGrid> other_grid =
+        std::make_shared<CartesianGrid>(std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 10, 12, 8);
+    EXPECT_THROW(ReadCheckpoint(directory, {std::make_shared<Field>("u", other_grid, FieldGridStagger::IFace, 1, 0)}),
+                 std::runtime_error);
+
+    // A corrupted value fails its checksum
+    amrex::ParallelDescriptor::Barrier();
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        std::fstream file(CheckpointRankFilename(directory, amrex::ParallelDescriptor::MyProc()),
+                          std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(17);
+        file.put('\x7f');
+    }
+    amrex::ParallelDescriptor::Barrier();
+    EXPECT_THROW(ReadCheckpoint(directory, MakeFields(box_decomposition, false)), std::runtime_error);
+
+    // And a checkpoint without its Header is incomplete
+    amrex::ParallelDescriptor::Barrier();
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        std::filesystem::remove(directory + "/Header");
+    }
+    amrex::ParallelDescriptor::Barrier();
+    EXPECT_THROW(ReadCheckpoint(directory, fields), std::runtime_error);
+}
@@ -0,0 +1,289 @@
+#include "column_solver.h"
+
+#include <AMReX.H>
+#include <AMReX_Arena.H>
+#include <AMReX_Extension.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MultiFab.H>
+
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+
+#include "column_utils.h"
+#include "field.h"
+#include "staggered_field.h"
+
+namespace turbo
+{
+
+namespace
+{
+
+// Components of the work array of the elimination
+constexpr int kInversePivot  = 0; /**< 1 / (diagonal(k) - lower(k) modified_upper(k - 1)) */
+constexpr int kModifiedLower = 1; /**< lower(k) / pivot(k) */
+constexpr int kModifiedUpper = 2; /**< upper(k) / pivot(k) */
+constexpr int kNWork         = 3;
+
+/**
+ * @brief Check that the coefficients and mask of a solve have the layout of the solution, the coefficients have one
+ * component, and the boxes of the solution contain whole columns.
+ * @param solution Right-hand side and solution.
+ * @param coefficients Lower, diagonal and upper coefficients.
+ * @param mask Mask, or null.
+ * @throws std::invalid_argument if a field does not match or a box does not contain whole columns.
+ */
+template <FieldGridStagger S>
+void CheckColumnOperands(const StaggeredField<S>& solution, const std::initializer_list<const Field*> coefficients,
+                         const Field* mask)
+{
+    const Field& output   = *solution.GetField();
+    const int n_ghost     = 0;
+    const int n_component = 1;
+    for (const Field* coefficient : coefficients)
+    {
+        CheckOperand("SolveTridiagonalColumns", output, *coefficient, n_ghost, n_component);
+    }
+    if (mask)
+    {
+        CheckOperand("SolveTridiagonalColumns", output, *mask);
+    }
+
+    CheckWholeColumns("SolveTridiagonalColumns", output);
+}
+
+/**
+ * @brief Eliminate the lower coefficient of row k of a column and store the modified row in the work array.
+ *
+ * Dry columns get the identity, which leaves their solution unchanged. The work array of the row is read at k - 1,
+ * so the levels of a column are eliminated in order.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void EliminateRow(const int i, const int j, const int k, const int j_work,
+                                                           const bool wet, const bool first, const bool last,
+                                                           const amrex::Array4<const amrex::Real>& lower,
+                                                           const amrex::Array4<const amrex::Real>& diagonal,
+                                                           const amrex::Array4<const amrex::Real>& upper,
+                                                           const amrex::Array4<amrex::Real>& work) noexcept
+{
+    const amrex::Real a              = (wet && !first) ? lower(i, j, k) : 0.0;
+    const amrex::Real b              = wet ? diagonal(i, j, k) : 1.0;
+    const amrex::Real c              = (wet && !last) ? upper(i, j, k) : 0.0;
+    const amrex::Real previous_upper = first ? 0.0 : work(i, j_work, k - 1, kModifiedUpper);
+    const amrex::Real inverse_pivot  = 1.0 / (b - a * previous_upper);
+    work(i, j_work, k, kInversePivot)  = inverse_pivot;
+    work(i, j_work, k, kModifiedLower) = a * inverse_pivot;
+    work(i, j_work, k, kModifiedUpper) = c * inverse_pivot;
+}
+
+/**
+ * @brief Forward substitution of row k of component n of a column, in place.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void ForwardStep(const int i, const int j, const int k, const int n,
+                                                          const int j_work, const bool first,
+                                                          const amrex::Array4<const amrex::Real>& work,
+                                                          const amrex::Array4<amrex::Real>& x) noexcept
+{
+    const amrex::Real previous = first ? 0.0 : x(i, j, k - 1, n);
+    x(i, j, k, n) = x(i, j, k, n) * work(i, j_work, k, kInversePivot) - work(i, j_work, k, kModifiedLower) * previous;
+}
+
+/**
+ * @brief Back substitution of row k of component n of a column, in place, for every row but the last.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void BackwardStep(const int i, const int j, const int k, const int n,
+                                                           const int j_work,
+                                                           const amrex::Array4<const amrex::Real>& work,
+                                                           const amrex::Array4<amrex::Real>& x) noexcept
+{
+    x(i, j, k, n) -= work(i, j_work, k, kModifiedUpper) * x(i, j, k + 1, n);
+}
+
+/**
+ * @brief Solve all columns, with or without a mask, see SolveTridiagonalColumns.
+ */
+template <FieldGridStagger S, bool kMasked>
+void Solve(const StaggeredField<S>& lower, const StaggeredField<S>& diagonal, const StaggeredField<S>& upper,
+           const StaggeredField<S>& solution, const Field* mask)
+{
+    CheckColumnOperands(solution, {lower.GetField().get(), diagonal.GetField().get(), upper.GetField().get()}, mask);
+
+    const amrex::MFItInfo info = ColumnTiling();
+    amrex::MultiFab& x_mf = solution.GetMultiFab();
+    const int n_component = x_mf.nComp();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(x_mf, info); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box tile                      = mfi.tilebox();
+        const amrex::Array4<amrex::Real> x         = x_mf.array(mfi);
+        const amrex::Array4<const amrex::Real> a   = lower.GetMultiFab().const_array(mfi);
+        const amrex::Array4<const amrex::Real> b   = diagonal.GetMultiFab().const_array(mfi);
+        const amrex::Array4<const amrex::Real> c   = upper.GetMultiFab().const_array(mfi);
+        const amrex::Array4<const amrex::Real> wet = kMasked ? mask->multifab->const_array(mfi) : b;
+        const int i_first                          = tile.smallEnd(0);
+        const int i_last                           = tile.bigEnd(0);
+        const int k_first                          = tile.smallEnd(2);
+        const int k_last                           = tile.bigEnd(2);
+
+        if (amrex::Gpu::inLaunchRegion())
+        {
+            // One thread per column, sweeping along k
+            amrex::FArrayBox work_fab(tile, kNWork, amrex::The_Async_Arena());
+            const amrex::Array4<amrex::Real> work = work_fab.array();
+            amrex::Box columns                    = tile;
+            columns.setBig(2, k_first);
+            amrex::ParallelFor(columns,
+                               [=] AMREX_GPU_DEVICE(int i, int j, int)
+                               {
+                                   if (kMasked && wet(i, j, k_first, 0) == 0.0)
+                                   {
+                                       return;
+                                   }
+                                   for (int k = k_first; k <= k_last; ++k)
+                                   {
+                                       EliminateRow(i, j, k, j, true, k == k_first, k == k_last, a, b, c, work);
+                                   }
+                                   for (int n = 0; n < n_component; ++n)
+                                   {
+                                       for (int k = k_first; k <= k_last; ++k)
+                                       {
+                                           ForwardStep(i, j, k, n, j, k == k_first, work, x);
+                                       }
+                                       for (int k = k_last - 1; k >= k_first; --k)
+                                       {
+                                           BackwardStep(i, j, k, n, j, work, x);
+                                       }
+                                   }
+                               });
+            continue;
+        }
+
+        // One row of columns at a time, see ColumnTiling. The work array of a row stays in cache for all components.
+        amrex::Box row = tile;
+        row.setSmall(1, 0);
+        row.setBig(1, 0);
+        amrex::FArrayBox work_fab(row, kNWork, amrex::The_Async_Arena());
+        const amrex::Array4<amrex::Real> work = work_fab.array();
+        const int j_work                      = 0;
+        for (int j = tile.smallEnd(1); j <= tile.bigEnd(1); ++j)
+        {
+            // Skip the dry columns at both ends of the row, and the row if it is all land
+            int i_begin = i_first;
+            int i_end   = i_last;
+            if constexpr (kMasked)
+            {
+                while (i_begin <= i_end && wet(i_begin, j, k_first, 0) == 0.0)
+                {
+                    ++i_begin;
+                }
+                while (i_end >= i_begin && wet(i_end, j, k_first, 0) == 0.0)
+                {
+                    --i_end;
+                }
+            }
+            if (i_begin > i_end)
+            {
+                continue;
+            }
+
+            for (int k = k_first; k <= k_last; ++k)
+            {
+                AMREX_PRAGMA_SIMD
+                for (int i = i_begin; i <= i_end; ++i)
+                {
+                    const bool is_wet = !kMasked || wet(i, j, k_first, 0) != 0.0;
+                    EliminateRow(i, j, k, j_work, is_wet, k == k_first, k == k_last, a, b, c, work);
+                }
+            }
+            for (int n = 0; n < n_component; ++n)
+            {
+                for (int k = k_first; k <= k_last; ++k)
+                {
+                    AMREX_PRAGMA_SIMD
+                    for (int i = i_begin; i <= i_end; ++i)
+                    {
+                        ForwardStep(i, j, k, n, j_work, k == k_first, work, x);
+                    }
+                }
+                for (int k = k_last - 1; k >= k_first; --k)
+                {
+                    AMREX_PRAGMA_SIMD
+                    for (int i = i_begin; i <= i_end; ++i)
+                    {
+                        BackwardStep(i, j, k, n, j_work, work, x);
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+template <FieldGridStagger S>
+void SolveTridiagonalColumns(const StaggeredField<S>& lower, const StaggeredField<S>& diagonal,
+                             const StaggeredField<S>& upper, const StaggeredField<S>& solution)
+{
+    const bool masked = false;
+    Solve<S, masked>(lower, diagonal, upper, solution, nullptr);
+}
+
+template <FieldGridStagger S>
+void SolveTridiagonalColumns(const StaggeredField<S>& lower, const StaggeredField<S>& diagonal,
+                             const StaggeredField<S>& upper, const StaggeredField<S>& solution,
+                             const StaggeredField<S>& mask)
+{
+    const bool masked = true;
+    Solve<S, masked>(lower, diagonal, upper, solution, mask.GetField().get());
+}
+
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::Nodal>&,
+                                      const StaggeredField<FieldGridStagger::Nodal>&,
+                                      const StaggeredField<FieldGridStagger::Nodal>&,
+                                      const StaggeredField<FieldGridStagger::Nodal>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::Nodal>&,
+                                      const StaggeredField<FieldGridStagger::Nodal>&,
+                                      const StaggeredField<FieldGridStagger::Nodal>&,
+                                      const StaggeredField<FieldGridStagger::Nodal>&,
+                                      const StaggeredField<FieldGridStagger::Nodal>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::CellCentered>&,
+                                      const StaggeredField<FieldGridStagger::CellCentered>&,
+                                      const StaggeredField<FieldGridStagger::CellCentered>&,
+                                      const StaggeredField<FieldGridStagger::CellCentered>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::CellCentered>&,
+                                      const StaggeredField<FieldGridStagger::CellCentered>&,
+                                      const StaggeredField<FieldGridStagger::CellCentered>&,
+                                      const StaggeredField<FieldGridStagger::CellCentered>&,
+                                      const StaggeredField<FieldGridStagger::CellCentered>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::IFace>&,
+                                      const StaggeredField<FieldGridStagger::IFace>&,
+                                      const StaggeredField<FieldGridStagger::IFace>&,
+                                      const StaggeredField<FieldGridStagger::IFace>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::IFace>&,
+                                      const StaggeredField<FieldGridStagger::IFace>&,
+                                      const StaggeredField<FieldGridStagger::IFace>&,
+                                      const StaggeredField<FieldGridStagger::IFace>&,
+                                      const StaggeredField<FieldGridStagger::IFace>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::JFace>&,
+                                      const StaggeredField<FieldGridStagger::JFace>&,
+                                      const StaggeredField<FieldGridStagger::JFace>&,
+                                      const StaggeredField<FieldGridStagger::JFace>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::JFace>&,
+                                      const StaggeredField<FieldGridStagger::JFace>&,
+                                      const StaggeredField<FieldGridStagger::JFace>&,
+                                      const StaggeredField<FieldGridStagger::JFace>&,
+                                      const StaggeredField<FieldGridStagger::JFace>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::KFace>&,
+                                      const StaggeredField<FieldGridStagger::KFace>&,
+                                      const StaggeredField<FieldGridStagger::KFace>&,
+                                      const StaggeredField<FieldGridStagger::KFace>&);
+template void SolveTridiagonalColumns(const StaggeredField<FieldGridStagger::KFace>&,
+                                      const StaggeredField<FieldGridStagger::KFace>&,
+                                      const StaggeredField<FieldGridStagger::KFace>&,
+                                      const StaggeredField<FieldGridStagger::KFace>&,
+                                      const StaggeredField<FieldGridStagger::KFace>&);
+
+}  // namespace turbo
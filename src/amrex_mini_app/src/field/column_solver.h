@@ -0,0 +1,58 @@
+#pragma once
+
+#include "field.h"
+#include "staggered_field.h"
+
+namespace turbo
+{
+
+/**
+ * @brief Solve one tridiagonal system along k in every column of a field, e.g. for implicit vertical diffusion and
+ * viscosity, with the Thomas algorithm.
+ *
+ * Row k of the system of a column is lower(k) x(k - 1) + diagonal(k) x(k) + upper(k) x(k + 1) = rhs(k), where
+ * lower is not used on the first level of the column and upper not on the last. The coefficients have one component,
+ * shared by all components of the right-hand side: the elimination is computed once per column and applied to every
+ * component, so e.g. all tracers with the same diffusivity are solved in one call. The system is assumed to be
+ * solvable without pivoting, as the diagonally dominant systems of implicit diffusion are.
+ *
+ * All columns of a box are solved at once. On the CPU the tiles of the boxes are spread over the OpenMP threads and
+ * the sweeps along k are vectorized across i, so neighboring columns share the SIMD lanes; on the GPU every column is
+ * a thread. Every box must contain whole columns, as the boxes of a MOM-style layout do; with chunking, max_box_size
+ * in k must be at least the number of levels.
+ *
+ * @tparam S Location of the field on the grid.
+ * @param lower Coefficient of x(k - 1), one component.
+ * @param diagonal Coefficient of x(k), one component.
+ * @param upper Coefficient of x(k + 1), one component.
+ * @param solution Right-hand side on input, solution on output, on the valid points.
+ * @throws std::invalid_argument if the fields do not share the layout of the solution, a coefficient has more than
+ * one component, or a box does not contain whole columns.
+ */
+template <FieldGridStagger S>
+void SolveTridiagonalColumns(const StaggeredField<S>& lower, const StaggeredField<S>& diagonal,
+                             const StaggeredField<S>& upper, const StaggeredField<S>& solution);
+
+/**
+ * @brief Solve the tridiagonal system of every wet column of a field, see SolveTridiagonalColumns above.
+ *
+ * A column is dry (land) where the first component of the mask is zero on the first level of the column, the surface
+ * layer in MOM's convention. Dry columns are skipped and their solution is left unchanged, so their coefficients may
+ * be anything, e.g. zero. Columns shallower than the grid are solved over all levels: set the rows below the bottom
+ * to the identity (diagonal 1, lower and upper 0) and the upper coefficient of the bottom level to 0.
+ *
+ * @tparam S Location of the field on the grid.
+ * @param lower Coefficient of x(k - 1), one component.
+ * @param diagonal Coefficient of x(k), one component.
+ * @param upper Coefficient of x(k + 1), one component.
+ * @param solution Right-hand side on input, solution on output, on the valid points.
+ * @param mask Wet (nonzero) or dry (zero) columns.
+ * @throws std::invalid_argument if the fields do not share the layout of the solution, a coefficient has more than
+ * one component, or a box does not contain whole columns.
+ */
+template <FieldGridStagger S>
+void SolveTridiagonalColumns(const StaggeredField<S>& lower, const StaggeredField<S>& diagonal,
+                             const StaggeredField<S>& upper, const StaggeredField<S>& solution,
+                             const StaggeredField<S>& mask);
+
+}  // namespace turbo
@@ -0,0 +1,144 @@
+#include "column_solver.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "field_test_utils.h"
+#include "staggered_field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for column solver tests
+//---------------------------------------------------------------------------//
+
+class ColumnSolverTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override { grid = MakeTestGrid(n_level); }
+
+    /**
+     * @brief Make a field and set its valid points to a function of the indices and the component.
+     */
+    template <FieldGridStagger S>
+    StaggeredField<S> MakeField(const Field::NameType& name, const PointFunction& function, const int n_component = 1,
+                                const BoxDecomposition& layout = MakeTestBoxDecomposition(n_level)) const
+    {
+        const StaggeredField<S> field(name, grid, n_component, 0, FoldParity::Scalar, layout);
+        FillField(field, function);
+        return field;
+    }
+
+    /**
+     * @brief Solve a diagonally dominant system with a known solution in every column of a field of stagger S and
+     * get the largest error of the solution.
+     */
+    template <FieldGridStagger S>
+    double SolveKnownSolution(const int n_component) const
+    {
+        const int k_last = StaggerTraits<S>::Domain(*grid).bigEnd(2);
+
+        // Implicit diffusion with a diffusivity that varies in all directions
+        const PointFunction lower    = [](int i, int j, int k, int) { return -0.5 - 0.1 * i - 0.05 * j * k; };
+        const PointFunction upper    = [](int i, int j, int k, int) { return -0.7 - 0.02 * i * k - 0.1 * j; };
+        const PointFunction diagonal = [&](int i, int j, int k, int n)
+        { return 1.0 - lower(i, j, k, n) - upper(i, j, k, n); };
+        const PointFunction exact    = [](int i, int j, int k, int n)
+        { return std::sin(i + 0.3 * j) + 0.1 * k * k - n; };
+        const PointFunction rhs      = [&](int i, int j, int k, int n)
+        {
+            double value = diagonal(i, j, k, n) * exact(i, j, k, n);
+            if (k > 0)
+            {
+                value += lower(i, j, k, n) * exact(i, j, k - 1, n);
+            }
+            if (k < k_last)
+            {
+                value += upper(i, j, k, n) * exact(i, j, k + 1, n);
+            }
+            return value;
+        };
+
+        const StaggeredField<S> solution = MakeField<S>("solution", rhs, n_component);
+        SolveTridiagonalColumns(MakeField<S>("lower", lower), MakeField<S>("diagonal", diagonal),
+                                MakeField<S>("upper", upper), solution);
+        return MaxError(solution, exact);
+    }
+
+    static constexpr int n_level = 5;
+    std::shared_ptr<CartesianGrid> grid;
+};
+
+//---------------------------------------------------------------------------//
+// Column solver tests
+//---------------------------------------------------------------------------//
+
+TEST_F(ColumnSolverTest, KnownSolution)
+{
+    EXPECT_LT(SolveKnownSolution<FieldGridStagger::CellCentered>(1), 1.0e-12);
+    EXPECT_LT(SolveKnownSolution<FieldGridStagger::CellCentered>(3), 1.0e-12);
+    EXPECT_LT(SolveKnownSolution<FieldGridStagger::IFace>(2), 1.0e-12);
+    EXPECT_LT(SolveKnownSolution<FieldGridStagger::KFace>(2), 1.0e-12);
+}
+
+TEST_F(ColumnSolverTest, Mask)
+{
+    // Dry columns, here every third column and the whole row j = 2, have a singular system and are left unchanged
+    auto is_wet                  = [](int i, int j) { return i % 3 != 1 && j != 2; };
+    const PointFunction mask     = [&](int i, int j, int, int) { return is_wet(i, j) ? 1.0 : 0.0; };
+    const PointFunction lower    = [&](int i, int j, int, int) { return is_wet(i, j) ? -1.0 : 0.0; };
+    const PointFunction upper    = lower;
+    const PointFunction diagonal = [&](int i, int j, int, int) { return is_wet(i, j) ? 3.0 : 0.0; };
+    const PointFunction exact    = [](int i, int j, int k, int n) { return 1.0 + i - 0.5 * j + k + 10.0 * n; };
+    const PointFunction rhs      = [&](int i, int j, int k, int n)
+    {
+        if (!is_wet(i, j))
+        {
+            return -99.0;
+        }
+        double value = 3.0 * exact(i, j, k, n);
+        value -= k > 0 ? exact(i, j, k - 1, n) : 0.0;
+        value -= k < n_level - 1 ? exact(i, j, k + 1, n) : 0.0;
+        return value;
+    };
+
+    const auto solution = MakeField<FieldGridStagger::CellCentered>("solution", rhs, 2);
+    SolveTridiagonalColumns(MakeField<FieldGridStagger::CellCentered>("lower", lower),
+                            MakeField<FieldGridStagger::CellCentered>("diagonal", diagonal),
+                            MakeField<FieldGridStagger::CellCentered>("upper", upper), solution,
+                            MakeField<FieldGridStagger::CellCentered>("mask", mask));
+    EXPECT_LT(MaxError(solution, [&](int i, int j, int k, int n) { return is_wet(i, j) ? exact(i, j, k, n) : -99.0; }),
+              1.0e-12);
+}
+
+TEST_F(ColumnSolverTest, Errors)
+{
+    // The checks themselves are tested with CheckOperand and CheckWholeColumns, these are the ones the solver applies
+    const PointFunction one = [](int, int, int, int) { return 1.0; };
+    const auto solution     = MakeField<FieldGridStagger::CellCentered>("solution", one, 2);
+    const auto scalar       = MakeField<FieldGridStagger::CellCentered>("scalar", one);
+    const auto split        = MakeField<FieldGridStagger::CellCentered>("split", one, 1, MakeTestBoxDecomposition(2));
+
+    // Coefficients with several components
+    EXPECT_THROW(SolveTridiagonalColumns(scalar, solution, scalar, solution), std::invalid_argument);
+
+    // A mask on another layout
+    EXPECT_THROW(SolveTridiagonalColumns(scalar, scalar, scalar, solution, split), std::invalid_argument);
+
+    // Columns split over boxes
+    EXPECT_THROW(SolveTridiagonalColumns(split, split, split, split), std::invalid_argument);
+
+    const auto diagonal = MakeField<FieldGridStagger::CellCentered>("diagonal", [](int, int, int, int) { return 3.0; });
+    EXPECT_NO_THROW(SolveTridiagonalColumns(scalar, diagonal, scalar, solution));
+}
@@ -0,0 +1,58 @@
+#include "column_utils.h"
+
+#include <AMReX.H>
+#include <AMReX_MFIter.H>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "box_decomposition.h"
+#include "field.h"
+
+namespace turbo
+{
+
+void CheckWholeColumns(const std::string& function, const Field& field)
+{
+    // Compared in cells, so the extra level of the KFace and Nodal staggers does not matter
+    const amrex::Box cell_domain     = CellDomain(*field.grid);
+    const amrex::BoxArray& box_array = field.multifab->boxArray();
+    for (int box_index = 0; box_index < static_cast<int>(box_array.size()); ++box_index)
+    {
+        const amrex::Box box = amrex::enclosedCells(box_array[box_index]);
+        if (box.smallEnd(2) != cell_domain.smallEnd(2) || box.bigEnd(2) != cell_domain.bigEnd(2))
+        {
+            throw std::invalid_argument(function + ": Box " + std::to_string(box_index) + " of field '" + field.name +
+                                        "' does not contain whole columns, use a box decomposition with max_box_size "
+                                        "in k of at least the number of levels.");
+        }
+    }
+}
+
+amrex::MFItInfo ColumnTiling()
+{
+    // Wider than any box, so the tiles are not split in i and k
+    const int whole_extent = 1024000;
+    const int tile_size_j  = 8;
+    amrex::MFItInfo info;
+    if (amrex::TilingIfNotGPU())
+    {
+        info.EnableTiling(amrex::IntVect(AMREX_D_DECL(whole_extent, tile_size_j, whole_extent))).SetDynamic(true);
+    }
+    return info;
+}
+
+BoxDecomposition WholeColumnDecomposition(const BoxDecomposition& box_decomposition, const int n_level)
+{
+    BoxDecomposition whole_columns = box_decomposition;
+    if (!whole_columns.UsesLayout())
+    {
+        const int blocking_factor     = whole_columns.blocking_factor[2];
+        whole_columns.max_box_size[2] = std::max(whole_columns.max_box_size[2],
+                                                 (n_level + blocking_factor - 1) / blocking_factor * blocking_factor);
+    }
+    return whole_columns;
+}
+
+}  // namespace turbo
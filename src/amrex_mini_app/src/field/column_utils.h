@@ -0,0 +1,45 @@
+#pragma once
+
+#include <AMReX_MFIter.H>
+
+#include <string>
+
+#include "box_decomposition.h"
+#include "field.h"
+
+namespace turbo
+{
+
+/**
+ * @brief Check that every box of a field contains whole columns, i.e. spans all levels of the grid, as the column
+ * operations (SolveTridiagonalColumns, RemapColumns) need to run every column on one rank and in one tile.
+ * @param function Name of the operation, for the error message.
+ * @param field Field the operation loops over.
+ * @throws std::invalid_argument if a box does not contain whole columns.
+ */
+void CheckWholeColumns(const std::string& function, const Field& field);
+
+/**
+ * @brief Get the tiling of a loop over whole columns.
+ *
+ * The tiles split the boxes in j only, so every tile contains whole columns with all of their i in a row, and a
+ * kernel can sweep the levels of a row of columns at a time. On the GPU every box is a single tile.
+ *
+ * @return Iterator options for amrex::MFIter.
+ */
+amrex::MFItInfo ColumnTiling();
+
+/**
+ * @brief Make a box decomposition whose boxes contain whole columns of a grid with a number of levels, see
+ * CheckWholeColumns.
+ *
+ * With chunking, max_box_size in k is raised to the number of levels, rounded up to the blocking factor. A MOM-style
+ * layout always spans all levels and is returned unchanged.
+ *
+ * @param box_decomposition Decomposition to start from.
+ * @param n_level Number of levels of the grid.
+ * @return The box decomposition.
+ */
+BoxDecomposition WholeColumnDecomposition(const BoxDecomposition& box_decomposition, const int n_level);
+
+}  // namespace turbo
@@ -0,0 +1,53 @@
+#include "column_utils.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Column utility tests
+//---------------------------------------------------------------------------//
+
+TEST(ColumnUtilsTest, WholeColumnDecomposition)
+{
+    // max_box_size in k is raised to the number of levels, rounded up to the blocking factor, never lowered
+    const BoxDecomposition chunked =
+        BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(16, 16, 16)), amrex::IntVect(AMREX_D_DECL(1, 1, 4)));
+    EXPECT_EQ(WholeColumnDecomposition(chunked, 75).max_box_size, amrex::IntVect(AMREX_D_DECL(16, 16, 76)));
+    EXPECT_EQ(WholeColumnDecomposition(chunked, 8).max_box_size, amrex::IntVect(AMREX_D_DECL(16, 16, 16)));
+    EXPECT_EQ(WholeColumnDecomposition(chunked, 75).blocking_factor, chunked.blocking_factor);
+
+    const BoxDecomposition layout = BoxDecomposition::Layout(4, 2);
+    EXPECT_EQ(WholeColumnDecomposition(layout, 75), layout);
+}
+
+TEST(ColumnUtilsTest, CheckWholeColumns)
+{
+    const int n_level = 22;
+    const std::shared_ptr<CartesianGrid> grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 8, 6, n_level);
+    const BoxDecomposition split = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(4, 3, 8)));
+    const BoxDecomposition whole = WholeColumnDecomposition(split, n_level);
+
+    // The extra level of the k faces belongs to the columns as well
+    for (const FieldGridStagger stagger : {FieldGridStagger::CellCentered, FieldGridStagger::KFace})
+    {
+        const Field whole_columns("whole_columns", grid, stagger, 1, 0, FoldParity::Scalar, whole);
+        EXPECT_NO_THROW(CheckWholeColumns("Test", whole_columns));
+        const Field split_columns("split_columns", grid, stagger, 1, 0, FoldParity::Scalar, split);
+        EXPECT_THROW(CheckWholeColumns("Test", split_columns), std::invalid_argument);
+    }
+}
@@ -1,15 +1,24 @@
 #pragma once
 
 #include <AMReX.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_MultiFab.H>
 #include <hdf5.h>
 
+#include <array>
 #include <cstddef>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "box_decomposition.h"
+#include "cartesian_grid_view.h"
 #include "grid.h"
+#include "hdf5_options.h"
+#include "tripolar_fold.h"
 
 namespace turbo
 {
@@ -52,6 +61,222 @@ inline std::string FieldGridStaggerToString(FieldGridStagger field_grid_stagger)
     }
 }
 
+/**
+ * @enum HDF5WriteMode
+ * @brief Specifies how the distributed field data gets into an HDF5 file.
+ */
+enum class HDF5WriteMode
+{
+    Gather,     /**< Gather the whole field onto the IO processor, which writes the dataset by itself. */
+    Collective, /**< Every rank writes its own boxes into the shared dataset with MPI-IO. Requires parallel HDF5. */
+    FilePerRank /**< Every rank writes its own boxes into its own file, see HDF5RankFilename, and the IO processor
+                     writes a master file with a virtual dataset of the whole field stitched from the boxes. */
+};
+
+/**
+ * @brief Convert a HDF5WriteMode enum value to a string. Useful for debugging and logging.
+ * @param mode The HDF5WriteMode value to convert.
+ * @return String representation of the write mode.
+ * @throws std::invalid_argument if the value is invalid.
+ */
+inline std::string HDF5WriteModeToString(HDF5WriteMode mode)
+{
+    switch (mode)
+    {
+        case HDF5WriteMode::Gather:
+            return "Gather";
+        case HDF5WriteMode::Collective:
+            return "Collective";
+        case HDF5WriteMode::FilePerRank:
+            return "FilePerRank";
+        default:
+            throw std::invalid_argument("HDF5WriteModeToString Invalid HDF5WriteMode specified.");
+    }
+}
+
+/**
+ * @enum HDF5ReadMode
+ * @brief Specifies how the ranks read their part of a field from an HDF5 file.
+ */
+enum class HDF5ReadMode
+{
+    Independent, /**< Every rank opens the file by itself and reads the hyperslabs of its own boxes. */
+    Collective   /**< Every rank reads its hyperslabs in collective MPI-IO reads. Requires parallel HDF5. */
+};
+
+/**
+ * @brief Convert a HDF5ReadMode enum value to a string. Useful for debugging and logging.
+ * @param mode The HDF5ReadMode value to convert.
+ * @return String representation of the read mode.
+ * @throws std::invalid_argument if the value is invalid.
+ */
+inline std::string HDF5ReadModeToString(HDF5ReadMode mode)
+{
+    switch (mode)
+    {
+        case HDF5ReadMode::Independent:
+            return "Independent";
+        case HDF5ReadMode::Collective:
+            return "Collective";
+        default:
+            throw std::invalid_argument("HDF5ReadModeToString Invalid HDF5ReadMode specified.");
+    }
+}
+
+/**
+ * @brief Create an HDF5 file (overwrites file if exists) that can be passed to the WriteHDF5 functions for the given
+ * mode. Must be called by all ranks.
+ *
+ * For HDF5WriteMode::Gather only the IO processor creates the file and every other rank gets H5I_INVALID_HID.
+ * For HDF5WriteMode::Collective every rank opens the file through the MPI-IO driver.
+ * For HDF5WriteMode::FilePerRank every rank creates its own file, named HDF5RankFilename(filename, rank). The master
+ * file is written separately, see Field::CreateHDF5VirtualDataset.
+ *
+ * @param filename Name of the HDF5 file to create.
+ * @param mode Write mode the file will be used with.
+ * @return HDF5 file identifier, or H5I_INVALID_HID on ranks that do not take part in the write.
+ * @throws std::runtime_error if the file cannot be created or the mode is not supported by the HDF5 library.
+ */
+hid_t CreateHDF5File(const std::string& filename, const HDF5WriteMode mode);
+
+/**
+ * @brief Get the name of the file a rank writes in HDF5WriteMode::FilePerRank, next to the master file.
+ * @param filename Name of the master file, e.g. "output.h5".
+ * @param rank Rank writing the file.
+ * @return Name of the file of the rank, e.g. "output.rank00003.h5".
+ */
+std::string HDF5RankFilename(const std::string& filename, const int rank);
+
+/**
+ * @brief Write a new HDF5 file (overwrites file if exists) in the given mode, and wait until it is complete. Must be
+ * called by all ranks.
+ *
+ * Creates the file with CreateHDF5File, writes it and closes it. For HDF5WriteMode::FilePerRank the IO processor
+ * then writes the master file next to the files of the ranks. The file is closed if a write throws.
+ *
+ * @param filename Name of the HDF5 file to write.
+ * @param mode Write mode of the file.
+ * @param write Writes the data, called by all ranks with the file from CreateHDF5File (H5I_INVALID_HID on ranks that
+ * do not take part in the write).
+ * @param write_master_file Writes the master file of HDF5WriteMode::FilePerRank, called on the IO processor only.
+ * @throws std::runtime_error if the file cannot be created, or any exception thrown by the writes.
+ */
+void WriteHDF5File(const std::string& filename, const HDF5WriteMode mode, const std::function<void(hid_t)>& write,
+                   const std::function<void(hid_t)>& write_master_file);
+
+/**
+ * @brief Open an existing HDF5 file read-only on every rank, to be passed to the ReadHDF5 functions for the given mode.
+ * Must be called by all ranks.
+ *
+ * For HDF5ReadMode::Independent every rank opens the file with the default driver.
+ * For HDF5ReadMode::Collective every rank opens the file through the MPI-IO driver.
+ * A file written earlier in the run must have been closed by its writer first, e.g. followed by a barrier.
+ *
+ * @param filename Name of the HDF5 file to open.
+ * @param mode Read mode the file will be used with.
+ * @return HDF5 file identifier.
+ * @throws std::runtime_error if the file cannot be opened or the mode is not supported by the HDF5 library.
+ */
+hid_t OpenHDF5File(const std::string& filename, const HDF5ReadMode mode);
+
+/**
+ * @struct HDF5CoordinateAxis
+ * @brief Coordinates of the points of reduced output data in one direction, see HDF5DatasetLayout.
+ */
+struct HDF5CoordinateAxis
+{
+    //-----------------------------------------------------------------------//
+    // Public Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Name of the dataset of the axis: "x", "y" or "z".
+     */
+    std::string name;
+
+    /**
+     * @brief Dimensions of the dataset: the number of points in the direction of the axis if the coordinate only
+     * depends on its own index, which makes the axis a dimension scale, otherwise the (i, j, k) numbers of points.
+     */
+    std::vector<hsize_t> dims;
+
+    /**
+     * @brief Coordinates of the points, in row-major order.
+     */
+    std::vector<double> values;
+};
+
+/**
+ * @struct HDF5DatasetLayout
+ * @brief Everything writing the dataset of a field needs besides the data, see Field::GetHDF5DatasetLayout.
+ *
+ * The layout is plain data, taken from the field and its storage options when it is made. Writing a dataset from it
+ * reads no field, grid or AMReX state, so it can run on another thread while the fields are updated, see
+ * AsyncHDF5Writer.
+ */
+struct HDF5DatasetLayout
+{
+    //-----------------------------------------------------------------------//
+    // Public Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Name of the dataset, the name of the field.
+     */
+    std::string name;
+
+    /**
+     * @brief Location of the field on the grid.
+     */
+    FieldGridStagger field_grid_stagger = FieldGridStagger::CellCentered;
+
+    /**
+     * @brief Name of the group of the coordinate axes of the dataset, see Field::HDF5GridLocation.
+     */
+    std::string grid_location;
+
+    /**
+     * @brief Points of the dataset, the index space of the field or of its reduced output data.
+     */
+    amrex::Box box;
+
+    /**
+     * @brief Number of components of the field.
+     */
+    int n_component = 1;
+
+    /**
+     * @brief Dimensions of the dataset, without the time dimension.
+     */
+    std::vector<hsize_t> dims;
+
+    /**
+     * @brief Chunk dimensions of the dataset, see Field::HDF5ChunkDims.
+     */
+    std::vector<hsize_t> chunk_dims;
+
+    /**
+     * @brief Storage options of the dataset. The data is already reduced, so they select no region or coarsening.
+     */
+    HDF5Options options;
+
+    /**
+     * @brief Cells of the grid that reduced output data covers, or none if the data is not reduced.
+     */
+    std::optional<std::array<int, 6>> region;
+
+    /**
+     * @brief Number of cells of the grid in one point of reduced output data in the i, j and k directions.
+     */
+    std::array<int, 3> coarsening_ratio = {1, 1, 1};
+
+    /**
+     * @brief Coordinates of the points of reduced output data, written with the first dataset of the file that needs
+     * them. Empty if the data is not reduced.
+     */
+    std::vector<HDF5CoordinateAxis> coordinates;
+};
+
 /**
  * @class Field
  * @brief Represents a physical field defined on a computational grid.
@@ -83,9 +308,36 @@ class Field
      * @param field_grid_stagger Location of the field on the grid.
      * @param n_component Number of components (e.g., 1 for a scalar field).
      * @param n_ghost Number of ghost cells.
+     * @param fold_parity How the field transforms across the fold of a TripolarGrid. Ignored on other grids.
+     * @param box_decomposition How the grid is split into boxes and distributed over the ranks.
+     * @throws std::invalid_argument if the grid is null, n_component is zero, the stagger is invalid, or the box
+     * decomposition does not fit the grid.
+     */
+    Field(const NameType& name, const std::shared_ptr<Grid>& grid, const FieldGridStagger field_grid_stagger,
+          const std::size_t n_component, const std::size_t n_ghost, const FoldParity fold_parity = FoldParity::Scalar,
+          const BoxDecomposition& box_decomposition = BoxDecomposition());
+
+    /**
+     * @brief Construct a new Field object on an existing layout.
+     *
+     * Fields built on the same BoxArray and DistributionMapping objects share one layout, so AMReX can copy and
+     * operate between them without communication and with cached communication metadata. See
+     * Domain::CreateField, which uses one layout per stagger for all its fields.
+     *
+     * @param name Name of the field.
+     * @param grid Shared pointer to the grid on which the field is defined.
+     * @param field_grid_stagger Location of the field on the grid.
+     * @param n_component Number of components (e.g., 1 for a scalar field).
+     * @param n_ghost Number of ghost cells.
+     * @param box_array Boxes of the field, with the index type of field_grid_stagger, covering the whole grid.
+     * @param distribution_mapping Distribution of the boxes over the ranks.
+     * @param fold_parity How the field transforms across the fold of a TripolarGrid. Ignored on other grids.
+     * @throws std::invalid_argument if the grid is null, n_component is zero, the stagger is invalid, or the layout
+     * does not match the stagger and the grid.
      */
     Field(const NameType& name, const std::shared_ptr<Grid>& grid, const FieldGridStagger field_grid_stagger,
-          const std::size_t n_component, const std::size_t n_ghost);
+          const std::size_t n_component, const std::size_t n_ghost, const amrex::BoxArray& box_array,
+          const amrex::DistributionMapping& distribution_mapping, const FoldParity fold_parity = FoldParity::Scalar);
 
     /**
      * @brief Check if the field is cell-centered.
@@ -130,16 +382,257 @@ class Field
     Grid::Point GetGridPoint(int i, int j, int k) const;
 
     /**
-     * @brief Write the field data to an HDF5 file (overwrites file if exists).
+     * @brief Get the grid's precomputed coordinate table for this field's stagger location.
+     *
+     * Unlike GetGridPoint, lookups into the table are unchecked and inline, so fetch the table once outside of a
+     * loop over the field and index it with valid (non-ghost) indices inside the loop.
+     *
+     * @return Coordinate table of the grid location matching field_grid_stagger.
+     */
+    const Grid::CoordinateTable& GetGridCoordinates() const;
+
+    /**
+     * @brief Get a trivially-copyable view of this field's grid location for use inside amrex::ParallelFor kernels.
+     *
+     * Capture the view by value in the kernel instead of the field, so the kernel does no virtual calls or bounds
+     * checks and can run on the device.
+     *
+     * @return View of the grid location matching field_grid_stagger.
+     * @throws std::invalid_argument if the field is not defined on a CartesianGrid.
+     */
+    CartesianGridView GetGridView() const;
+
+    /**
+     * @brief Fill the ghost cells of all components of the field from neighboring valid cells. Must be called by all
+     * ranks.
+     *
+     * On a TripolarGrid the ghost cells are filled periodically in i and across the fold at the j maximum, applying
+     * fold_parity, for every stagger. The fold communication metadata is built on the first call and reused as long as
+     * the layout of the MultiFab does not change. On other grids only ghost cells that overlap the valid cells of
+     * other boxes are filled, there are no periodic boundaries.
+     */
+    void FillBoundary();
+
+    /**
+     * @brief Start filling the ghost cells, split-phase version of FillBoundary. Must be called by all ranks.
+     *
+     * Posts the messages of the exchange with neighboring boxes (including the periodic wrap) and returns without
+     * waiting for them, so work that only reads valid data, like updating InteriorBox of each box, can overlap with
+     * the communication. The field must not be written until FillBoundaryFinish is called. On a TripolarGrid the fold
+     * row is made consistent before the messages are posted and the ghost cells beyond the fold are filled in
+     * FillBoundaryFinish.
+     *
+     * @throws std::logic_error if a fill is already in progress.
+     */
+    void FillBoundaryStart();
+
+    /**
+     * @brief Finish filling the ghost cells started by FillBoundaryStart. Must be called by all ranks.
+     * @throws std::logic_error if no fill is in progress.
+     */
+    void FillBoundaryFinish();
+
+    /**
+     * @brief Get the part of a valid box whose points are at least n_ghost points away from the box boundary in every
+     * direction, so a stencil reaching at most n_ghost points only reads valid data of the same box. This part can be
+     * updated between FillBoundaryStart and FillBoundaryFinish.
+     * @param valid_box A valid box of this field's MultiFab.
+     * @return The interior of the box, empty if the box is too small.
+     */
+    amrex::Box InteriorBox(const amrex::Box& valid_box) const;
+
+    /**
+     * @brief Get the part of a valid box outside of InteriorBox, to be updated after FillBoundaryFinish.
+     * @param valid_box A valid box of this field's MultiFab.
+     * @return Disjoint boxes covering the boundary strips of the box.
+     */
+    amrex::BoxList BoundaryBoxes(const amrex::Box& valid_box) const;
+
+    /**
+     * @brief Get the periodicity of the field's grid, used for the exchange with neighboring boxes.
+     * @return Periodic in i on a TripolarGrid, non-periodic otherwise.
+     */
+    amrex::Periodicity GetPeriodicity() const;
+
+    /**
+     * @brief First step of FillBoundary on a TripolarGrid, making the valid points on the fold row consistent. Does
+     * nothing on other grids. Only needed to split FillBoundary up, e.g. for a fused exchange of several fields.
+     * Must be called by all ranks.
+     */
+    void SyncFoldRow();
+
+    /**
+     * @brief Last step of FillBoundary on a TripolarGrid, filling the ghost cells beyond the fold after the ghost
+     * cells shared with neighboring boxes have been filled using GetPeriodicity(). Does nothing on other grids. Must be
+     * called by all ranks.
+     */
+    void FillFoldGhostCells();
+
+    /**
+     * @brief Get the part of a valid box of this field that is written out and reduced over by the box's owner.
+     *
+     * Neighboring boxes of nodal and face centered fields share the nodes/faces on their common boundary. Dropping
+     * the upper shared layer of a box, except on the domain boundary, makes the owned boxes of a field partition the
+     * domain so every point is handled by exactly one box.
+     *
+     * @param valid_box A valid box of this field's MultiFab.
+     * @return The owned part of the valid box.
+     */
+    amrex::Box OwnedBox(const amrex::Box& valid_box) const;
+
+    /**
+     * @brief Convert FieldGridStagger to AMReX IndexType.
+     * @param field_location Field location enum.
+     * @return Corresponding AMReX IndexType.
+     * @throws std::invalid_argument if the stagger is invalid.
+     */
+    static amrex::IndexType FieldGridStaggerToAMReXIndexType(const FieldGridStagger field_location);
+
+    /**
+     * @brief Write the field data to an HDF5 file (overwrites file if exists), stored as set by hdf5_options. Must be
+     * called by all ranks.
+     *
+     * If hdf5_options selects a region or a coarsening ratio, the ranks first reduce the boxes they own to the written
+     * region and resolution, so only the reduced data is gathered or written. Coarsened values are the mean of the
+     * block of cells along cell centered directions, which conserves the sum over the block on a uniform grid, and the
+     * value at the first point of the block along nodal directions, so face and node values stay on the faces and
+     * nodes of the coarse cells. The dataset gets the "region" and "coarsening_ratio" attributes, and the coordinates
+     * of its points, reduced the same way, are written next to the full grid axes (see WriteHDF5DatasetAttributes).
+     * All the other WriteHDF5, time series and gather functions reduce the data in the same way.
+     *
+     * With HDF5WriteMode::FilePerRank the ranks write their files without any communication and the IO processor
+     * writes the master file named filename, in which the field is a single virtual dataset.
+     *
+     * The call returns once the file, and with a file per rank every rank file, is closed, so any rank can read it
+     * right away.
+     *
      * @param filename Name of the HDF5 file to write.
+     * @param mode How the distributed data gets into the file.
      */
-    void WriteHDF5(const std::string& filename) const;
+    void WriteHDF5(const std::string& filename, const HDF5WriteMode mode = HDF5WriteMode::Gather) const;
 
     /**
-     * @brief Write the field data to an already open HDF5 file.
+     * @brief Write the field data to an already open HDF5 file, stored as set by hdf5_options. Must be called by all
+     * ranks.
+     * @param file_id HDF5 file identifier. Only needs to be valid on the IO processor for HDF5WriteMode::Gather and
+     * must come from a file opened with the MPI-IO driver on every rank for HDF5WriteMode::Collective (see
+     * CreateHDF5File). For HDF5WriteMode::FilePerRank it is the file of the rank, and only the boxes of the rank are
+     * written, see CreateHDF5VirtualDataset for the master file.
+     * @param mode How the distributed data gets into the file.
+     */
+    void WriteHDF5(const hid_t file_id, const HDF5WriteMode mode = HDF5WriteMode::Gather) const;
+
+    /**
+     * @brief Create the virtual dataset of the field in the master file of HDF5WriteMode::FilePerRank, mapping the
+     * owned part of every box onto its dataset in the file of the rank that owns the box. Only called on the IO
+     * processor.
+     *
+     * The virtual dataset has the dimensions and attributes of the dataset WriteHDF5 writes in the other modes, so
+     * readers see the same single array. The mapping follows from the layout of the field alone, so this needs no
+     * communication and can be written before the files of the ranks. The files of the ranks are referred to by name
+     * without directory and have to stay next to the master file.
+     *
+     * @param file_id HDF5 file identifier of the master file.
+     * @param filename Name of the master file, from which the names of the files of the ranks follow.
+     * @throws std::runtime_error if the file_id is invalid or the dataset cannot be created.
+     */
+    void CreateHDF5VirtualDataset(const hid_t file_id, const std::string& filename) const;
+
+    /**
+     * @brief Create an empty time series dataset for the field in an open HDF5 file, to which AppendHDF5 adds
+     * snapshots. Must be called by all ranks.
+     *
+     * The dataset is named after the field and has a leading unlimited time dimension before the dimensions written by
+     * WriteHDF5. It is always chunked, one snapshot per chunk at most, and otherwise stored as set by hdf5_options. If
+     * the file has a "time" dimension scale (see HDF5TimeSeries) it is attached to the time dimension.
+     *
+     * @param file_id HDF5 file identifier, see WriteHDF5 for the requirements of each mode.
+     * @param mode How the distributed data gets into the file, HDF5WriteMode::Gather or HDF5WriteMode::Collective.
+     * @throws std::invalid_argument if the mode does not support time series.
+     * @throws std::runtime_error if the file_id is invalid or the dataset cannot be created.
+     */
+    void CreateHDF5TimeSeries(const hid_t file_id, const HDF5WriteMode mode = HDF5WriteMode::Gather) const;
+
+    /**
+     * @brief Write the field data as a snapshot into the time series dataset created by CreateHDF5TimeSeries, extending
+     * the time dimension if needed. Must be called by all ranks.
+     * @param file_id HDF5 file identifier, see WriteHDF5 for the requirements of each mode.
+     * @param time_index Index of the snapshot along the time dimension.
+     * @param mode How the distributed data gets into the file, HDF5WriteMode::Gather or HDF5WriteMode::Collective.
+     * @throws std::invalid_argument if the mode does not support time series.
+     * @throws std::runtime_error if the file has no time series dataset of the field or it cannot be written.
+     */
+    void AppendHDF5(const hid_t file_id, const hsize_t time_index,
+                    const HDF5WriteMode mode = HDF5WriteMode::Gather) const;
+
+    /**
+     * @brief Read the field data from an HDF5 file written by WriteHDF5, e.g. to restart. Must be called by all ranks.
+     * @param filename Name of the HDF5 file to read.
+     * @param mode How the ranks read their part of the dataset.
+     * @param read_ghost Also read the ghost cells that lie inside the domain, see ReadHDF5 below.
+     */
+    void ReadHDF5(const std::string& filename, const HDF5ReadMode mode = HDF5ReadMode::Independent,
+                  const bool read_ghost = false);
+
+    /**
+     * @brief Read the field data from the dataset named after the field in an open HDF5 file. Must be called by all
+     * ranks.
+     *
+     * Each rank only reads the hyperslabs covering its own boxes, straight into the FAB memory for column-major
+     * datasets and through a transpose for row-major datasets, so no data passes between ranks. The dataset has to have
+     * the stagger of the field (its "field_grid_stagger" attribute), its number of components and its dimensions. The
+     * layout is taken from the "data_layout" attribute, row-major if it is missing. With read_ghost the ghost cells
+     * inside the domain are read too, which saves a FillBoundary except for periodic and fold ghost cells but reads
+     * the neighboring chunks of a chunked dataset as well.
+     *
+     * @param file_id HDF5 file identifier, open on every rank (see OpenHDF5File).
+     * @param mode How the ranks read their part of the dataset.
+     * @param read_ghost Also read the ghost cells that lie inside the domain.
+     * @param time_index If set, read this snapshot of a time series dataset (see AppendHDF5).
+     * @throws std::invalid_argument if the mode is invalid.
+     * @throws std::runtime_error if the dataset is missing, does not match the field or cannot be read.
+     */
+    void ReadHDF5(const hid_t file_id, const HDF5ReadMode mode = HDF5ReadMode::Independent,
+                  const bool read_ghost = false, const std::optional<hsize_t> time_index = std::nullopt);
+
+    /**
+     * @brief Copy the valid data of the field into a MultiFab with a single box covering the field, owned by the IO
+     * processor. Must be called by all ranks.
+     *
+     * This is the communication step of HDF5WriteMode::Gather, see WriteHDF5Gathered for the write step. The MultiFab
+     * is only (re)allocated if it is null or does not match the field, so a MultiFab kept between calls is reused.
+     *
+     * @param gathered MultiFab to copy into, allocated if needed.
+     */
+    void GatherToIOProcessor(std::shared_ptr<amrex::MultiFab>& gathered) const;
+
+    /**
+     * @brief Get the layout of the dataset of the field with its current storage options. With a region or
+     * coarsening ratio, this is the layout of the reduced data on a single box, as gathered by GatherToIOProcessor.
+     * @return The layout.
+     * @throws std::invalid_argument if the region or coarsening ratio do not fit the grid, see HDF5OutputRegion.
+     */
+    HDF5DatasetLayout GetHDF5DatasetLayout() const;
+
+    /**
+     * @brief Write a dataset from data gathered by GatherToIOProcessor. Only called on the IO processor.
+     *
+     * Does not communicate and only reads the layout and the gathered data, so it can run on another thread while the
+     * field is updated.
+     *
      * @param file_id HDF5 file identifier.
+     * @param layout Layout of the dataset, see GetHDF5DatasetLayout, taken when the data was gathered.
+     * @param gathered Data of the field gathered onto this rank.
+     * @param data Buffer for the packed data, reused between calls. Not used for column-major data without bit
+     * rounding, which is written straight from the gathered data.
+     * @param time_index If set, write the snapshot at this index of the time series dataset of the field (see
+     * AppendHDF5) instead of creating a dataset.
+     * @throws std::invalid_argument if the gathered data is not a single box of the layout on this rank.
+     * @throws std::runtime_error if the file_id is invalid or the dataset cannot be written.
      */
-    void WriteHDF5(const hid_t file_id) const;
+    static void WriteHDF5Gathered(const hid_t file_id, const HDF5DatasetLayout& layout,
+                                  const amrex::MultiFab& gathered, std::vector<double>& data,
+                                  const std::optional<hsize_t> time_index = std::nullopt);
 
     /**
      * @brief Default comparison operators for Field (pointer-based for grid).
@@ -176,31 +669,306 @@ class Field
      */
     const FieldGridStagger field_grid_stagger;
 
+    /**
+     * @brief How the field transforms across the fold of a TripolarGrid.
+     */
+    const FoldParity fold_parity;
+
     /**
      * @brief AMReX MultiFab storing the field data.
      */
     std::shared_ptr<amrex::MultiFab> multifab;
 
+    /**
+     * @brief Storage options (chunking, compression, bit rounding) of the datasets written by WriteHDF5.
+     */
+    HDF5Options hdf5_options;
+
    private:
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Fold communication metadata for the layout of multifab, shared with the other fields of that layout (see
+     * TripolarFold::ForLayout). Only used on a TripolarGrid.
+     */
+    std::shared_ptr<const TripolarFold> tripolar_fold_;
+
+    /**
+     * @brief Whether FillBoundaryStart was called without FillBoundaryFinish.
+     */
+    bool fill_boundary_in_progress_ = false;
+
+    /**
+     * @brief Region and coarsening ratio a field holding reduced output data was made with, see MakeHDF5OutputField.
+     * None for the fields of the model.
+     */
+    std::optional<HDF5Options> hdf5_selection_;
+
     //-----------------------------------------------------------------------//
     // Private Member Functions
     //-----------------------------------------------------------------------//
 
     /**
-     * @brief Convert FieldGridStagger to AMReX IndexType.
-     * @param field_location Field location enum.
-     * @return Corresponding AMReX IndexType.
+     * @brief Construct a field holding the reduced output data of another field, see MakeHDF5OutputField.
+     * @param field Field the output data is reduced from.
+     * @param output_multifab Reduced data, on 0-based boxes covering the written region at the written resolution.
+     * @param selection Options whose region (set) and coarsening ratio the data was reduced with.
+     */
+    Field(const Field& field, const std::shared_ptr<amrex::MultiFab>& output_multifab, const HDF5Options& selection);
+
+    /**
+     * @brief Get the fold communication metadata for the current layout of multifab, building it if no field of that
+     * layout has it yet.
+     * @return The fold, or null if the field is not on a TripolarGrid.
+     */
+    const TripolarFold* GetTripolarFold();
+
+    /**
+     * @brief Write the field by gathering it onto the IO processor, which writes the whole dataset.
+     * @param file_id HDF5 file identifier, only used on the IO processor.
+     * @param time_index If set, the snapshot of the time series dataset to write instead of creating a dataset.
+     */
+    void WriteHDF5Gather(const hid_t file_id, const std::optional<hsize_t> time_index = std::nullopt) const;
+
+    /**
+     * @brief Write the field with every rank writing the owned part of its boxes as hyperslabs of the dataset.
+     * @param file_id HDF5 file identifier of a file opened with the MPI-IO driver.
+     * @param time_index If set, the snapshot of the time series dataset to write instead of creating a dataset.
+     */
+    void WriteHDF5Collective(const hid_t file_id, const std::optional<hsize_t> time_index = std::nullopt) const;
+
+    /**
+     * @brief Write every local box of the field into its own dataset in the file of this rank, named as in
+     * HDF5BoxDatasetName.
+     * @param file_id HDF5 file identifier of the file of this rank.
+     */
+    void WriteHDF5FilePerRank(const hid_t file_id) const;
+
+    /**
+     * @brief Get the cell region written with the region and coarsening ratio of some options.
+     * @param options Storage options of the dataset.
+     * @return Cells of the region, the whole grid if the options have no region.
+     * @throws std::invalid_argument if the region is outside the grid or its cells do not divide evenly into blocks.
+     */
+    amrex::Box HDF5OutputRegion(const HDF5Options& options) const;
+
+    /**
+     * @brief Make the field written in place of this one when hdf5_options selects a region or a coarsening ratio.
+     *
+     * Every box of the output covers the coarse cells whose first fine cell is in the matching box of this field,
+     * and is owned by the same rank, so the reduction is local where the coarse cells do not straddle the boxes of
+     * this field. Otherwise the fine data of the output boxes is first copied to their ranks.
+     *
+     * @param fill Reduce the data of this field into the output field. Collective if set, otherwise only the layout
+     * is made, e.g. for the dataset dimensions.
+     * @return Field with the name, stagger and storage options of this field, on the reduced index space.
+     * @throws std::invalid_argument if the region or coarsening ratio do not fit the grid, see HDF5OutputRegion.
+     */
+    std::unique_ptr<Field> MakeHDF5OutputField(const bool fill) const;
+
+    /**
+     * @brief Make the layout of the dataset of data of this field on some boxes, see GetHDF5DatasetLayout.
+     * @param box_array Boxes of the data, of the field or of its reduced output data.
+     * @param options Storage options of the dataset, selecting no region or coarsening.
+     * @param selection Options whose region (set) and coarsening ratio the data was reduced with, none if it is not.
+     * @return The layout.
+     */
+    HDF5DatasetLayout MakeHDF5DatasetLayout(const amrex::BoxArray& box_array, const HDF5Options& options,
+                                            const std::optional<HDF5Options>& selection) const;
+
+    /**
+     * @brief Get the name of the group of the coordinate axes of the dataset of this field: the grid location of the
+     * stagger (e.g. "cell_center"), followed by the region and coarsening ratio of reduced output data.
+     * @param selection Options whose region (set) and coarsening ratio the data was reduced with, none if it is not.
+     * @return Group name.
+     * @throws std::invalid_argument if the stagger is invalid.
+     */
+    std::string HDF5GridLocation(const std::optional<HDF5Options>& selection) const;
+
+    /**
+     * @brief Get the coordinates of the points of reduced output data, reduced like the data. A coordinate that only
+     * depends on its own index direction is a 1D axis, otherwise it has (i, j, k) dimensions.
+     * @param selection Options whose region (set) and coarsening ratio the data was reduced with.
+     * @param output_box Points of the reduced data.
+     * @return The x, y and z axes.
+     */
+    std::vector<HDF5CoordinateAxis> HDF5OutputCoordinates(const HDF5Options& selection,
+                                                          const amrex::Box& output_box) const;
+
+    /**
+     * @brief Write the coordinates of the points of reduced output data into the group of the layout, if the file
+     * does not have it yet. 1D axes are written as dimension scales.
+     * @param file_id HDF5 file identifier.
+     * @param layout Layout of the dataset of the reduced data.
+     * @throws std::runtime_error if the coordinates cannot be written.
+     */
+    static void WriteHDF5OutputCoordinates(const hid_t file_id, const HDF5DatasetLayout& layout);
+
+    /**
+     * @brief Get the name of the dataset of a box in the file of a rank, in HDF5WriteMode::FilePerRank.
+     * @param box_index Index of the box in the BoxArray of the field.
+     * @return Path of the dataset, in a group named after the field.
+     */
+    std::string HDF5BoxDatasetName(const int box_index) const;
+
+    /**
+     * @brief Get the region of a box of the field as the start and count of a hyperslab of the whole dataset.
+     * @param box Box inside the domain of the field, e.g. an owned box (see OwnedBox).
+     * @param data_layout Order of the dataset dimensions.
+     * @param start Set to the offset of the hyperslab.
+     * @param count Set to the size of the hyperslab.
+     */
+    void HDF5Hyperslab(const amrex::Box& box, const HDF5DataLayout data_layout, std::vector<hsize_t>& start,
+                       std::vector<hsize_t>& count) const;
+
+    /**
+     * @brief Write the attributes of a dataset and attach the dimension scales of the file to it, writing the
+     * coordinates of reduced output data first (see WriteHDF5OutputCoordinates).
+     * @param file_id HDF5 file identifier.
+     * @param dataset_id HDF5 dataset identifier.
+     * @param layout Layout of the dataset.
+     * @param time_series Whether the dataset has a leading time dimension.
+     */
+    static void WriteHDF5DatasetAttributes(const hid_t file_id, const hid_t dataset_id,
+                                           const HDF5DatasetLayout& layout, const bool time_series);
+
+    /**
+     * @brief Create a dataset, including its attributes. Collective in HDF5WriteMode::Collective.
+     * @param file_id HDF5 file identifier.
+     * @param layout Layout of the dataset.
+     * @param time_series Add a leading unlimited time dimension of initial size 0, see CreateHDF5TimeSeries.
+     * @return HDF5 dataset identifier. Caller is responsible for closing it.
+     */
+    static hid_t CreateHDF5Dataset(const hid_t file_id, const HDF5DatasetLayout& layout,
+                                   const bool time_series = false);
+
+    /**
+     * @brief Open a time series dataset and extend it to include a snapshot. Collective in HDF5WriteMode::Collective.
+     * @param file_id HDF5 file identifier.
+     * @param layout Layout of one snapshot of the dataset.
+     * @param time_index Index of the snapshot to write.
+     * @return HDF5 dataset identifier. Caller is responsible for closing it.
+     * @throws std::runtime_error if the dataset does not exist, does not match the layout or cannot be extended.
+     */
+    static hid_t OpenHDF5TimeSeriesDataset(const hid_t file_id, const HDF5DatasetLayout& layout,
+                                           const hsize_t time_index);
+
+    /**
+     * @brief Open the dataset of this field to read it and check that it matches the field.
+     * @param file_id HDF5 file identifier.
+     * @param time_index If set, the snapshot of a time series dataset to read.
+     * @param data_layout Set to the layout of the dataset.
+     * @return HDF5 dataset identifier. Caller is responsible for closing it.
+     * @throws std::runtime_error if the dataset does not exist or its attributes or dimensions do not match the field.
+     */
+    hid_t OpenHDF5DatasetToRead(const hid_t file_id, const std::optional<hsize_t> time_index,
+                                HDF5DataLayout& data_layout) const;
+
+    /**
+     * @brief Read a string attribute of an HDF5 object.
+     * @param object_id HDF5 object identifier.
+     * @param attribute_name Name of the attribute.
+     * @return Value of the attribute, or nothing if the object has no such attribute.
+     * @throws std::runtime_error if the attribute is not a fixed-length string or cannot be read.
+     */
+    static std::optional<std::string> ReadHDF5StringAttribute(const hid_t object_id, const std::string& attribute_name);
+
+    /**
+     * @brief Get the file dataspace of a dataset with a hyperslab selected.
+     * @param dataset_id HDF5 dataset identifier.
+     * @param start Offset of the hyperslab, without the time dimension.
+     * @param count Size of the hyperslab, without the time dimension.
+     * @param time_index If set, select this snapshot of a time series dataset.
+     * @return HDF5 dataspace identifier. Caller is responsible for closing it.
+     */
+    static hid_t SelectHDF5FileSpace(const hid_t dataset_id, std::vector<hsize_t> start, std::vector<hsize_t> count,
+                                     const std::optional<hsize_t> time_index);
+
+    /**
+     * @brief Get the dimensions of the dataset of the whole field.
+     * @param data_layout Order of the dataset dimensions.
+     * @return Dataset dimensions, see ToHDF5Dims.
+     */
+    std::vector<hsize_t> HDF5Dims(const HDF5DataLayout data_layout) const;
+
+    /**
+     * @brief Get the chunk dimensions of a dataset: the largest number of cells of the boxes of the data in each
+     * direction and all components, limited to the dataset dimensions. Staggered data uses the cells of its boxes, so
+     * the owned points of every box start on a chunk boundary.
+     * @param box_array Boxes of the data.
+     * @param n_component Number of components of the data.
+     * @param dims Dataset dimensions.
+     * @param data_layout Order of the dataset dimensions.
+     * @return Chunk dimensions, with the rank of the dataset.
+     */
+    static std::vector<hsize_t> HDF5ChunkDims(const amrex::BoxArray& box_array, const int n_component,
+                                              const std::vector<hsize_t>& dims, const HDF5DataLayout data_layout);
+
+    /**
+     * @brief Put extents (or offsets) in each direction and the component dimension in the order of the dimensions of
+     * a dataset: (i, j, k[, component]) for row-major and ([component, ]k, j, i) for column-major data.
+     * @param ijk Extents or offsets in the i, j and k directions.
+     * @param component Extent or offset in the component dimension.
+     * @param n_component Number of components of the field. The component dimension is left out if it is 1.
+     * @param data_layout Order of the dataset dimensions.
+     * @return Dimensions, with the rank of the dataset.
+     */
+    static std::vector<hsize_t> ToHDF5Dims(const std::array<hsize_t, 3>& ijk, const hsize_t component,
+                                           const int n_component, const HDF5DataLayout data_layout);
+
+    /**
+     * @brief Create an HDF5 memory dataspace for the data of a FAB, ghost cells included, with a box of it selected.
+     * @param fab_box Box of the FAB's memory.
+     * @param box Region of the FAB to select.
+     * @param n_component Number of components of the FAB, all of them selected.
+     * @return HDF5 dataspace identifier. Caller is responsible for closing it.
+     */
+    static hid_t CreateHDF5MemorySpace(const amrex::Box& fab_box, const amrex::Box& box, const int n_component);
+
+    /**
+     * @brief Copy the data of a box into a buffer in the order of a dataset, see PackRowMajor and PackColumnMajor.
+     * @param array Data to copy.
+     * @param box Region of the data to copy.
+     * @param n_component Number of components to copy.
+     * @param data_layout Order of the data in the buffer.
+     * @param data Buffer, resized to fit the box.
+     */
+    static void Pack(const amrex::Array4<const amrex::Real>& array, const amrex::Box& box, const int n_component,
+                     const HDF5DataLayout data_layout, std::vector<double>& data);
+
+    /**
+     * @brief Copy the data of a box into a buffer in row-major (i slowest, component fastest) order. The transpose is
+     * done in cache-sized tiles, threaded with OpenMP.
+     * @param array Data to copy.
+     * @param box Region of the data to copy.
+     * @param n_component Number of components to copy.
+     * @param data Buffer, resized to fit the box.
+     */
+    static void PackRowMajor(const amrex::Array4<const amrex::Real>& array, const amrex::Box& box,
+                             const int n_component, std::vector<double>& data);
+
+    /**
+     * @brief Copy data in row-major (i slowest, component fastest) order into a box, the inverse of PackRowMajor.
+     * @param data Data to copy, the size of the box.
+     * @param box Region of the array to copy into.
+     * @param n_component Number of components to copy.
+     * @param array Data to copy into.
      */
-    amrex::IndexType FieldGridStaggerToAMReXIndexType(const FieldGridStagger field_location) const;
+    static void UnpackRowMajor(const std::vector<double>& data, const amrex::Box& box, const int n_component,
+                               const amrex::Array4<amrex::Real>& array);
 
     /**
-     * @brief Copy a MultiFab to a single MPI rank.
-     * @param source_mf Source MultiFab.
-     * @param dest_rank Destination MPI rank.
-     * @return Shared pointer to the copied MultiFab.
+     * @brief Copy the data of a box into a buffer in column-major (i fastest, component slowest) order, the order of
+     * the AMReX data. Threaded with OpenMP.
+     * @param array Data to copy.
+     * @param box Region of the data to copy.
+     * @param n_component Number of components to copy.
+     * @param data Buffer, resized to fit the box.
      */
-    std::shared_ptr<amrex::MultiFab> CopyMultiFabToSingleRank(const std::shared_ptr<amrex::MultiFab>& source_mf,
-                                                              int dest_rank) const;
+    static void PackColumnMajor(const amrex::Array4<const amrex::Real>& array, const amrex::Box& box,
+                                const int n_component, std::vector<double>& data);
 };
 
 }  // namespace turbo
@@ -0,0 +1,477 @@
+#pragma once
+
+#include <AMReX.H>
+#include <AMReX_Extension.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MultiFab.H>
+
+#include <concepts>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "field.h"
+#include "staggered_field.h"
+
+namespace turbo
+{
+
+// Lazy pointwise arithmetic on StaggeredFields. An arithmetic expression of fields and scalars, like
+// h + dt * (a * f + b * g), does not compute anything: it builds a tree of small expression objects, and Assign
+// evaluates the whole tree in one amrex::ParallelFor per tile of the output, reading every field once and writing the
+// output once instead of sweeping over memory once per operation. Fields of different staggers cannot be combined, a
+// compile error like for Copy and Saxpy. The numbers of components and the layouts are checked when the expression is
+// assigned. An expression refers to the data of its fields, so it sees changes made to them before it is assigned.
+
+/**
+ * @brief Interface of the nodes of an expression tree.
+ *
+ * A node is a scalar or has the stagger of its fields. Its Evaluator, created for every tile by Prepare, is trivially
+ * copyable, to capture by value in GPU kernels, and gives the value of component n at point (i, j, k). Check throws
+ * if the fields of the node do not match the output.
+ */
+template <typename E>
+concept ExpressionNode = std::is_trivially_copyable_v<typename E::Evaluator> &&
+                         requires(const E& node, const amrex::MFIter& mfi, const Field& output, const int n_ghost) {
+                             { E::kIsScalar } -> std::convertible_to<bool>;
+                             { node.Prepare(mfi) } -> std::same_as<typename E::Evaluator>;
+                             node.Check(output, n_ghost);
+                         };
+
+/**
+ * @brief Leaf node for a field, which reads the field at the point.
+ * @tparam S Location of the field on the grid.
+ */
+template <FieldGridStagger S>
+class FieldTerminal
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Types
+    //-----------------------------------------------------------------------//
+
+    static constexpr bool kIsScalar            = false;
+    static constexpr FieldGridStagger kStagger = S;
+
+    struct Evaluator
+    {
+        amrex::Array4<const amrex::Real> array; /**< Data of the field on the box of the tile */
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE amrex::Real operator()(const int i, const int j, const int k,
+                                                                        const int n) const noexcept
+        {
+            return array(i, j, k, n);
+        }
+    };
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct a leaf node, sharing the field.
+     * @param field Field to read.
+     */
+    explicit FieldTerminal(const StaggeredField<S>& field) : field_(field.GetField()) {}
+
+    /**
+     * @brief Get the evaluator of the node on a tile.
+     * @param mfi Iterator over the output, which shares the layout of the field.
+     * @return Evaluator reading the box of the field.
+     */
+    Evaluator Prepare(const amrex::MFIter& mfi) const { return Evaluator{field_->multifab->const_array(mfi)}; }
+
+    /**
+     * @brief Check that the field can be read on the points of the output.
+     * @param output Field the expression is assigned to.
+     * @param n_ghost Number of ghost cells of the output that are assigned as well.
+     * @throws std::invalid_argument if the field does not have the layout or number of components of the output or
+     * has fewer than n_ghost ghost cells.
+     */
+    void Check(const Field& output, const int n_ghost) const
+    {
+        CheckOperand("Assign", output, *field_, n_ghost, output.multifab->nComp());
+    }
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief The field, kept alive for the lifetime of the expression.
+     */
+    std::shared_ptr<Field> field_;
+};
+
+/**
+ * @brief Leaf node for a scalar, the same at every point and for every component.
+ */
+class ScalarTerminal
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Types
+    //-----------------------------------------------------------------------//
+
+    static constexpr bool kIsScalar = true;
+
+    struct Evaluator
+    {
+        amrex::Real value; /**< Value of the scalar */
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE amrex::Real operator()(const int, const int, const int,
+                                                                        const int) const noexcept
+        {
+            return value;
+        }
+    };
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct a leaf node for a scalar.
+     * @param value Value of the scalar.
+     */
+    explicit ScalarTerminal(const amrex::Real value) noexcept : value_(value) {}
+
+    /**
+     * @brief Get the evaluator of the node, the same on every tile.
+     */
+    Evaluator Prepare(const amrex::MFIter&) const noexcept { return Evaluator{value_}; }
+
+    /**
+     * @brief A scalar matches every output.
+     */
+    void Check(const Field&, const int) const noexcept {}
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    amrex::Real value_; /**< Value of the scalar */
+};
+
+/**
+ * @brief Node for a pointwise operation on the values of two nodes.
+ * @tparam Operation Type with a static function Apply(left, right) callable on the device.
+ * @tparam L Left operand node.
+ * @tparam R Right operand node.
+ */
+template <typename Operation, ExpressionNode L, ExpressionNode R>
+    requires(!(L::kIsScalar && R::kIsScalar))
+class BinaryExpression
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Types
+    //-----------------------------------------------------------------------//
+
+    static constexpr bool kIsScalar = false;
+
+    /**
+     * @brief Location of the fields of the expression on the grid.
+     */
+    static constexpr FieldGridStagger kStagger = []
+    {
+        if constexpr (L::kIsScalar)
+        {
+            return R::kStagger;
+        }
+        else
+        {
+            return L::kStagger;
+        }
+    }();
+
+    struct Evaluator
+    {
+        typename L::Evaluator left;  /**< Evaluator of the left operand */
+        typename R::Evaluator right; /**< Evaluator of the right operand */
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE amrex::Real operator()(const int i, const int j, const int k,
+                                                                        const int n) const noexcept
+        {
+            return Operation::Apply(left(i, j, k, n), right(i, j, k, n));
+        }
+    };
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct the node from its operands.
+     * @param left Left operand.
+     * @param right Right operand.
+     */
+    BinaryExpression(L left, R right) : left_(std::move(left)), right_(std::move(right)) {}
+
+    /**
+     * @brief Get the evaluator of the node on a tile.
+     */
+    Evaluator Prepare(const amrex::MFIter& mfi) const { return Evaluator{left_.Prepare(mfi), right_.Prepare(mfi)}; }
+
+    /**
+     * @brief Check the fields of both operands, see FieldTerminal::Check.
+     */
+    void Check(const Field& output, const int n_ghost) const
+    {
+        left_.Check(output, n_ghost);
+        right_.Check(output, n_ghost);
+    }
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    L left_;  /**< Left operand */
+    R right_; /**< Right operand */
+};
+
+/**
+ * @brief Node for a pointwise operation on the value of one node.
+ * @tparam Operation Type with a static function Apply(value) callable on the device.
+ * @tparam E Operand node.
+ */
+template <typename Operation, ExpressionNode E>
+    requires(!E::kIsScalar)
+class UnaryExpression
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Types
+    //-----------------------------------------------------------------------//
+
+    static constexpr bool kIsScalar            = false;
+    static constexpr FieldGridStagger kStagger = E::kStagger;
+
+    struct Evaluator
+    {
+        typename E::Evaluator operand; /**< Evaluator of the operand */
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE amrex::Real operator()(const int i, const int j, const int k,
+                                                                        const int n) const noexcept
+        {
+            return Operation::Apply(operand(i, j, k, n));
+        }
+    };
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct the node from its operand.
+     * @param operand Operand.
+     */
+    explicit UnaryExpression(E operand) : operand_(std::move(operand)) {}
+
+    /**
+     * @brief Get the evaluator of the node on a tile.
+     */
+    Evaluator Prepare(const amrex::MFIter& mfi) const { return Evaluator{operand_.Prepare(mfi)}; }
+
+    /**
+     * @brief Check the fields of the operand, see FieldTerminal::Check.
+     */
+    void Check(const Field& output, const int n_ghost) const { operand_.Check(output, n_ghost); }
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    E operand_; /**< Operand */
+};
+
+//---------------------------------------------------------------------------//
+// Pointwise operations
+//---------------------------------------------------------------------------//
+
+struct PlusOperation
+{
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE static amrex::Real Apply(const amrex::Real a, const amrex::Real b) noexcept
+    {
+        return a + b;
+    }
+};
+
+struct MinusOperation
+{
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE static amrex::Real Apply(const amrex::Real a, const amrex::Real b) noexcept
+    {
+        return a - b;
+    }
+};
+
+struct MultipliesOperation
+{
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE static amrex::Real Apply(const amrex::Real a, const amrex::Real b) noexcept
+    {
+        return a * b;
+    }
+};
+
+struct DividesOperation
+{
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE static amrex::Real Apply(const amrex::Real a, const amrex::Real b) noexcept
+    {
+        return a / b;
+    }
+};
+
+struct NegateOperation
+{
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE static amrex::Real Apply(const amrex::Real a) noexcept { return -a; }
+};
+
+//---------------------------------------------------------------------------//
+// Building expressions
+//---------------------------------------------------------------------------//
+
+/**
+ * @brief Get the leaf node of a field.
+ */
+template <FieldGridStagger S>
+FieldTerminal<S> MakeExpression(const StaggeredField<S>& field)
+{
+    return FieldTerminal<S>(field);
+}
+
+/**
+ * @brief Get the leaf node of a scalar.
+ */
+inline ScalarTerminal MakeExpression(const amrex::Real value) noexcept
+{
+    return ScalarTerminal(value);
+}
+
+/**
+ * @brief Expressions are their own nodes.
+ */
+template <ExpressionNode E>
+const E& MakeExpression(const E& expression) noexcept
+{
+    return expression;
+}
+
+/**
+ * @brief A field, a scalar or an expression, anything that can be an operand of the arithmetic operators below.
+ */
+template <typename T>
+concept ExpressionOperand = requires(const T& operand) { MakeExpression(operand); };
+
+/**
+ * @brief Node type of an operand.
+ */
+template <ExpressionOperand T>
+using ExpressionOf = std::remove_cvref_t<decltype(MakeExpression(std::declval<const T&>()))>;
+
+/**
+ * @brief Whether two operands can be combined: at least one of them has fields, and if both have, of the same stagger.
+ */
+template <typename L, typename R>
+concept CompatibleOperands =
+    ExpressionOperand<L> && ExpressionOperand<R> &&
+    ((ExpressionOf<L>::kIsScalar && !ExpressionOf<R>::kIsScalar) ||
+     (!ExpressionOf<L>::kIsScalar && ExpressionOf<R>::kIsScalar) ||
+     (!ExpressionOf<L>::kIsScalar && !ExpressionOf<R>::kIsScalar &&
+      ExpressionOf<L>::kStagger == ExpressionOf<R>::kStagger));
+
+template <typename L, typename R>
+    requires CompatibleOperands<L, R>
+auto operator+(const L& left, const R& right)
+{
+    return BinaryExpression<PlusOperation, ExpressionOf<L>, ExpressionOf<R>>(MakeExpression(left),
+                                                                             MakeExpression(right));
+}
+
+template <typename L, typename R>
+    requires CompatibleOperands<L, R>
+auto operator-(const L& left, const R& right)
+{
+    return BinaryExpression<MinusOperation, ExpressionOf<L>, ExpressionOf<R>>(MakeExpression(left),
+                                                                              MakeExpression(right));
+}
+
+template <typename L, typename R>
+    requires CompatibleOperands<L, R>
+auto operator*(const L& left, const R& right)
+{
+    return BinaryExpression<MultipliesOperation, ExpressionOf<L>, ExpressionOf<R>>(MakeExpression(left),
+                                                                                   MakeExpression(right));
+}
+
+template <typename L, typename R>
+    requires CompatibleOperands<L, R>
+auto operator/(const L& left, const R& right)
+{
+    return BinaryExpression<DividesOperation, ExpressionOf<L>, ExpressionOf<R>>(MakeExpression(left),
+                                                                                MakeExpression(right));
+}
+
+template <typename E>
+    requires(ExpressionOperand<E> && !ExpressionOf<E>::kIsScalar)
+auto operator-(const E& operand)
+{
+    return UnaryExpression<NegateOperation, ExpressionOf<E>>(MakeExpression(operand));
+}
+
+//---------------------------------------------------------------------------//
+// Evaluating expressions
+//---------------------------------------------------------------------------//
+
+/**
+ * @brief Evaluate an expression into a field of the same stagger, in one fused kernel per tile of the field.
+ *
+ * The tiles are spread over the OpenMP threads, and on the GPU every box is a single tile. The output may appear in
+ * the expression, e.g. Assign(h, h + dt * f), since every point only reads its own values before writing them.
+ *
+ * @param output Field to assign, all components.
+ * @param operand Field or expression of the stagger of the output.
+ * @param n_ghost Number of ghost cells of the output to assign as well.
+ * @throws std::invalid_argument if the output or a field of the expression has fewer ghost cells than n_ghost, or a
+ * field of the expression does not have the layout or number of components of the output.
+ */
+template <FieldGridStagger S, typename E>
+    requires(ExpressionOperand<E> && !ExpressionOf<E>::kIsScalar && ExpressionOf<E>::kStagger == S)
+void Assign(const StaggeredField<S>& output, const E& operand, const int n_ghost = 0)
+{
+    if (output.GetMultiFab().nGrow() < n_ghost)
+    {
+        throw std::invalid_argument("Assign: Field '" + output.GetField()->name + "' needs at least " +
+                                    std::to_string(n_ghost) + " ghost cells.");
+    }
+    const ExpressionOf<E>& expression = MakeExpression(operand);
+    expression.Check(*output.GetField(), n_ghost);
+
+    amrex::MultiFab& mf = output.GetMultiFab();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real> array             = mf.array(mfi);
+        const typename ExpressionOf<E>::Evaluator evaluate = expression.Prepare(mfi);
+        amrex::ParallelFor(mfi.growntilebox(n_ghost), mf.nComp(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                           { array(i, j, k, n) = evaluate(i, j, k, n); });
+    }
+}
+
+/**
+ * @brief Fields of different staggers live on different points, so an expression cannot be assigned to a field of
+ * another stagger.
+ */
+template <FieldGridStagger S, typename E>
+    requires(ExpressionOperand<E> && !ExpressionOf<E>::kIsScalar && ExpressionOf<E>::kStagger != S)
+void Assign(const StaggeredField<S>& output, const E& operand, const int n_ghost = 0) = delete;
+
+}  // namespace turbo
@@ -0,0 +1,176 @@
+#include "field_expression.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "field_test_utils.h"
+#include "staggered_field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+namespace
+{
+
+/**
+ * @brief Whether the sum of two operands compiles.
+ */
+template <typename L, typename R>
+concept Addable = requires(const L& left, const R& right) { left + right; };
+
+/**
+ * @brief Whether an operand can be assigned to a field.
+ */
+template <typename Output, typename E>
+concept Assignable = requires(const Output& output, const E& operand) { Assign(output, operand); };
+
+using CellField  = StaggeredField<FieldGridStagger::CellCentered>;
+using IFaceField = StaggeredField<FieldGridStagger::IFace>;
+
+// A stagger mismatch is a compile error
+static_assert(Addable<CellField, CellField>);
+static_assert(Addable<double, IFaceField>);
+static_assert(!Addable<CellField, IFaceField>);
+static_assert(Addable<decltype(std::declval<CellField>() * 2.0), CellField>);
+static_assert(!Addable<decltype(std::declval<CellField>() * 2.0), IFaceField>);
+static_assert(Assignable<IFaceField, decltype(std::declval<IFaceField>() - 1.0)>);
+static_assert(!Assignable<CellField, decltype(std::declval<IFaceField>() - 1.0)>);
+static_assert(!Assignable<CellField, double>);
+
+// Evaluators are captured by value in kernels
+static_assert(std::is_trivially_copyable_v<
+              decltype(std::declval<CellField>() + 2.0 * std::declval<CellField>())::Evaluator>);
+
+/**
+ * @brief Set every component n of a field to value + n, ghost cells included.
+ */
+template <FieldGridStagger S>
+void SetComponents(const StaggeredField<S>& field, const double value)
+{
+    amrex::MultiFab& mf = field.GetMultiFab();
+    for (int n = 0; n < mf.nComp(); ++n)
+    {
+        const int n_component = 1;
+        mf.setVal(value + n, n, n_component, mf.nGrow());
+    }
+}
+
+/**
+ * @brief Check that every component n of a field is value + n on the valid points and n_ghost ghost cells.
+ */
+template <FieldGridStagger S>
+void ExpectComponents(const StaggeredField<S>& field, const double value, const int n_ghost = 0)
+{
+    const amrex::MultiFab& mf = field.GetMultiFab();
+    for (int n = 0; n < mf.nComp(); ++n)
+    {
+        EXPECT_DOUBLE_EQ(mf.min(n, n_ghost), value + n);
+        EXPECT_DOUBLE_EQ(mf.max(n, n_ghost), value + n);
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for field expression tests
+//---------------------------------------------------------------------------//
+
+class FieldExpressionTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override { grid = MakeTestGrid(4); }
+
+    template <FieldGridStagger S>
+    StaggeredField<S> MakeField(const Field::NameType& name, const double value, const int n_component = 2) const
+    {
+        const StaggeredField<S> field(name, grid, n_component, 1, FoldParity::Scalar, box_decomposition);
+        SetComponents(field, value);
+        return field;
+    }
+
+    std::shared_ptr<CartesianGrid> grid;
+    const BoxDecomposition box_decomposition = MakeTestBoxDecomposition(2);
+};
+
+//---------------------------------------------------------------------------//
+// Field expression tests
+//---------------------------------------------------------------------------//
+
+TEST_F(FieldExpressionTest, FusedTendencyUpdate)
+{
+    const auto h     = MakeField<FieldGridStagger::CellCentered>("h", 10.0);
+    const auto f     = MakeField<FieldGridStagger::CellCentered>("f", 1.0);
+    const auto g     = MakeField<FieldGridStagger::CellCentered>("g", 3.0);
+    const auto h_new = MakeField<FieldGridStagger::CellCentered>("h_new", -1.0);
+
+    // Component n: 10 + n + 0.5 * (2 * (1 + n) - 2 * (3 + n)) = 8 + n
+    const double dt = 0.5;
+    const double a  = 2.0;
+    const double b  = -2.0;
+    Assign(h_new, h + dt * (a * f + b * g));
+    ExpectComponents(h_new, 8.0);
+    EXPECT_DOUBLE_EQ(h_new.GetMultiFab().min(0, 1), -1.0);
+
+    // Ghost cells on request
+    Assign(h_new, h + dt * (a * f + b * g), 1);
+    ExpectComponents(h_new, 8.0, 1);
+}
+
+TEST_F(FieldExpressionTest, Operations)
+{
+    const auto u   = MakeField<FieldGridStagger::IFace>("u", 4.0, 1);
+    const auto v   = MakeField<FieldGridStagger::IFace>("v", 2.0, 1);
+    const auto out = MakeField<FieldGridStagger::IFace>("out", 0.0, 1);
+
+    Assign(out, u / v - 1.0);
+    ExpectComponents(out, 1.0);
+    Assign(out, -u);
+    ExpectComponents(out, -4.0);
+    Assign(out, 3.0 - v * v / 2.0);
+    ExpectComponents(out, 1.0);
+    Assign(out, v);
+    ExpectComponents(out, 2.0);
+
+    // The output may be read by the expression
+    Assign(u, u * u + u);
+    ExpectComponents(u, 20.0);
+
+    // Expressions read the fields when assigned
+    const auto sum = u + v;
+    SetComponents(v, 5.0);
+    Assign(out, sum);
+    ExpectComponents(out, 25.0);
+}
+
+TEST_F(FieldExpressionTest, Errors)
+{
+    const auto h = MakeField<FieldGridStagger::CellCentered>("h", 1.0);
+
+    // Other number of components
+    const auto scalar = MakeField<FieldGridStagger::CellCentered>("scalar", 1.0, 1);
+    EXPECT_THROW(Assign(h, h + scalar), std::invalid_argument);
+    EXPECT_THROW(Assign(scalar, 2.0 * h), std::invalid_argument);
+
+    // Too few ghost cells, in the expression or in an output that is not part of it
+    EXPECT_THROW(Assign(h, 2.0 * h, 2), std::invalid_argument);
+    const StaggeredField<FieldGridStagger::CellCentered> wide("wide", grid, 2, 3, FoldParity::Scalar,
+                                                              box_decomposition);
+    EXPECT_THROW(Assign(h, 2.0 * wide, 2), std::invalid_argument);
+
+    // Other layout
+    const BoxDecomposition one_box = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 6, 4)));
+    const StaggeredField<FieldGridStagger::CellCentered> other_layout("other_layout", grid, 2, 1, FoldParity::Scalar,
+                                                                      one_box);
+    EXPECT_THROW(Assign(h, h - other_layout), std::invalid_argument);
+}
@@ -0,0 +1,498 @@
+#include "field_reductions.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "field.h"
+
+namespace turbo
+{
+
+namespace
+{
+
+constexpr std::int64_t kLimbBase = std::int64_t{1} << ReproducibleSum::kLimbBits;
+
+// Limbs of kLimbBits bits can take this many additions of values below kLimbBase before a carry, without overflowing
+constexpr std::int64_t kMaxAddBeforeCarry = (std::int64_t{1} << (63 - ReproducibleSum::kLimbBits)) - 1;
+
+/**
+ * @brief Power of two of the least significant bit of a limb, limb 0 is the most significant.
+ */
+constexpr int LimbExponent(const int limb) { return ReproducibleSum::kLimbBits * (2 - limb); }
+
+/**
+ * @brief Map a double to a 64 bit integer with the same order, so a maximum can be reduced as an integer.
+ */
+std::int64_t OrderKey(const double value)
+{
+    const std::int64_t bits = std::bit_cast<std::int64_t>(value);
+    return bits >= 0 ? bits : bits ^ std::numeric_limits<std::int64_t>::max();
+}
+
+/**
+ * @brief Inverse of OrderKey.
+ */
+double FromOrderKey(const std::int64_t key)
+{
+    return std::bit_cast<double>(key >= 0 ? key : key ^ std::numeric_limits<std::int64_t>::max());
+}
+
+/**
+ * @brief Partial result of one reduction on one rank or thread.
+ */
+struct ReductionState
+{
+    ReproducibleSum sum;           /**< Sum, L1Norm and L2Norm: the sum. Mean: the weighted sum of the values. */
+    ReproducibleSum weight_sum;    /**< Mean: the sum of the weights. */
+    std::int64_t key   = 0;        /**< Min: ~OrderKey of the minimum. Max and MaxNorm: OrderKey of the maximum. */
+    std::int64_t n_nan = 0;        /**< Min, Max and MaxNorm: number of NaN values. */
+
+    explicit ReductionState(const ReductionType type)
+    {
+        switch (type)
+        {
+            case ReductionType::Min:
+                key = ~OrderKey(std::numeric_limits<double>::infinity());
+                break;
+            case ReductionType::Max:
+                key = OrderKey(-std::numeric_limits<double>::infinity());
+                break;
+            default:
+                key = OrderKey(0.0);
+                break;
+        }
+    }
+
+    void Merge(const ReductionState& other)
+    {
+        sum += other.sum;
+        weight_sum += other.weight_sum;
+        key = std::max(key, other.key);
+        n_nan += other.n_nan;
+    }
+};
+
+// Number of integers each reduction adds to, and takes the maximum of, in the MPI reduction
+constexpr int kNSumPerReduction = 2 * ReproducibleSum::kNPacked + 1;
+constexpr int kNMaxPerReduction = 1;
+
+#ifdef AMREX_USE_MPI
+/**
+ * @brief MPI reduction of the packed states of all reductions: a leading integer n_sum, then n_sum integers that are
+ * added, then integers of which the maximum is taken. The whole buffer is a single element of the datatype, so MPI
+ * cannot split it.
+ */
+void ReducePackedStates(void* in, void* in_out, int* length, MPI_Datatype* datatype)
+{
+    int n_byte = 0;
+    MPI_Type_size(*datatype, &n_byte);
+    const int n_integer = n_byte / static_cast<int>(sizeof(std::int64_t));
+
+    for (int element = 0; element < *length; ++element)
+    {
+        const std::int64_t* source = static_cast<const std::int64_t*>(in) + element * n_integer;
+        std::int64_t* destination  = static_cast<std::int64_t*>(in_out) + element * n_integer;
+        const int n_sum            = static_cast<int>(source[0]);
+        for (int index = 1; index <= n_sum; ++index)
+        {
+            destination[index] += source[index];
+        }
+        for (int index = n_sum + 1; index < n_integer; ++index)
+        {
+            destination[index] = std::max(destination[index], source[index]);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Combine the states of all ranks into the first state of each reduction, with one MPI_Allreduce.
+ */
+void AllReduce(std::vector<ReductionState>& states)
+{
+#ifdef AMREX_USE_MPI
+    const int n_state   = static_cast<int>(states.size());
+    const int n_sum     = n_state * kNSumPerReduction;
+    const int n_integer = 1 + n_sum + n_state * kNMaxPerReduction;
+
+    std::vector<std::int64_t> packed(n_integer);
+    packed[0] = n_sum;
+    for (int state = 0; state < n_state; ++state)
+    {
+        std::int64_t* sums = packed.data() + 1 + state * kNSumPerReduction;
+        states[state].sum.Pack(sums);
+        states[state].weight_sum.Pack(sums + ReproducibleSum::kNPacked);
+        sums[2 * ReproducibleSum::kNPacked] = states[state].n_nan;
+        packed[1 + n_sum + state]           = states[state].key;
+    }
+
+    MPI_Datatype datatype;
+    MPI_Type_contiguous(n_integer, MPI_INT64_T, &datatype);
+    MPI_Type_commit(&datatype);
+    MPI_Op operation;
+    MPI_Op_create(&ReducePackedStates, 1, &operation);
+    MPI_Allreduce(MPI_IN_PLACE, packed.data(), 1, datatype, operation, amrex::ParallelDescriptor::Communicator());
+    MPI_Op_free(&operation);
+    MPI_Type_free(&datatype);
+
+    for (int state = 0; state < n_state; ++state)
+    {
+        const std::int64_t* sums = packed.data() + 1 + state * kNSumPerReduction;
+        states[state].sum        = ReproducibleSum::Unpack(sums);
+        states[state].weight_sum = ReproducibleSum::Unpack(sums + ReproducibleSum::kNPacked);
+        states[state].n_nan      = sums[2 * ReproducibleSum::kNPacked];
+        states[state].key        = packed[1 + n_sum + state];
+    }
+#else
+    (void)states;
+#endif
+}
+
+/**
+ * @brief Add the points of the boxes of this rank to the states of reductions over fields with the same layout.
+ */
+void ReduceLocal(const std::vector<Reduction>& reductions, const std::vector<int>& group,
+                 std::vector<ReductionState>& states)
+{
+    const Field& layout_field = *reductions[group.front()].field;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    {
+        // Integer sums and maxima do not depend on how the boxes are split over the threads
+        std::vector<ReductionState> thread_states;
+        thread_states.reserve(group.size());
+        for (const int reduction : group)
+        {
+            thread_states.emplace_back(reductions[reduction].type);
+        }
+
+        std::vector<amrex::Array4<const amrex::Real>> values(group.size()), weights(group.size()), masks(group.size());
+        for (amrex::MFIter mfi(*layout_field.multifab); mfi.isValid(); ++mfi)
+        {
+            for (std::size_t member = 0; member < group.size(); ++member)
+            {
+                const Reduction& reduction = reductions[group[member]];
+                values[member]             = reduction.field->multifab->const_array(mfi);
+                if (reduction.weight)
+                {
+                    weights[member] = reduction.weight->multifab->const_array(mfi);
+                }
+                if (reduction.mask)
+                {
+                    masks[member] = reduction.mask->multifab->const_array(mfi);
+                }
+            }
+
+            const amrex::Box box = layout_field.OwnedBox(mfi.validbox());
+            const auto lo        = amrex::lbound(box);
+            const auto hi        = amrex::ubound(box);
+            for (int k = lo.z; k <= hi.z; ++k)
+            {
+                for (int j = lo.y; j <= hi.y; ++j)
+                {
+                    for (int i = lo.x; i <= hi.x; ++i)
+                    {
+                        for (std::size_t member = 0; member < group.size(); ++member)
+                        {
+                            const Reduction& reduction = reductions[group[member]];
+                            if (reduction.mask && masks[member](i, j, k, 0) == 0.0)
+                            {
+                                continue;
+                            }
+
+                            ReductionState& state = thread_states[member];
+                            const double value    = values[member](i, j, k, reduction.component);
+                            const double weight   = reduction.weight ? weights[member](i, j, k, 0) : 1.0;
+                            switch (reduction.type)
+                            {
+                                case ReductionType::Sum:
+                                    state.sum.Add(weight * value);
+                                    break;
+                                case ReductionType::Mean:
+                                    state.sum.Add(weight * value);
+                                    state.weight_sum.Add(weight);
+                                    break;
+                                case ReductionType::L1Norm:
+                                    state.sum.Add(weight * std::abs(value));
+                                    break;
+                                case ReductionType::L2Norm:
+                                    state.sum.Add(weight * value * value);
+                                    break;
+                                case ReductionType::Min:
+                                    state.n_nan += std::isnan(value);
+                                    state.key = std::max(state.key, ~OrderKey(value));
+                                    break;
+                                case ReductionType::Max:
+                                    state.n_nan += std::isnan(value);
+                                    state.key = std::max(state.key, OrderKey(value));
+                                    break;
+                                case ReductionType::MaxNorm:
+                                    state.n_nan += std::isnan(value);
+                                    state.key = std::max(state.key, OrderKey(std::abs(value)));
+                                    break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+#ifdef AMREX_USE_OMP
+#pragma omp critical(turbo_field_reductions)
+#endif
+        for (std::size_t member = 0; member < group.size(); ++member)
+        {
+            states[group[member]].Merge(thread_states[member]);
+        }
+    }
+}
+
+/**
+ * @brief Check if two fields have the same boxes on the same ranks, so they can be iterated over together.
+ */
+bool SameLayout(const Field& a, const Field& b)
+{
+    return a.multifab->boxArray() == b.multifab->boxArray() &&
+           a.multifab->DistributionMap() == b.multifab->DistributionMap();
+}
+
+/**
+ * @brief Check that a weight or mask field can be used with the field of a reduction.
+ */
+void CheckLayout(const Reduction& reduction, const std::shared_ptr<const Field>& other, const std::string& what)
+{
+    if (other && !SameLayout(*other, *reduction.field))
+    {
+        throw std::invalid_argument("Reduce: The " + what + " '" + other->name +
+                                    "' does not have the layout of field '" + reduction.field->name + "'.");
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------//
+// ReproducibleSum
+//---------------------------------------------------------------------------//
+
+void ReproducibleSum::Add(const double value) noexcept
+{
+    if (!std::isfinite(value))
+    {
+        ++n_non_finite_;
+        return;
+    }
+    double remainder = std::abs(value);
+    if (remainder >= std::ldexp(1.0, LimbExponent(0) + kLimbBits))
+    {
+        ++n_out_of_range_;
+        return;
+    }
+
+    // Each limb takes the next kLimbBits bits of the magnitude, all subtractions are exact
+    const std::int64_t sign = value < 0.0 ? -1 : 1;
+    for (int limb = 0; limb < kNLimb; ++limb)
+    {
+        const std::int64_t bits = static_cast<std::int64_t>(std::ldexp(remainder, -LimbExponent(limb)));
+        remainder -= std::ldexp(static_cast<double>(bits), LimbExponent(limb));
+        limbs_[limb] += sign * bits;
+    }
+
+    if (++n_add_since_carry_ == kMaxAddBeforeCarry)
+    {
+        Carry();
+    }
+}
+
+ReproducibleSum& ReproducibleSum::operator+=(const ReproducibleSum& other) noexcept
+{
+    ReproducibleSum carried = other;
+    carried.Carry();
+    Carry();
+    for (int limb = 0; limb < kNLimb; ++limb)
+    {
+        limbs_[limb] += carried.limbs_[limb];
+    }
+    // Two carried limbs add up to less than 2 * kLimbBase
+    n_add_since_carry_ = 2;
+    n_non_finite_ += carried.n_non_finite_;
+    n_out_of_range_ += carried.n_out_of_range_;
+    return *this;
+}
+
+double ReproducibleSum::Value() const
+{
+    if (n_non_finite_ > 0)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (n_out_of_range_ > 0)
+    {
+        throw std::runtime_error("ReproducibleSum::Value: Sum out of range, magnitudes must be below 2^" +
+                                 std::to_string(LimbExponent(0) + kLimbBits) + ".");
+    }
+
+    // The carried limbs all have the same sign, adding them up from the least significant one rounds the exact sum
+    const Limbs limbs = GetLimbs();
+    double value      = 0.0;
+    for (int limb = kNLimb - 1; limb >= 0; --limb)
+    {
+        value += std::ldexp(static_cast<double>(limbs[limb]), LimbExponent(limb));
+    }
+    return value;
+}
+
+ReproducibleSum::Limbs ReproducibleSum::GetLimbs() const noexcept
+{
+    ReproducibleSum carried = *this;
+    carried.Carry();
+    return carried.limbs_;
+}
+
+void ReproducibleSum::Pack(std::int64_t* packed) const noexcept
+{
+    const Limbs limbs = GetLimbs();
+    std::copy(limbs.begin(), limbs.end(), packed);
+    packed[kNLimb]     = n_non_finite_;
+    packed[kNLimb + 1] = n_out_of_range_;
+}
+
+ReproducibleSum ReproducibleSum::Unpack(const std::int64_t* packed) noexcept
+{
+    ReproducibleSum sum;
+    std::copy(packed, packed + kNLimb, sum.limbs_.begin());
+    sum.n_non_finite_   = packed[kNLimb];
+    sum.n_out_of_range_ = packed[kNLimb + 1];
+    sum.Carry();
+    return sum;
+}
+
+void ReproducibleSum::Carry() noexcept
+{
+    for (int limb = kNLimb - 1; limb > 0; --limb)
+    {
+        // Truncating division keeps the sign of the limb, so the carried limb stays below kLimbBase in magnitude
+        const std::int64_t carry = limbs_[limb] / kLimbBase;
+        limbs_[limb] -= carry * kLimbBase;
+        limbs_[limb - 1] += carry;
+    }
+    if (limbs_[0] >= kLimbBase || limbs_[0] <= -kLimbBase)
+    {
+        ++n_out_of_range_;
+        limbs_.fill(0);
+    }
+
+    // Give all limbs the sign of the most significant non-zero limb, which makes the limbs of a sum unique
+    const auto leading_limb = std::find_if(limbs_.begin(), limbs_.end(), [](std::int64_t l) { return l != 0; });
+    const std::int64_t sign = (leading_limb != limbs_.end() && *leading_limb < 0) ? -1 : 1;
+    for (int limb = kNLimb - 1; limb > 0; --limb)
+    {
+        if (limbs_[limb] * sign < 0)
+        {
+            limbs_[limb] += sign * kLimbBase;
+            limbs_[limb - 1] -= sign;
+        }
+    }
+    n_add_since_carry_ = 0;
+}
+
+//---------------------------------------------------------------------------//
+// Field reductions
+//---------------------------------------------------------------------------//
+
+std::vector<double> Reduce(const std::vector<Reduction>& reductions)
+{
+    // Group the reductions by layout, each group is reduced in one pass over its boxes
+    std::vector<std::vector<int>> groups;
+    for (int index = 0; index < static_cast<int>(reductions.size()); ++index)
+    {
+        const Reduction& reduction = reductions[index];
+        if (!reduction.field)
+        {
+            throw std::invalid_argument("Reduce: Invalid field pointer.");
+        }
+        if (reduction.component < 0 || reduction.component >= reduction.field->multifab->nComp())
+        {
+            throw std::invalid_argument("Reduce: Component " + std::to_string(reduction.component) +
+                                        " out of range for field '" + reduction.field->name + "'.");
+        }
+        CheckLayout(reduction, reduction.weight, "weight");
+        CheckLayout(reduction, reduction.mask, "mask");
+
+        const auto group = std::find_if(groups.begin(), groups.end(), [&](const std::vector<int>& g)
+                                        { return SameLayout(*reductions[g.front()].field, *reduction.field); });
+        if (group == groups.end())
+        {
+            groups.push_back({index});
+        }
+        else
+        {
+            group->push_back(index);
+        }
+    }
+
+    std::vector<ReductionState> states;
+    states.reserve(reductions.size());
+    for (const Reduction& reduction : reductions)
+    {
+        states.emplace_back(reduction.type);
+    }
+    for (const std::vector<int>& group : groups)
+    {
+        ReduceLocal(reductions, group, states);
+    }
+    AllReduce(states);
+
+    std::vector<double> results;
+    results.reserve(reductions.size());
+    for (std::size_t index = 0; index < reductions.size(); ++index)
+    {
+        const ReductionState& state = states[index];
+        const bool nan              = state.n_nan > 0;
+        switch (reductions[index].type)
+        {
+            case ReductionType::Sum:
+            case ReductionType::L1Norm:
+                results.push_back(state.sum.Value());
+                break;
+            case ReductionType::Mean:
+            {
+                const double weight_sum = state.weight_sum.Value();
+                results.push_back(weight_sum == 0.0 ? std::numeric_limits<double>::quiet_NaN()
+                                                    : state.sum.Value() / weight_sum);
+                break;
+            }
+            case ReductionType::L2Norm:
+                results.push_back(std::sqrt(state.sum.Value()));
+                break;
+            case ReductionType::Min:
+                results.push_back(nan ? std::numeric_limits<double>::quiet_NaN() : FromOrderKey(~state.key));
+                break;
+            case ReductionType::Max:
+            case ReductionType::MaxNorm:
+                results.push_back(nan ? std::numeric_limits<double>::quiet_NaN() : FromOrderKey(state.key));
+                break;
+            default:
+                throw std::invalid_argument("Reduce: Invalid ReductionType specified.");
+        }
+    }
+    return results;
+}
+
+double Reduce(const Reduction& reduction) { return Reduce(std::vector<Reduction>{reduction}).front(); }
+
+}  // namespace turbo
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "field.h"
+
+namespace turbo
+{
+
+/**
+ * @class ReproducibleSum
+ * @brief Exact, order-independent sum of double values, like the reproducing sums of MOM6.
+ *
+ * Every value is split into ReproducibleSum::kNLimb signed 64 bit integer limbs of ReproducibleSum::kLimbBits bits
+ * each, covering magnitudes from 2^-138 up to (but excluding) 2^138, and the limbs are added as integers. Integer
+ * addition is associative, so the result is bit-identical for any order of the values and any split of the values into
+ * partial sums, i.e. for any box decomposition, number of ranks or number of threads. Bits below 2^-138 are truncated.
+ */
+class ReproducibleSum
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Types
+    //-----------------------------------------------------------------------//
+
+    static constexpr int kNLimb    = 6;          /**< Number of integer limbs. */
+    static constexpr int kLimbBits = 46;         /**< Number of bits stored in each limb after a carry. */
+    static constexpr int kNPacked  = kNLimb + 2; /**< Number of integers written by Pack. */
+
+    using Limbs = std::array<std::int64_t, kNLimb>;
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Add a value to the sum. NaN and infinite values make the sum NaN, finite values of magnitude 2^138 or
+     * more make the sum out of range.
+     * @param value Value to add.
+     */
+    void Add(const double value) noexcept;
+
+    /**
+     * @brief Add a partial sum to this sum.
+     * @param other Partial sum to add.
+     * @return Reference to this sum.
+     */
+    ReproducibleSum& operator+=(const ReproducibleSum& other) noexcept;
+
+    /**
+     * @brief Get the sum, rounded to a double.
+     * @return The sum, NaN if a non-finite value was added.
+     * @throws std::runtime_error if the sum or one of the values is out of range.
+     */
+    double Value() const;
+
+    /**
+     * @brief Get the limbs of the sum after carrying, most significant limb first. Equal sums have equal limbs.
+     * @return The limbs.
+     */
+    Limbs GetLimbs() const noexcept;
+
+    /**
+     * @brief Write the state of the sum to ReproducibleSum::kNPacked integers, e.g. to reduce it over the ranks by
+     * adding the integers. Sums of up to 2^17 packed states can be unpacked.
+     * @param packed Destination of the integers.
+     */
+    void Pack(std::int64_t* packed) const noexcept;
+
+    /**
+     * @brief Read a sum written by Pack, or the element-wise integer sum of several such states.
+     * @param packed The integers.
+     * @return The sum.
+     */
+    static ReproducibleSum Unpack(const std::int64_t* packed) noexcept;
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Integer limbs, most significant first. Limb l holds multiples of 2^(kLimbBits * (2 - l)).
+     */
+    Limbs limbs_{};
+
+    /**
+     * @brief Number of values added since the last carry, a carry is needed before the limbs can overflow.
+     */
+    std::int64_t n_add_since_carry_ = 0;
+
+    /**
+     * @brief Number of non-finite values added.
+     */
+    std::int64_t n_non_finite_ = 0;
+
+    /**
+     * @brief Number of values, or carries into the most significant limb, that were out of range.
+     */
+    std::int64_t n_out_of_range_ = 0;
+
+    //-----------------------------------------------------------------------//
+    // Private Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Carry the bits above kLimbBits of each limb into the next more significant limb.
+     */
+    void Carry() noexcept;
+};
+
+/**
+ * @enum ReductionType
+ * @brief Specifies how a Reduction combines the values of a field component.
+ */
+enum class ReductionType
+{
+    Sum,    /**< Sum of weight * value. */
+    Mean,   /**< Sum of weight * value divided by the sum of weight, NaN if the weights sum to zero. */
+    Min,    /**< Minimum value, +infinity if there are no points. The weight is ignored. */
+    Max,    /**< Maximum value, -infinity if there are no points. The weight is ignored. */
+    L1Norm, /**< Sum of weight * |value|. */
+    L2Norm, /**< Square root of the sum of weight * value^2. */
+    MaxNorm /**< Maximum |value|, zero if there are no points. The weight is ignored. */
+};
+
+/**
+ * @brief Convert a ReductionType enum value to a string. Useful for debugging and logging.
+ * @param reduction_type The ReductionType value to convert.
+ * @return String representation of the reduction type.
+ * @throws std::invalid_argument if the value is invalid.
+ */
+inline std::string ReductionTypeToString(ReductionType reduction_type)
+{
+    switch (reduction_type)
+    {
+        case ReductionType::Sum:
+            return "Sum";
+        case ReductionType::Mean:
+            return "Mean";
+        case ReductionType::Min:
+            return "Min";
+        case ReductionType::Max:
+            return "Max";
+        case ReductionType::L1Norm:
+            return "L1Norm";
+        case ReductionType::L2Norm:
+            return "L2Norm";
+        case ReductionType::MaxNorm:
+            return "MaxNorm";
+        default:
+            throw std::invalid_argument("ReductionTypeToString Invalid ReductionType specified.");
+    }
+}
+
+/**
+ * @brief A global reduction of one component of a field, see Reduce.
+ *
+ * Every point of the field is visited once, using Field::OwnedBox, so points shared by neighboring boxes of staggered
+ * fields are not counted twice. The optional weight (e.g. the cell area or volume) and mask must have the same layout
+ * as the field and only their first component is used.
+ */
+struct Reduction
+{
+    std::shared_ptr<const Field> field;            /**< Field to reduce. */
+    ReductionType type;                            /**< How to combine the values. */
+    int component                       = 0;       /**< Component of the field to reduce. */
+    std::shared_ptr<const Field> weight = nullptr; /**< Weight of each point, 1 if null. */
+    std::shared_ptr<const Field> mask   = nullptr; /**< Points where the mask is zero are skipped, none if null. */
+};
+
+/**
+ * @brief Compute several global reductions at once. Must be called by all ranks with the same reductions.
+ *
+ * The result is bit-identical for any box decomposition, number of ranks and number of threads: sums are computed
+ * with ReproducibleSum and minima and maxima do not depend on the order of the values. The reductions over fields
+ * with the same layout are computed in a single pass over their boxes, and all reductions share one MPI_Allreduce.
+ * A NaN value, or for sums any non-finite value, makes the result NaN.
+ *
+ * @param reductions Reductions to compute.
+ * @return The result of each reduction, in order, on every rank.
+ * @throws std::invalid_argument if a field is null, a component is out of range, or a weight or mask does not have
+ * the layout of its field.
+ * @throws std::runtime_error if a sum is out of the range of ReproducibleSum.
+ */
+std::vector<double> Reduce(const std::vector<Reduction>& reductions);
+
+/**
+ * @brief Compute a single global reduction, see Reduce. Must be called by all ranks.
+ * @param reduction Reduction to compute.
+ * @return The result on every rank.
+ * @throws std::invalid_argument if the reduction is invalid.
+ * @throws std::runtime_error if a sum is out of the range of ReproducibleSum.
+ */
+double Reduce(const Reduction& reduction);
+
+}  // namespace turbo
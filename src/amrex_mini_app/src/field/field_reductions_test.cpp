@@ -0,0 +1,291 @@
+#include "field_reductions.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Reproducible sum tests
+//---------------------------------------------------------------------------//
+
+TEST(ReproducibleSumTest, OrderIndependent)
+{
+    // Values over 40 orders of magnitude, of both signs, which a floating point sum rounds differently in every order
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-20, 20);
+    std::vector<double> values(10000);
+    for (double& value : values)
+    {
+        value = mantissa(generator) * std::pow(10.0, exponent(generator));
+    }
+
+    ReproducibleSum forward;
+    for (const double value : values)
+    {
+        forward.Add(value);
+    }
+
+    std::shuffle(values.begin(), values.end(), generator);
+    ReproducibleSum first_half, second_half;
+    for (std::size_t index = 0; index < values.size(); ++index)
+    {
+        (index < values.size() / 3 ? first_half : second_half).Add(values[index]);
+    }
+    second_half += first_half;
+
+    EXPECT_EQ(forward.GetLimbs(), second_half.GetLimbs());
+    EXPECT_EQ(forward.Value(), second_half.Value());
+}
+
+TEST(ReproducibleSumTest, Exact)
+{
+    ReproducibleSum sum;
+    sum.Add(1.0e20);
+    sum.Add(1.0);
+    sum.Add(-1.0e20);
+    EXPECT_EQ(sum.Value(), 1.0);
+
+    // Many small values that a floating point sum of the large value would lose
+    ReproducibleSum small;
+    small.Add(1.0);
+    for (int index = 0; index < 1000; ++index)
+    {
+        small.Add(0x1p-60);
+    }
+    EXPECT_EQ(small.Value(), 1.0 + 1000 * 0x1p-60);
+
+    EXPECT_EQ(ReproducibleSum().Value(), 0.0);
+}
+
+TEST(ReproducibleSumTest, PackUnpack)
+{
+    ReproducibleSum a, b;
+    a.Add(3.25);
+    a.Add(-1.0e-30);
+    b.Add(-7.5);
+    b.Add(2.0e30);
+
+    // Adding the packed integers, as the MPI reduction does, gives the same sum as adding the sums
+    std::vector<std::int64_t> packed_a(ReproducibleSum::kNPacked), packed_b(ReproducibleSum::kNPacked);
+    a.Pack(packed_a.data());
+    b.Pack(packed_b.data());
+    for (int index = 0; index < ReproducibleSum::kNPacked; ++index)
+    {
+        packed_a[index] += packed_b[index];
+    }
+
+    ReproducibleSum expected = a;
+    expected += b;
+    EXPECT_EQ(ReproducibleSum::Unpack(packed_a.data()).GetLimbs(), expected.GetLimbs());
+}
+
+TEST(ReproducibleSumTest, NonFiniteAndOutOfRange)
+{
+    ReproducibleSum nan;
+    nan.Add(1.0);
+    nan.Add(std::numeric_limits<double>::infinity());
+    EXPECT_TRUE(std::isnan(nan.Value()));
+
+    ReproducibleSum out_of_range;
+    out_of_range.Add(1.0e42);
+    EXPECT_THROW(out_of_range.Value(), std::runtime_error);
+
+    ReproducibleSum in_range;
+    in_range.Add(1.0e41);
+    EXPECT_EQ(in_range.Value(), 1.0e41);
+}
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for field reduction tests
+//---------------------------------------------------------------------------//
+
+class FieldReductionsTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        grid = std::make_shared<CartesianGrid>(std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0),
+                                               n_cell_x, n_cell_y, n_cell_z);
+    }
+
+    /**
+     * @brief Make a field with values over many orders of magnitude that only depend on the indices.
+     */
+    std::shared_ptr<Field> MakeField(const FieldGridStagger stagger, const BoxDecomposition& box_decomposition) const
+    {
+        auto field = std::make_shared<Field>("field", grid, stagger, 2, 1, FoldParity::Scalar, box_decomposition);
+        amrex::MultiFab& mf = *field->multifab;
+        mf.setVal(std::numeric_limits<double>::quiet_NaN());
+        for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), mf.nComp(),
+                               [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                               {
+                                   array(i, j, k, n) = std::sin(1.0 + i + 7.0 * j + 13.0 * k + n) *
+                                                       std::pow(10.0, (i * 7 + j * 3 + k) % 17 - 8);
+                               });
+        }
+        return field;
+    }
+
+    /**
+     * @brief Make a field with the given value in every point.
+     */
+    std::shared_ptr<Field> MakeConstantField(const FieldGridStagger stagger, const BoxDecomposition& box_decomposition,
+                                             const double value) const
+    {
+        auto field = std::make_shared<Field>("constant", grid, stagger, 1, 0, FoldParity::Scalar, box_decomposition);
+        field->multifab->setVal(value);
+        return field;
+    }
+
+    const int n_cell_x = 30;
+    const int n_cell_y = 20;
+    const int n_cell_z = 6;
+
+    std::shared_ptr<CartesianGrid> grid;
+};
+
+//---------------------------------------------------------------------------//
+// Field reduction tests
+//---------------------------------------------------------------------------//
+
+TEST_F(FieldReductionsTest, DecompositionIndependent)
+{
+    const std::vector<BoxDecomposition> box_decompositions = {
+        BoxDecomposition(), BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 4, 2))),
+        BoxDecomposition::Layout(3, 2), BoxDecomposition::Layout(7, 5)};
+    const std::vector<ReductionType> types = {ReductionType::Sum,    ReductionType::Mean,   ReductionType::Min,
+                                              ReductionType::Max,    ReductionType::L1Norm, ReductionType::L2Norm,
+                                              ReductionType::MaxNorm};
+
+    for (const FieldGridStagger stagger : {FieldGridStagger::CellCentered, FieldGridStagger::Nodal})
+    {
+        std::vector<double> expected;
+        for (const BoxDecomposition& box_decomposition : box_decompositions)
+        {
+            const std::shared_ptr<Field> field  = MakeField(stagger, box_decomposition);
+            const std::shared_ptr<Field> weight = MakeConstantField(stagger, box_decomposition, 0.1);
+
+            std::vector<Reduction> reductions;
+            for (const ReductionType type : types)
+            {
+                reductions.push_back({field, type, 1, weight});
+            }
+            const std::vector<double> results = Reduce(reductions);
+            ASSERT_EQ(results.size(), types.size());
+
+            if (expected.empty())
+            {
+                expected = results;
+                continue;
+            }
+            for (std::size_t index = 0; index < types.size(); ++index)
+            {
+                EXPECT_EQ(results[index], expected[index])
+                    << ReductionTypeToString(types[index]) << " with " << box_decomposition;
+            }
+        }
+    }
+}
+
+TEST_F(FieldReductionsTest, Values)
+{
+    // Points shared by neighboring boxes of staggered fields are counted once
+    for (const FieldGridStagger stagger : {FieldGridStagger::CellCentered, FieldGridStagger::IFace,
+                                           FieldGridStagger::JFace, FieldGridStagger::KFace, FieldGridStagger::Nodal})
+    {
+        const std::shared_ptr<Field> ones = MakeConstantField(stagger, BoxDecomposition::Layout(3, 2), 1.0);
+        const double n_point              = static_cast<double>(ones->multifab->boxArray().minimalBox().numPts());
+        EXPECT_EQ(Reduce({ones, ReductionType::Sum}), n_point) << FieldGridStaggerToString(stagger);
+    }
+
+    const BoxDecomposition layout       = BoxDecomposition::Layout(3, 2);
+    const std::shared_ptr<Field> field  = MakeConstantField(FieldGridStagger::CellCentered, layout, -2.0);
+    const std::shared_ptr<Field> weight = MakeConstantField(FieldGridStagger::CellCentered, layout, 0.5);
+    const double n_cell                 = static_cast<double>(n_cell_x * n_cell_y * n_cell_z);
+
+    const std::vector<double> results = Reduce({{field, ReductionType::Sum, 0, weight},
+                                                {field, ReductionType::Mean, 0, weight},
+                                                {field, ReductionType::Min},
+                                                {field, ReductionType::Max},
+                                                {field, ReductionType::L1Norm, 0, weight},
+                                                {field, ReductionType::L2Norm, 0, weight},
+                                                {field, ReductionType::MaxNorm}});
+    EXPECT_EQ(results[0], -1.0 * n_cell);
+    EXPECT_EQ(results[1], -2.0);
+    EXPECT_EQ(results[2], -2.0);
+    EXPECT_EQ(results[3], -2.0);
+    EXPECT_EQ(results[4], 1.0 * n_cell);
+    EXPECT_DOUBLE_EQ(results[5], std::sqrt(2.0 * n_cell));
+    EXPECT_EQ(results[6], 2.0);
+}
+
+TEST_F(FieldReductionsTest, Mask)
+{
+    const BoxDecomposition layout      = BoxDecomposition::Layout(3, 2);
+    const std::shared_ptr<Field> field = MakeField(FieldGridStagger::CellCentered, layout);
+    const std::shared_ptr<Field> mask  = MakeConstantField(FieldGridStagger::CellCentered, layout, 0.0);
+
+    // Only the cells with i == 0 are in the mask
+    for (amrex::MFIter mfi(*mask->multifab); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real>& array = mask->multifab->array(mfi);
+        amrex::ParallelFor(mfi.validbox(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k) { array(i, j, k) = (i == 0) ? 1.0 : 0.0; });
+    }
+    const std::shared_ptr<Field> ones = MakeConstantField(FieldGridStagger::CellCentered, layout, 1.0);
+    EXPECT_EQ(Reduce({ones, ReductionType::Sum, 0, nullptr, mask}), static_cast<double>(n_cell_y * n_cell_z));
+
+    const double masked_max = Reduce({field, ReductionType::Max, 0, nullptr, mask});
+    EXPECT_LE(masked_max, Reduce({field, ReductionType::Max}));
+
+    // Nothing in the mask
+    const std::shared_ptr<Field> empty = MakeConstantField(FieldGridStagger::CellCentered, layout, 0.0);
+    const std::vector<double> results  = Reduce({{field, ReductionType::Sum, 0, nullptr, empty},
+                                                 {field, ReductionType::Mean, 0, nullptr, empty},
+                                                 {field, ReductionType::Min, 0, nullptr, empty},
+                                                 {field, ReductionType::Max, 0, nullptr, empty},
+                                                 {field, ReductionType::MaxNorm, 0, nullptr, empty}});
+    EXPECT_EQ(results[0], 0.0);
+    EXPECT_TRUE(std::isnan(results[1]));
+    EXPECT_EQ(results[2], std::numeric_limits<double>::infinity());
+    EXPECT_EQ(results[3], -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(results[4], 0.0);
+}
+
+TEST_F(FieldReductionsTest, InvalidInput)
+{
+    const BoxDecomposition layout      = BoxDecomposition::Layout(3, 2);
+    const std::shared_ptr<Field> field = MakeField(FieldGridStagger::CellCentered, layout);
+    const std::shared_ptr<Field> other = MakeConstantField(FieldGridStagger::CellCentered, BoxDecomposition(), 1.0);
+    const std::shared_ptr<Field> nodal = MakeConstantField(FieldGridStagger::Nodal, layout, 1.0);
+
+    EXPECT_THROW(Reduce({nullptr, ReductionType::Sum}), std::invalid_argument);
+    EXPECT_THROW(Reduce({field, ReductionType::Sum, 2}), std::invalid_argument);
+    EXPECT_THROW(Reduce({field, ReductionType::Sum, -1}), std::invalid_argument);
+    EXPECT_THROW(Reduce({field, ReductionType::Sum, 0, other}), std::invalid_argument);
+    EXPECT_THROW(Reduce({field, ReductionType::Sum, 0, nullptr, nodal}), std::invalid_argument);
+    EXPECT_TRUE(Reduce(std::vector<Reduction>{}).empty());
+}
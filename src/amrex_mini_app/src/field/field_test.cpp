@@ -2,13 +2,18 @@
 
 #include <AMReX.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <H5DSpublic.h>
 #include <gtest/gtest.h>
 
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "amrex_test_environment.h"
+#include "box_decomposition.h"
 #include "cartesian_grid.h"
 #include "geometry.h"
 
@@ -143,6 +148,35 @@ TEST_F(FieldTest, Constructor)
     }
 }
 
+TEST_F(FieldTest, ConstructorWithLayout)
+{
+    const amrex::BoxArray cell_box_array = BoxDecomposition().MakeBoxArray(CellDomain(*grid));
+    const amrex::DistributionMapping distribution_mapping(cell_box_array);
+    const amrex::BoxArray node_box_array = amrex::convert(cell_box_array, amrex::IndexType::TheNodeType());
+
+    Field field("field", grid, FieldGridStagger::Nodal, 2, 1, node_box_array, distribution_mapping);
+    EXPECT_EQ(field.multifab->boxArray(), node_box_array);
+    EXPECT_EQ(field.multifab->DistributionMap(), distribution_mapping);
+    EXPECT_EQ(field.multifab->nComp(), 2);
+    EXPECT_EQ(field.multifab->nGrow(), 1);
+
+    // Expect constructor to throw with invalid input
+    EXPECT_THROW(Field("invalid_field_because_nullptr_grid", nullptr, FieldGridStagger::Nodal, 1, 0, node_box_array,
+                       distribution_mapping),
+                 std::invalid_argument);
+    EXPECT_THROW(Field("invalid_field_because_0_components", grid, FieldGridStagger::Nodal, 0, 0, node_box_array,
+                       distribution_mapping),
+                 std::invalid_argument);
+    EXPECT_THROW(Field("invalid_field_because_index_type", grid, FieldGridStagger::CellCentered, 1, 0, node_box_array,
+                       distribution_mapping),
+                 std::invalid_argument);
+
+    const amrex::BoxArray too_small_box_array(amrex::Box(amrex::IntVect(0, 0, 0), amrex::IntVect(0, 0, 0)));
+    EXPECT_THROW(Field("invalid_field_because_too_small", grid, FieldGridStagger::CellCentered, 1, 0,
+                       too_small_box_array, amrex::DistributionMapping(too_small_box_array)),
+                 std::invalid_argument);
+}
+
 TEST_F(FieldTest, StaggerChecks)
 {
     std::size_t n_component = 1;
@@ -268,8 +302,12 @@ TEST_F(FieldTest, GetGridPoint)
 
         auto [i_size, j_size, k_size] = GridSizeHelper(field_grid_stagger);
 
+        const Grid::CoordinateTable& coordinates = field.GetGridCoordinates();
+        const CartesianGridView grid_view        = field.GetGridView();
+
         // Loop over grid, for this stagger, and and compare with the location of each grid point with the location from
-        // field.GetGridPoint. They should match.
+        // field.GetGridPoint, the unchecked field.GetGridCoordinates table, and the field.GetGridView view. They should
+        // match.
         for (std::size_t i = 0; i < i_size; ++i)
         {
             for (std::size_t j = 0; j < j_size; ++j)
@@ -282,6 +320,8 @@ TEST_F(FieldTest, GetGridPoint)
                         << "Field location does not match expected location for field stagger "
                         << FieldGridStaggerToString(field_grid_stagger) << " at indices (" << i << "," << j << "," << k
                         << ")";
+                    EXPECT_EQ(grid_location, coordinates(i, j, k));
+                    EXPECT_EQ(grid_location, grid_view(i, j, k));
                 }
             }
         }
@@ -304,6 +344,140 @@ TEST_F(FieldTest, GetGridPoint)
     }
 }
 
+TEST_F(FieldTest, FillBoundary)
+{
+    // On a Cartesian grid, FillBoundary only fills ghost cells that overlap valid cells of other boxes. Use a grid with
+    // more cells than the maximum box size so there are several boxes.
+    const int n_cell_x = 80;
+    const int n_cell_y = 40;
+    const int n_cell_z = 2;
+    const std::shared_ptr<CartesianGrid> multi_box_grid =
+        std::make_shared<CartesianGrid>(geometry, n_cell_x, n_cell_y, n_cell_z);
+
+    Field field("field", multi_box_grid, FieldGridStagger::CellCentered, 1, 1);
+    amrex::MultiFab& mf = *field.multifab;
+
+    mf.setVal(-1.0);
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+        amrex::ParallelFor(mfi.validbox(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k) { array(i, j, k) = 1.0 + i + 100.0 * j; });
+    }
+
+    field.FillBoundary();
+
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<const amrex::Real>& array = mf.const_array(mfi);
+        amrex::ParallelFor(mfi.fabbox(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k)
+                           {
+                               const bool inside_domain =
+                                   i >= 0 && i < n_cell_x && j >= 0 && j < n_cell_y && k >= 0 && k < n_cell_z;
+                               EXPECT_EQ(array(i, j, k), inside_domain ? 1.0 + i + 100.0 * j : -1.0);
+                           });
+    }
+}
+
+TEST_F(FieldTest, FillBoundaryStartFinish)
+{
+    const int n_cell_x = 80;
+    const int n_cell_y = 40;
+    const int n_cell_z = 2;
+    const std::shared_ptr<CartesianGrid> multi_box_grid =
+        std::make_shared<CartesianGrid>(geometry, n_cell_x, n_cell_y, n_cell_z);
+
+    Field field("field", multi_box_grid, FieldGridStagger::CellCentered, 1, 1);
+    amrex::MultiFab& mf = *field.multifab;
+    mf.setVal(-1.0);
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+        amrex::ParallelFor(mfi.validbox(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k) { array(i, j, k) = 1.0 + i + 100.0 * j; });
+    }
+
+    // Overlap a 5-point Laplacian of the interior of each box with the exchange, then do the boundary strips
+    amrex::MultiFab laplacian(mf.boxArray(), mf.DistributionMap(), 1, 0);
+    auto apply_laplacian = [&mf, &laplacian](const amrex::MFIter& mfi, const amrex::Box& box)
+    {
+        const amrex::Array4<const amrex::Real>& input = mf.const_array(mfi);
+        const amrex::Array4<amrex::Real>& output      = laplacian.array(mfi);
+        amrex::ParallelFor(box,
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k)
+                           {
+                               output(i, j, k) = input(i - 1, j, k) + input(i + 1, j, k) + input(i, j - 1, k) +
+                                                 input(i, j + 1, k) - 4.0 * input(i, j, k);
+                           });
+    };
+
+    field.FillBoundaryStart();
+    EXPECT_THROW(field.FillBoundaryStart(), std::logic_error);
+    EXPECT_THROW(field.FillBoundary(), std::logic_error);
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        apply_laplacian(mfi, field.InteriorBox(mfi.validbox()));
+    }
+    field.FillBoundaryFinish();
+    EXPECT_THROW(field.FillBoundaryFinish(), std::logic_error);
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        for (const amrex::Box& box : field.BoundaryBoxes(mfi.validbox()))
+        {
+            apply_laplacian(mfi, box);
+        }
+    }
+
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<const amrex::Real>& ghosts = mf.const_array(mfi);
+        amrex::ParallelFor(mfi.fabbox(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k)
+                           {
+                               const bool inside_domain =
+                                   i >= 0 && i < n_cell_x && j >= 0 && j < n_cell_y && k >= 0 && k < n_cell_z;
+                               EXPECT_EQ(ghosts(i, j, k), inside_domain ? 1.0 + i + 100.0 * j : -1.0);
+                           });
+
+        // The field is linear, so the Laplacian vanishes away from the domain boundary
+        const amrex::Array4<const amrex::Real>& output = laplacian.const_array(mfi);
+        amrex::ParallelFor(mfi.validbox(),
+                           [=] AMREX_GPU_DEVICE(int i, int j, int k)
+                           {
+                               if (i > 0 && i < n_cell_x - 1 && j > 0 && j < n_cell_y - 1)
+                               {
+                                   EXPECT_EQ(output(i, j, k), 0.0) << "at (" << i << "," << j << "," << k << ")";
+                               }
+                           });
+    }
+}
+
+TEST_F(FieldTest, InteriorAndBoundaryBoxes)
+{
+    Field field("field", grid, FieldGridStagger::CellCentered, 1, 1);
+
+    const amrex::Box valid_box(amrex::IntVect(0, 0, 0), amrex::IntVect(9, 7, 5));
+    const amrex::Box interior_box = field.InteriorBox(valid_box);
+    EXPECT_EQ(interior_box, amrex::Box(amrex::IntVect(1, 1, 1), amrex::IntVect(8, 6, 4)));
+
+    // The boundary boxes and the interior partition the valid box
+    const amrex::BoxList boundary_boxes = field.BoundaryBoxes(valid_box);
+    amrex::Long n_point                 = interior_box.numPts();
+    for (const amrex::Box& box : boundary_boxes)
+    {
+        EXPECT_TRUE(valid_box.contains(box));
+        EXPECT_FALSE(box.intersects(interior_box));
+        n_point += box.numPts();
+    }
+    EXPECT_EQ(n_point, valid_box.numPts());
+
+    // Too small for an interior, so everything is boundary
+    const amrex::Box thin_box(amrex::IntVect(0, 0, 0), amrex::IntVect(9, 1, 5));
+    EXPECT_FALSE(field.InteriorBox(thin_box).ok());
+    EXPECT_EQ(field.BoundaryBoxes(thin_box).numPts(), thin_box.numPts());
+}
+
 TEST_F(FieldTest, WriteHDF5)
 {
     Field::NameType name     = "test_field";
@@ -325,4 +499,405 @@ TEST_F(FieldTest, WriteHDF5)
         const std::string filename = "Test_Output_Field_WriteHDF5_via_filename.h5";
         field.WriteHDF5(filename);
     }
-}
\ No newline at end of file
+
+    // A failed write closes the file, so it can be written again
+    {
+        const std::string filename = "Test_Output_Field_WriteHDF5_failed.h5";
+        const ssize_t n_open_file  = H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_FILE);
+        EXPECT_THROW(WriteHDF5File(
+                         filename, HDF5WriteMode::Gather,
+                         [](const hid_t) { throw std::runtime_error("Test: Failed write."); }, [](const hid_t) {}),
+                     std::runtime_error);
+        EXPECT_EQ(H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_FILE), n_open_file);
+        EXPECT_NO_THROW(field.WriteHDF5(filename));
+    }
+}
+
+TEST_F(FieldTest, WriteHDF5Collective)
+{
+    // Use a grid larger than the maximum box size so the field is split into several boxes and every rank writes more
+    // than one hyperslab.
+    const std::shared_ptr<CartesianGrid> multi_box_grid = std::make_shared<CartesianGrid>(geometry, 40, 36, 8);
+
+#ifdef H5_HAVE_PARALLEL
+    // Helper to read back a whole dataset on the IO processor
+    auto ReadDataset = [](const std::string& filename, const std::string& dataset_name) -> std::vector<double>
+    {
+        const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        const hid_t dataset_id = H5Dopen2(file_id, dataset_name.c_str(), H5P_DEFAULT);
+        const hid_t space_id   = H5Dget_space(dataset_id);
+        std::vector<double> data(H5Sget_simple_extent_npoints(space_id));
+        H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+        H5Sclose(space_id);
+        H5Dclose(dataset_id);
+        H5Fclose(file_id);
+        return data;
+    };
+#endif
+
+    const std::size_t n_ghost = 1;
+    for (std::size_t n_component : {1, 3})
+    {
+        for (const FieldGridStagger field_grid_stagger :
+             {FieldGridStagger::Nodal, FieldGridStagger::CellCentered, FieldGridStagger::IFace,
+              FieldGridStagger::JFace, FieldGridStagger::KFace})
+        {
+            Field::NameType field_name = "field_" + FieldGridStaggerToString(field_grid_stagger);
+            Field field(field_name, multi_box_grid, field_grid_stagger, n_component, n_ghost);
+
+            // Give every point a unique value so any misplaced hyperslab shows up in the comparison
+            for (amrex::MFIter mfi(*field.multifab); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<amrex::Real>& array = field.multifab->array(mfi);
+                amrex::ParallelFor(mfi.validbox(), n_component,
+                                   [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   { array(i, j, k, n) = i + 100.0 * j + 10000.0 * k + 1000000.0 * n; });
+            }
+
+            const std::string gather_filename     = "Test_Output_Field_WriteHDF5_Gather.h5";
+            const std::string collective_filename = "Test_Output_Field_WriteHDF5_Collective.h5";
+            field.WriteHDF5(gather_filename, HDF5WriteMode::Gather);
+
+#ifdef H5_HAVE_PARALLEL
+            field.WriteHDF5(collective_filename, HDF5WriteMode::Collective);
+
+            // Both write modes should produce exactly the same dataset
+            if (amrex::ParallelDescriptor::IOProcessor())
+            {
+                EXPECT_EQ(ReadDataset(gather_filename, field_name), ReadDataset(collective_filename, field_name))
+                    << "Collective write does not match gathered write for field stagger "
+                    << FieldGridStaggerToString(field_grid_stagger) << " with " << n_component << " components";
+            }
+#else
+            // Without parallel HDF5 asking for MPI-IO should fail loudly instead of silently falling back
+            EXPECT_THROW(field.WriteHDF5(collective_filename, HDF5WriteMode::Collective), std::runtime_error);
+#endif
+        }
+    }
+}
+
+TEST_F(FieldTest, ReadHDF5)
+{
+    const std::shared_ptr<CartesianGrid> multi_box_grid = std::make_shared<CartesianGrid>(geometry, 20, 12, 8);
+
+    // Write with one decomposition and read with another, like a restart on a different number of ranks
+    const BoxDecomposition write_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 8, 8)));
+    const BoxDecomposition read_decomposition  = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(4, 12, 4)));
+
+    auto value = [](int i, int j, int k, int n) { return i + 100.0 * j + 10000.0 * k + 1000000.0 * n; };
+
+    const std::size_t n_ghost = 1;
+    for (const HDF5DataLayout data_layout : {HDF5DataLayout::RowMajor, HDF5DataLayout::ColumnMajor})
+    {
+        for (const std::size_t n_component : {1, 3})
+        {
+            for (const FieldGridStagger field_grid_stagger : {FieldGridStagger::Nodal, FieldGridStagger::CellCentered,
+                                                              FieldGridStagger::IFace, FieldGridStagger::KFace})
+            {
+                const Field::NameType field_name = "field_" + FieldGridStaggerToString(field_grid_stagger);
+                Field written(field_name, multi_box_grid, field_grid_stagger, n_component, n_ghost, FoldParity::Scalar,
+                              write_decomposition);
+                written.hdf5_options             = HDF5Options::Compressed(1);
+                written.hdf5_options.data_layout = data_layout;
+                for (amrex::MFIter mfi(*written.multifab); mfi.isValid(); ++mfi)
+                {
+                    const amrex::Array4<amrex::Real>& array = written.multifab->array(mfi);
+                    amrex::ParallelFor(mfi.validbox(), n_component, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       { array(i, j, k, n) = value(i, j, k, n); });
+                }
+                const std::string filename = "Test_Output_Field_ReadHDF5.h5";
+                written.WriteHDF5(filename);
+
+                for (const bool read_ghost : {false, true})
+                {
+                    Field read(field_name, multi_box_grid, field_grid_stagger, n_component, n_ghost,
+                               FoldParity::Scalar, read_decomposition);
+                    read.multifab->setVal(-1.0);
+                    read.ReadHDF5(filename, HDF5ReadMode::Independent, read_ghost);
+
+                    const amrex::Box domain_box = read.multifab->boxArray().minimalBox();
+                    for (amrex::MFIter mfi(*read.multifab); mfi.isValid(); ++mfi)
+                    {
+                        // Points outside of what was read keep their initial value
+                        const amrex::Box read_box = read_ghost ? (mfi.fabbox() & domain_box) : mfi.validbox();
+                        const amrex::Array4<const amrex::Real>& array = read.multifab->const_array(mfi);
+                        for (int n = 0; n < static_cast<int>(n_component); ++n)
+                        {
+                            amrex::LoopOnCpu(mfi.fabbox(),
+                                             [&](int i, int j, int k)
+                                             {
+                                                 const amrex::IntVect point(AMREX_D_DECL(i, j, k));
+                                                 const double expected =
+                                                     read_box.contains(point) ? value(i, j, k, n) : -1.0;
+                                                 ASSERT_EQ(array(i, j, k, n), expected)
+                                                     << HDF5DataLayoutToString(data_layout) << " "
+                                                     << FieldGridStaggerToString(field_grid_stagger) << " at (" << i
+                                                     << ", " << j << ", " << k << ", " << n << ")";
+                                             });
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(FieldTest, ReadHDF5Mismatch)
+{
+    Field field("test_field", grid, FieldGridStagger::CellCentered, 2, 0);
+    const std::string filename = "Test_Output_Field_ReadHDF5_Mismatch.h5";
+    field.WriteHDF5(filename);
+
+    EXPECT_THROW(OpenHDF5File("Test_Output_Field_ReadHDF5_Missing.h5", HDF5ReadMode::Independent),
+                 std::runtime_error);
+
+    Field other_name("other_field", grid, FieldGridStagger::CellCentered, 2, 0);
+    EXPECT_THROW(other_name.ReadHDF5(filename), std::runtime_error);
+    Field other_stagger("test_field", grid, FieldGridStagger::Nodal, 2, 0);
+    EXPECT_THROW(other_stagger.ReadHDF5(filename), std::runtime_error);
+    Field other_n_component("test_field", grid, FieldGridStagger::CellCentered, 1, 0);
+    EXPECT_THROW(other_n_component.ReadHDF5(filename), std::runtime_error);
+    const std::shared_ptr<CartesianGrid> other_grid = std::make_shared<CartesianGrid>(geometry, 2, 3, 5);
+    Field other_size("test_field", other_grid, FieldGridStagger::CellCentered, 2, 0);
+    EXPECT_THROW(other_size.ReadHDF5(filename), std::runtime_error);
+    EXPECT_THROW(field.ReadHDF5(filename, static_cast<HDF5ReadMode>(-1)), std::invalid_argument);
+
+#ifndef H5_HAVE_PARALLEL
+    EXPECT_THROW(field.ReadHDF5(filename, HDF5ReadMode::Collective), std::runtime_error);
+#endif
+    EXPECT_NO_THROW(field.ReadHDF5(filename));
+}
+
+TEST_F(FieldTest, ReadHDF5TimeSeries)
+{
+    Field field("test_field", grid, FieldGridStagger::CellCentered, 1, 0);
+    const std::string filename = "Test_Output_Field_ReadHDF5_TimeSeries.h5";
+    {
+        const hid_t file_id = CreateHDF5File(filename, HDF5WriteMode::Gather);
+        field.CreateHDF5TimeSeries(file_id);
+        for (hsize_t time_index = 0; time_index < 3; ++time_index)
+        {
+            field.multifab->setVal(static_cast<double>(time_index));
+            field.AppendHDF5(file_id, time_index);
+        }
+        if (file_id >= 0)
+        {
+            H5Fclose(file_id);
+        }
+    }
+    amrex::ParallelDescriptor::Barrier();
+
+    const hid_t file_id = OpenHDF5File(filename, HDF5ReadMode::Independent);
+    field.ReadHDF5(file_id, HDF5ReadMode::Independent, false, 1);
+    EXPECT_EQ(field.multifab->min(0), 1.0);
+    EXPECT_EQ(field.multifab->max(0), 1.0);
+    EXPECT_THROW(field.ReadHDF5(file_id, HDF5ReadMode::Independent, false, 3), std::runtime_error);
+    H5Fclose(file_id);
+}
+
+TEST_F(FieldTest, WriteHDF5FilePerRank)
+{
+    EXPECT_EQ(HDF5RankFilename("output.h5", 3), "output.rank00003.h5");
+    EXPECT_EQ(HDF5RankFilename("run/output.h5", 123456), "run/output.rank123456.h5");
+
+    auto ReadDataset = [](const std::string& filename, const std::string& dataset_name) -> std::vector<double>
+    {
+        const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        const hid_t dataset_id = H5Dopen2(file_id, dataset_name.c_str(), H5P_DEFAULT);
+        const hid_t space_id   = H5Dget_space(dataset_id);
+        std::vector<double> data(H5Sget_simple_extent_npoints(space_id));
+        H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+        H5Sclose(space_id);
+        H5Dclose(dataset_id);
+        H5Fclose(file_id);
+        return data;
+    };
+
+    const std::shared_ptr<CartesianGrid> multi_box_grid = std::make_shared<CartesianGrid>(geometry, 20, 12, 8);
+    const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 4, 8)));
+    for (const HDF5DataLayout data_layout : {HDF5DataLayout::RowMajor, HDF5DataLayout::ColumnMajor})
+    {
+        for (const std::size_t n_component : {1, 3})
+        {
+            for (const FieldGridStagger field_grid_stagger :
+                 {FieldGridStagger::Nodal, FieldGridStagger::CellCentered, FieldGridStagger::JFace})
+            {
+                const Field::NameType field_name = "field_" + FieldGridStaggerToString(field_grid_stagger);
+                Field field(field_name, multi_box_grid, field_grid_stagger, n_component, 1, FoldParity::Scalar,
+                            box_decomposition);
+                field.hdf5_options             = HDF5Options::Compressed(1);
+                field.hdf5_options.data_layout = data_layout;
+                for (amrex::MFIter mfi(*field.multifab); mfi.isValid(); ++mfi)
+                {
+                    const amrex::Array4<amrex::Real>& array = field.multifab->array(mfi);
+                    amrex::ParallelFor(mfi.validbox(), n_component,
+                                       [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       { array(i, j, k, n) = i + 100.0 * j + 10000.0 * k + 1000000.0 * n; });
+                }
+
+                const std::string gather_filename        = "Test_Output_Field_WriteHDF5_Gather.h5";
+                const std::string file_per_rank_filename = "Test_Output_Field_WriteHDF5_FilePerRank.h5";
+                field.WriteHDF5(gather_filename, HDF5WriteMode::Gather);
+                field.WriteHDF5(file_per_rank_filename, HDF5WriteMode::FilePerRank);
+
+                // The virtual dataset of the master file reads as the dataset of the other modes
+                if (amrex::ParallelDescriptor::IOProcessor())
+                {
+                    EXPECT_EQ(ReadDataset(gather_filename, field_name),
+                              ReadDataset(file_per_rank_filename, field_name))
+                        << "File per rank write does not match gathered write for field stagger "
+                        << FieldGridStaggerToString(field_grid_stagger) << " with " << n_component << " components";
+                }
+
+                // And can be read back like any other dataset
+                Field read(field_name, multi_box_grid, field_grid_stagger, n_component, 0);
+                read.ReadHDF5(file_per_rank_filename);
+                for (int n = 0; n < static_cast<int>(n_component); ++n)
+                {
+                    EXPECT_EQ(read.multifab->min(n), field.multifab->min(n));
+                    EXPECT_EQ(read.multifab->max(n), field.multifab->max(n));
+                }
+                amrex::ParallelDescriptor::Barrier();
+            }
+        }
+    }
+
+    // Time series need a single file
+    Field field("test_field", grid, FieldGridStagger::CellCentered, 1, 0);
+    EXPECT_THROW(field.CreateHDF5TimeSeries(H5I_INVALID_HID, HDF5WriteMode::FilePerRank), std::invalid_argument);
+    EXPECT_THROW(field.AppendHDF5(H5I_INVALID_HID, 0, HDF5WriteMode::FilePerRank), std::invalid_argument);
+}
+
+TEST_F(FieldTest, WriteHDF5Reduced)
+{
+    auto ReadDataset = [](const std::string& filename, const std::string& dataset_name) -> std::vector<double>
+    {
+        const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        const hid_t dataset_id = H5Dopen2(file_id, dataset_name.c_str(), H5P_DEFAULT);
+        const hid_t space_id   = H5Dget_space(dataset_id);
+        std::vector<double> data(H5Sget_simple_extent_npoints(space_id));
+        H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+        H5Sclose(space_id);
+        H5Dclose(dataset_id);
+        H5Fclose(file_id);
+        return data;
+    };
+
+    // Cells 4-15, 2-9 and 0-7 averaged in blocks of 2 x 2 x 4 cells. The chunked decomposition puts some blocks across
+    // the boxes of the field, the layout decomposition does not.
+    const std::shared_ptr<CartesianGrid> multi_box_grid = std::make_shared<CartesianGrid>(geometry, 20, 12, 8);
+    const std::array<int, 6> region                     = {4, 2, 0, 15, 9, 7};
+    const std::array<int, 3> ratio                      = {2, 2, 4};
+    for (const BoxDecomposition& box_decomposition :
+         {BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 4, 8))),
+          BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(5, 5, 8)))})
+    {
+        for (const FieldGridStagger field_grid_stagger :
+             {FieldGridStagger::CellCentered, FieldGridStagger::IFace, FieldGridStagger::Nodal})
+        {
+            const Field::NameType field_name = "field_" + FieldGridStaggerToString(field_grid_stagger);
+            Field field(field_name, multi_box_grid, field_grid_stagger, 1, 1, FoldParity::Scalar, box_decomposition);
+            field.hdf5_options.region           = region;
+            field.hdf5_options.coarsening_ratio = ratio;
+            for (amrex::MFIter mfi(*field.multifab); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<amrex::Real>& array = field.multifab->array(mfi);
+                amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE(int i, int j, int k)
+                                   { array(i, j, k) = i + 100.0 * j + 10000.0 * k; });
+            }
+
+            const std::string gather_filename        = "Test_Output_Field_WriteHDF5_Reduced_Gather.h5";
+            const std::string file_per_rank_filename = "Test_Output_Field_WriteHDF5_Reduced_FilePerRank.h5";
+            field.WriteHDF5(gather_filename, HDF5WriteMode::Gather);
+            field.WriteHDF5(file_per_rank_filename, HDF5WriteMode::FilePerRank);
+
+            if (amrex::ParallelDescriptor::IOProcessor())
+            {
+                // The mean of a linear field over a block is its value at the center of the block, and nodal
+                // directions take the first node of the block
+                const amrex::IndexType index_type = field.multifab->ixType();
+                std::array<int, 3> n_output;
+                std::array<double, 3> block_offset;
+                for (int direction = 0; direction < 3; ++direction)
+                {
+                    const bool nodal        = index_type.nodeCentered(direction);
+                    n_output[direction]     = (region[direction + 3] + 1 - region[direction]) / ratio[direction];
+                    n_output[direction]     = nodal ? n_output[direction] + 1 : n_output[direction];
+                    block_offset[direction] = nodal ? 0.0 : 0.5 * (ratio[direction] - 1);
+                }
+                std::vector<double> expected;
+                for (int i = 0; i < n_output[0]; ++i)
+                {
+                    for (int j = 0; j < n_output[1]; ++j)
+                    {
+                        for (int k = 0; k < n_output[2]; ++k)
+                        {
+                            expected.push_back(region[0] + i * ratio[0] + block_offset[0] +
+                                               100.0 * (region[1] + j * ratio[1] + block_offset[1]) +
+                                               10000.0 * (region[2] + k * ratio[2] + block_offset[2]));
+                        }
+                    }
+                }
+                EXPECT_EQ(ReadDataset(gather_filename, field_name), expected)
+                    << "Reduced write does not match the block means for field stagger "
+                    << FieldGridStaggerToString(field_grid_stagger);
+                EXPECT_EQ(ReadDataset(file_per_rank_filename, field_name), expected)
+                    << "Reduced file per rank write does not match the block means for field stagger "
+                    << FieldGridStaggerToString(field_grid_stagger);
+
+                // The coordinates are reduced like the data and label the dimensions of the dataset
+                const std::string location =
+                    field.IsCellCentered() ? "cell_center" : (field.IsNodal() ? "node" : "x_face");
+                const std::string grid_location = location + "_i4-15_j2-9_k0-7_r2x2x4";
+                const std::vector<double> x     = ReadDataset(gather_filename, grid_location + "/x");
+                ASSERT_EQ(x.size(), static_cast<std::size_t>(n_output[0]));
+                for (int i = 0; i < n_output[0]; ++i)
+                {
+                    const double x_expected = (region[0] + i * ratio[0] + block_offset[0]) / 20.0 +
+                                              (index_type.nodeCentered(0) ? 0.0 : 0.5 / 20.0);
+                    EXPECT_NEAR(x[i], x_expected, 1e-12);
+                }
+
+                const hid_t file_id    = H5Fopen(gather_filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                const hid_t dataset_id = H5Dopen2(file_id, field_name.c_str(), H5P_DEFAULT);
+                const hid_t x_id       = H5Dopen2(file_id, (grid_location + "/x").c_str(), H5P_DEFAULT);
+                EXPECT_GT(H5DSis_attached(dataset_id, x_id, 0), 0);
+                std::array<int, 6> region_attribute;
+                const hid_t attr_id = H5Aopen(dataset_id, "region", H5P_DEFAULT);
+                H5Aread(attr_id, H5T_NATIVE_INT, region_attribute.data());
+                EXPECT_EQ(region_attribute, region);
+                H5Aclose(attr_id);
+                H5Dclose(x_id);
+                H5Dclose(dataset_id);
+                H5Fclose(file_id);
+            }
+
+            // Time series are reduced in the same way
+            const std::string time_series_filename = "Test_Output_Field_WriteHDF5_Reduced_TimeSeries.h5";
+            {
+                const hid_t file_id = CreateHDF5File(time_series_filename, HDF5WriteMode::Gather);
+                field.CreateHDF5TimeSeries(file_id);
+                field.AppendHDF5(file_id, 0);
+                if (file_id >= 0)
+                {
+                    H5Fclose(file_id);
+                }
+            }
+            if (amrex::ParallelDescriptor::IOProcessor())
+            {
+                EXPECT_EQ(ReadDataset(time_series_filename, field_name), ReadDataset(gather_filename, field_name));
+            }
+            amrex::ParallelDescriptor::Barrier();
+        }
+    }
+
+    // The region has to be inside the grid and divide into blocks
+    Field field("test_field", multi_box_grid, FieldGridStagger::CellCentered, 1, 0);
+    field.hdf5_options.region = std::array<int, 6>{0, 0, 0, 20, 11, 7};
+    EXPECT_THROW(field.WriteHDF5("Test_Output_Field_WriteHDF5_Reduced_Invalid.h5"), std::invalid_argument);
+    field.hdf5_options.region           = std::nullopt;
+    field.hdf5_options.coarsening_ratio = {3, 1, 1};
+    EXPECT_THROW(field.WriteHDF5("Test_Output_Field_WriteHDF5_Reduced_Invalid.h5"), std::invalid_argument);
+    field.hdf5_options.coarsening_ratio = {4, 4, 8};
+    EXPECT_NO_THROW(field.WriteHDF5("Test_Output_Field_WriteHDF5_Reduced_Whole.h5"));
+}
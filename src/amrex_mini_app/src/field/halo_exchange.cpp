@@ -0,0 +1,268 @@
+#include "halo_exchange.h"
+
+#include <AMReX.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "field.h"
+
+namespace turbo
+{
+
+HaloExchange::HaloExchange(const std::vector<std::shared_ptr<Field>>& fields) : fields_(fields)
+{
+    std::set<const Field*> unique_fields;
+    exchanges_.reserve(fields_.size());
+    for (const std::shared_ptr<Field>& field : fields_)
+    {
+        if (!field)
+        {
+            throw std::invalid_argument("HaloExchange::HaloExchange: Invalid field pointer.");
+        }
+        if (!unique_fields.insert(field.get()).second)
+        {
+            throw std::invalid_argument("HaloExchange::HaloExchange: Field '" + field->name +
+                                        "' appears more than once.");
+        }
+
+        // The metadata is owned by AMReX's FillBoundary cache and lives as long as the BoxArray of the field
+        amrex::MultiFab& multifab = *field->multifab;
+        if (multifab.nGrowVect().max() > 0)
+        {
+            exchanges_.push_back({&multifab, &multifab.getFB(multifab.nGrowVect(), field->GetPeriodicity())});
+        }
+    }
+}
+
+HaloExchange::~HaloExchange()
+{
+    if (in_progress_)
+    {
+        WaitAll();
+    }
+}
+
+void HaloExchange::Start()
+{
+    if (in_progress_)
+    {
+        throw std::logic_error("HaloExchange::Start: Exchange is already in progress, call Finish first.");
+    }
+    in_progress_ = true;
+
+    for (const std::shared_ptr<Field>& field : fields_)
+    {
+        field->SyncFoldRow();
+    }
+
+#ifdef AMREX_USE_MPI
+    const std::map<int, std::size_t> n_send_value    = CountMessageValues(true);
+    const std::map<int, std::size_t> n_receive_value = CountMessageValues(false);
+
+    const MPI_Comm communicator = amrex::ParallelDescriptor::Communicator();
+    const MPI_Datatype type     = amrex::ParallelDescriptor::Mpi_typemap<amrex::Real>::type();
+    const int message_tag       = amrex::ParallelDescriptor::SeqNum();
+
+    // One message per neighbor rank in each direction, holding the values of all fields
+    // The buffers are reserved up front so their addresses, posted to MPI, stay fixed while more are added
+    receive_requests_.assign(n_receive_value.size(), MPI_REQUEST_NULL);
+    receive_ranks_.reserve(n_receive_value.size());
+    receive_buffers_.reserve(n_receive_value.size());
+    send_buffers_.reserve(n_send_value.size());
+    for (const auto& [rank, n_value] : n_receive_value)
+    {
+        receive_ranks_.push_back(rank);
+        receive_buffers_.emplace_back(n_value);
+        MPI_Irecv(receive_buffers_.back().data(), static_cast<int>(n_value), type, rank, message_tag, communicator,
+                  &receive_requests_[receive_ranks_.size() - 1]);
+    }
+
+    for (const auto& [rank, n_value] : n_send_value)
+    {
+        send_buffers_.emplace_back(n_value);
+        CopyMessage(rank, send_buffers_.back().data(), true);
+    }
+    amrex::Gpu::streamSynchronize();
+
+    send_requests_.assign(n_send_value.size(), MPI_REQUEST_NULL);
+    std::size_t send_index = 0;
+    for (const auto& [rank, n_value] : n_send_value)
+    {
+        MPI_Isend(send_buffers_[send_index].data(), static_cast<int>(n_value), type, rank, message_tag, communicator,
+                  &send_requests_[send_index]);
+        ++send_index;
+    }
+#endif
+
+    // Copies between boxes on this rank, while the messages are in flight
+    for (const FieldExchange& exchange : exchanges_)
+    {
+        amrex::MultiFab& multifab = *exchange.multifab;
+        const int n_component     = multifab.nComp();
+        for (const amrex::FabArrayBase::CopyComTag& tag : *exchange.fill_boundary->m_LocTags)
+        {
+            const amrex::Array4<const amrex::Real> source = multifab.const_array(tag.srcIndex);
+            const amrex::Array4<amrex::Real> destination  = multifab.array(tag.dstIndex);
+            const amrex::IntVect shift                    = tag.sbox.smallEnd() - tag.dbox.smallEnd();
+            amrex::ParallelFor(tag.dbox, n_component,
+                               [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                               { destination(i, j, k, n) = source(i + shift[0], j + shift[1], k + shift[2], n); });
+        }
+    }
+}
+
+void HaloExchange::Finish()
+{
+    if (!in_progress_)
+    {
+        throw std::logic_error("HaloExchange::Finish: Exchange is not in progress, call Start first.");
+    }
+
+#ifdef AMREX_USE_MPI
+    if (!receive_requests_.empty())
+    {
+        MPI_Waitall(static_cast<int>(receive_requests_.size()), receive_requests_.data(), MPI_STATUSES_IGNORE);
+    }
+    for (std::size_t receive_index = 0; receive_index < receive_ranks_.size(); ++receive_index)
+    {
+        CopyMessage(receive_ranks_[receive_index], receive_buffers_[receive_index].data(), false);
+    }
+    amrex::Gpu::streamSynchronize();
+#endif
+    WaitAll();
+
+    for (const std::shared_ptr<Field>& field : fields_)
+    {
+        field->FillFoldGhostCells();
+    }
+}
+
+bool HaloExchange::InProgress() const noexcept { return in_progress_; }
+
+HaloExchangeStatistics HaloExchange::GetStatistics(const bool fused) const
+{
+    const std::map<int, std::size_t> n_send_value = CountMessageValues(true);
+
+    HaloExchangeStatistics statistics{0, 0};
+    for (const auto& [rank, n_value] : n_send_value)
+    {
+        statistics.n_byte += n_value * sizeof(amrex::Real);
+    }
+
+    if (fused)
+    {
+        statistics.n_message = n_send_value.size();
+    }
+    else
+    {
+        for (const FieldExchange& exchange : exchanges_)
+        {
+            statistics.n_message += exchange.fill_boundary->m_SndTags->size();
+        }
+    }
+    return statistics;
+}
+
+const std::vector<std::shared_ptr<Field>>& HaloExchange::GetFields() const noexcept { return fields_; }
+
+std::map<int, std::size_t> HaloExchange::CountMessageValues(const bool send) const
+{
+    std::map<int, std::size_t> n_value;
+    for (const FieldExchange& exchange : exchanges_)
+    {
+        const amrex::FabArrayBase::MapOfCopyComTagContainers& tags =
+            send ? *exchange.fill_boundary->m_SndTags : *exchange.fill_boundary->m_RcvTags;
+        for (const auto& [rank, rank_tags] : tags)
+        {
+            for (const amrex::FabArrayBase::CopyComTag& tag : rank_tags)
+            {
+                n_value[rank] +=
+                    static_cast<std::size_t>((send ? tag.sbox : tag.dbox).numPts()) * exchange.multifab->nComp();
+            }
+        }
+    }
+    return n_value;
+}
+
+// The order of the copy tags for a pair of ranks is the same on the sending and the receiving side (AMReX relies on
+// this for its own FillBoundary), so the receiver finds the values of each tag where the sender packed them.
+void HaloExchange::CopyMessage(const int rank, amrex::Real* buffer, const bool pack) const
+{
+    std::size_t offset = 0;
+    for (const FieldExchange& exchange : exchanges_)
+    {
+        const amrex::FabArrayBase::MapOfCopyComTagContainers& tags =
+            pack ? *exchange.fill_boundary->m_SndTags : *exchange.fill_boundary->m_RcvTags;
+        const auto rank_tags = tags.find(rank);
+        if (rank_tags == tags.end())
+        {
+            continue;
+        }
+
+        amrex::MultiFab& multifab = *exchange.multifab;
+        const int n_component     = multifab.nComp();
+        for (const amrex::FabArrayBase::CopyComTag& tag : rank_tags->second)
+        {
+            if (pack)
+            {
+                const amrex::Array4<const amrex::Real> source = multifab.const_array(tag.srcIndex);
+                const amrex::Array4<amrex::Real> message = amrex::makeArray4(buffer + offset, tag.sbox, n_component);
+                amrex::ParallelFor(tag.sbox, n_component, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   { message(i, j, k, n) = source(i, j, k, n); });
+                offset += static_cast<std::size_t>(tag.sbox.numPts()) * n_component;
+            }
+            else
+            {
+                const amrex::Array4<const amrex::Real> message =
+                    amrex::makeArray4(static_cast<const amrex::Real*>(buffer + offset), tag.dbox, n_component);
+                const amrex::Array4<amrex::Real> destination = multifab.array(tag.dstIndex);
+                amrex::ParallelFor(tag.dbox, n_component, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   { destination(i, j, k, n) = message(i, j, k, n); });
+                offset += static_cast<std::size_t>(tag.dbox.numPts()) * n_component;
+            }
+        }
+    }
+}
+
+void HaloExchange::WaitAll()
+{
+#ifdef AMREX_USE_MPI
+    if (!receive_requests_.empty())
+    {
+        MPI_Waitall(static_cast<int>(receive_requests_.size()), receive_requests_.data(), MPI_STATUSES_IGNORE);
+    }
+    if (!send_requests_.empty())
+    {
+        MPI_Waitall(static_cast<int>(send_requests_.size()), send_requests_.data(), MPI_STATUSES_IGNORE);
+    }
+    receive_requests_.clear();
+    send_requests_.clear();
+#endif
+    receive_ranks_.clear();
+    receive_buffers_.clear();
+    send_buffers_.clear();
+    in_progress_ = false;
+}
+
+void FillBoundary(const std::vector<std::shared_ptr<Field>>& fields)
+{
+    HaloExchange halo_exchange(fields);
+    halo_exchange.Start();
+    halo_exchange.Finish();
+}
+
+HaloExchangeStatistics GetHaloExchangeStatistics(const std::vector<std::shared_ptr<Field>>& fields, const bool fused)
+{
+    return HaloExchange(fields).GetStatistics(fused);
+}
+
+}  // namespace turbo
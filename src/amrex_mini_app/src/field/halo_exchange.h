@@ -0,0 +1,180 @@
+#pragma once
+
+#include <AMReX_GpuContainers.H>
+#include <AMReX_MultiFab.H>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "field.h"
+
+namespace turbo
+{
+
+/**
+ * @brief Message counts and volume of a halo exchange on the calling rank, see GetHaloExchangeStatistics.
+ */
+struct HaloExchangeStatistics
+{
+    std::size_t n_message; /**< Number of MPI messages sent by this rank. */
+    std::size_t n_byte;    /**< Number of bytes sent by this rank. */
+};
+
+/**
+ * @class HaloExchange
+ * @brief Fused, split-phase halo exchange for a group of fields.
+ *
+ * Gives the same result as calling Field::FillBoundary on each field, including the periodic wrap and the fold of a
+ * TripolarGrid, but packs the ghost cell data of all fields for a neighboring rank into a single message, so each
+ * rank sends one message per neighbor instead of one per neighbor and field. The fields can have any stagger, number
+ * of components, ghost cells and layout.
+ *
+ * Start posts the messages and returns, Finish waits for them and fills the remaining ghost cells. In between, the
+ * valid data of the fields can be read (e.g. to update the interior of each box, see Field::InteriorBox) but no field
+ * of the group may be written. Start and Finish must be called by all ranks, with the same fields in the same order
+ * and in the same order relative to other exchanges.
+ */
+class HaloExchange
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct a halo exchange for a group of fields.
+     * @param fields Fields to fill.
+     * @throws std::invalid_argument if a field is null or appears more than once.
+     */
+    explicit HaloExchange(const std::vector<std::shared_ptr<Field>>& fields);
+
+    /**
+     * @brief Destructor, waits for the messages of an exchange that was started but not finished.
+     */
+    ~HaloExchange();
+
+    HaloExchange(const HaloExchange&)            = delete;
+    HaloExchange& operator=(const HaloExchange&) = delete;
+
+    /**
+     * @brief Start filling the ghost cells: make the tripolar fold rows consistent, post all messages and fill the
+     * ghost cells that come from boxes on this rank.
+     * @throws std::logic_error if the exchange is already in progress.
+     */
+    void Start();
+
+    /**
+     * @brief Finish filling the ghost cells: wait for the messages, unpack them and fill the ghost cells beyond the
+     * tripolar fold.
+     * @throws std::logic_error if the exchange was not started.
+     */
+    void Finish();
+
+    /**
+     * @brief Check if the exchange was started and not finished yet.
+     * @return true if the exchange is in progress, false otherwise.
+     */
+    bool InProgress() const noexcept;
+
+    /**
+     * @brief Count the messages and bytes the calling rank sends for this exchange, excluding the tripolar fold.
+     * @param fused true to count for this fused exchange, false for one Field::FillBoundary call per field.
+     * @return Statistics of the calling rank.
+     */
+    HaloExchangeStatistics GetStatistics(const bool fused) const;
+
+    /**
+     * @brief Get the fields of the exchange.
+     * @return The fields, in the order they are packed.
+     */
+    const std::vector<std::shared_ptr<Field>>& GetFields() const noexcept;
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Types
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief A field with ghost cells and the (cached) AMReX communication metadata of its FillBoundary.
+     */
+    struct FieldExchange
+    {
+        amrex::MultiFab* multifab;
+        const amrex::FabArrayBase::FB* fill_boundary;
+    };
+
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Fields of the exchange.
+     */
+    std::vector<std::shared_ptr<Field>> fields_;
+
+    /**
+     * @brief The fields that have ghost cells, with their communication metadata.
+     */
+    std::vector<FieldExchange> exchanges_;
+
+    /**
+     * @brief Whether Start was called without Finish.
+     */
+    bool in_progress_ = false;
+
+    /**
+     * @brief Message buffers and MPI requests of the exchange in progress, one per neighbor rank.
+     */
+    std::vector<int> receive_ranks_;
+    std::vector<amrex::Gpu::PinnedVector<amrex::Real>> receive_buffers_, send_buffers_;
+#ifdef AMREX_USE_MPI
+    std::vector<MPI_Request> receive_requests_, send_requests_;
+#endif
+
+    //-----------------------------------------------------------------------//
+    // Private Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Total number of values sent to (or received from) each neighbor rank, over all fields.
+     * @param send true to count the values sent, false for the values received.
+     * @return Number of values per neighbor rank.
+     */
+    std::map<int, std::size_t> CountMessageValues(const bool send) const;
+
+    /**
+     * @brief Copy the data of every field for one neighbor rank to or from a message buffer, field by field in order.
+     * @param rank Neighbor rank.
+     * @param buffer Message buffer, sized by CountMessageValues.
+     * @param pack true to copy from the fields into the buffer, false to copy from the buffer into the ghost cells.
+     */
+    void CopyMessage(const int rank, amrex::Real* buffer, const bool pack) const;
+
+    /**
+     * @brief Wait for all posted messages without unpacking them.
+     */
+    void WaitAll();
+};
+
+/**
+ * @brief Fill the ghost cells of several fields with one fused halo exchange, see HaloExchange. Must be called by all
+ * ranks with the same fields in the same order.
+ * @param fields Fields to fill.
+ * @throws std::invalid_argument if a field is null or appears more than once.
+ */
+void FillBoundary(const std::vector<std::shared_ptr<Field>>& fields);
+
+/**
+ * @brief Count the messages and bytes the calling rank sends to fill the ghost cells of several fields, excluding
+ * the tripolar fold.
+ * @param fields Fields to fill.
+ * @param fused true to count for the fused FillBoundary, false for one Field::FillBoundary call per field.
+ * @return Statistics of the calling rank.
+ * @throws std::invalid_argument if a field is null or appears more than once.
+ */
+HaloExchangeStatistics GetHaloExchangeStatistics(const std::vector<std::shared_ptr<Field>>& fields,
+                                                 const bool fused);
+
+}  // namespace turbo
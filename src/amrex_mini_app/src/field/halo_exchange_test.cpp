@@ -0,0 +1,198 @@
+#include "halo_exchange.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "tripolar_geometry.h"
+#include "tripolar_grid.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for halo exchange tests
+//---------------------------------------------------------------------------//
+
+class HaloExchangeTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        cartesian_grid = std::make_shared<CartesianGrid>(
+            std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), n_cell_x, n_cell_y, n_cell_z);
+        tripolar_grid = std::make_shared<TripolarGrid>(
+            std::make_shared<TripolarGeometry>(0.0, 360.0, -80.0, 90.0, 0.0, 5000.0), n_cell_x, n_cell_y, n_cell_z);
+    }
+
+    /**
+     * @brief Make a mix of fields like the prognostic fields of an ocean model, with unfilled ghost cells.
+     */
+    std::vector<std::shared_ptr<Field>> MakeFields(const std::shared_ptr<Grid>& grid) const
+    {
+        std::vector<std::shared_ptr<Field>> fields = {
+            std::make_shared<Field>("u", grid, FieldGridStagger::IFace, 1, 2, FoldParity::Vector, box_decomposition),
+            std::make_shared<Field>("v", grid, FieldGridStagger::JFace, 1, 2, FoldParity::Vector, box_decomposition),
+            std::make_shared<Field>("h", grid, FieldGridStagger::CellCentered, 1, 1, FoldParity::Scalar,
+                                    box_decomposition),
+            std::make_shared<Field>("tracers", grid, FieldGridStagger::CellCentered, 3, 2, FoldParity::Scalar,
+                                    box_decomposition),
+            std::make_shared<Field>("vorticity", grid, FieldGridStagger::Nodal, 1, 1, FoldParity::Scalar,
+                                    box_decomposition),
+            std::make_shared<Field>("w", grid, FieldGridStagger::KFace, 1, 0, FoldParity::Scalar, box_decomposition)};
+
+        for (std::size_t field_index = 0; field_index < fields.size(); ++field_index)
+        {
+            amrex::MultiFab& mf = *fields[field_index]->multifab;
+            mf.setVal(-1.0);
+            const double offset = 1000000.0 * field_index;
+            for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+                amrex::ParallelFor(mfi.validbox(), mf.nComp(), [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   { array(i, j, k, n) = offset + i + 100.0 * j + 10000.0 * k + 0.5 * n; });
+            }
+        }
+        return fields;
+    }
+
+    /**
+     * @brief Expect all points, including ghost cells, of two lists of fields to be equal.
+     */
+    static void ExpectEqual(const std::vector<std::shared_ptr<Field>>& expected,
+                            const std::vector<std::shared_ptr<Field>>& actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (std::size_t field_index = 0; field_index < expected.size(); ++field_index)
+        {
+            const amrex::MultiFab& expected_mf = *expected[field_index]->multifab;
+            const amrex::MultiFab& actual_mf   = *actual[field_index]->multifab;
+            for (amrex::MFIter mfi(expected_mf); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<const amrex::Real>& expected_array = expected_mf.const_array(mfi);
+                const amrex::Array4<const amrex::Real>& actual_array   = actual_mf.const_array(mfi);
+                const std::string name                                 = expected[field_index]->name;
+                amrex::ParallelFor(mfi.fabbox(), expected_mf.nComp(),
+                                   [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   {
+                                       EXPECT_EQ(actual_array(i, j, k, n), expected_array(i, j, k, n))
+                                           << "Mismatch for field " << name << " at (" << i << "," << j << "," << k
+                                           << "," << n << ")";
+                                   });
+            }
+        }
+    }
+
+    // Several boxes in each direction, so every field has neighbors on this and (with more than one rank) other ranks
+    const int n_cell_x                       = 32;
+    const int n_cell_y                       = 24;
+    const int n_cell_z                       = 4;
+    const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 8, 4)));
+
+    std::shared_ptr<CartesianGrid> cartesian_grid;
+    std::shared_ptr<TripolarGrid> tripolar_grid;
+};
+
+//---------------------------------------------------------------------------//
+// Halo exchange tests
+//---------------------------------------------------------------------------//
+
+TEST_F(HaloExchangeTest, FillBoundaryMatchesFieldFillBoundary)
+{
+    const std::vector<std::shared_ptr<Grid>> grids = {cartesian_grid, tripolar_grid};
+    for (const std::shared_ptr<Grid>& grid : grids)
+    {
+        const std::vector<std::shared_ptr<Field>> expected = MakeFields(grid);
+        for (const std::shared_ptr<Field>& field : expected)
+        {
+            field->FillBoundary();
+        }
+
+        const std::vector<std::shared_ptr<Field>> actual = MakeFields(grid);
+        FillBoundary(actual);
+
+        ExpectEqual(expected, actual);
+    }
+}
+
+TEST_F(HaloExchangeTest, StartFinishMatchesFieldFillBoundary)
+{
+    const std::vector<std::shared_ptr<Grid>> grids = {cartesian_grid, tripolar_grid};
+    for (const std::shared_ptr<Grid>& grid : grids)
+    {
+        const std::vector<std::shared_ptr<Field>> expected = MakeFields(grid);
+        for (const std::shared_ptr<Field>& field : expected)
+        {
+            field->FillBoundaryStart();
+        }
+        for (const std::shared_ptr<Field>& field : expected)
+        {
+            field->FillBoundaryFinish();
+        }
+
+        const std::vector<std::shared_ptr<Field>> actual = MakeFields(grid);
+        HaloExchange halo_exchange(actual);
+        EXPECT_FALSE(halo_exchange.InProgress());
+        EXPECT_THROW(halo_exchange.Finish(), std::logic_error);
+
+        halo_exchange.Start();
+        EXPECT_TRUE(halo_exchange.InProgress());
+        EXPECT_THROW(halo_exchange.Start(), std::logic_error);
+        halo_exchange.Finish();
+        EXPECT_FALSE(halo_exchange.InProgress());
+
+        ExpectEqual(expected, actual);
+
+        // The exchange can be reused
+        halo_exchange.Start();
+        halo_exchange.Finish();
+        ExpectEqual(expected, actual);
+    }
+}
+
+TEST_F(HaloExchangeTest, FillBoundaryInvalidInput)
+{
+    const std::vector<std::shared_ptr<Field>> fields = MakeFields(cartesian_grid);
+    EXPECT_THROW(FillBoundary({fields[0], nullptr}), std::invalid_argument);
+    EXPECT_THROW(FillBoundary({fields[0], fields[1], fields[0]}), std::invalid_argument);
+    EXPECT_THROW(GetHaloExchangeStatistics({fields[0], fields[0]}, true), std::invalid_argument);
+    EXPECT_NO_THROW(FillBoundary({}));
+}
+
+TEST_F(HaloExchangeTest, Statistics)
+{
+    const std::vector<std::shared_ptr<Field>> fields = MakeFields(cartesian_grid);
+
+    const HaloExchangeStatistics fused   = GetHaloExchangeStatistics(fields, true);
+    const HaloExchangeStatistics unfused = GetHaloExchangeStatistics(fields, false);
+
+    // Same data, in fewer messages
+    EXPECT_EQ(fused.n_byte, unfused.n_byte);
+    EXPECT_LE(fused.n_message, unfused.n_message);
+    if (amrex::ParallelDescriptor::NProcs() == 1)
+    {
+        EXPECT_EQ(fused.n_message, 0);
+        EXPECT_EQ(fused.n_byte, 0);
+    }
+    else
+    {
+        // At most one message per other rank, instead of up to one per other rank and field
+        EXPECT_LT(fused.n_message, static_cast<std::size_t>(amrex::ParallelDescriptor::NProcs()));
+        if (fused.n_message > 0)
+        {
+            EXPECT_LT(fused.n_message, unfused.n_message);
+        }
+    }
+}
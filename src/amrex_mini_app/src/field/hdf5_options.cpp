@@ -0,0 +1,207 @@
+#include "hdf5_options.h"
+
+#include <AMReX_ParmParse.H>
+#include <hdf5.h>
+
+#include <algorithm>
+#include <array>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace turbo
+{
+
+std::string HDF5DataLayoutToString(const HDF5DataLayout data_layout)
+{
+    switch (data_layout)
+    {
+        case HDF5DataLayout::RowMajor:
+            return "row_major";
+        case HDF5DataLayout::ColumnMajor:
+            return "column_major";
+        default:
+            throw std::invalid_argument("HDF5DataLayoutToString: Invalid HDF5DataLayout specified.");
+    }
+}
+
+HDF5Options HDF5Options::Compressed(const int deflate_level, const int mantissa_bits)
+{
+    HDF5Options hdf5_options;
+    hdf5_options.chunked       = true;
+    hdf5_options.shuffle       = true;
+    hdf5_options.deflate_level = deflate_level;
+    hdf5_options.mantissa_bits = mantissa_bits;
+    hdf5_options.Validate();
+    return hdf5_options;
+}
+
+HDF5Options HDF5Options::FromParmParse(const std::string& prefix)
+{
+    HDF5Options hdf5_options;
+    const amrex::ParmParse pp(prefix);
+    pp.query("chunked", hdf5_options.chunked);
+    pp.query("shuffle", hdf5_options.shuffle);
+    pp.query("deflate_level", hdf5_options.deflate_level);
+    pp.query("mantissa_bits", hdf5_options.mantissa_bits);
+    std::string data_layout = HDF5DataLayoutToString(hdf5_options.data_layout);
+    pp.query("data_layout", data_layout);
+    if (data_layout == HDF5DataLayoutToString(HDF5DataLayout::ColumnMajor))
+    {
+        hdf5_options.data_layout = HDF5DataLayout::ColumnMajor;
+    }
+    else if (data_layout != HDF5DataLayoutToString(HDF5DataLayout::RowMajor))
+    {
+        throw std::invalid_argument("HDF5Options::FromParmParse: Unknown data layout '" + data_layout +
+                                    "', expected row_major or column_major.");
+    }
+    std::vector<int> region;
+    if (pp.queryarr("region", region))
+    {
+        if (region.size() != 6)
+        {
+            throw std::invalid_argument("HDF5Options::FromParmParse: The region needs 6 cell indices.");
+        }
+        hdf5_options.region.emplace();
+        std::copy(region.begin(), region.end(), hdf5_options.region->begin());
+    }
+    std::vector<int> coarsening_ratio;
+    if (pp.queryarr("coarsening_ratio", coarsening_ratio))
+    {
+        if (coarsening_ratio.size() != 3)
+        {
+            throw std::invalid_argument("HDF5Options::FromParmParse: The coarsening ratio needs 3 values.");
+        }
+        std::copy(coarsening_ratio.begin(), coarsening_ratio.end(), hdf5_options.coarsening_ratio.begin());
+    }
+    hdf5_options.Validate();
+    return hdf5_options;
+}
+
+void HDF5Options::Validate() const
+{
+    if (deflate_level < 0 || deflate_level > 9)
+    {
+        throw std::invalid_argument("HDF5Options::Validate: Deflate level " + std::to_string(deflate_level) +
+                                    " is not between 0 and 9.");
+    }
+    if (mantissa_bits < 0 || mantissa_bits > 51)
+    {
+        throw std::invalid_argument("HDF5Options::Validate: Number of mantissa bits " + std::to_string(mantissa_bits) +
+                                    " is not between 0 and 51.");
+    }
+    if (data_layout != HDF5DataLayout::RowMajor && data_layout != HDF5DataLayout::ColumnMajor)
+    {
+        throw std::invalid_argument("HDF5Options::Validate: Invalid HDF5DataLayout specified.");
+    }
+    if (region)
+    {
+        const std::array<int, 6>& bounds = *region;
+        for (int direction = 0; direction < 3; ++direction)
+        {
+            if (bounds[direction] < 0 || bounds[direction] > bounds[direction + 3])
+            {
+                throw std::invalid_argument("HDF5Options::Validate: The region is empty or has negative indices.");
+            }
+        }
+    }
+    for (const int ratio : coarsening_ratio)
+    {
+        if (ratio < 1)
+        {
+            throw std::invalid_argument("HDF5Options::Validate: Coarsening ratio " + std::to_string(ratio) +
+                                        " is less than 1.");
+        }
+    }
+}
+
+bool HDF5Options::ReducesOutput() const noexcept
+{
+    return region.has_value() || coarsening_ratio != std::array<int, 3>{1, 1, 1};
+}
+
+bool HDF5Options::UsesChunking() const noexcept { return chunked || shuffle || deflate_level > 0; }
+
+hid_t HDF5Options::MakeDatasetCreationPropertyList(const std::vector<hsize_t>& chunk_dims) const
+{
+    Validate();
+
+    const hid_t plist_id = H5Pcreate(H5P_DATASET_CREATE);
+    if (plist_id < 0)
+    {
+        throw std::runtime_error("HDF5Options::MakeDatasetCreationPropertyList: Failed to create property list.");
+    }
+    if (!UsesChunking())
+    {
+        return plist_id;
+    }
+
+    auto check = [plist_id](const herr_t status, const std::string& what)
+    {
+        if (status < 0)
+        {
+            H5Pclose(plist_id);
+            throw std::runtime_error("HDF5Options::MakeDatasetCreationPropertyList: Failed to " + what + ".");
+        }
+    };
+
+    check(H5Pset_chunk(plist_id, static_cast<int>(chunk_dims.size()), chunk_dims.data()), "set the chunk dimensions");
+    // Every point of a field dataset is written, so skip filling (and with filters, compressing) the fill value
+    check(H5Pset_fill_time(plist_id, H5D_FILL_TIME_NEVER), "set the fill time");
+    if (shuffle)
+    {
+        check(H5Zfilter_avail(H5Z_FILTER_SHUFFLE) > 0 ? 0 : -1, "find the shuffle filter");
+        check(H5Pset_shuffle(plist_id), "set the shuffle filter");
+    }
+    if (deflate_level > 0)
+    {
+        check(H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0 ? 0 : -1, "find the deflate filter");
+        check(H5Pset_deflate(plist_id, static_cast<unsigned int>(deflate_level)), "set the deflate filter");
+    }
+    return plist_id;
+}
+
+void HDF5Options::BitRound(std::vector<double>& data) const noexcept
+{
+    if (mantissa_bits == 0)
+    {
+        return;
+    }
+    for (double& value : data)
+    {
+        value = turbo::BitRound(value, mantissa_bits);
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, const HDF5Options& hdf5_options)
+{
+    os << HDF5DataLayoutToString(hdf5_options.data_layout) << ", "
+       << (hdf5_options.UsesChunking() ? "chunked" : "contiguous");
+    if (hdf5_options.shuffle)
+    {
+        os << ", shuffle";
+    }
+    if (hdf5_options.deflate_level > 0)
+    {
+        os << ", deflate_level = " << hdf5_options.deflate_level;
+    }
+    if (hdf5_options.mantissa_bits > 0)
+    {
+        os << ", mantissa_bits = " << hdf5_options.mantissa_bits;
+    }
+    if (hdf5_options.region)
+    {
+        const std::array<int, 6>& region = *hdf5_options.region;
+        os << ", region = (" << region[0] << ":" << region[3] << ", " << region[1] << ":" << region[4] << ", "
+           << region[2] << ":" << region[5] << ")";
+    }
+    const std::array<int, 3>& ratio = hdf5_options.coarsening_ratio;
+    if (ratio != std::array<int, 3>{1, 1, 1})
+    {
+        os << ", coarsening_ratio = " << ratio[0] << "x" << ratio[1] << "x" << ratio[2];
+    }
+    return os;
+}
+
+}  // namespace turbo
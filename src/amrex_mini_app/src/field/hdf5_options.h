@@ -0,0 +1,202 @@
+#pragma once
+
+#include <hdf5.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace turbo
+{
+
+/**
+ * @enum HDF5DataLayout
+ * @brief Order of the points of a field in its HDF5 dataset.
+ */
+enum class HDF5DataLayout
+{
+    RowMajor,   /**< Dimensions (i, j, k[, component]), component fastest. A transpose of the AMReX data. */
+    ColumnMajor /**< Dimensions ([component, ]k, j, i), i fastest. The AMReX data as is, written without a copy. */
+};
+
+/**
+ * @brief Convert a HDF5DataLayout enum value to a string, the value of the "data_layout" attribute of the datasets.
+ * @param data_layout The HDF5DataLayout value to convert.
+ * @return "row_major" or "column_major".
+ * @throws std::invalid_argument if the value is invalid.
+ */
+std::string HDF5DataLayoutToString(HDF5DataLayout data_layout);
+
+/**
+ * @brief Storage options for the HDF5 datasets of a field, see Field::hdf5_options and Domain::SetHDF5Options.
+ *
+ * By default datasets are row-major, contiguous and uncompressed. Column-major datasets are written straight from the
+ * memory of the field, without packing the data into a separate buffer, unless bit rounding needs a copy to round.
+ * With chunking, each dataset is stored in chunks the size of the largest box of the field, so with the default
+ * chunked box decomposition every box maps onto one chunk. Compression (shuffle and deflate) requires and implies
+ * chunking. Bit rounding is applied to the data before it is passed to HDF5: each value is rounded to nearest, ties to
+ * even, keeping mantissa_bits explicit mantissa bits, which makes the data much more compressible at a bounded
+ * relative error of 2^-(mantissa_bits + 1).
+ *
+ * The options can also reduce what is written to a region of the grid and to a coarser resolution, for overviews or
+ * high frequency output of a subdomain. The reduction runs on the ranks that own the data before it is gathered or
+ * written, see Field::WriteHDF5, and the reduced datasets get coordinates of their own.
+ */
+struct HDF5Options
+{
+    //-----------------------------------------------------------------------//
+    // Public Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Store the datasets in chunks matching the boxes of the field.
+     */
+    bool chunked = false;
+
+    /**
+     * @brief Apply the HDF5 byte shuffle filter before deflate.
+     */
+    bool shuffle = false;
+
+    /**
+     * @brief Deflate (gzip) compression level from 1 to 9, or 0 for no deflate.
+     */
+    int deflate_level = 0;
+
+    /**
+     * @brief Number of explicit mantissa bits to keep, from 1 to 51, or 0 to keep all 52 bits.
+     */
+    int mantissa_bits = 0;
+
+    /**
+     * @brief Order of the points in the datasets.
+     */
+    HDF5DataLayout data_layout = HDF5DataLayout::RowMajor;
+
+    /**
+     * @brief Inclusive cell index bounds {i_lo, j_lo, k_lo, i_hi, j_hi, k_hi} of the region to write, or none for the
+     * whole grid. Staggered fields are written on the nodes and faces of the cells of the region.
+     */
+    std::optional<std::array<int, 6>> region;
+
+    /**
+     * @brief Number of cells averaged into one written cell in the i, j and k directions, 1 to keep the resolution.
+     * The cells of the region must divide evenly into blocks.
+     */
+    std::array<int, 3> coarsening_ratio = {1, 1, 1};
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Make options for chunked datasets with shuffle and deflate, and optionally bit rounding.
+     * @param deflate_level Deflate compression level from 1 to 9.
+     * @param mantissa_bits Number of mantissa bits to keep, 0 to keep all.
+     * @return The options.
+     */
+    static HDF5Options Compressed(const int deflate_level = 4, const int mantissa_bits = 0);
+
+    /**
+     * @brief Read options from the AMReX runtime parameters, starting from the default (contiguous) options.
+     *
+     * Reads the optional parameters `<prefix>.chunked`, `<prefix>.shuffle`, `<prefix>.deflate_level`,
+     * `<prefix>.mantissa_bits`, `<prefix>.data_layout` (`row_major` or `column_major`), `<prefix>.region` (6 cell
+     * indices) and `<prefix>.coarsening_ratio` (3 ratios).
+     *
+     * @param prefix ParmParse prefix of the parameters.
+     * @return The options.
+     * @throws std::invalid_argument if the options are invalid, see Validate, the data layout is unknown, or the
+     * region or coarsening ratio has the wrong number of values.
+     */
+    static HDF5Options FromParmParse(const std::string& prefix = "hdf5");
+
+    /**
+     * @brief Check the options.
+     * @throws std::invalid_argument if deflate_level or mantissa_bits is out of range, data_layout is invalid, the
+     * region is empty or has negative indices, or a coarsening ratio is less than 1. The region is checked against
+     * the grid when a field is written.
+     */
+    void Validate() const;
+
+    /**
+     * @brief Check if the written data is reduced to a region or a coarser resolution.
+     * @return true if a region is set or a coarsening ratio is not 1.
+     */
+    bool ReducesOutput() const noexcept;
+
+    /**
+     * @brief Check if the datasets are chunked, which is the case if chunked is set or a filter is used.
+     * @return true if the datasets are chunked, false if they are contiguous.
+     */
+    bool UsesChunking() const noexcept;
+
+    /**
+     * @brief Make the dataset creation property list for a dataset.
+     * @param chunk_dims Chunk dimensions, with the rank of the dataset. Ignored if UsesChunking() is false.
+     * @return HDF5 property list identifier. Caller is responsible for closing it.
+     * @throws std::invalid_argument if the options are invalid.
+     * @throws std::runtime_error if a filter is not available in the HDF5 library or the property list cannot be set.
+     */
+    hid_t MakeDatasetCreationPropertyList(const std::vector<hsize_t>& chunk_dims) const;
+
+    /**
+     * @brief Apply bit rounding to data before it is written. Does nothing if mantissa_bits is 0.
+     * @param data Values to round in place.
+     */
+    void BitRound(std::vector<double>& data) const noexcept;
+
+    /**
+     * @brief Default comparison operators for HDF5Options, so Field keeps its default comparison operators.
+     */
+    auto operator<=>(const HDF5Options& other) const = default;
+};
+
+/**
+ * @brief Output stream operator for HDF5Options.
+ * @param os Output stream.
+ * @param hdf5_options Options to output.
+ * @return Reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const HDF5Options& hdf5_options);
+
+/**
+ * @brief Round a value to the nearest double that keeps mantissa_bits explicit mantissa bits, ties to even, so the
+ * lower 52 - mantissa_bits bits of the mantissa of the result are zero.
+ *
+ * NaN and infinite values are returned unchanged. A finite value that would round up to infinity is truncated to
+ * mantissa_bits bits instead.
+ *
+ * @param value Value to round.
+ * @param mantissa_bits Number of explicit mantissa bits to keep, from 1 to 51. Other values return the value unchanged.
+ * @return The rounded value.
+ */
+inline double BitRound(const double value, const int mantissa_bits) noexcept
+{
+    constexpr int kNMantissaBit           = 52;
+    constexpr std::uint64_t kExponentMask = std::uint64_t{0x7FF} << kNMantissaBit;
+    if (mantissa_bits < 1 || mantissa_bits >= kNMantissaBit)
+    {
+        return value;
+    }
+
+    const std::uint64_t bits = std::bit_cast<std::uint64_t>(value);
+    if ((bits & kExponentMask) == kExponentMask)
+    {
+        return value;
+    }
+
+    const int n_drop            = kNMantissaBit - mantissa_bits;
+    const std::uint64_t keep    = ~((std::uint64_t{1} << n_drop) - 1);
+    const std::uint64_t half    = std::uint64_t{1} << (n_drop - 1);
+    const std::uint64_t rounded = (bits + half - 1 + ((bits >> n_drop) & 1)) & keep;
+    return (rounded & kExponentMask) == kExponentMask ? std::bit_cast<double>(bits & keep)
+                                                      : std::bit_cast<double>(rounded);
+}
+
+}  // namespace turbo
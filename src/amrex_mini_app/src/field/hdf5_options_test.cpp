@@ -0,0 +1,351 @@
+#include "hdf5_options.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <gtest/gtest.h>
+#include <hdf5.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// HDF5 options tests
+//---------------------------------------------------------------------------//
+
+TEST(HDF5OptionsTest, BitRound)
+{
+    // 1 + 2^-3 + 2^-10 rounds to 1 + 2^-3 with 4 mantissa bits and keeps its value with 10
+    const double value = 1.0 + 0x1p-3 + 0x1p-10;
+    EXPECT_EQ(BitRound(value, 4), 1.0 + 0x1p-3);
+    EXPECT_EQ(BitRound(value, 10), value);
+    EXPECT_EQ(BitRound(-value, 4), -(1.0 + 0x1p-3));
+
+    // Round to nearest, ties to even
+    EXPECT_EQ(BitRound(1.0 + 0x1p-2 + 0x1p-3, 2), 1.5);
+    EXPECT_EQ(BitRound(1.0 + 0x1p-3, 2), 1.0);
+    EXPECT_EQ(BitRound(1.0 + 0x1p-2 + 0x1p-3, 1), 1.5);
+
+    // The relative error is at most 2^-(mantissa_bits + 1)
+    for (const double x : {0.1, 3.14159, -2.71828e-10, 6.02214e23})
+    {
+        for (const int mantissa_bits : {1, 7, 23, 40})
+        {
+            EXPECT_LE(std::abs(BitRound(x, mantissa_bits) - x), std::ldexp(std::abs(x), -(mantissa_bits + 1)));
+        }
+    }
+
+    // Special values and out of range bit counts are unchanged
+    EXPECT_EQ(BitRound(0.0, 4), 0.0);
+    EXPECT_TRUE(std::isnan(BitRound(std::numeric_limits<double>::quiet_NaN(), 4)));
+    EXPECT_EQ(BitRound(std::numeric_limits<double>::infinity(), 4), std::numeric_limits<double>::infinity());
+    EXPECT_TRUE(std::isfinite(BitRound(std::numeric_limits<double>::max(), 4)));
+    EXPECT_EQ(BitRound(value, 0), value);
+    EXPECT_EQ(BitRound(value, 52), value);
+}
+
+TEST(HDF5OptionsTest, Options)
+{
+    EXPECT_FALSE(HDF5Options().UsesChunking());
+    EXPECT_EQ(HDF5Options::Compressed(), HDF5Options::Compressed(4, 0));
+
+    const HDF5Options compressed = HDF5Options::Compressed(6, 16);
+    EXPECT_TRUE(compressed.UsesChunking());
+    EXPECT_TRUE(compressed.shuffle);
+    EXPECT_EQ(compressed.deflate_level, 6);
+    EXPECT_EQ(compressed.mantissa_bits, 16);
+
+    // Filters imply chunking
+    HDF5Options deflate_only;
+    deflate_only.deflate_level = 1;
+    EXPECT_TRUE(deflate_only.UsesChunking());
+
+    EXPECT_THROW(HDF5Options::Compressed(10), std::invalid_argument);
+    EXPECT_THROW(HDF5Options::Compressed(4, 52), std::invalid_argument);
+    EXPECT_THROW(HDF5Options::Compressed(-1), std::invalid_argument);
+
+    {
+        amrex::ParmParse pp("hdf5_options_test");
+        pp.add("deflate_level", 2);
+        pp.add("mantissa_bits", 10);
+    }
+    const HDF5Options from_parm_parse = HDF5Options::FromParmParse("hdf5_options_test");
+    EXPECT_FALSE(from_parm_parse.chunked);
+    EXPECT_FALSE(from_parm_parse.shuffle);
+    EXPECT_EQ(from_parm_parse.deflate_level, 2);
+    EXPECT_EQ(from_parm_parse.mantissa_bits, 10);
+    EXPECT_EQ(from_parm_parse.data_layout, HDF5DataLayout::RowMajor);
+    EXPECT_EQ(HDF5Options::FromParmParse("hdf5_options_test_unset"), HDF5Options());
+
+    {
+        amrex::ParmParse pp("hdf5_options_test_layout");
+        pp.add("data_layout", std::string("column_major"));
+        amrex::ParmParse pp_invalid("hdf5_options_test_invalid_layout");
+        pp_invalid.add("data_layout", std::string("diagonal"));
+    }
+    EXPECT_EQ(HDF5Options::FromParmParse("hdf5_options_test_layout").data_layout, HDF5DataLayout::ColumnMajor);
+    EXPECT_THROW(HDF5Options::FromParmParse("hdf5_options_test_invalid_layout"), std::invalid_argument);
+
+    // Output reduced to a region and a coarser resolution
+    EXPECT_FALSE(HDF5Options().ReducesOutput());
+    {
+        amrex::ParmParse pp("hdf5_options_test_reduced");
+        pp.addarr("region", std::vector<int>{2, 0, 1, 9, 5, 1});
+        pp.addarr("coarsening_ratio", std::vector<int>{2, 3, 1});
+        amrex::ParmParse pp_invalid("hdf5_options_test_invalid_region");
+        pp_invalid.addarr("region", std::vector<int>{0, 0, 0, 4, 4});
+    }
+    const HDF5Options reduced = HDF5Options::FromParmParse("hdf5_options_test_reduced");
+    EXPECT_TRUE(reduced.ReducesOutput());
+    EXPECT_EQ(reduced.region, (std::array<int, 6>{2, 0, 1, 9, 5, 1}));
+    EXPECT_EQ(reduced.coarsening_ratio, (std::array<int, 3>{2, 3, 1}));
+    EXPECT_THROW(HDF5Options::FromParmParse("hdf5_options_test_invalid_region"), std::invalid_argument);
+
+    HDF5Options coarsened;
+    coarsened.coarsening_ratio = {1, 1, 2};
+    EXPECT_TRUE(coarsened.ReducesOutput());
+    EXPECT_NO_THROW(coarsened.Validate());
+    coarsened.coarsening_ratio = {1, 0, 1};
+    EXPECT_THROW(coarsened.Validate(), std::invalid_argument);
+
+    HDF5Options empty_region;
+    empty_region.region = {0, 3, 0, 4, 2, 1};
+    EXPECT_THROW(empty_region.Validate(), std::invalid_argument);
+    empty_region.region = {-1, 0, 0, 4, 2, 1};
+    EXPECT_THROW(empty_region.Validate(), std::invalid_argument);
+}
+
+TEST(HDF5OptionsTest, DatasetCreationPropertyList)
+{
+    const std::vector<hsize_t> chunk_dims = {8, 4, 2};
+
+    const hid_t contiguous = HDF5Options().MakeDatasetCreationPropertyList(chunk_dims);
+    EXPECT_EQ(H5Pget_layout(contiguous), H5D_CONTIGUOUS);
+    EXPECT_EQ(H5Pget_nfilters(contiguous), 0);
+    H5Pclose(contiguous);
+
+    const hid_t compressed = HDF5Options::Compressed(4).MakeDatasetCreationPropertyList(chunk_dims);
+    EXPECT_EQ(H5Pget_layout(compressed), H5D_CHUNKED);
+    std::vector<hsize_t> actual_chunk_dims(3);
+    EXPECT_EQ(H5Pget_chunk(compressed, 3, actual_chunk_dims.data()), 3);
+    EXPECT_EQ(actual_chunk_dims, chunk_dims);
+    ASSERT_EQ(H5Pget_nfilters(compressed), 2);
+    // Shuffle runs before deflate
+    unsigned int flags;
+    std::size_t n_value = 0;
+    EXPECT_EQ(H5Pget_filter2(compressed, 0, &flags, &n_value, NULL, 0, NULL, NULL), H5Z_FILTER_SHUFFLE);
+    EXPECT_EQ(H5Pget_filter2(compressed, 1, &flags, &n_value, NULL, 0, NULL, NULL), H5Z_FILTER_DEFLATE);
+    H5Pclose(compressed);
+}
+
+TEST(HDF5OptionsTest, FieldWriteHDF5)
+{
+    const std::shared_ptr<CartesianGrid> grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 40, 36, 8);
+    const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(16, 16, 8)));
+
+    for (const std::size_t n_component : {1, 2})
+    {
+        Field field("compressed_field", grid, FieldGridStagger::CellCentered, n_component, 0, FoldParity::Scalar,
+                    box_decomposition);
+        field.hdf5_options = HDF5Options::Compressed(4, 10);
+        for (amrex::MFIter mfi(*field.multifab); mfi.isValid(); ++mfi)
+        {
+            const amrex::Array4<amrex::Real>& array = field.multifab->array(mfi);
+            amrex::ParallelFor(mfi.validbox(), static_cast<int>(n_component),
+                               [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                               { array(i, j, k, n) = std::sin(0.1 * i) * std::cos(0.2 * j) + 0.01 * k + n; });
+        }
+
+        const std::string filename = "Test_Output_HDF5Options_FieldWriteHDF5.h5";
+        field.WriteHDF5(filename);
+
+        if (amrex::ParallelDescriptor::IOProcessor())
+        {
+            const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            const hid_t dataset_id = H5Dopen2(file_id, field.name.c_str(), H5P_DEFAULT);
+
+            // Chunks the size of the boxes, with all components
+            const hid_t create_plist = H5Dget_create_plist(dataset_id);
+            std::vector<hsize_t> chunk_dims(n_component > 1 ? 4 : 3);
+            ASSERT_EQ(H5Pget_chunk(create_plist, static_cast<int>(chunk_dims.size()), chunk_dims.data()),
+                      static_cast<int>(chunk_dims.size()));
+            EXPECT_EQ(chunk_dims[0], 16);
+            EXPECT_EQ(chunk_dims[1], 16);
+            EXPECT_EQ(chunk_dims[2], 8);
+            if (n_component > 1)
+            {
+                EXPECT_EQ(chunk_dims[3], n_component);
+            }
+            EXPECT_EQ(H5Pget_nfilters(create_plist), 2);
+            H5Pclose(create_plist);
+
+            int mantissa_bits        = 0;
+            const hid_t attribute_id = H5Aopen(dataset_id, "mantissa_bits", H5P_DEFAULT);
+            H5Aread(attribute_id, H5T_NATIVE_INT, &mantissa_bits);
+            H5Aclose(attribute_id);
+            EXPECT_EQ(mantissa_bits, 10);
+
+            // The data is the bit rounded field, in row-major order
+            std::vector<double> data(40 * 36 * 8 * n_component);
+            H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+            std::size_t index = 0;
+            for (int i = 0; i < 40; ++i)
+            {
+                for (int j = 0; j < 36; ++j)
+                {
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        for (std::size_t n = 0; n < n_component; ++n)
+                        {
+                            const double expected = std::sin(0.1 * i) * std::cos(0.2 * j) + 0.01 * k + n;
+                            EXPECT_EQ(data[index++], BitRound(expected, 10));
+                        }
+                    }
+                }
+            }
+
+            H5Dclose(dataset_id);
+            H5Fclose(file_id);
+        }
+    }
+}
+
+TEST(HDF5OptionsTest, FieldWriteHDF5ColumnMajor)
+{
+    const std::shared_ptr<CartesianGrid> grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 20, 12, 6);
+    const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 8, 4)));
+
+    // Straight from the field's memory, and packed to apply bit rounding
+    for (const int mantissa_bits : {0, 10})
+    {
+        Field field("column_major_field", grid, FieldGridStagger::IFace, 2, 1, FoldParity::Scalar, box_decomposition);
+        field.hdf5_options.data_layout   = HDF5DataLayout::ColumnMajor;
+        field.hdf5_options.mantissa_bits = mantissa_bits;
+        field.multifab->setVal(-1.0);  // Ghost cells, which must not end up in the file
+        for (amrex::MFIter mfi(*field.multifab); mfi.isValid(); ++mfi)
+        {
+            const amrex::Array4<amrex::Real>& array = field.multifab->array(mfi);
+            amrex::ParallelFor(mfi.validbox(), 2,
+                               [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                               { array(i, j, k, n) = 1000 * n + 100 * i + 10 * j + k + 0.125; });
+        }
+
+        const std::string filename = "Test_Output_HDF5Options_FieldWriteHDF5ColumnMajor.h5";
+        field.WriteHDF5(filename);
+
+        if (amrex::ParallelDescriptor::IOProcessor())
+        {
+            const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            const hid_t dataset_id = H5Dopen2(file_id, field.name.c_str(), H5P_DEFAULT);
+
+            // Dimensions (component, k, j, i), i fastest
+            const hid_t space_id = H5Dget_space(dataset_id);
+            std::vector<hsize_t> dims(4);
+            ASSERT_EQ(H5Sget_simple_extent_dims(space_id, dims.data(), NULL), 4);
+            EXPECT_EQ(dims, (std::vector<hsize_t>{2, 6, 12, 21}));
+            H5Sclose(space_id);
+
+            const hid_t attribute_id = H5Aopen(dataset_id, "data_layout", H5P_DEFAULT);
+            const hid_t type_id      = H5Aget_type(attribute_id);
+            std::string data_layout(H5Tget_size(type_id), '\0');
+            H5Aread(attribute_id, type_id, data_layout.data());
+            H5Tclose(type_id);
+            H5Aclose(attribute_id);
+            EXPECT_STREQ(data_layout.c_str(), "column_major");
+
+            std::vector<double> data(2 * 6 * 12 * 21);
+            H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+            std::size_t index = 0;
+            for (int n = 0; n < 2; ++n)
+            {
+                for (int k = 0; k < 6; ++k)
+                {
+                    for (int j = 0; j < 12; ++j)
+                    {
+                        for (int i = 0; i < 21; ++i)
+                        {
+                            const double expected = 1000 * n + 100 * i + 10 * j + k + 0.125;
+                            EXPECT_EQ(data[index++], BitRound(expected, mantissa_bits));
+                        }
+                    }
+                }
+            }
+
+            H5Dclose(dataset_id);
+            H5Fclose(file_id);
+        }
+    }
+}
+
+TEST(HDF5OptionsTest, FieldWriteHDF5StaggeredChunks)
+{
+    const std::shared_ptr<CartesianGrid> grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 40, 36, 8);
+    const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(16, 12, 8)));
+
+    // The chunks have the cells of the boxes, not their faces or nodes, so the owned points of every box start on a
+    // chunk boundary
+    for (const FieldGridStagger stagger : {FieldGridStagger::IFace, FieldGridStagger::Nodal})
+    {
+        Field field("staggered_field", grid, stagger, 1, 0, FoldParity::Scalar, box_decomposition);
+        field.hdf5_options = HDF5Options::Compressed(4);
+        for (amrex::MFIter mfi(*field.multifab); mfi.isValid(); ++mfi)
+        {
+            const amrex::Array4<amrex::Real>& array = field.multifab->array(mfi);
+            amrex::ParallelFor(mfi.validbox(),
+                               [=] AMREX_GPU_DEVICE(int i, int j, int k) { array(i, j, k) = 100 * i + 10 * j + k; });
+        }
+
+        const std::string filename = "Test_Output_HDF5Options_FieldWriteHDF5StaggeredChunks.h5";
+        field.WriteHDF5(filename);
+
+        if (amrex::ParallelDescriptor::IOProcessor())
+        {
+            const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            const hid_t dataset_id = H5Dopen2(file_id, field.name.c_str(), H5P_DEFAULT);
+
+            const hid_t create_plist = H5Dget_create_plist(dataset_id);
+            std::vector<hsize_t> chunk_dims(3);
+            ASSERT_EQ(H5Pget_chunk(create_plist, 3, chunk_dims.data()), 3) << FieldGridStaggerToString(stagger);
+            EXPECT_EQ(chunk_dims, (std::vector<hsize_t>{16, 12, 8})) << FieldGridStaggerToString(stagger);
+            H5Pclose(create_plist);
+
+            const int n_i = 41;
+            const int n_j = stagger == FieldGridStagger::Nodal ? 37 : 36;
+            const int n_k = stagger == FieldGridStagger::Nodal ? 9 : 8;
+            std::vector<double> data(n_i * n_j * n_k);
+            H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+            std::size_t index = 0;
+            for (int i = 0; i < n_i; ++i)
+            {
+                for (int j = 0; j < n_j; ++j)
+                {
+                    for (int k = 0; k < n_k; ++k)
+                    {
+                        EXPECT_EQ(data[index++], 100 * i + 10 * j + k);
+                    }
+                }
+            }
+
+            H5Dclose(dataset_id);
+            H5Fclose(file_id);
+        }
+    }
+}
@@ -0,0 +1,204 @@
+#include "hdf5_time_series.h"
+
+#include <AMReX.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <H5DSpublic.h>
+#include <hdf5.h>
+
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "field.h"
+#include "grid.h"
+
+namespace turbo
+{
+
+namespace
+{
+
+/**
+ * @brief Number of times per chunk of the "time" dataset.
+ */
+constexpr hsize_t kTimeChunkSize = 512;
+
+/**
+ * @brief Check the grid and fields of a time series and return the fields.
+ */
+std::vector<std::shared_ptr<const Field>> CheckedFields(const std::shared_ptr<Grid>& grid,
+                                                        const std::vector<std::shared_ptr<Field>>& fields)
+{
+    if (!grid)
+    {
+        throw std::invalid_argument("HDF5TimeSeries::HDF5TimeSeries: Invalid grid pointer.");
+    }
+    std::set<Field::NameType> field_names;
+    for (const std::shared_ptr<Field>& field : fields)
+    {
+        if (!field)
+        {
+            throw std::invalid_argument("HDF5TimeSeries::HDF5TimeSeries: Invalid field pointer.");
+        }
+        if (!field_names.insert(field->name).second)
+        {
+            throw std::invalid_argument("HDF5TimeSeries::HDF5TimeSeries: Field '" + field->name +
+                                        "' appears more than once.");
+        }
+    }
+    return std::vector<std::shared_ptr<const Field>>(fields.begin(), fields.end());
+}
+
+}  // namespace
+
+HDF5TimeSeries::HDF5TimeSeries(const std::string& filename, const std::shared_ptr<Grid>& grid,
+                               const std::vector<std::shared_ptr<Field>>& fields, const HDF5WriteMode mode,
+                               const std::size_t flush_interval)
+    : filename_(filename), fields_(CheckedFields(grid, fields)), mode_(mode), flush_interval_(flush_interval)
+{
+    if (mode_ != HDF5WriteMode::Gather && mode_ != HDF5WriteMode::Collective)
+    {
+        throw std::invalid_argument(
+            "HDF5TimeSeries::HDF5TimeSeries: Time series support the Gather and Collective HDF5WriteModes only.");
+    }
+
+    file_id_ = CreateHDF5File(filename_, mode_);
+    open_    = true;
+
+    try
+    {
+        // The grid is written once for the whole run. With MPI-IO, creating datasets is collective so every rank
+        // writes the grid, see Domain::WriteHDF5.
+        if (HasFile())
+        {
+            grid->WriteHDF5(file_id_);
+            CreateTime();
+        }
+        for (const std::shared_ptr<const Field>& field : fields_)
+        {
+            field->CreateHDF5TimeSeries(file_id_, mode_);
+        }
+    }
+    catch (...)
+    {
+        Close();
+        throw;
+    }
+}
+
+HDF5TimeSeries::~HDF5TimeSeries() { Close(); }
+
+void HDF5TimeSeries::Append(const double time)
+{
+    if (!open_)
+    {
+        throw std::logic_error("HDF5TimeSeries::Append: The time series '" + filename_ + "' is closed.");
+    }
+
+    for (const std::shared_ptr<const Field>& field : fields_)
+    {
+        field->AppendHDF5(file_id_, n_snapshot_, mode_);
+    }
+    // Written last, so a snapshot only shows up in the time coordinate once all its fields are in the file
+    if (HasFile())
+    {
+        WriteTime(time);
+    }
+    ++n_snapshot_;
+
+    if (flush_interval_ > 0 && n_snapshot_ % flush_interval_ == 0)
+    {
+        Flush();
+    }
+}
+
+void HDF5TimeSeries::Flush()
+{
+    if (!open_)
+    {
+        throw std::logic_error("HDF5TimeSeries::Flush: The time series '" + filename_ + "' is closed.");
+    }
+    if (HasFile() && H5Fflush(file_id_, H5F_SCOPE_LOCAL) < 0)
+    {
+        throw std::runtime_error("HDF5TimeSeries::Flush: Failed to flush HDF5 file: " + filename_);
+    }
+}
+
+void HDF5TimeSeries::Close()
+{
+    if (!open_)
+    {
+        return;
+    }
+    if (file_id_ >= 0)
+    {
+        H5Fclose(file_id_);
+        file_id_ = H5I_INVALID_HID;
+    }
+    open_ = false;
+}
+
+bool HDF5TimeSeries::IsOpen() const noexcept { return open_; }
+
+std::size_t HDF5TimeSeries::GetNSnapshot() const noexcept { return n_snapshot_; }
+
+const std::string& HDF5TimeSeries::GetFilename() const noexcept { return filename_; }
+
+bool HDF5TimeSeries::HasFile() const
+{
+    return mode_ == HDF5WriteMode::Collective || amrex::ParallelDescriptor::IOProcessor();
+}
+
+void HDF5TimeSeries::CreateTime() const
+{
+    const hsize_t dims[1]     = {0};
+    const hsize_t max_dims[1] = {H5S_UNLIMITED};
+    const hsize_t chunk[1]    = {kTimeChunkSize};
+
+    const hid_t create_plist = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(create_plist, 1, chunk);
+    const hid_t dataspace_id = H5Screate_simple(1, dims, max_dims);
+    const hid_t dataset_id =
+        H5Dcreate(file_id_, "time", H5T_NATIVE_DOUBLE, dataspace_id, H5P_DEFAULT, create_plist, H5P_DEFAULT);
+    H5Sclose(dataspace_id);
+    H5Pclose(create_plist);
+    if (dataset_id < 0)
+    {
+        throw std::runtime_error("HDF5TimeSeries::HDF5TimeSeries: Failed to create HDF5 dataset 'time'.");
+    }
+
+    H5DSset_scale(dataset_id, "time");
+    H5Dclose(dataset_id);
+}
+
+void HDF5TimeSeries::WriteTime(const double time) const
+{
+    const hid_t dataset_id  = H5Dopen2(file_id_, "time", H5P_DEFAULT);
+    const hsize_t extent[1] = {n_snapshot_ + 1};
+    herr_t status           = H5Dset_extent(dataset_id, extent);
+
+    // Extending is collective with MPI-IO, but only the IO processor needs to write the value
+    if (status >= 0 && amrex::ParallelDescriptor::IOProcessor())
+    {
+        const hsize_t start[1]    = {n_snapshot_};
+        const hsize_t count[1]    = {1};
+        const hid_t file_space_id = H5Dget_space(dataset_id);
+        H5Sselect_hyperslab(file_space_id, H5S_SELECT_SET, start, NULL, count, NULL);
+        const hid_t memory_space_id = H5Screate_simple(1, count, NULL);
+
+        status = H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, memory_space_id, file_space_id, H5P_DEFAULT, &time);
+        H5Sclose(memory_space_id);
+        H5Sclose(file_space_id);
+    }
+    H5Dclose(dataset_id);
+
+    if (status < 0)
+    {
+        throw std::runtime_error("HDF5TimeSeries::Append: Failed to write the time to HDF5 file: " + filename_);
+    }
+}
+
+}  // namespace turbo
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <hdf5.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "field.h"
+#include "grid.h"
+
+namespace turbo
+{
+
+/**
+ * @class HDF5TimeSeries
+ * @brief An HDF5 file kept open over a run, with a snapshot of the fields appended at each output time.
+ *
+ * The file is created and the grid written once, when the time series is constructed. Each field gets a dataset with
+ * a leading unlimited time dimension (see Field::CreateHDF5TimeSeries), and a 1D "time" dataset, attached to the time
+ * dimension of every field as a dimension scale, holds the time of each snapshot. Append writes the fields first and
+ * the time last, so the length of "time" is the number of complete snapshots. The file is flushed every
+ * flush_interval snapshots and when it is closed.
+ */
+class HDF5TimeSeries
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Create the file (overwrites file if exists), write the grid and create the time series datasets. Must be
+     * called by all ranks.
+     * @param filename Name of the HDF5 file to create.
+     * @param grid Grid of the fields, written into the file.
+     * @param fields Fields to write at each snapshot, each as a dataset named after the field.
+     * @param mode How the distributed field data gets into the file.
+     * @param flush_interval Number of snapshots between flushes of the file, 0 to only flush on Close.
+     * @throws std::invalid_argument if the grid or a field is null, two fields have the same name, or the mode is not
+     * HDF5WriteMode::Gather or HDF5WriteMode::Collective.
+     * @throws std::runtime_error if the file cannot be created or written.
+     */
+    HDF5TimeSeries(const std::string& filename, const std::shared_ptr<Grid>& grid,
+                   const std::vector<std::shared_ptr<Field>>& fields, const HDF5WriteMode mode = HDF5WriteMode::Gather,
+                   const std::size_t flush_interval = 1);
+
+    /**
+     * @brief Close the file if it is still open. Must be called by all ranks.
+     */
+    ~HDF5TimeSeries();
+
+    HDF5TimeSeries(const HDF5TimeSeries&)            = delete;
+    HDF5TimeSeries& operator=(const HDF5TimeSeries&) = delete;
+
+    /**
+     * @brief Append a snapshot of the fields at the given time. Must be called by all ranks.
+     * @param time Model time of the snapshot, stored in the "time" dataset.
+     * @throws std::logic_error if the time series is closed.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void Append(const double time);
+
+    /**
+     * @brief Flush the data written so far to disk. Must be called by all ranks.
+     * @throws std::logic_error if the time series is closed.
+     */
+    void Flush();
+
+    /**
+     * @brief Close the file. Does nothing if it is already closed. Must be called by all ranks.
+     */
+    void Close();
+
+    /**
+     * @brief Check if the file is open.
+     * @return true until Close is called.
+     */
+    bool IsOpen() const noexcept;
+
+    /**
+     * @brief Get the number of snapshots appended.
+     * @return Number of snapshots.
+     */
+    std::size_t GetNSnapshot() const noexcept;
+
+    /**
+     * @brief Get the name of the file.
+     * @return Name of the HDF5 file.
+     */
+    const std::string& GetFilename() const noexcept;
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Check if this rank takes part in the HDF5 calls: all ranks with MPI-IO, only the IO processor otherwise.
+     * @return true if this rank has the file open.
+     */
+    bool HasFile() const;
+
+    /**
+     * @brief Create the empty, extendible "time" dataset and make it a dimension scale.
+     */
+    void CreateTime() const;
+
+    /**
+     * @brief Write the time of the snapshot n_snapshot_ into the "time" dataset.
+     * @param time Model time of the snapshot.
+     */
+    void WriteTime(const double time) const;
+
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Name of the HDF5 file.
+     */
+    const std::string filename_;
+
+    /**
+     * @brief Fields written at each snapshot.
+     */
+    const std::vector<std::shared_ptr<const Field>> fields_;
+
+    /**
+     * @brief How the distributed field data gets into the file.
+     */
+    const HDF5WriteMode mode_;
+
+    /**
+     * @brief Number of snapshots between flushes, 0 to only flush on Close.
+     */
+    const std::size_t flush_interval_;
+
+    /**
+     * @brief HDF5 file identifier, H5I_INVALID_HID on ranks without the file (see HasFile) or once closed.
+     */
+    hid_t file_id_ = H5I_INVALID_HID;
+
+    /**
+     * @brief Whether Close has not been called yet.
+     */
+    bool open_ = false;
+
+    /**
+     * @brief Number of snapshots appended.
+     */
+    std::size_t n_snapshot_ = 0;
+};
+
+}  // namespace turbo
@@ -0,0 +1,185 @@
+#include "hdf5_time_series.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <H5DSpublic.h>
+#include <gtest/gtest.h>
+#include <hdf5.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "hdf5_options.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+namespace
+{
+
+/**
+ * @brief Read a whole dataset of doubles and its dimensions from a file, on the IO processor.
+ */
+std::vector<double> ReadDataset(const std::string& filename, const std::string& dataset_name,
+                                std::vector<hsize_t>& dims)
+{
+    const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset_id = H5Dopen2(file_id, dataset_name.c_str(), H5P_DEFAULT);
+    const hid_t space_id   = H5Dget_space(dataset_id);
+    dims.resize(H5Sget_simple_extent_ndims(space_id));
+    H5Sget_simple_extent_dims(space_id, dims.data(), NULL);
+    std::vector<double> data(H5Sget_simple_extent_npoints(space_id));
+    if (!data.empty())
+    {
+        H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+    }
+    H5Sclose(space_id);
+    H5Dclose(dataset_id);
+    H5Fclose(file_id);
+    return data;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------//
+// HDF5TimeSeries tests
+//---------------------------------------------------------------------------//
+
+class HDF5TimeSeriesTest : public ::testing::Test
+{
+   protected:
+    std::shared_ptr<CartesianGrid> grid;
+    std::shared_ptr<Field> scalar;
+    std::shared_ptr<Field> vector;
+
+    void SetUp() override
+    {
+        grid = std::make_shared<CartesianGrid>(std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 10,
+                                               6, 4);
+        const BoxDecomposition box_decomposition = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(4, 4, 4)));
+        scalar = std::make_shared<Field>("scalar", grid, FieldGridStagger::CellCentered, 1, 1, FoldParity::Scalar,
+                                         box_decomposition);
+        vector = std::make_shared<Field>("vector", grid, FieldGridStagger::KFace, 2, 0, FoldParity::Scalar,
+                                         box_decomposition);
+    }
+};
+
+TEST_F(HDF5TimeSeriesTest, InvalidArguments)
+{
+    const std::string filename = "Test_Output_HDF5TimeSeries_Invalid.h5";
+    EXPECT_THROW(HDF5TimeSeries(filename, nullptr, {scalar}), std::invalid_argument);
+    EXPECT_THROW(HDF5TimeSeries(filename, grid, {scalar, nullptr}), std::invalid_argument);
+    EXPECT_THROW(HDF5TimeSeries(filename, grid, {scalar, scalar}), std::invalid_argument);
+
+    HDF5TimeSeries time_series(filename, grid, {scalar});
+    EXPECT_TRUE(time_series.IsOpen());
+    time_series.Close();
+    EXPECT_FALSE(time_series.IsOpen());
+    EXPECT_THROW(time_series.Append(0.0), std::logic_error);
+    EXPECT_THROW(time_series.Flush(), std::logic_error);
+    EXPECT_NO_THROW(time_series.Close());
+}
+
+TEST_F(HDF5TimeSeriesTest, Append)
+{
+    const std::string filename = "Test_Output_HDF5TimeSeries_Append.h5";
+    const std::vector<double> times = {0.0, 86400.0, 172800.0};
+    vector->hdf5_options            = HDF5Options::Compressed(4);
+    vector->hdf5_options.data_layout = HDF5DataLayout::ColumnMajor;
+    {
+        const std::size_t flush_interval = 2;
+        HDF5TimeSeries time_series(filename, grid, {scalar, vector}, HDF5WriteMode::Gather, flush_interval);
+        EXPECT_EQ(time_series.GetFilename(), filename);
+        for (std::size_t snapshot = 0; snapshot < times.size(); ++snapshot)
+        {
+            scalar->multifab->setVal(static_cast<double>(snapshot));
+            vector->multifab->setVal(-static_cast<double>(snapshot));
+            time_series.Append(times[snapshot]);
+        }
+        EXPECT_EQ(time_series.GetNSnapshot(), times.size());
+    }
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        std::vector<hsize_t> dims;
+        EXPECT_EQ(ReadDataset(filename, "time", dims), times);
+
+        // Snapshots along the leading time dimension, in the layout of each field
+        const std::vector<double> scalar_data = ReadDataset(filename, scalar->name, dims);
+        EXPECT_EQ(dims, (std::vector<hsize_t>{3, 10, 6, 4}));
+        const std::vector<double> vector_data = ReadDataset(filename, vector->name, dims);
+        EXPECT_EQ(dims, (std::vector<hsize_t>{3, 2, 5, 6, 10}));
+        for (std::size_t snapshot = 0; snapshot < times.size(); ++snapshot)
+        {
+            for (std::size_t index = 0; index < 10 * 6 * 4; ++index)
+            {
+                EXPECT_EQ(scalar_data[snapshot * 10 * 6 * 4 + index], static_cast<double>(snapshot));
+            }
+            for (std::size_t index = 0; index < 2 * 5 * 6 * 10; ++index)
+            {
+                EXPECT_EQ(vector_data[snapshot * 2 * 5 * 6 * 10 + index], -static_cast<double>(snapshot));
+            }
+        }
+
+        // The grid is written once and the time coordinate is attached to the time dimension
+        const hid_t file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        EXPECT_GT(H5Lexists(file_id, "cell_center", H5P_DEFAULT), 0);
+        const hid_t dataset_id = H5Dopen2(file_id, scalar->name.c_str(), H5P_DEFAULT);
+        const hid_t time_id    = H5Dopen2(file_id, "time", H5P_DEFAULT);
+        EXPECT_GT(H5DSis_attached(dataset_id, time_id, 0), 0);
+        H5Dclose(time_id);
+        H5Dclose(dataset_id);
+        H5Fclose(file_id);
+    }
+}
+
+TEST_F(HDF5TimeSeriesTest, FieldAppendHDF5)
+{
+    // Appending needs a time series dataset of the field
+    const std::string filename = "Test_Output_HDF5TimeSeries_FieldAppendHDF5.h5";
+    scalar->WriteHDF5(filename);
+    const hid_t file_id = amrex::ParallelDescriptor::IOProcessor()
+                              ? H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT)
+                              : H5I_INVALID_HID;
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        EXPECT_THROW(scalar->AppendHDF5(file_id, 0), std::runtime_error);
+    }
+    else
+    {
+        scalar->AppendHDF5(file_id, 0);
+    }
+
+    // Snapshots can be written in any order, the time dimension grows to the largest index
+    vector->CreateHDF5TimeSeries(file_id);
+    vector->multifab->setVal(3.0);
+    vector->AppendHDF5(file_id, 2);
+    vector->multifab->setVal(1.0);
+    vector->AppendHDF5(file_id, 0);
+    if (file_id >= 0)
+    {
+        H5Fclose(file_id);
+    }
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        std::vector<hsize_t> dims;
+        const std::vector<double> data = ReadDataset(filename, vector->name, dims);
+        EXPECT_EQ(dims, (std::vector<hsize_t>{3, 10, 6, 5, 2}));
+        const std::size_t n_point = 10 * 6 * 5 * 2;
+        EXPECT_EQ(data[0], 1.0);
+        EXPECT_EQ(data[n_point - 1], 1.0);
+        EXPECT_EQ(data[2 * n_point], 3.0);
+        EXPECT_EQ(data[3 * n_point - 1], 3.0);
+    }
+}
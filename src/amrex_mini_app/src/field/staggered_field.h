@@ -0,0 +1,372 @@
+#pragma once
+
+#include <AMReX.H>
+#include <AMReX_Extension.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MultiFab.H>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "box_decomposition.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "grid.h"
+
+namespace turbo
+{
+
+/**
+ * @brief Compile-time properties of a FieldGridStagger.
+ *
+ * Along a nodal direction the points of the stagger lie on the cell faces normal to it, one more point than cells,
+ * and along a cell centered direction they lie halfway between the faces. Kernels that use these constants instead
+ * of switching on the runtime stagger of a Field compile to branch-free code.
+ */
+template <FieldGridStagger S>
+struct StaggerTraits
+{
+    static_assert(S == FieldGridStagger::Nodal || S == FieldGridStagger::CellCentered || S == FieldGridStagger::IFace ||
+                      S == FieldGridStagger::JFace || S == FieldGridStagger::KFace,
+                  "StaggerTraits: Invalid FieldGridStagger specified.");
+
+    static constexpr bool kNodalI = S == FieldGridStagger::Nodal || S == FieldGridStagger::IFace; /**< Nodal in I */
+    static constexpr bool kNodalJ = S == FieldGridStagger::Nodal || S == FieldGridStagger::JFace; /**< Nodal in J */
+    static constexpr bool kNodalK = S == FieldGridStagger::Nodal || S == FieldGridStagger::KFace; /**< Nodal in K */
+
+    static constexpr int kExtraPointI = kNodalI ? 1 : 0; /**< Number of points minus number of cells in I */
+    static constexpr int kExtraPointJ = kNodalJ ? 1 : 0; /**< Number of points minus number of cells in J */
+    static constexpr int kExtraPointK = kNodalK ? 1 : 0; /**< Number of points minus number of cells in K */
+
+    static constexpr double kOffsetI = kNodalI ? 0.0 : 0.5; /**< Offset of the points from the nodes in cells in I */
+    static constexpr double kOffsetJ = kNodalJ ? 0.0 : 0.5; /**< Offset of the points from the nodes in cells in J */
+    static constexpr double kOffsetK = kNodalK ? 0.0 : 0.5; /**< Offset of the points from the nodes in cells in K */
+
+    /**
+     * @brief Get the AMReX index type of the stagger, see Field::FieldGridStaggerToAMReXIndexType.
+     * @return Index type, nodal in the nodal directions.
+     */
+    static amrex::IndexType IndexType() noexcept
+    {
+        return amrex::IndexType({AMREX_D_DECL(kExtraPointI, kExtraPointJ, kExtraPointK)});
+    }
+
+    /**
+     * @brief Get the index space of the points of the stagger on a grid, the union of the valid boxes of its fields.
+     * @param grid Grid of the field.
+     * @return Box from (0, 0, 0) to (NCellI() - 1 + kExtraPointI, NCellJ() - 1 + kExtraPointJ, NCellK() - 1 +
+     * kExtraPointK).
+     */
+    static amrex::Box Domain(const Grid& grid) { return amrex::convert(CellDomain(grid), IndexType()); }
+};
+
+/**
+ * @brief Trivially-copyable view of one grid location of a CartesianGrid, with the stagger offsets known at compile
+ * time.
+ *
+ * Like CartesianGridView, but only holds the domain origin and the grid spacing, so the offsets fold into the
+ * coordinate computation. Capture by value in amrex::ParallelFor kernels. Obtain a view from
+ * StaggeredField::GetGridView or MakeStaggeredGridView.
+ */
+template <FieldGridStagger S>
+struct StaggeredGridView
+{
+    double x_origin, y_origin, z_origin; /**< Minimum coordinate of the domain in X, Y, Z */
+    double dx, dy, dz;                   /**< Grid spacing in X, Y, Z */
+
+    /**
+     * @brief Get the X coordinate of index i.
+     * @param i I index
+     * @return X coordinate
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE double X(const int i) const noexcept
+    {
+        return x_origin + (i + StaggerTraits<S>::kOffsetI) * dx;
+    }
+
+    /**
+     * @brief Get the Y coordinate of index j.
+     * @param j J index
+     * @return Y coordinate
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE double Y(const int j) const noexcept
+    {
+        return y_origin + (j + StaggerTraits<S>::kOffsetJ) * dy;
+    }
+
+    /**
+     * @brief Get the Z coordinate of index k.
+     * @param k K index
+     * @return Z coordinate
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE double Z(const int k) const noexcept
+    {
+        return z_origin + (k + StaggerTraits<S>::kOffsetK) * dz;
+    }
+
+    /**
+     * @brief Get the location of a grid point.
+     * @param i I index
+     * @param j J index
+     * @param k K index
+     * @return Grid point location
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE Grid::Point operator()(const int i, const int j,
+                                                                    const int k) const noexcept
+    {
+        return {X(i), Y(j), Z(k)};
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<StaggeredGridView<FieldGridStagger::CellCentered>>,
+              "StaggeredGridView must be trivially copyable to be captured in device kernels.");
+
+/**
+ * @brief Make the view of a grid location of a CartesianGrid with compile-time stagger offsets.
+ * @param grid Grid to view.
+ * @return View of the points of stagger S.
+ */
+template <FieldGridStagger S>
+StaggeredGridView<S> MakeStaggeredGridView(const CartesianGrid& grid) noexcept
+{
+    const CartesianGridView node_view = grid.NodeView();
+    return StaggeredGridView<S>{node_view.x_origin, node_view.y_origin, node_view.z_origin,
+                                node_view.dx,       node_view.dy,       node_view.dz};
+}
+
+/**
+ * @class StaggeredField
+ * @brief Field whose stagger is part of its type.
+ *
+ * Wraps a type-erased Field, which stays the type of registries like Domain and of I/O, and shares it, so both see
+ * the same data. Grid locations, index types and valid extents come from StaggerTraits at compile time, and
+ * operations between fields (see Copy, Saxpy and field_expression.h) only compile for fields of the same stagger, so
+ * e.g. adding a u-face field to a cell field is a compile error instead of a runtime bug.
+ *
+ * @tparam S Location of the field on the grid.
+ */
+template <FieldGridStagger S>
+class StaggeredField
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Types
+    //-----------------------------------------------------------------------//
+
+    using Traits = StaggerTraits<S>;
+
+    /**
+     * @brief Location of the field on the grid.
+     */
+    static constexpr FieldGridStagger kStagger = S;
+
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct a new field with stagger S, see the matching Field constructor.
+     * @param name Name of the field.
+     * @param grid Shared pointer to the grid on which the field is defined.
+     * @param n_component Number of components (e.g., 1 for a scalar field).
+     * @param n_ghost Number of ghost cells.
+     * @param fold_parity How the field transforms across the fold of a TripolarGrid. Ignored on other grids.
+     * @param box_decomposition How the grid is split into boxes and distributed over the ranks.
+     * @throws std::invalid_argument if the grid is null, n_component is zero, or the box decomposition does not fit
+     * the grid.
+     */
+    StaggeredField(const Field::NameType& name, const std::shared_ptr<Grid>& grid, const std::size_t n_component,
+                   const std::size_t n_ghost, const FoldParity fold_parity = FoldParity::Scalar,
+                   const BoxDecomposition& box_decomposition = BoxDecomposition())
+        : field_(std::make_shared<Field>(name, grid, S, n_component, n_ghost, fold_parity, box_decomposition))
+    {
+    }
+
+    /**
+     * @brief Wrap an existing field, e.g. from Domain::CreateField, sharing its data.
+     * @param field Field with stagger S.
+     * @throws std::invalid_argument if the field is null or has another stagger.
+     */
+    explicit StaggeredField(const std::shared_ptr<Field>& field) : field_(field)
+    {
+        if (!field_)
+        {
+            throw std::invalid_argument("StaggeredField::StaggeredField: Invalid field pointer.");
+        }
+        if (field_->field_grid_stagger != S)
+        {
+            throw std::invalid_argument("StaggeredField::StaggeredField: Field '" + field_->name + "' has stagger " +
+                                        FieldGridStaggerToString(field_->field_grid_stagger) + ", expected " +
+                                        FieldGridStaggerToString(S) + ".");
+        }
+    }
+
+    /**
+     * @brief Get the type-erased field, e.g. to add it to a registry or write it out.
+     * @return Shared pointer to the Field.
+     */
+    const std::shared_ptr<Field>& GetField() const noexcept { return field_; }
+
+    /**
+     * @brief Get the data of the field.
+     * @return AMReX MultiFab storing the field data.
+     */
+    amrex::MultiFab& GetMultiFab() const noexcept { return *field_->multifab; }
+
+    /**
+     * @brief Get the index space of the points of the field, see StaggerTraits::Domain.
+     * @return Union of the valid boxes of the field.
+     */
+    amrex::Box Domain() const { return Traits::Domain(*field_->grid); }
+
+    /**
+     * @brief Get the physical location of a grid point of the field, without a runtime switch on the stagger.
+     * @param i Index in the x-direction.
+     * @param j Index in the y-direction.
+     * @param k Index in the z-direction.
+     * @return Grid::Point representing the physical location.
+     */
+    Grid::Point GetGridPoint(const int i, const int j, const int k) const
+    {
+        if constexpr (S == FieldGridStagger::CellCentered)
+        {
+            return field_->grid->CellCenter(i, j, k);
+        }
+        else if constexpr (S == FieldGridStagger::IFace)
+        {
+            return field_->grid->IFace(i, j, k);
+        }
+        else if constexpr (S == FieldGridStagger::JFace)
+        {
+            return field_->grid->JFace(i, j, k);
+        }
+        else if constexpr (S == FieldGridStagger::KFace)
+        {
+            return field_->grid->KFace(i, j, k);
+        }
+        else
+        {
+            return field_->grid->Node(i, j, k);
+        }
+    }
+
+    /**
+     * @brief Get a trivially-copyable view of the field's grid location with compile-time offsets, to capture by value
+     * in amrex::ParallelFor kernels.
+     * @return View of the grid location of stagger S.
+     * @throws std::invalid_argument if the field is not defined on a CartesianGrid.
+     */
+    StaggeredGridView<S> GetGridView() const
+    {
+        const auto* cartesian_grid = dynamic_cast<const CartesianGrid*>(field_->grid.get());
+        if (!cartesian_grid)
+        {
+            throw std::invalid_argument(
+                "StaggeredField::GetGridView: Grid views are only available for fields on a CartesianGrid.");
+        }
+        return MakeStaggeredGridView<S>(*cartesian_grid);
+    }
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief The type-erased field, with stagger S.
+     */
+    std::shared_ptr<Field> field_;
+};
+
+/**
+ * @brief Check that an operand of an operation on fields can be read on the points of the field the operation writes.
+ * @param function Name of the operation, for the error messages.
+ * @param output Field the operation writes, or whose layout the operands share.
+ * @param input Operand.
+ * @param n_ghost Number of ghost cells of the operand the operation reads.
+ * @param n_component Number of components the operand must have, any if not set.
+ * @throws std::invalid_argument if the operand does not have the layout of the output, has fewer than n_ghost ghost
+ * cells, or does not have n_component components.
+ */
+inline void CheckOperand(const std::string& function, const Field& output, const Field& input, const int n_ghost = 0,
+                         const std::optional<int> n_component = std::nullopt)
+{
+    if (!input.multifab->boxArray().CellEqual(output.multifab->boxArray()) ||
+        input.multifab->DistributionMap() != output.multifab->DistributionMap())
+    {
+        throw std::invalid_argument(function + ": Field '" + input.name + "' does not have the layout of field '" +
+                                    output.name + "'.");
+    }
+    if (n_component && input.multifab->nComp() != *n_component)
+    {
+        throw std::invalid_argument(function + ": Field '" + input.name + "' has " +
+                                    std::to_string(input.multifab->nComp()) + " components, expected " +
+                                    std::to_string(*n_component) + ".");
+    }
+    if (input.multifab->nGrow() < n_ghost)
+    {
+        throw std::invalid_argument(function + ": Field '" + input.name + "' needs at least " +
+                                    std::to_string(n_ghost) + " ghost cells.");
+    }
+}
+
+/**
+ * @brief Copy all components of one field into another of the same stagger, on the same layout.
+ * @param destination Field to copy into.
+ * @param source Field to copy from.
+ * @param n_ghost Number of ghost cells to copy as well.
+ * @throws std::invalid_argument if the fields have different layouts or numbers of components, or either has fewer
+ * ghost cells than n_ghost.
+ */
+template <FieldGridStagger S>
+void Copy(const StaggeredField<S>& destination, const StaggeredField<S>& source, const int n_ghost = 0)
+{
+    // The ghost cells copied are read from the source and written to the destination
+    CheckOperand("Copy", *destination.GetField(), *source.GetField(), n_ghost, destination.GetMultiFab().nComp());
+    CheckOperand("Copy", *source.GetField(), *destination.GetField(), n_ghost);
+    const int comp_src_start  = 0;
+    const int comp_dest_start = 0;
+    amrex::MultiFab::Copy(destination.GetMultiFab(), source.GetMultiFab(), comp_src_start, comp_dest_start,
+                          source.GetMultiFab().nComp(), n_ghost);
+}
+
+/**
+ * @brief Add a multiple of one field to another of the same stagger, y += a * x for all components, on the same
+ * layout.
+ * @param y Field to add to.
+ * @param a Factor of x.
+ * @param x Field to add.
+ * @param n_ghost Number of ghost cells to update as well.
+ * @throws std::invalid_argument if the fields have different layouts or numbers of components, or either has fewer
+ * ghost cells than n_ghost.
+ */
+template <FieldGridStagger S>
+void Saxpy(const StaggeredField<S>& y, const amrex::Real a, const StaggeredField<S>& x, const int n_ghost = 0)
+{
+    CheckOperand("Saxpy", *y.GetField(), *x.GetField(), n_ghost, y.GetMultiFab().nComp());
+    CheckOperand("Saxpy", *x.GetField(), *y.GetField(), n_ghost);
+    const int comp_src_start  = 0;
+    const int comp_dest_start = 0;
+    amrex::MultiFab::Saxpy(y.GetMultiFab(), a, x.GetMultiFab(), comp_src_start, comp_dest_start,
+                           x.GetMultiFab().nComp(), n_ghost);
+}
+
+/**
+ * @brief Fields of different staggers live on different points, so they cannot be copied into each other.
+ */
+template <FieldGridStagger S, FieldGridStagger T>
+    requires(S != T)
+void Copy(const StaggeredField<S>& destination, const StaggeredField<T>& source, const int n_ghost = 0) = delete;
+
+/**
+ * @brief Fields of different staggers live on different points, so they cannot be added to each other.
+ */
+template <FieldGridStagger S, FieldGridStagger T>
+    requires(S != T)
+void Saxpy(const StaggeredField<S>& y, const amrex::Real a, const StaggeredField<T>& x, const int n_ghost = 0) = delete;
+
+}  // namespace turbo
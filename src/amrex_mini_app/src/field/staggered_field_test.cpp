@@ -0,0 +1,159 @@
+#include "staggered_field.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "tripolar_geometry.h"
+#include "tripolar_grid.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+namespace
+{
+
+/**
+ * @brief Whether Copy compiles for two fields.
+ */
+template <typename Destination, typename Source>
+concept Copyable = requires(const Destination& destination, const Source& source) { Copy(destination, source); };
+
+/**
+ * @brief Whether Saxpy compiles for two fields.
+ */
+template <typename Y, typename X>
+concept Saxpyable = requires(const Y& y, const X& x) { Saxpy(y, 1.0, x); };
+
+// A stagger mismatch is a compile error
+static_assert(Copyable<StaggeredField<FieldGridStagger::IFace>, StaggeredField<FieldGridStagger::IFace>>);
+static_assert(!Copyable<StaggeredField<FieldGridStagger::CellCentered>, StaggeredField<FieldGridStagger::IFace>>);
+static_assert(Saxpyable<StaggeredField<FieldGridStagger::Nodal>, StaggeredField<FieldGridStagger::Nodal>>);
+static_assert(!Saxpyable<StaggeredField<FieldGridStagger::JFace>, StaggeredField<FieldGridStagger::KFace>>);
+
+// The traits are usable in constant expressions
+static_assert(StaggerTraits<FieldGridStagger::IFace>::kNodalI && !StaggerTraits<FieldGridStagger::IFace>::kNodalJ);
+static_assert(StaggerTraits<FieldGridStagger::KFace>::kOffsetK == 0.0);
+static_assert(StaggerTraits<FieldGridStagger::KFace>::kOffsetI == 0.5);
+static_assert(StaggerTraits<FieldGridStagger::Nodal>::kExtraPointJ == 1);
+static_assert(StaggerTraits<FieldGridStagger::CellCentered>::kExtraPointJ == 0);
+static_assert(std::is_trivially_copyable_v<StaggeredGridView<FieldGridStagger::JFace>>);
+
+/**
+ * @brief Check the compile-time properties of a stagger against the runtime ones of a Field of the stagger.
+ */
+template <FieldGridStagger S>
+void ExpectMatchesField(const std::shared_ptr<Grid>& grid)
+{
+    const StaggeredField<S> field("field", grid, 2, 1);
+    const Field& erased = *field.GetField();
+    EXPECT_EQ(erased.field_grid_stagger, S);
+    EXPECT_EQ(StaggerTraits<S>::IndexType(), Field::FieldGridStaggerToAMReXIndexType(S));
+    EXPECT_EQ(field.Domain(), erased.multifab->boxArray().minimalBox());
+    EXPECT_EQ(field.GetMultiFab().nComp(), 2);
+    EXPECT_EQ(field.GetMultiFab().nGrow(), 1);
+
+    const amrex::Box domain = field.Domain();
+    for (const amrex::IntVect& point : {domain.smallEnd(), domain.bigEnd()})
+    {
+        EXPECT_EQ(field.GetGridPoint(point[0], point[1], point[2]), erased.GetGridPoint(point[0], point[1], point[2]));
+    }
+
+    const StaggeredGridView<S> view  = field.GetGridView();
+    const CartesianGridView expected = erased.GetGridView();
+    for (const int index : {-2, 0, 3})
+    {
+        EXPECT_DOUBLE_EQ(view.X(index), expected.X(index));
+        EXPECT_DOUBLE_EQ(view.Y(index), expected.Y(index));
+        EXPECT_DOUBLE_EQ(view.Z(index), expected.Z(index));
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------//
+// StaggeredField tests
+//---------------------------------------------------------------------------//
+
+TEST(StaggeredFieldTest, MatchesField)
+{
+    const std::shared_ptr<Grid> cartesian_grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 2.0, -1.0, 1.0, 0.0, 3.0), 8, 4, 6);
+    const std::shared_ptr<Grid> tripolar_grid  = std::make_shared<TripolarGrid>(
+        std::make_shared<TripolarGeometry>(0.0, 360.0, -80.0, 90.0, 0.0, 5000.0), 12, 8, 3);
+
+    for (const std::shared_ptr<Grid>& grid : {cartesian_grid, tripolar_grid})
+    {
+        ExpectMatchesField<FieldGridStagger::Nodal>(grid);
+        ExpectMatchesField<FieldGridStagger::CellCentered>(grid);
+        ExpectMatchesField<FieldGridStagger::IFace>(grid);
+        ExpectMatchesField<FieldGridStagger::JFace>(grid);
+        ExpectMatchesField<FieldGridStagger::KFace>(grid);
+    }
+}
+
+TEST(StaggeredFieldTest, WrapAndOperations)
+{
+    const std::shared_ptr<Grid> grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 8, 8, 4);
+    const std::shared_ptr<Field> erased = std::make_shared<Field>("u", grid, FieldGridStagger::IFace, 1, 1);
+
+    // Wrapping shares the data of the type-erased field
+    const StaggeredField<FieldGridStagger::IFace> u(erased);
+    EXPECT_EQ(u.GetField(), erased);
+    EXPECT_EQ(&u.GetMultiFab(), erased->multifab.get());
+    EXPECT_THROW(StaggeredField<FieldGridStagger::JFace>{erased}, std::invalid_argument);
+    EXPECT_THROW(StaggeredField<FieldGridStagger::IFace>{nullptr}, std::invalid_argument);
+
+    const StaggeredField<FieldGridStagger::IFace> du("du", grid, 1, 1);
+    u.GetMultiFab().setVal(1.0);
+    du.GetMultiFab().setVal(2.0);
+    Saxpy(u, 0.5, du);
+    EXPECT_EQ(erased->multifab->min(0), 2.0);
+    EXPECT_EQ(erased->multifab->max(0), 2.0);
+
+    const StaggeredField<FieldGridStagger::IFace> u_old("u_old", grid, 1, 1);
+    Copy(u_old, u, 1);
+    EXPECT_EQ(u_old.GetMultiFab().min(0, 1), 2.0);
+
+    const StaggeredField<FieldGridStagger::IFace> uv("uv", grid, 2, 1);
+    EXPECT_THROW(Copy(uv, u), std::invalid_argument);
+    EXPECT_THROW(Saxpy(uv, 1.0, u), std::invalid_argument);
+
+    // Layouts and ghost cells are checked before any data is touched
+    const BoxDecomposition chunks = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(4, 4, 4)));
+    const StaggeredField<FieldGridStagger::IFace> chunked("chunked", grid, 1, 1, FoldParity::Scalar, chunks);
+    const StaggeredField<FieldGridStagger::IFace> no_ghost("no_ghost", grid, 1, 0);
+    EXPECT_THROW(Copy(chunked, u), std::invalid_argument);
+    EXPECT_THROW(Saxpy(u, 1.0, chunked), std::invalid_argument);
+    EXPECT_THROW(Copy(no_ghost, u, 1), std::invalid_argument);
+    EXPECT_THROW(Saxpy(u, 1.0, no_ghost, 1), std::invalid_argument);
+}
+
+TEST(StaggeredFieldTest, CheckOperand)
+{
+    const std::shared_ptr<Grid> grid = std::make_shared<CartesianGrid>(
+        std::make_shared<CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 8, 8, 4);
+    const Field output("output", grid, FieldGridStagger::CellCentered, 2, 0);
+    const Field face("face", grid, FieldGridStagger::IFace, 2, 1);
+    const Field scalar("scalar", grid, FieldGridStagger::CellCentered, 1, 1);
+    const Field chunked("chunked", grid, FieldGridStagger::CellCentered, 2, 1, FoldParity::Scalar,
+                        BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(4, 4, 4))));
+
+    // Operands of another stagger have the layout of the cells they belong to
+    EXPECT_NO_THROW(CheckOperand("Test", output, face, 1, 2));
+    EXPECT_NO_THROW(CheckOperand("Test", output, scalar));
+    EXPECT_THROW(CheckOperand("Test", output, chunked), std::invalid_argument);
+    EXPECT_THROW(CheckOperand("Test", output, face, 2), std::invalid_argument);
+    EXPECT_THROW(CheckOperand("Test", output, scalar, 0, 2), std::invalid_argument);
+}
@@ -0,0 +1,324 @@
+#include "stencil_operators.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "box_decomposition.h"
+#include "field.h"
+#include "staggered_field.h"
+
+namespace turbo
+{
+
+namespace
+{
+
+/**
+ * @brief Check that the inputs of an operator can be read on the points of its output, with the number of components
+ * of the output, see CheckOperand.
+ * @param function Name of the operator, for the error messages.
+ * @param output Output field.
+ * @param inputs Input fields, each with the number of ghost cells the stencil reaches outside of it.
+ * @throws std::invalid_argument if an input does not match.
+ */
+void CheckOperands(const std::string& function, const Field& output,
+                   const std::initializer_list<std::pair<const Field*, int>> inputs)
+{
+    for (const auto& [input, n_ghost] : inputs)
+    {
+        CheckOperand(function, output, *input, n_ghost, output.multifab->nComp());
+    }
+}
+
+/**
+ * @brief Run a kernel on every tile of the valid boxes of an output MultiFab, spreading the tiles over the OpenMP
+ * threads. On the GPU every box is a single tile.
+ * @param output MultiFab whose tiles to loop over.
+ * @param kernel Called with the iterator and the tile, in the index type of the output.
+ */
+template <typename Kernel>
+void ForEachTile(const amrex::MultiFab& output, Kernel&& kernel)
+{
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(output, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        kernel(mfi, mfi.tilebox());
+    }
+}
+
+/**
+ * @brief Get the grid spacing normal to the faces of stagger F.
+ */
+template <FieldGridStagger F>
+double FaceNormalSpacing(const StaggeredGridView<F>& view) noexcept
+{
+    if constexpr (F == FieldGridStagger::IFace)
+    {
+        return view.dx;
+    }
+    else if constexpr (F == FieldGridStagger::JFace)
+    {
+        return view.dy;
+    }
+    else
+    {
+        return view.dz;
+    }
+}
+
+}  // namespace
+
+template <FieldGridStagger F>
+    requires(IsFaceStagger(F))
+void Gradient(const StaggeredField<F>& gradient, const StaggeredField<FieldGridStagger::CellCentered>& field)
+{
+    CheckOperands("Gradient", *gradient.GetField(), {{field.GetField().get(), 1}});
+
+    // Unit offset from a face to the cell on its lower side
+    constexpr int di             = F == FieldGridStagger::IFace ? 1 : 0;
+    constexpr int dj             = F == FieldGridStagger::JFace ? 1 : 0;
+    constexpr int dk             = F == FieldGridStagger::KFace ? 1 : 0;
+    const double inverse_spacing = 1.0 / FaceNormalSpacing(gradient.GetGridView());
+    amrex::MultiFab& output      = gradient.GetMultiFab();
+    const amrex::MultiFab& input = field.GetMultiFab();
+    ForEachTile(output,
+                [&](const amrex::MFIter& mfi, const amrex::Box& tile)
+                {
+                    const amrex::Array4<amrex::Real> out      = output.array(mfi);
+                    const amrex::Array4<const amrex::Real> in = input.const_array(mfi);
+                    amrex::ParallelFor(tile, output.nComp(),
+                                       [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       {
+                                           out(i, j, k, n) =
+                                               (in(i, j, k, n) - in(i - di, j - dj, k - dk, n)) * inverse_spacing;
+                                       });
+                });
+}
+
+void Divergence(const StaggeredField<FieldGridStagger::CellCentered>& divergence,
+                const StaggeredField<FieldGridStagger::IFace>& u, const StaggeredField<FieldGridStagger::JFace>& v,
+                const StaggeredField<FieldGridStagger::KFace>& w)
+{
+    CheckOperands("Divergence", *divergence.GetField(),
+                  {{u.GetField().get(), 0}, {v.GetField().get(), 0}, {w.GetField().get(), 0}});
+
+    const StaggeredGridView<FieldGridStagger::CellCentered> view = divergence.GetGridView();
+    const double inverse_dx                                      = 1.0 / view.dx;
+    const double inverse_dy                                      = 1.0 / view.dy;
+    const double inverse_dz                                      = 1.0 / view.dz;
+    amrex::MultiFab& output                                      = divergence.GetMultiFab();
+    ForEachTile(output,
+                [&](const amrex::MFIter& mfi, const amrex::Box& tile)
+                {
+                    const amrex::Array4<amrex::Real> out           = output.array(mfi);
+                    const amrex::Array4<const amrex::Real> u_array = u.GetMultiFab().const_array(mfi);
+                    const amrex::Array4<const amrex::Real> v_array = v.GetMultiFab().const_array(mfi);
+                    const amrex::Array4<const amrex::Real> w_array = w.GetMultiFab().const_array(mfi);
+                    amrex::ParallelFor(tile, output.nComp(),
+                                       [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       {
+                                           out(i, j, k, n) =
+                                               (u_array(i + 1, j, k, n) - u_array(i, j, k, n)) * inverse_dx +
+                                               (v_array(i, j + 1, k, n) - v_array(i, j, k, n)) * inverse_dy +
+                                               (w_array(i, j, k + 1, n) - w_array(i, j, k, n)) * inverse_dz;
+                                       });
+                });
+}
+
+void HorizontalDivergence(const StaggeredField<FieldGridStagger::CellCentered>& divergence,
+                          const StaggeredField<FieldGridStagger::IFace>& u,
+                          const StaggeredField<FieldGridStagger::JFace>& v)
+{
+    CheckOperands("HorizontalDivergence", *divergence.GetField(), {{u.GetField().get(), 0}, {v.GetField().get(), 0}});
+
+    const StaggeredGridView<FieldGridStagger::CellCentered> view = divergence.GetGridView();
+    const double inverse_dx                                      = 1.0 / view.dx;
+    const double inverse_dy                                      = 1.0 / view.dy;
+    amrex::MultiFab& output                                      = divergence.GetMultiFab();
+    ForEachTile(output,
+                [&](const amrex::MFIter& mfi, const amrex::Box& tile)
+                {
+                    const amrex::Array4<amrex::Real> out           = output.array(mfi);
+                    const amrex::Array4<const amrex::Real> u_array = u.GetMultiFab().const_array(mfi);
+                    const amrex::Array4<const amrex::Real> v_array = v.GetMultiFab().const_array(mfi);
+                    amrex::ParallelFor(tile, output.nComp(),
+                                       [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       {
+                                           out(i, j, k, n) =
+                                               (u_array(i + 1, j, k, n) - u_array(i, j, k, n)) * inverse_dx +
+                                               (v_array(i, j + 1, k, n) - v_array(i, j, k, n)) * inverse_dy;
+                                       });
+                });
+}
+
+void HorizontalLaplacian(const StaggeredField<FieldGridStagger::CellCentered>& laplacian,
+                         const StaggeredField<FieldGridStagger::CellCentered>& field)
+{
+    CheckOperands("HorizontalLaplacian", *laplacian.GetField(), {{field.GetField().get(), 1}});
+
+    const StaggeredGridView<FieldGridStagger::CellCentered> view = laplacian.GetGridView();
+    const double inverse_dx2                                     = 1.0 / (view.dx * view.dx);
+    const double inverse_dy2                                     = 1.0 / (view.dy * view.dy);
+    amrex::MultiFab& output                                      = laplacian.GetMultiFab();
+    const amrex::MultiFab& input                                 = field.GetMultiFab();
+    ForEachTile(output,
+                [&](const amrex::MFIter& mfi, const amrex::Box& tile)
+                {
+                    const amrex::Array4<amrex::Real> out      = output.array(mfi);
+                    const amrex::Array4<const amrex::Real> in = input.const_array(mfi);
+                    amrex::ParallelFor(tile, output.nComp(),
+                                       [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       {
+                                           const double center = in(i, j, k, n);
+                                           out(i, j, k, n) =
+                                               (in(i - 1, j, k, n) - 2.0 * center + in(i + 1, j, k, n)) * inverse_dx2 +
+                                               (in(i, j - 1, k, n) - 2.0 * center + in(i, j + 1, k, n)) * inverse_dy2;
+                                       });
+                });
+}
+
+void HorizontalBiharmonic(const StaggeredField<FieldGridStagger::CellCentered>& biharmonic,
+                          const StaggeredField<FieldGridStagger::CellCentered>& field)
+{
+    CheckOperands("HorizontalBiharmonic", *biharmonic.GetField(), {{field.GetField().get(), 2}});
+
+    // d4/dx4 + 2 d4/dx2dy2 + d4/dy4, the expansion of the Laplacian of the 5-point Laplacian
+    const StaggeredGridView<FieldGridStagger::CellCentered> view = biharmonic.GetGridView();
+    const double inverse_dx2                                     = 1.0 / (view.dx * view.dx);
+    const double inverse_dy2                                     = 1.0 / (view.dy * view.dy);
+    const double inverse_dx4                                     = inverse_dx2 * inverse_dx2;
+    const double inverse_dy4                                     = inverse_dy2 * inverse_dy2;
+    const double inverse_dx2dy2                                  = 2.0 * inverse_dx2 * inverse_dy2;
+    amrex::MultiFab& output                                      = biharmonic.GetMultiFab();
+    const amrex::MultiFab& input                                 = field.GetMultiFab();
+    ForEachTile(output,
+                [&](const amrex::MFIter& mfi, const amrex::Box& tile)
+                {
+                    const amrex::Array4<amrex::Real> out      = output.array(mfi);
+                    const amrex::Array4<const amrex::Real> in = input.const_array(mfi);
+                    amrex::ParallelFor(
+                        tile, output.nComp(),
+                        [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                        {
+                            const double center = in(i, j, k, n);
+                            const double d4x    = in(i - 2, j, k, n) - 4.0 * in(i - 1, j, k, n) + 6.0 * center -
+                                               4.0 * in(i + 1, j, k, n) + in(i + 2, j, k, n);
+                            const double d4y    = in(i, j - 2, k, n) - 4.0 * in(i, j - 1, k, n) + 6.0 * center -
+                                               4.0 * in(i, j + 1, k, n) + in(i, j + 2, k, n);
+                            const double d2xd2y = in(i - 1, j - 1, k, n) + in(i + 1, j - 1, k, n) +
+                                                  in(i - 1, j + 1, k, n) + in(i + 1, j + 1, k, n) -
+                                                  2.0 * (in(i - 1, j, k, n) + in(i + 1, j, k, n) + in(i, j - 1, k, n) +
+                                                         in(i, j + 1, k, n)) +
+                                                  4.0 * center;
+                            out(i, j, k, n) = d4x * inverse_dx4 + d2xd2y * inverse_dx2dy2 + d4y * inverse_dy4;
+                        });
+                });
+}
+
+void Vorticity(const StaggeredField<FieldGridStagger::Nodal>& vorticity,
+               const StaggeredField<FieldGridStagger::IFace>& u, const StaggeredField<FieldGridStagger::JFace>& v)
+{
+    CheckOperands("Vorticity", *vorticity.GetField(), {{u.GetField().get(), 1}, {v.GetField().get(), 1}});
+
+    const StaggeredGridView<FieldGridStagger::Nodal> view = vorticity.GetGridView();
+    const double inverse_dx                               = 1.0 / view.dx;
+    const double inverse_dy                               = 1.0 / view.dy;
+    const int k_top_layer                                 = CellDomain(*vorticity.GetField()->grid).bigEnd(2);
+    amrex::MultiFab& output                               = vorticity.GetMultiFab();
+    ForEachTile(output,
+                [&](const amrex::MFIter& mfi, const amrex::Box& tile)
+                {
+                    // The nodes above the top layer have no vorticity
+                    amrex::Box box = tile;
+                    box.setBig(2, std::min(box.bigEnd(2), k_top_layer));
+                    if (!box.ok())
+                    {
+                        return;
+                    }
+                    const amrex::Array4<amrex::Real> out           = output.array(mfi);
+                    const amrex::Array4<const amrex::Real> u_array = u.GetMultiFab().const_array(mfi);
+                    const amrex::Array4<const amrex::Real> v_array = v.GetMultiFab().const_array(mfi);
+                    amrex::ParallelFor(box, output.nComp(),
+                                       [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       {
+                                           out(i, j, k, n) =
+                                               (v_array(i, j, k, n) - v_array(i - 1, j, k, n)) * inverse_dx -
+                                               (u_array(i, j, k, n) - u_array(i, j - 1, k, n)) * inverse_dy;
+                                       });
+                });
+}
+
+template <FieldGridStagger F>
+    requires(IsFaceStagger(F))
+void CellToFace(const StaggeredField<F>& face, const StaggeredField<FieldGridStagger::CellCentered>& cell)
+{
+    CheckOperands("CellToFace", *face.GetField(), {{cell.GetField().get(), 1}});
+
+    // Unit offset from a face to the cell on its lower side
+    constexpr int di             = F == FieldGridStagger::IFace ? 1 : 0;
+    constexpr int dj             = F == FieldGridStagger::JFace ? 1 : 0;
+    constexpr int dk             = F == FieldGridStagger::KFace ? 1 : 0;
+    amrex::MultiFab& output      = face.GetMultiFab();
+    const amrex::MultiFab& input = cell.GetMultiFab();
+    ForEachTile(output,
+                [&](const amrex::MFIter& mfi, const amrex::Box& tile)
+                {
+                    const amrex::Array4<amrex::Real> out      = output.array(mfi);
+                    const amrex::Array4<const amrex::Real> in = input.const_array(mfi);
+                    amrex::ParallelFor(tile, output.nComp(),
+                                       [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       { out(i, j, k, n) = 0.5 * (in(i - di, j - dj, k - dk, n) + in(i, j, k, n)); });
+                });
+}
+
+template <FieldGridStagger F>
+    requires(IsFaceStagger(F))
+void FaceToCell(const StaggeredField<FieldGridStagger::CellCentered>& cell, const StaggeredField<F>& face)
+{
+    CheckOperands("FaceToCell", *cell.GetField(), {{face.GetField().get(), 0}});
+
+    // Unit offset from a cell to the face on its upper side
+    constexpr int di             = F == FieldGridStagger::IFace ? 1 : 0;
+    constexpr int dj             = F == FieldGridStagger::JFace ? 1 : 0;
+    constexpr int dk             = F == FieldGridStagger::KFace ? 1 : 0;
+    amrex::MultiFab& output      = cell.GetMultiFab();
+    const amrex::MultiFab& input = face.GetMultiFab();
+    ForEachTile(output,
+                [&](const amrex::MFIter& mfi, const amrex::Box& tile)
+                {
+                    const amrex::Array4<amrex::Real> out      = output.array(mfi);
+                    const amrex::Array4<const amrex::Real> in = input.const_array(mfi);
+                    amrex::ParallelFor(tile, output.nComp(),
+                                       [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                       { out(i, j, k, n) = 0.5 * (in(i, j, k, n) + in(i + di, j + dj, k + dk, n)); });
+                });
+}
+
+template void Gradient<FieldGridStagger::IFace>(const StaggeredField<FieldGridStagger::IFace>&,
+                                                const StaggeredField<FieldGridStagger::CellCentered>&);
+template void Gradient<FieldGridStagger::JFace>(const StaggeredField<FieldGridStagger::JFace>&,
+                                                const StaggeredField<FieldGridStagger::CellCentered>&);
+template void Gradient<FieldGridStagger::KFace>(const StaggeredField<FieldGridStagger::KFace>&,
+                                                const StaggeredField<FieldGridStagger::CellCentered>&);
+template void CellToFace<FieldGridStagger::IFace>(const StaggeredField<FieldGridStagger::IFace>&,
+                                                  const StaggeredField<FieldGridStagger::CellCentered>&);
+template void CellToFace<FieldGridStagger::JFace>(const StaggeredField<FieldGridStagger::JFace>&,
+                                                  const StaggeredField<FieldGridStagger::CellCentered>&);
+template void CellToFace<FieldGridStagger::KFace>(const StaggeredField<FieldGridStagger::KFace>&,
+                                                  const StaggeredField<FieldGridStagger::CellCentered>&);
+template void FaceToCell<FieldGridStagger::IFace>(const StaggeredField<FieldGridStagger::CellCentered>&,
+                                                  const StaggeredField<FieldGridStagger::IFace>&);
+template void FaceToCell<FieldGridStagger::JFace>(const StaggeredField<FieldGridStagger::CellCentered>&,
+                                                  const StaggeredField<FieldGridStagger::JFace>&);
+template void FaceToCell<FieldGridStagger::KFace>(const StaggeredField<FieldGridStagger::CellCentered>&,
+                                                  const StaggeredField<FieldGridStagger::KFace>&);
+
+}  // namespace turbo
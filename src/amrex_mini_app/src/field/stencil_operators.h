@@ -0,0 +1,128 @@
+#pragma once
+
+#include "field.h"
+#include "staggered_field.h"
+
+namespace turbo
+{
+
+/**
+ * @brief Check if a stagger is one of the face staggers, the output of Gradient and CellToFace.
+ * @param stagger Field grid staggering type.
+ * @return true for IFace, JFace and KFace, false otherwise.
+ */
+constexpr bool IsFaceStagger(const FieldGridStagger stagger) noexcept
+{
+    return stagger == FieldGridStagger::IFace || stagger == FieldGridStagger::JFace ||
+           stagger == FieldGridStagger::KFace;
+}
+
+// Finite-volume operators between the staggers of the C-grid, on fields of a CartesianGrid with the grid spacing of
+// the grid. Every operator runs one fused amrex::ParallelFor per tile of the output, with the tiles of the boxes spread
+// over the OpenMP threads, and computes all components of the output. The output is computed on its valid points
+// only, and the input fields need as many ghost cells as the stencil reaches outside of them, filled (e.g. by
+// FillBoundary, or with boundary values outside of the domain) before the call. All fields of a call must share the
+// layout of the boxes, as all fields of a Domain do, and have the same number of components.
+
+/**
+ * @brief Compute the gradient of a cell centered field normal to the faces of stagger F, (c(i) - c(i - 1)) / dx for
+ * IFace. Needs 1 ghost cell of the input.
+ * @tparam F Face stagger of the output, which selects the direction.
+ * @param gradient Output, on the faces.
+ * @param field Input, at the cell centers.
+ * @throws std::invalid_argument if the layouts or numbers of components do not match or the input has too few ghost
+ * cells.
+ */
+template <FieldGridStagger F>
+    requires(IsFaceStagger(F))
+void Gradient(const StaggeredField<F>& gradient, const StaggeredField<FieldGridStagger::CellCentered>& field);
+
+/**
+ * @brief Compute the divergence of a flux given by its components normal to the faces, (u(i + 1) - u(i)) / dx +
+ * (v(j + 1) - v(j)) / dy + (w(k + 1) - w(k)) / dz. Needs no ghost cells.
+ * @param divergence Output, at the cell centers.
+ * @param u Input I component, on the I faces.
+ * @param v Input J component, on the J faces.
+ * @param w Input K component, on the K faces.
+ * @throws std::invalid_argument if the layouts or numbers of components do not match.
+ */
+void Divergence(const StaggeredField<FieldGridStagger::CellCentered>& divergence,
+                const StaggeredField<FieldGridStagger::IFace>& u, const StaggeredField<FieldGridStagger::JFace>& v,
+                const StaggeredField<FieldGridStagger::KFace>& w);
+
+/**
+ * @brief Compute the horizontal divergence of a flux, the layer-wise divergence of the horizontal velocity of the
+ * ocean, (u(i + 1) - u(i)) / dx + (v(j + 1) - v(j)) / dy. Needs no ghost cells.
+ * @param divergence Output, at the cell centers.
+ * @param u Input I component, on the I faces.
+ * @param v Input J component, on the J faces.
+ * @throws std::invalid_argument if the layouts or numbers of components do not match.
+ */
+void HorizontalDivergence(const StaggeredField<FieldGridStagger::CellCentered>& divergence,
+                          const StaggeredField<FieldGridStagger::IFace>& u,
+                          const StaggeredField<FieldGridStagger::JFace>& v);
+
+/**
+ * @brief Compute the horizontal Laplacian of a cell centered field with the 5-point stencil, the divergence of the
+ * Gradient on the I and J faces fused into one sweep. Needs 1 ghost cell of the input.
+ * @param laplacian Output, at the cell centers.
+ * @param field Input, at the cell centers.
+ * @throws std::invalid_argument if the layouts or numbers of components do not match or the input has too few ghost
+ * cells.
+ */
+void HorizontalLaplacian(const StaggeredField<FieldGridStagger::CellCentered>& laplacian,
+                         const StaggeredField<FieldGridStagger::CellCentered>& field);
+
+/**
+ * @brief Compute the horizontal biharmonic operator of a cell centered field with the 13-point stencil, equal to
+ * HorizontalLaplacian applied twice but in one sweep without the intermediate field. Needs 2 ghost cells of the input.
+ * @param biharmonic Output, at the cell centers.
+ * @param field Input, at the cell centers.
+ * @throws std::invalid_argument if the layouts or numbers of components do not match or the input has too few ghost
+ * cells.
+ */
+void HorizontalBiharmonic(const StaggeredField<FieldGridStagger::CellCentered>& biharmonic,
+                          const StaggeredField<FieldGridStagger::CellCentered>& field);
+
+/**
+ * @brief Compute the vertical component of the curl of the horizontal velocity, the relative vorticity
+ * (v(i) - v(i - 1)) / dx - (u(j) - u(j - 1)) / dy, at the cell corners. Needs 1 ghost cell of the inputs.
+ *
+ * The vorticity of layer k is stored at the nodes (i, j, k). The nodes on the top of the grid, k = NCellK(), have no
+ * layer and are left unchanged.
+ *
+ * @param vorticity Output, at the nodes.
+ * @param u Input I component, on the I faces.
+ * @param v Input J component, on the J faces.
+ * @throws std::invalid_argument if the layouts or numbers of components do not match or the inputs have too few ghost
+ * cells.
+ */
+void Vorticity(const StaggeredField<FieldGridStagger::Nodal>& vorticity,
+               const StaggeredField<FieldGridStagger::IFace>& u, const StaggeredField<FieldGridStagger::JFace>& v);
+
+/**
+ * @brief Average a cell centered field onto the faces of stagger F, (c(i - 1) + c(i)) / 2 for IFace. Needs 1 ghost
+ * cell of the input.
+ * @tparam F Face stagger of the output.
+ * @param face Output, on the faces.
+ * @param cell Input, at the cell centers.
+ * @throws std::invalid_argument if the layouts or numbers of components do not match or the input has too few ghost
+ * cells.
+ */
+template <FieldGridStagger F>
+    requires(IsFaceStagger(F))
+void CellToFace(const StaggeredField<F>& face, const StaggeredField<FieldGridStagger::CellCentered>& cell);
+
+/**
+ * @brief Average a field on the faces of stagger F onto the cell centers, (f(i) + f(i + 1)) / 2 for IFace. Needs no
+ * ghost cells.
+ * @tparam F Face stagger of the input.
+ * @param cell Output, at the cell centers.
+ * @param face Input, on the faces.
+ * @throws std::invalid_argument if the layouts or numbers of components do not match.
+ */
+template <FieldGridStagger F>
+    requires(IsFaceStagger(F))
+void FaceToCell(const StaggeredField<FieldGridStagger::CellCentered>& cell, const StaggeredField<F>& face);
+
+}  // namespace turbo
@@ -0,0 +1,170 @@
+#include "stencil_operators.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "field_test_utils.h"
+#include "staggered_field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for stencil operator tests
+//---------------------------------------------------------------------------//
+
+class StencilOperatorsTest : public ::testing::Test
+{
+   protected:
+    using Function = std::function<double(const Grid::Point&, int)>;
+
+    void SetUp() override
+    {
+        // Unit spacing keeps the differences of the polynomials below exact
+        grid = std::make_shared<CartesianGrid>(std::make_shared<CartesianGeometry>(-4.0, 4.0, 0.0, 6.0, 0.0, 4.0), 8,
+                                               6, 4);
+    }
+
+    /**
+     * @brief Make a field with two components and set it to a function of the location of its points, ghost points
+     * included.
+     */
+    template <FieldGridStagger S>
+    StaggeredField<S> MakeField(const Function& function, const int n_ghost = 2) const
+    {
+        const StaggeredField<S> field("field", grid, 2, n_ghost, FoldParity::Scalar, box_decomposition);
+        FillField(field, AtLocation(field, function), n_ghost);
+        return field;
+    }
+
+    /**
+     * @brief Get the largest difference between the valid points of a field and a function of their location, on
+     * all ranks.
+     */
+    template <FieldGridStagger S>
+    static double MaxError(const StaggeredField<S>& field, const Function& expected)
+    {
+        return ::MaxError(field, AtLocation(field, expected));
+    }
+
+    std::shared_ptr<CartesianGrid> grid;
+    const BoxDecomposition box_decomposition = MakeTestBoxDecomposition(2);
+};
+
+//---------------------------------------------------------------------------//
+// Stencil operator tests
+//---------------------------------------------------------------------------//
+
+TEST_F(StencilOperatorsTest, GradientAndAveraging)
+{
+    // Second component is scaled, so components are not mixed up
+    const auto cell = MakeField<FieldGridStagger::CellCentered>(
+        [](const Grid::Point& p, int n) { return (n + 1) * (p.x * p.x + 3.0 * p.y - 2.0 * p.z * p.z); });
+
+    const auto gradient_i = MakeField<FieldGridStagger::IFace>([](const Grid::Point&, int) { return 0.0; });
+    const auto gradient_j = MakeField<FieldGridStagger::JFace>([](const Grid::Point&, int) { return 0.0; });
+    const auto gradient_k = MakeField<FieldGridStagger::KFace>([](const Grid::Point&, int) { return 0.0; });
+    Gradient(gradient_i, cell);
+    Gradient(gradient_j, cell);
+    Gradient(gradient_k, cell);
+    EXPECT_LT(MaxError(gradient_i, [](const Grid::Point& p, int n) { return (n + 1) * 2.0 * p.x; }), 1.0e-12);
+    EXPECT_LT(MaxError(gradient_j, [](const Grid::Point&, int n) { return (n + 1) * 3.0; }), 1.0e-12);
+    EXPECT_LT(MaxError(gradient_k, [](const Grid::Point& p, int n) { return (n + 1) * -4.0 * p.z; }), 1.0e-12);
+
+    // Averages of linear functions are exact
+    const auto linear = MakeField<FieldGridStagger::CellCentered>(
+        [](const Grid::Point& p, int n) { return p.x - 2.0 * p.y + 0.5 * p.z + n; });
+    const auto face_j = MakeField<FieldGridStagger::JFace>([](const Grid::Point&, int) { return 0.0; });
+    CellToFace(face_j, linear);
+    EXPECT_LT(MaxError(face_j, [](const Grid::Point& p, int n) { return p.x - 2.0 * p.y + 0.5 * p.z + n; }), 1.0e-12);
+
+    const auto face_k = MakeField<FieldGridStagger::KFace>([](const Grid::Point& p, int n) { return 3.0 * p.z - n; });
+    const auto average = MakeField<FieldGridStagger::CellCentered>([](const Grid::Point&, int) { return 0.0; });
+    FaceToCell(average, face_k);
+    EXPECT_LT(MaxError(average, [](const Grid::Point& p, int n) { return 3.0 * p.z - n; }), 1.0e-12);
+}
+
+TEST_F(StencilOperatorsTest, DivergenceAndVorticity)
+{
+    const auto u = MakeField<FieldGridStagger::IFace>([](const Grid::Point& p, int n) { return p.x * p.x - p.y + n; });
+    const auto v = MakeField<FieldGridStagger::JFace>([](const Grid::Point& p, int) { return 2.0 * p.y + 3.0 * p.x; });
+    const auto w = MakeField<FieldGridStagger::KFace>([](const Grid::Point& p, int n) { return -(n + 1) * p.z; });
+
+    const auto divergence = MakeField<FieldGridStagger::CellCentered>([](const Grid::Point&, int) { return 0.0; });
+    Divergence(divergence, u, v, w);
+    EXPECT_LT(MaxError(divergence, [](const Grid::Point& p, int n) { return 2.0 * p.x + 2.0 - (n + 1); }), 1.0e-12);
+    HorizontalDivergence(divergence, u, v);
+    EXPECT_LT(MaxError(divergence, [](const Grid::Point& p, int) { return 2.0 * p.x + 2.0; }), 1.0e-12);
+
+    // dv/dx - du/dy = 3 + 1, except above the top layer, which is left unchanged
+    const auto vorticity = MakeField<FieldGridStagger::Nodal>([](const Grid::Point&, int) { return -7.0; });
+    Vorticity(vorticity, u, v);
+    const double z_top = grid->GetGeometry()->ZMax();
+    EXPECT_LT(MaxError(vorticity, [z_top](const Grid::Point& p, int) { return p.z < z_top - 0.5 ? 4.0 : -7.0; }),
+              1.0e-12);
+}
+
+TEST_F(StencilOperatorsTest, LaplacianAndBiharmonic)
+{
+    const auto field = MakeField<FieldGridStagger::CellCentered>(
+        [](const Grid::Point& p, int n)
+        { return std::pow(p.x, 4) + (n + 1) * p.x * p.x * p.y * p.y - p.y * p.y + 5.0 * p.z; });
+
+    const auto laplacian = MakeField<FieldGridStagger::CellCentered>([](const Grid::Point&, int) { return 0.0; });
+    HorizontalLaplacian(laplacian, field);
+    // The 5-point stencil adds dx^2 / 12 * d4/dx4 = 2 on the unit grid
+    EXPECT_LT(MaxError(laplacian,
+                       [](const Grid::Point& p, int n)
+                       { return 12.0 * p.x * p.x + 2.0 + 2.0 * (n + 1) * (p.x * p.x + p.y * p.y) - 2.0; }),
+              1.0e-9);
+
+    const auto biharmonic = MakeField<FieldGridStagger::CellCentered>([](const Grid::Point&, int) { return 0.0; });
+    HorizontalBiharmonic(biharmonic, field);
+    EXPECT_LT(MaxError(biharmonic, [](const Grid::Point&, int n) { return 24.0 + 8.0 * (n + 1); }), 1.0e-9);
+
+    // The fused biharmonic equals the Laplacian applied twice, on the points where both have their ghost cells
+    const auto laplacian_ghost = MakeField<FieldGridStagger::CellCentered>(
+        [](const Grid::Point& p, int n)
+        { return 12.0 * p.x * p.x + 2.0 + 2.0 * (n + 1) * (p.x * p.x + p.y * p.y) - 2.0; });
+    HorizontalLaplacian(laplacian, laplacian_ghost);
+    EXPECT_LT(MaxError(laplacian, [](const Grid::Point&, int n) { return 24.0 + 8.0 * (n + 1); }), 1.0e-9);
+}
+
+TEST_F(StencilOperatorsTest, Errors)
+{
+    const auto cell = MakeField<FieldGridStagger::CellCentered>([](const Grid::Point&, int) { return 0.0; });
+    const auto face = MakeField<FieldGridStagger::IFace>([](const Grid::Point&, int) { return 0.0; });
+
+    // Too few ghost cells
+    const auto no_ghost = MakeField<FieldGridStagger::CellCentered>([](const Grid::Point&, int) { return 0.0; }, 0);
+    const auto one_ghost = MakeField<FieldGridStagger::CellCentered>([](const Grid::Point&, int) { return 0.0; }, 1);
+    EXPECT_THROW(Gradient(face, no_ghost), std::invalid_argument);
+    EXPECT_THROW(CellToFace(face, no_ghost), std::invalid_argument);
+    EXPECT_THROW(HorizontalLaplacian(cell, no_ghost), std::invalid_argument);
+    EXPECT_THROW(HorizontalBiharmonic(cell, one_ghost), std::invalid_argument);
+    EXPECT_NO_THROW(HorizontalLaplacian(cell, one_ghost));
+    EXPECT_NO_THROW(FaceToCell(no_ghost, face));
+
+    // Other number of components
+    const StaggeredField<FieldGridStagger::CellCentered> scalar("scalar", grid, 1, 2, FoldParity::Scalar,
+                                                                box_decomposition);
+    EXPECT_THROW(Gradient(face, scalar), std::invalid_argument);
+
+    // Other layout
+    const BoxDecomposition one_box = BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(8, 6, 4)));
+    const StaggeredField<FieldGridStagger::CellCentered> other_layout("other_layout", grid, 2, 2, FoldParity::Scalar,
+                                                                      one_box);
+    EXPECT_THROW(FaceToCell(other_layout, face), std::invalid_argument);
+}
@@ -0,0 +1,135 @@
+#include "tripolar_fold.h"
+
+#include <AMReX_MultiFab.H>
+#include <AMReX_NonLocalBC.H>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace turbo
+{
+
+TripolarFold::TripolarFold(const amrex::MultiFab& multifab, const amrex::Box& cell_domain)
+    : box_array_(multifab.boxArray()),
+      distribution_mapping_(multifab.DistributionMap()),
+      n_grow_(multifab.nGrowVect()),
+      periodicity_(amrex::IntVect(AMREX_D_DECL(cell_domain.length(0), 0, 0)))
+{
+    const int nx = cell_domain.length(0);
+    const int ny = cell_domain.length(1);
+    if (nx % 2 != 0)
+    {
+        throw std::invalid_argument("TripolarFold::TripolarFold: Number of cells in i must be even.");
+    }
+
+    const amrex::IndexType index_type = multifab.ixType();
+    const bool nodal_i                = index_type.nodeCentered(0);
+    const bool nodal_j                = index_type.nodeCentered(1);
+    const int i_sum                   = nodal_i ? nx : nx - 1;
+    const int j_sum                   = nodal_j ? 2 * ny : 2 * ny - 1;
+
+    fold_row_mapping_ = FoldMapping{i_sum, j_sum, false};
+    ghost_mapping_    = FoldMapping{i_sum, j_sum, true};
+
+    // Domain of the data in its own index space, e.g. j = 0..ny for data that is nodal in j
+    const amrex::Box domain = amrex::convert(cell_domain, index_type);
+
+    // The fold row of data that is nodal in j lies on the fold. Its upper half in i gets the values of the lower half.
+    // For data nodal in i, the points i = 0 and i = nx / 2 map onto themselves and i = nx is the periodic image of 0.
+    if (nodal_j)
+    {
+        amrex::Box fold_row_box = domain;
+        fold_row_box.setSmall(1, domain.bigEnd(1));
+        fold_row_box.setSmall(0, nodal_i ? nx / 2 + 1 : nx / 2);
+        fold_row_box.setBig(0, nx - 1);
+        if (fold_row_box.ok())
+        {
+            fold_row_comm_meta_data_ = std::make_unique<amrex::NonLocalBC::MultiBlockCommMetaData>(
+                multifab, fold_row_box, multifab, amrex::IntVect(0), fold_row_mapping_);
+        }
+    }
+
+    // The ghost cells beyond the fold, over the valid i range of the domain. The ghost cells in i of this strip are
+    // filled afterwards by enforcing periodicity.
+    const int n_grow_j = n_grow_[1];
+    if (n_grow_j > 0)
+    {
+        amrex::Box ghost_box = domain;
+        ghost_box.setSmall(1, domain.bigEnd(1) + 1);
+        ghost_box.setBig(1, domain.bigEnd(1) + n_grow_j);
+        ghost_comm_meta_data_ = std::make_unique<amrex::NonLocalBC::MultiBlockCommMetaData>(
+            multifab, ghost_box, multifab, n_grow_, ghost_mapping_);
+    }
+}
+
+std::shared_ptr<const TripolarFold> TripolarFold::ForLayout(const amrex::MultiFab& multifab,
+                                                            const amrex::Box& cell_domain)
+{
+    // Folds nobody holds anymore are dropped, so the registry only keeps the layouts in use
+    static std::vector<std::weak_ptr<const TripolarFold>> registry;
+    std::erase_if(registry, [](const std::weak_ptr<const TripolarFold>& entry) { return entry.expired(); });
+
+    for (const std::weak_ptr<const TripolarFold>& entry : registry)
+    {
+        // The BoxArray covers the grid, so a fold with the same layout was built for the same domain
+        std::shared_ptr<const TripolarFold> fold = entry.lock();
+        if (fold->IsCompatible(multifab))
+        {
+            return fold;
+        }
+    }
+
+    auto fold = std::make_shared<const TripolarFold>(multifab, cell_domain);
+    registry.push_back(fold);
+    return fold;
+}
+
+bool TripolarFold::IsCompatible(const amrex::MultiFab& multifab) const
+{
+    return multifab.boxArray() == box_array_ && multifab.DistributionMap() == distribution_mapping_ &&
+           multifab.nGrowVect() == n_grow_;
+}
+
+void TripolarFold::FillBoundary(amrex::MultiFab& multifab, const FoldParity fold_parity) const
+{
+    SyncFoldRow(multifab, fold_parity);
+    multifab.FillBoundary(periodicity_);
+    FillFoldGhostCells(multifab, fold_parity);
+}
+
+void TripolarFold::SyncFoldRow(amrex::MultiFab& multifab, const FoldParity fold_parity) const
+{
+    if (!IsCompatible(multifab))
+    {
+        throw std::invalid_argument("TripolarFold::SyncFoldRow: MultiFab layout does not match the fold layout.");
+    }
+
+    if (fold_row_comm_meta_data_)
+    {
+        const ParityProjection projection{fold_parity == FoldParity::Vector ? amrex::Real(-1.0) : amrex::Real(1.0)};
+        amrex::NonLocalBC::ParallelCopy(multifab, multifab, *fold_row_comm_meta_data_, 0, 0, multifab.nComp(),
+                                        fold_row_mapping_, projection);
+    }
+}
+
+void TripolarFold::FillFoldGhostCells(amrex::MultiFab& multifab, const FoldParity fold_parity) const
+{
+    if (!IsCompatible(multifab))
+    {
+        throw std::invalid_argument(
+            "TripolarFold::FillFoldGhostCells: MultiFab layout does not match the fold layout.");
+    }
+
+    if (ghost_comm_meta_data_)
+    {
+        const ParityProjection projection{fold_parity == FoldParity::Vector ? amrex::Real(-1.0) : amrex::Real(1.0)};
+        amrex::NonLocalBC::ParallelCopy(multifab, multifab, *ghost_comm_meta_data_, 0, 0, multifab.nComp(),
+                                        ghost_mapping_, projection);
+        multifab.EnforcePeriodicity(periodicity_);
+    }
+}
+
+const amrex::Periodicity& TripolarFold::GetPeriodicity() const noexcept { return periodicity_; }
+
+}  // namespace turbo
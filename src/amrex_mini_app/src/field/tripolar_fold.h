@@ -0,0 +1,195 @@
+#pragma once
+
+#include <AMReX_MultiFab.H>
+#include <AMReX_NonLocalBC.H>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace turbo
+{
+
+/**
+ * @brief How a field transforms when it is reflected across the tripolar fold.
+ */
+enum class FoldParity
+{
+    Scalar, /**< Values are copied across the fold unchanged (e.g. temperature, sea surface height). */
+    Vector  /**< Values change sign across the fold (e.g. the x and y components of velocity). */
+};
+
+/**
+ * @brief Convert FoldParity enum to string.
+ * @param fold_parity The FoldParity value to convert.
+ * @return String representation of the fold parity.
+ * @throws std::invalid_argument if the value is invalid.
+ */
+inline std::string FoldParityToString(FoldParity fold_parity)
+{
+    switch (fold_parity)
+    {
+        case FoldParity::Scalar:
+            return "Scalar";
+        case FoldParity::Vector:
+            return "Vector";
+        default:
+            throw std::invalid_argument("FoldParityToString Invalid FoldParity specified.");
+    }
+}
+
+/**
+ * @brief Halo exchange for MultiFabs on a tripolar grid: periodic in i and folded at the j maximum of the domain.
+ *
+ * Across the fold, the point (i, j) of the MultiFab neighbors the point (i_sum - i, j_sum - j), where the sums depend
+ * on the index type: i_sum is nx for data that is nodal in i and nx - 1 for cell centered data, and j_sum is 2 ny for
+ * data that is nodal in j and 2 ny - 1 for cell centered data. The mapping is its own inverse.
+ *
+ * The communication metadata for the fold is built once at construction for the layout (BoxArray,
+ * DistributionMapping, index type, and ghost cells) of a MultiFab and can then be reused for every halo exchange of
+ * any MultiFab with that layout, with any number of components and either parity. ForLayout shares one fold between
+ * all MultiFabs with the same layout.
+ */
+class TripolarFold
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Build the fold communication metadata for the layout of a MultiFab.
+     * @param multifab MultiFab whose layout the fold is built for.
+     * @param cell_domain Cell centered index space of the whole tripolar grid.
+     * @throws std::invalid_argument if the number of cells in i of the domain is odd.
+     */
+    TripolarFold(const amrex::MultiFab& multifab, const amrex::Box& cell_domain);
+
+    /**
+     * @brief Get the fold for the layout of a MultiFab, built once for all MultiFabs with that layout.
+     *
+     * The folds are kept in a registry while any caller holds them, like the FillBoundary metadata that AMReX caches
+     * per BoxArray, so e.g. all fields of a domain with the same stagger and ghost cells share one fold. The fold does
+     * not depend on the parity, so fields of either parity share it too. Not thread-safe.
+     *
+     * @param multifab MultiFab whose layout the fold is built for.
+     * @param cell_domain Cell centered index space of the whole tripolar grid.
+     * @return The fold, shared with the other callers for the same layout.
+     * @throws std::invalid_argument if the number of cells in i of the domain is odd.
+     */
+    static std::shared_ptr<const TripolarFold> ForLayout(const amrex::MultiFab& multifab,
+                                                         const amrex::Box& cell_domain);
+
+    /**
+     * @brief Check if a MultiFab has the layout this fold was built for.
+     * @param multifab MultiFab to check.
+     * @return true if the fold can be used for the MultiFab, false otherwise.
+     */
+    bool IsCompatible(const amrex::MultiFab& multifab) const;
+
+    /**
+     * @brief Fill all ghost cells of a MultiFab, periodically in i and across the fold at the j maximum.
+     *
+     * For data that is nodal in j, the fold row j = ny itself is shared by both sides of the fold, so its upper half
+     * in i is first overwritten with the (projected) values of the lower half to make the valid data consistent.
+     * Points that map onto themselves are left as is. Must be called by all ranks.
+     *
+     * @param multifab MultiFab to fill, must have the layout the fold was built for.
+     * @param fold_parity Whether the values change sign across the fold.
+     * @throws std::invalid_argument if the MultiFab does not have the layout the fold was built for.
+     */
+    void FillBoundary(amrex::MultiFab& multifab, const FoldParity fold_parity) const;
+
+    /**
+     * @brief First step of FillBoundary: make the fold row of data nodal in j consistent. Does nothing for data cell
+     * centered in j. Must be called by all ranks.
+     * @param multifab MultiFab to fill, must have the layout the fold was built for.
+     * @param fold_parity Whether the values change sign across the fold.
+     * @throws std::invalid_argument if the MultiFab does not have the layout the fold was built for.
+     */
+    void SyncFoldRow(amrex::MultiFab& multifab, const FoldParity fold_parity) const;
+
+    /**
+     * @brief Last step of FillBoundary: fill the ghost cells beyond the fold, after the ghost cells shared with
+     * neighboring boxes have been filled with GetPeriodicity(). Must be called by all ranks.
+     * @param multifab MultiFab to fill, must have the layout the fold was built for.
+     * @param fold_parity Whether the values change sign across the fold.
+     * @throws std::invalid_argument if the MultiFab does not have the layout the fold was built for.
+     */
+    void FillFoldGhostCells(amrex::MultiFab& multifab, const FoldParity fold_parity) const;
+
+    /**
+     * @brief Get the periodicity of the tripolar grid, periodic in i only.
+     * @return The periodicity.
+     */
+    const amrex::Periodicity& GetPeriodicity() const noexcept;
+
+   private:
+    //-----------------------------------------------------------------------//
+    // Private Types
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Maps a destination index to the source index across the fold, for amrex::NonLocalBC::ParallelCopy.
+     */
+    struct FoldMapping
+    {
+        int i_sum;   /**< i + i' for points i and i' across the fold. */
+        int j_sum;   /**< j + j' for points j and j' across the fold. */
+        bool fold_j; /**< Reflect j too; false to only reflect i within the fold row. */
+
+        AMREX_GPU_HOST_DEVICE amrex::Dim3 operator()(amrex::Dim3 index) const noexcept
+        {
+            return {i_sum - index.x, fold_j ? j_sum - index.y : index.y, index.z};
+        }
+
+        AMREX_GPU_HOST_DEVICE amrex::Dim3 Inverse(amrex::Dim3 index) const noexcept { return (*this)(index); }
+
+        constexpr amrex::IndexType operator()(amrex::IndexType index_type) const noexcept { return index_type; }
+
+        static constexpr amrex::IndexType Inverse(amrex::IndexType index_type) noexcept { return index_type; }
+    };
+
+    /**
+     * @brief Applies the fold parity to the values copied across the fold.
+     */
+    struct ParityProjection
+    {
+        amrex::Real sign; /**< 1 for scalars, -1 for vector components. */
+
+        AMREX_GPU_HOST_DEVICE amrex::Real operator()(const amrex::Array4<const amrex::Real>& array, amrex::Dim3 index,
+                                                     int component) const noexcept
+        {
+            return sign * array(index.x, index.y, index.z, component);
+        }
+    };
+
+    //-----------------------------------------------------------------------//
+    // Private Data Members
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Layout the fold was built for.
+     */
+    amrex::BoxArray box_array_;
+    amrex::DistributionMapping distribution_mapping_;
+    amrex::IntVect n_grow_;
+
+    /**
+     * @brief Periodicity of the grid, periodic in i only.
+     */
+    amrex::Periodicity periodicity_;
+
+    /**
+     * @brief Mappings within the fold row and from the ghost cells beyond the fold into the domain.
+     */
+    FoldMapping fold_row_mapping_, ghost_mapping_;
+
+    /**
+     * @brief Communication metadata for the fold row (only for data nodal in j) and the ghost cells beyond the fold
+     * (only with ghost cells in j). Null if there is nothing to communicate.
+     */
+    std::unique_ptr<amrex::NonLocalBC::MultiBlockCommMetaData> fold_row_comm_meta_data_, ghost_comm_meta_data_;
+};
+
+}  // namespace turbo
@@ -0,0 +1,173 @@
+#include "tripolar_fold.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+#include "amrex_test_environment.h"
+#include "field.h"
+#include "tripolar_geometry.h"
+#include "tripolar_grid.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for tripolar fold tests
+//---------------------------------------------------------------------------//
+
+class TripolarFoldTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        geometry = std::make_shared<TripolarGeometry>(0.0, 360.0, -80.0, 90.0, 0.0, 5000.0);
+        grid     = std::make_shared<TripolarGrid>(geometry, n_cell_x, n_cell_y, n_cell_z);
+    }
+
+    // Bigger than the maximum box size of a Field in x and y, so the fold and the periodic boundary cross boxes
+    const int n_cell_x = 80;
+    const int n_cell_y = 40;
+    const int n_cell_z = 2;
+
+    std::shared_ptr<TripolarGeometry> geometry;
+    std::shared_ptr<TripolarGrid> grid;
+};
+
+//---------------------------------------------------------------------------//
+// Tripolar fold tests
+//---------------------------------------------------------------------------//
+
+TEST_F(TripolarFoldTest, Constructor)
+{
+    Field field("field", grid, FieldGridStagger::CellCentered, 1, 1);
+
+    // The fold pairs up cells i and nx - 1 - i, so an odd number of cells in i is invalid
+    const amrex::Box odd_domain(amrex::IntVect(AMREX_D_DECL(0, 0, 0)),
+                                amrex::IntVect(AMREX_D_DECL(n_cell_x - 2, n_cell_y - 1, n_cell_z - 1)));
+    EXPECT_THROW(TripolarFold(*field.multifab, odd_domain), std::invalid_argument);
+
+    // A fold can only be used for MultiFabs with the layout it was built for
+    const amrex::Box cell_domain(amrex::IntVect(AMREX_D_DECL(0, 0, 0)),
+                                 amrex::IntVect(AMREX_D_DECL(n_cell_x - 1, n_cell_y - 1, n_cell_z - 1)));
+    const TripolarFold fold(*field.multifab, cell_domain);
+    EXPECT_TRUE(fold.IsCompatible(*field.multifab));
+
+    Field other_layout_field("other_layout_field", grid, FieldGridStagger::CellCentered, 1, 2);
+    EXPECT_FALSE(fold.IsCompatible(*other_layout_field.multifab));
+    EXPECT_THROW(fold.FillBoundary(*other_layout_field.multifab, FoldParity::Scalar), std::invalid_argument);
+}
+
+TEST_F(TripolarFoldTest, ForLayout)
+{
+    const Field scalar("scalar", grid, FieldGridStagger::CellCentered, 1, 1, FoldParity::Scalar);
+    const Field vector("vector", grid, FieldGridStagger::CellCentered, 2, 1, FoldParity::Vector);
+    const Field wide("wide", grid, FieldGridStagger::CellCentered, 1, 2, FoldParity::Scalar);
+    const amrex::Box cell_domain(amrex::IntVect(AMREX_D_DECL(0, 0, 0)),
+                                 amrex::IntVect(AMREX_D_DECL(n_cell_x - 1, n_cell_y - 1, n_cell_z - 1)));
+
+    // One fold per layout, whatever the parity and number of components
+    const std::shared_ptr<const TripolarFold> fold = TripolarFold::ForLayout(*scalar.multifab, cell_domain);
+    EXPECT_EQ(TripolarFold::ForLayout(*vector.multifab, cell_domain), fold);
+    EXPECT_NE(TripolarFold::ForLayout(*wide.multifab, cell_domain), fold);
+    EXPECT_TRUE(TripolarFold::ForLayout(*wide.multifab, cell_domain)->IsCompatible(*wide.multifab));
+}
+
+TEST_F(TripolarFoldTest, FoldParityToString)
+{
+    EXPECT_EQ(FoldParityToString(FoldParity::Scalar), "Scalar");
+    EXPECT_EQ(FoldParityToString(FoldParity::Vector), "Vector");
+    EXPECT_THROW(FoldParityToString(static_cast<FoldParity>(-1)), std::invalid_argument);
+}
+
+TEST_F(TripolarFoldTest, FillBoundary)
+{
+    const int n_component = 2;
+    const int n_ghost     = 2;
+
+    for (const FieldGridStagger field_grid_stagger :
+         {FieldGridStagger::Nodal, FieldGridStagger::CellCentered, FieldGridStagger::IFace, FieldGridStagger::JFace,
+          FieldGridStagger::KFace})
+    {
+        for (const FoldParity fold_parity : {FoldParity::Scalar, FoldParity::Vector})
+        {
+            Field field("field", grid, field_grid_stagger, n_component, n_ghost, fold_parity);
+            amrex::MultiFab& mf = *field.multifab;
+
+            const amrex::IndexType index_type = mf.ixType();
+            const bool nodal_i                = index_type.nodeCentered(0);
+            const bool nodal_j                = index_type.nodeCentered(1);
+            const int i_max                   = nodal_i ? n_cell_x : n_cell_x - 1;
+            const int j_max                   = nodal_j ? n_cell_y : n_cell_y - 1;
+            const int k_max                   = index_type.nodeCentered(2) ? n_cell_z : n_cell_z - 1;
+            const int i_sum                   = nodal_i ? n_cell_x : n_cell_x - 1;
+            const int j_sum                   = nodal_j ? 2 * n_cell_y : 2 * n_cell_y - 1;
+            const int fold_row_i_min          = nodal_i ? n_cell_x / 2 + 1 : n_cell_x / 2;
+            const amrex::Real sign            = (fold_parity == FoldParity::Vector) ? -1.0 : 1.0;
+            const int nx                      = n_cell_x;
+
+            // Periodic in i, so points i and i + nx of nodal data get the same value
+            auto ValidValue = [nx](int i, int j, int k, int n) -> amrex::Real
+            { return 1.0 + (i % nx) + 100.0 * j + 10000.0 * k + 1000000.0 * n; };
+
+            // Expected value after the fill for any point with j >= 0 and a valid k
+            auto ExpectedValue = [=](int i, int j, int k, int n) -> amrex::Real
+            {
+                int i_periodic = i;
+                while (i_periodic < 0)
+                {
+                    i_periodic += nx;
+                }
+                while (i_periodic > i_max)
+                {
+                    i_periodic -= nx;
+                }
+                if (j > j_max)
+                {
+                    // Beyond the fold, the reflected point is always a valid point off the fold row
+                    return sign * ValidValue(i_sum - i_periodic, j_sum - j, k, n);
+                }
+                if (nodal_j && j == j_max && i_periodic >= fold_row_i_min && i_periodic <= nx - 1)
+                {
+                    return sign * ValidValue(i_sum - i_periodic, j, k, n);
+                }
+                return ValidValue(i_periodic, j, k, n);
+            };
+
+            mf.setVal(-1.0);
+            for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<amrex::Real>& array = mf.array(mfi);
+                amrex::ParallelFor(mfi.validbox(), n_component, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   { array(i, j, k, n) = ValidValue(i, j, k, n); });
+            }
+
+            // Fill twice, the second fill reuses the cached fold and must give the same result
+            field.FillBoundary();
+            field.FillBoundary();
+
+            for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<const amrex::Real>& array = mf.const_array(mfi);
+                amrex::ParallelFor(mfi.fabbox(), n_component,
+                                   [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                                   {
+                                       // Ghost cells at the y_min and z boundaries are not filled
+                                       if (j < 0 || k < 0 || k > k_max)
+                                       {
+                                           return;
+                                       }
+                                       EXPECT_EQ(array(i, j, k, n), ExpectedValue(i, j, k, n))
+                                           << "Mismatch for stagger " << FieldGridStaggerToString(field_grid_stagger)
+                                           << " and parity " << FoldParityToString(fold_parity) << " at (" << i
+                                           << "," << j << "," << k << "," << n << ")";
+                                   });
+            }
+        }
+    }
+}
@@ -0,0 +1,485 @@
+#include "vertical_remap.h"
+
+#include <AMReX.H>
+#include <AMReX_Arena.H>
+#include <AMReX_Extension.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MultiFab.H>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "column_utils.h"
+
+namespace turbo
+{
+
+namespace
+{
+
+// Components of the work array of a column, on the levels k_first to k_last + 1. Interfaces and source indices are per
+// interface of the column; the other components are per layer, with the last level unused.
+constexpr int kSourceInterface = 0; /**< Depth of the top of source layer k below the top of the column */
+constexpr int kTargetInterface = 1; /**< Depth of the top of target layer k below the top of the column */
+constexpr int kSourceIndex     = 2; /**< Source layer that contains target interface k */
+constexpr int kMean            = 3; /**< Source mean of layer k of the component being remapped */
+constexpr int kSlope           = 4; /**< Limited change of the component across source layer k */
+constexpr int kEdge            = 5; /**< PPM estimate of the component at source interface k */
+constexpr int kEdgeTop         = 6; /**< Reconstruction at the top of source layer k */
+constexpr int kEdgeBottom      = 7; /**< Reconstruction at the bottom of source layer k */
+constexpr int kNWork           = 8;
+
+// Added to the denominators of the reconstruction, which are sums of thicknesses that vanish with the layers
+constexpr amrex::Real kThicknessNeglect = 1.0e-30;
+
+/**
+ * @brief Check that the thicknesses and the tracers of a remapping have the layout of the source thickness, and the
+ * boxes contain whole columns.
+ * @param source_thickness Source thickness.
+ * @param target_thickness Target thickness.
+ * @param tracers Tracers.
+ * @throws std::invalid_argument if a field does not match or a box does not contain whole columns.
+ */
+void CheckRemapOperands(const StaggeredField<FieldGridStagger::CellCentered>& source_thickness,
+                        const StaggeredField<FieldGridStagger::CellCentered>& target_thickness,
+                        const std::vector<std::shared_ptr<Field>>& tracers)
+{
+    const Field& source   = *source_thickness.GetField();
+    const int n_ghost     = 0;
+    const int n_component = 1;
+    for (const Field* thickness : {source_thickness.GetField().get(), target_thickness.GetField().get()})
+    {
+        CheckOperand("RemapColumns", source, *thickness, n_ghost, n_component);
+    }
+    for (const std::shared_ptr<Field>& tracer : tracers)
+    {
+        if (!tracer)
+        {
+            throw std::invalid_argument("RemapColumns: Tracer is null.");
+        }
+        if (tracer->field_grid_stagger != FieldGridStagger::CellCentered)
+        {
+            throw std::invalid_argument("RemapColumns: Tracer '" + tracer->name + "' is " +
+                                        FieldGridStaggerToString(tracer->field_grid_stagger) +
+                                        ", expected CellCentered.");
+        }
+        CheckOperand("RemapColumns", source, *tracer);
+    }
+
+    CheckWholeColumns("RemapColumns", source);
+}
+
+/**
+ * @brief Get the thickness of layer k of a column, zero above and below the column.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE amrex::Real LayerThickness(const int i, const int j, const int k,
+                                                                    const int k_first, const int k_last,
+                                                                    const amrex::Array4<const amrex::Real>& h) noexcept
+{
+    return (k < k_first || k > k_last) ? 0.0 : h(i, j, k);
+}
+
+/**
+ * @brief Accumulate the source and target interfaces below layer k of a column. The interfaces of k_first are zero.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void InterfaceStep(const int i, const int j, const int k, const int j_work,
+                                                            const amrex::Array4<const amrex::Real>& h_source,
+                                                            const amrex::Array4<const amrex::Real>& h_target,
+                                                            const amrex::Array4<amrex::Real>& work) noexcept
+{
+    work(i, j_work, k + 1, kSourceInterface) = work(i, j_work, k, kSourceInterface) + h_source(i, j, k);
+    work(i, j_work, k + 1, kTargetInterface) = work(i, j_work, k, kTargetInterface) + h_target(i, j, k);
+}
+
+/**
+ * @brief Find the source layer that contains every target interface of a column, in one walk down both columns.
+ *
+ * Target interface k is in source layer s if the top of s is at or above it and the bottom of s below it, so the layer
+ * has a nonzero thickness; interfaces at or below the bottom of the source column are in the last layer.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void FindSourceLayers(const int i, const int j_work, const int k_first,
+                                                               const int k_last,
+                                                               const amrex::Array4<amrex::Real>& work) noexcept
+{
+    int s = k_first;
+    for (int k = k_first; k <= k_last + 1; ++k)
+    {
+        const amrex::Real z = work(i, j_work, k, kTargetInterface);
+        while (s < k_last && work(i, j_work, s + 1, kSourceInterface) <= z)
+        {
+            ++s;
+        }
+        work(i, j_work, k, kSourceIndex) = s;
+    }
+}
+
+/**
+ * @brief Store the mean of source layer k of component n and its limited change across the layer, the slope of
+ * Colella and Woodward (1984) on a nonuniform grid with the monotonized central limiter. The slope is zero at the ends
+ * of the column and at extrema.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void MeanAndSlope(const int i, const int j, const int k, const int n,
+                                                           const int j_work, const int k_first, const int k_last,
+                                                           const amrex::Array4<const amrex::Real>& h,
+                                                           const amrex::Array4<const amrex::Real>& x,
+                                                           const amrex::Array4<amrex::Real>& work) noexcept
+{
+    const amrex::Real mean     = x(i, j, k, n);
+    work(i, j_work, k, kMean)  = mean;
+    work(i, j_work, k, kSlope) = 0.0;
+    if (k == k_first || k == k_last)
+    {
+        return;
+    }
+    const amrex::Real difference_above = mean - x(i, j, k - 1, n);
+    const amrex::Real difference_below = x(i, j, k + 1, n) - mean;
+    if (difference_above * difference_below <= 0.0)
+    {
+        return;
+    }
+    const amrex::Real h_above = h(i, j, k - 1);
+    const amrex::Real h_layer = h(i, j, k);
+    const amrex::Real h_below = h(i, j, k + 1);
+    const amrex::Real slope =
+        h_layer / (h_above + h_layer + h_below + kThicknessNeglect) *
+        ((2.0 * h_above + h_layer) / (h_below + h_layer + kThicknessNeglect) * difference_below +
+         (h_layer + 2.0 * h_below) / (h_above + h_layer + kThicknessNeglect) * difference_above);
+    const amrex::Real limited =
+        std::min({std::abs(slope), 2.0 * std::abs(difference_above), 2.0 * std::abs(difference_below)});
+    work(i, j_work, k, kSlope) = slope < 0.0 ? -limited : limited;
+}
+
+/**
+ * @brief Store the PPM estimate of the component at source interface k, between layers k - 1 and k, from the means
+ * and slopes of the two layers and the thicknesses of the four layers around it (Colella and Woodward, 1984, eq. 1.6).
+ * The estimate is bounded by the means of the two layers, so it is monotone.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void EdgeValue(const int i, const int j, const int k, const int j_work,
+                                                        const int k_first, const int k_last,
+                                                        const amrex::Array4<const amrex::Real>& h,
+                                                        const amrex::Array4<amrex::Real>& work) noexcept
+{
+    const amrex::Real h_0        = LayerThickness(i, j, k - 2, k_first, k_last, h);
+    const amrex::Real h_1        = LayerThickness(i, j, k - 1, k_first, k_last, h);
+    const amrex::Real h_2        = LayerThickness(i, j, k, k_first, k_last, h);
+    const amrex::Real h_3        = LayerThickness(i, j, k + 1, k_first, k_last, h);
+    const amrex::Real mean_above = work(i, j_work, k - 1, kMean);
+    const amrex::Real mean_below = work(i, j_work, k, kMean);
+    const amrex::Real difference = mean_below - mean_above;
+
+    const amrex::Real weight_above = (h_0 + h_1) / (2.0 * h_1 + h_2 + kThicknessNeglect);
+    const amrex::Real weight_below = (h_3 + h_2) / (2.0 * h_2 + h_1 + kThicknessNeglect);
+    const amrex::Real correction =
+        (2.0 * h_2 * h_1 / (h_1 + h_2 + kThicknessNeglect) * (weight_above - weight_below) * difference -
+         h_1 * weight_above * work(i, j_work, k, kSlope) + h_2 * weight_below * work(i, j_work, k - 1, kSlope)) /
+        (h_0 + h_1 + h_2 + h_3 + kThicknessNeglect);
+    const amrex::Real edge = mean_above + h_1 / (h_1 + h_2 + kThicknessNeglect) * difference + correction;
+    work(i, j_work, k, kEdge) = std::clamp(edge, std::min(mean_above, mean_below), std::max(mean_above, mean_below));
+}
+
+/**
+ * @brief Store the values of the reconstruction at the top and bottom of source layer k.
+ *
+ * PLM takes them from the limited slope. PPM takes the edge estimates of the interfaces of the layer, or the mean at
+ * the ends of the column, and applies the limiter of Colella and Woodward (1984, eq. 1.10): the parabola is flattened
+ * at an extremum and steepened where it would overshoot inside the layer.
+ */
+template <RemapScheme kScheme>
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void LimitEdges(const int i, const int k, const int j_work, const int k_first,
+                                                         const int k_last,
+                                                         const amrex::Array4<amrex::Real>& work) noexcept
+{
+    const amrex::Real mean = work(i, j_work, k, kMean);
+    amrex::Real top        = mean - 0.5 * work(i, j_work, k, kSlope);
+    amrex::Real bottom     = mean + 0.5 * work(i, j_work, k, kSlope);
+    if constexpr (kScheme == RemapScheme::PPM)
+    {
+        top    = k == k_first ? mean : work(i, j_work, k, kEdge);
+        bottom = k == k_last ? mean : work(i, j_work, k + 1, kEdge);
+        if ((bottom - mean) * (mean - top) <= 0.0)
+        {
+            top    = mean;
+            bottom = mean;
+        }
+        else
+        {
+            const amrex::Real change    = bottom - top;
+            const amrex::Real curvature = 6.0 * mean - 3.0 * (top + bottom);
+            if (change * curvature > change * change)
+            {
+                top = 3.0 * mean - 2.0 * bottom;
+            }
+            else if (change * curvature < -change * change)
+            {
+                bottom = 3.0 * mean - 2.0 * top;
+            }
+        }
+    }
+    work(i, j_work, k, kEdgeTop)    = top;
+    work(i, j_work, k, kEdgeBottom) = bottom;
+}
+
+/**
+ * @brief Get the average of the reconstruction of source layer s from xi_top to xi_bottom, the positions in the layer
+ * from 0 at the top to 1 at the bottom.
+ *
+ * The reconstruction is u(xi) = top + xi (change + curvature (1 - xi)), with curvature zero for PLM, and its average
+ * over the whole layer is the mean.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE amrex::Real LayerAverage(const int i, const int s, const int j_work,
+                                                                  const amrex::Real xi_top, const amrex::Real xi_bottom,
+                                                                  const amrex::Array4<const amrex::Real>& work) noexcept
+{
+    const amrex::Real top       = work(i, j_work, s, kEdgeTop);
+    const amrex::Real bottom    = work(i, j_work, s, kEdgeBottom);
+    const amrex::Real change    = bottom - top;
+    const amrex::Real curvature = 6.0 * work(i, j_work, s, kMean) - 3.0 * (top + bottom);
+    return top + 0.5 * (change + curvature) * (xi_top + xi_bottom) -
+           curvature * (xi_top * xi_top + xi_top * xi_bottom + xi_bottom * xi_bottom) / 3.0;
+}
+
+/**
+ * @brief Get the value of the reconstruction of source layer s at depth z, clamped to the layer, or the mean of a
+ * vanished layer.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE amrex::Real LayerValue(const int i, const int s, const int j_work,
+                                                                const amrex::Real z,
+                                                                const amrex::Array4<const amrex::Real>& work) noexcept
+{
+    const amrex::Real z_top     = work(i, j_work, s, kSourceInterface);
+    const amrex::Real thickness = work(i, j_work, s + 1, kSourceInterface) - z_top;
+    if (thickness <= 0.0)
+    {
+        return work(i, j_work, s, kMean);
+    }
+    const amrex::Real xi        = std::clamp((z - z_top) / thickness, 0.0, 1.0);
+    const amrex::Real top       = work(i, j_work, s, kEdgeTop);
+    const amrex::Real bottom    = work(i, j_work, s, kEdgeBottom);
+    const amrex::Real curvature = 6.0 * work(i, j_work, s, kMean) - 3.0 * (top + bottom);
+    return top + xi * (bottom - top + curvature * (1.0 - xi));
+}
+
+/**
+ * @brief Set target layer k of component n of a column to the average of the reconstruction over the layer, from the
+ * source layers it overlaps. Land columns are left unchanged.
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE void IntegrateLayer(const int i, const int j, const int k, const int n,
+                                                             const int j_work, const int k_last,
+                                                             const amrex::Array4<const amrex::Real>& work,
+                                                             const amrex::Array4<amrex::Real>& x) noexcept
+{
+    const amrex::Real source_bottom = work(i, j_work, k_last + 1, kSourceInterface);
+    if (source_bottom <= 0.0)
+    {
+        return;
+    }
+    const amrex::Real z_top    = work(i, j_work, k, kTargetInterface);
+    const amrex::Real z_bottom = work(i, j_work, k + 1, kTargetInterface);
+    const int s_top            = static_cast<int>(work(i, j_work, k, kSourceIndex));
+    const int s_bottom         = static_cast<int>(work(i, j_work, k + 1, kSourceIndex));
+    if (z_bottom <= z_top)
+    {
+        x(i, j, k, n) = LayerValue(i, s_top, j_work, z_top, work);
+        return;
+    }
+
+    amrex::Real content = 0.0;
+    for (int s = s_top; s <= s_bottom; ++s)
+    {
+        const amrex::Real layer_top    = work(i, j_work, s, kSourceInterface);
+        const amrex::Real layer_bottom = work(i, j_work, s + 1, kSourceInterface);
+        const amrex::Real overlap_top  = std::max(z_top, layer_top);
+        const amrex::Real overlap_end  = std::min(z_bottom, layer_bottom);
+        if (overlap_end > overlap_top)
+        {
+            // Whole layers average to their mean exactly, without the rounding of the positions
+            const amrex::Real thickness = layer_bottom - layer_top;
+            const amrex::Real xi_top    = overlap_top == layer_top ? 0.0 : (overlap_top - layer_top) / thickness;
+            const amrex::Real xi_bottom = overlap_end == layer_bottom ? 1.0 : (overlap_end - layer_top) / thickness;
+            content += (overlap_end - overlap_top) * LayerAverage(i, s, j_work, xi_top, xi_bottom, work);
+        }
+    }
+    if (z_bottom > source_bottom)
+    {
+        content += (z_bottom - std::max(z_top, source_bottom)) * LayerValue(i, k_last, j_work, source_bottom, work);
+    }
+    x(i, j, k, n) = content / (z_bottom - z_top);
+}
+
+/**
+ * @brief Remap all columns with one reconstruction scheme, see RemapColumns.
+ */
+template <RemapScheme kScheme>
+void Remap(const StaggeredField<FieldGridStagger::CellCentered>& source_thickness,
+           const StaggeredField<FieldGridStagger::CellCentered>& target_thickness,
+           const std::vector<std::shared_ptr<Field>>& tracers)
+{
+    CheckRemapOperands(source_thickness, target_thickness, tracers);
+
+    const amrex::MFItInfo info = ColumnTiling();
+    amrex::MultiFab& source_mf = source_thickness.GetMultiFab();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(source_mf, info); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box tile                           = mfi.tilebox();
+        const amrex::Array4<const amrex::Real> h_source = source_mf.const_array(mfi);
+        const amrex::Array4<const amrex::Real> h_target = target_thickness.GetMultiFab().const_array(mfi);
+        const int i_first                               = tile.smallEnd(0);
+        const int i_last                                = tile.bigEnd(0);
+        const int k_first                               = tile.smallEnd(2);
+        const int k_last                                = tile.bigEnd(2);
+
+        if (amrex::Gpu::inLaunchRegion())
+        {
+            // One thread per column, sweeping along k. The geometry stays in the work array for all tracers.
+            amrex::FArrayBox work_fab(amrex::growHi(tile, 2, 1), kNWork, amrex::The_Async_Arena());
+            const amrex::Array4<amrex::Real> work = work_fab.array();
+            amrex::Box columns                    = tile;
+            columns.setBig(2, k_first);
+            amrex::ParallelFor(columns,
+                               [=] AMREX_GPU_DEVICE(int i, int j, int)
+                               {
+                                   work(i, j, k_first, kSourceInterface) = 0.0;
+                                   work(i, j, k_first, kTargetInterface) = 0.0;
+                                   for (int k = k_first; k <= k_last; ++k)
+                                   {
+                                       InterfaceStep(i, j, k, j, h_source, h_target, work);
+                                   }
+                                   FindSourceLayers(i, j, k_first, k_last, work);
+                               });
+            for (const std::shared_ptr<Field>& tracer : tracers)
+            {
+                const amrex::Array4<amrex::Real> x = tracer->multifab->array(mfi);
+                const int n_component              = tracer->multifab->nComp();
+                amrex::ParallelFor(columns,
+                                   [=] AMREX_GPU_DEVICE(int i, int j, int)
+                                   {
+                                       for (int n = 0; n < n_component; ++n)
+                                       {
+                                           for (int k = k_first; k <= k_last; ++k)
+                                           {
+                                               MeanAndSlope(i, j, k, n, j, k_first, k_last, h_source, x, work);
+                                           }
+                                           if constexpr (kScheme == RemapScheme::PPM)
+                                           {
+                                               for (int k = k_first + 1; k <= k_last; ++k)
+                                               {
+                                                   EdgeValue(i, j, k, j, k_first, k_last, h_source, work);
+                                               }
+                                           }
+                                           for (int k = k_first; k <= k_last; ++k)
+                                           {
+                                               LimitEdges<kScheme>(i, k, j, k_first, k_last, work);
+                                           }
+                                           for (int k = k_first; k <= k_last; ++k)
+                                           {
+                                               IntegrateLayer(i, j, k, n, j, k_last, work, x);
+                                           }
+                                       }
+                                   });
+            }
+            continue;
+        }
+
+        // One row of columns at a time, see ColumnTiling. The work array of a row stays in cache for all tracers and
+        // components.
+        amrex::Box row = amrex::growHi(tile, 2, 1);
+        row.setSmall(1, 0);
+        row.setBig(1, 0);
+        amrex::FArrayBox work_fab(row, kNWork, amrex::The_Async_Arena());
+        const amrex::Array4<amrex::Real> work = work_fab.array();
+        const int j_work                      = 0;
+        for (int j = tile.smallEnd(1); j <= tile.bigEnd(1); ++j)
+        {
+            // Geometry, shared by all tracers
+            AMREX_PRAGMA_SIMD
+            for (int i = i_first; i <= i_last; ++i)
+            {
+                work(i, j_work, k_first, kSourceInterface) = 0.0;
+                work(i, j_work, k_first, kTargetInterface) = 0.0;
+            }
+            for (int k = k_first; k <= k_last; ++k)
+            {
+                AMREX_PRAGMA_SIMD
+                for (int i = i_first; i <= i_last; ++i)
+                {
+                    InterfaceStep(i, j, k, j_work, h_source, h_target, work);
+                }
+            }
+            // The walk down the columns branches per column, so it is the one step that is not vectorized
+            for (int i = i_first; i <= i_last; ++i)
+            {
+                FindSourceLayers(i, j_work, k_first, k_last, work);
+            }
+
+            for (const std::shared_ptr<Field>& tracer : tracers)
+            {
+                const amrex::Array4<amrex::Real> x = tracer->multifab->array(mfi);
+                for (int n = 0; n < tracer->multifab->nComp(); ++n)
+                {
+                    for (int k = k_first; k <= k_last; ++k)
+                    {
+                        AMREX_PRAGMA_SIMD
+                        for (int i = i_first; i <= i_last; ++i)
+                        {
+                            MeanAndSlope(i, j, k, n, j_work, k_first, k_last, h_source, x, work);
+                        }
+                    }
+                    if constexpr (kScheme == RemapScheme::PPM)
+                    {
+                        for (int k = k_first + 1; k <= k_last; ++k)
+                        {
+                            AMREX_PRAGMA_SIMD
+                            for (int i = i_first; i <= i_last; ++i)
+                            {
+                                EdgeValue(i, j, k, j_work, k_first, k_last, h_source, work);
+                            }
+                        }
+                    }
+                    for (int k = k_first; k <= k_last; ++k)
+                    {
+                        AMREX_PRAGMA_SIMD
+                        for (int i = i_first; i <= i_last; ++i)
+                        {
+                            LimitEdges<kScheme>(i, k, j_work, k_first, k_last, work);
+                        }
+                    }
+                    for (int k = k_first; k <= k_last; ++k)
+                    {
+                        AMREX_PRAGMA_SIMD
+                        for (int i = i_first; i <= i_last; ++i)
+                        {
+                            IntegrateLayer(i, j, k, n, j_work, k_last, work, x);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void RemapColumns(const StaggeredField<FieldGridStagger::CellCentered>& source_thickness,
+                  const StaggeredField<FieldGridStagger::CellCentered>& target_thickness,
+                  const std::vector<std::shared_ptr<Field>>& tracers, const RemapScheme scheme)
+{
+    switch (scheme)
+    {
+        case RemapScheme::PLM:
+            Remap<RemapScheme::PLM>(source_thickness, target_thickness, tracers);
+            break;
+        case RemapScheme::PPM:
+            Remap<RemapScheme::PPM>(source_thickness, target_thickness, tracers);
+            break;
+        default:
+            throw std::invalid_argument("RemapColumns: Invalid RemapScheme specified.");
+    }
+}
+
+}  // namespace turbo
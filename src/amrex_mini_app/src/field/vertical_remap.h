@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "field.h"
+#include "staggered_field.h"
+
+namespace turbo
+{
+
+/**
+ * @enum RemapScheme
+ * @brief Specifies the reconstruction of the source layers used by RemapColumns.
+ */
+enum class RemapScheme
+{
+    PLM, /**< Piecewise linear, with the monotonized central slope limiter. Second order. */
+    PPM  /**< Piecewise parabolic (Colella and Woodward, 1984) with monotone edge values and limiter. Third order. */
+};
+
+/**
+ * @brief Convert a RemapScheme enum value to a string. Useful for debugging and logging.
+ * @param remap_scheme The RemapScheme value to convert.
+ * @return String representation of the remap scheme.
+ * @throws std::invalid_argument if the value is invalid.
+ */
+inline std::string RemapSchemeToString(RemapScheme remap_scheme)
+{
+    switch (remap_scheme)
+    {
+        case RemapScheme::PLM:
+            return "PLM";
+        case RemapScheme::PPM:
+            return "PPM";
+        default:
+            throw std::invalid_argument("RemapSchemeToString Invalid RemapScheme specified.");
+    }
+}
+
+/**
+ * @brief Remap cell-centered tracers from the source layers of every column to the target layers, as the ALE
+ * regridding step of MOM6 does after every time step.
+ *
+ * Every layer is a cell along k, from the surface at the first level of the column to the bottom at the last, and the
+ * thicknesses give the positions of its interfaces. Each component of each tracer is reconstructed in the source
+ * layers with the chosen scheme and its integral over the overlap with every target layer becomes the new layer mean.
+ * The remapping conserves the content (thickness times tracer) of a column when the source and target thicknesses of
+ * the column have the same total, and it is monotone: a new mean is within the source means of the column. A target
+ * layer of zero thickness gets the value of the reconstruction at its position. If the target column is deeper than
+ * the source column, the part below the source bottom gets the value at the bottom of the last source layer.
+ *
+ * Vanished layers, of zero thickness, are allowed in both columns. Their source means take part in the reconstruction
+ * of the neighboring layers, as in MOM6, so they should hold sensible values, e.g. the values from before the layer
+ * vanished. Columns of zero total source thickness (land) are left unchanged.
+ *
+ * All tracers of a box are remapped together. The geometry of the remapping, i.e. the interfaces of both columns and
+ * the source layers overlapped by every target layer, is computed once per column and shared by all tracers and
+ * components. On the CPU the tiles of the boxes are spread over the OpenMP threads and every step is a sweep along k
+ * with the columns of a row in the SIMD lanes; on the GPU every column is a thread. Every box must contain whole
+ * columns, as the boxes of a MOM-style layout do; with chunking, max_box_size in k must be at least the number of
+ * levels.
+ *
+ * @param source_thickness Thickness of the layers before the remapping, one component.
+ * @param target_thickness Thickness of the layers after the remapping, one component. The thicknesses are not modified,
+ * the caller copies the target into its layer thickness afterwards.
+ * @param tracers Cell-centered tracers, with any number of components, remapped in place on the valid points.
+ * @param scheme Reconstruction of the source layers.
+ * @throws std::invalid_argument if a tracer is null or not cell-centered, a field does not have the layout of the
+ * source thickness, a thickness has more than one component, or a box does not contain whole columns.
+ */
+void RemapColumns(const StaggeredField<FieldGridStagger::CellCentered>& source_thickness,
+                  const StaggeredField<FieldGridStagger::CellCentered>& target_thickness,
+                  const std::vector<std::shared_ptr<Field>>& tracers, const RemapScheme scheme);
+
+}  // namespace turbo
@@ -0,0 +1,199 @@
+#include "vertical_remap.h"
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "amrex_test_environment.h"
+#include "box_decomposition.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "field_test_utils.h"
+#include "staggered_field.h"
+
+using namespace turbo;
+
+::testing::Environment* const amrex_env = ::testing::AddGlobalTestEnvironment(new AmrexEnvironment());
+
+//---------------------------------------------------------------------------//
+// Define a test fixture for vertical remap tests
+//---------------------------------------------------------------------------//
+
+class VerticalRemapTest : public ::testing::Test
+{
+   protected:
+    using CellField = StaggeredField<FieldGridStagger::CellCentered>;
+
+    void SetUp() override { grid = MakeTestGrid(n_level); }
+
+    /**
+     * @brief Make a cell-centered field and set its valid points to a function of the indices and the component.
+     */
+    CellField MakeField(const Field::NameType& name, const PointFunction& function, const int n_component = 1,
+                        const BoxDecomposition& layout = MakeTestBoxDecomposition(n_level)) const
+    {
+        const CellField field(name, grid, n_component, 0, FoldParity::Scalar, layout);
+        FillField(field, function);
+        return field;
+    }
+
+    /**
+     * @brief Source thickness with varying and vanished layers.
+     */
+    static double SourceThickness(int i, int j, int k, int)
+    {
+        return (i + 2 * j + k) % 5 == 0 ? 0.0 : 1.0 + 0.3 * std::sin(i + 0.7 * k + j);
+    }
+
+    /**
+     * @brief Target thickness with other varying and vanished layers and the column total of the source thickness.
+     */
+    static double TargetThickness(int i, int j, int k, int)
+    {
+        auto weight = [i, j](int level) { return (level == 2 && j % 2 == 0) ? 0.0 : 1.0 + 0.5 * std::cos(level + i); };
+        double source_total = 0.0;
+        double weight_total = 0.0;
+        for (int level = 0; level < n_level; ++level)
+        {
+            source_total += SourceThickness(i, j, level, 0);
+            weight_total += weight(level);
+        }
+        return source_total * weight(k) / weight_total;
+    }
+
+    static constexpr int n_level = 10;
+    std::shared_ptr<CartesianGrid> grid;
+};
+
+//---------------------------------------------------------------------------//
+// Vertical remap tests
+//---------------------------------------------------------------------------//
+
+TEST_F(VerticalRemapTest, Identity)
+{
+    const CellField thickness  = MakeField("thickness", SourceThickness);
+    const PointFunction values = [](int i, int j, int k, int n) { return std::sin(0.9 * k + i) + 0.1 * j - n; };
+    for (const RemapScheme scheme : {RemapScheme::PLM, RemapScheme::PPM})
+    {
+        const CellField tracer = MakeField("tracer", values, 2);
+        RemapColumns(thickness, thickness, {tracer.GetField()}, scheme);
+        EXPECT_LT(MaxError(tracer, values, SourceThickness), 1.0e-12) << RemapSchemeToString(scheme);
+    }
+}
+
+TEST_F(VerticalRemapTest, ConservativeAndMonotone)
+{
+    const CellField source_thickness = MakeField("source_thickness", SourceThickness);
+    const CellField target_thickness = MakeField("target_thickness", TargetThickness);
+    const PointFunction values       = [](int i, int j, int k, int n)
+    { return (k % 3 == 1 ? 5.0 : std::sin(k + i)) + j * n; };
+    for (const RemapScheme scheme : {RemapScheme::PLM, RemapScheme::PPM})
+    {
+        const CellField temperature = MakeField("temperature", values, 2);
+        const CellField salinity    = MakeField("salinity", [](int, int, int, int) { return 35.0; });
+        RemapColumns(source_thickness, target_thickness, {temperature.GetField(), salinity.GetField()}, scheme);
+
+        // A constant stays constant
+        EXPECT_LT(MaxError(salinity, [](int, int, int, int) { return 35.0; }, TargetThickness), 1.0e-12);
+
+        const amrex::MultiFab& mf = temperature.GetMultiFab();
+        for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const amrex::Array4<const amrex::Real> remapped = mf.const_array(mfi);
+            const amrex::Box box                            = mfi.validbox();
+            for (int n = 0; n < mf.nComp(); ++n)
+            {
+                for (int j = box.smallEnd(1); j <= box.bigEnd(1); ++j)
+                {
+                    for (int i = box.smallEnd(0); i <= box.bigEnd(0); ++i)
+                    {
+                        double source_content = 0.0;
+                        double target_content = 0.0;
+                        double min_value      = values(i, j, 0, n);
+                        double max_value      = values(i, j, 0, n);
+                        for (int k = 0; k < n_level; ++k)
+                        {
+                            source_content += SourceThickness(i, j, k, n) * values(i, j, k, n);
+                            target_content += TargetThickness(i, j, k, n) * remapped(i, j, k, n);
+                            min_value = std::min(min_value, values(i, j, k, n));
+                            max_value = std::max(max_value, values(i, j, k, n));
+                        }
+                        EXPECT_NEAR(target_content, source_content, 1.0e-12 * (1.0 + std::abs(source_content)))
+                            << RemapSchemeToString(scheme) << " column " << i << ", " << j;
+                        for (int k = 0; k < n_level; ++k)
+                        {
+                            EXPECT_GE(remapped(i, j, k, n), min_value - 1.0e-12);
+                            EXPECT_LE(remapped(i, j, k, n), max_value + 1.0e-12);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(VerticalRemapTest, LinearProfile)
+{
+    // Layers of thickness 1 shifted by half a layer: away from the ends of the column, where the reconstruction is
+    // flat, a linear profile is exact
+    const CellField source_thickness = MakeField("source_thickness", [](int, int, int, int) { return 1.0; });
+    const CellField target_thickness =
+        MakeField("target_thickness", [](int, int, int k, int) { return (k == 0 || k == n_level - 1) ? 0.5 : 1.0; });
+    const PointFunction exact    = [](int, int, int k, int) { return 2.0 * k - 1.0; };
+    const PointFunction interior = [](int, int, int k, int) { return (k >= 3 && k <= n_level - 3) ? 1.0 : 0.0; };
+    for (const RemapScheme scheme : {RemapScheme::PLM, RemapScheme::PPM})
+    {
+        const CellField tracer = MakeField("tracer", [](int, int, int k, int) { return 2.0 * k; });
+        RemapColumns(source_thickness, target_thickness, {tracer.GetField()}, scheme);
+        EXPECT_LT(MaxError(tracer, exact, interior), 1.0e-12) << RemapSchemeToString(scheme);
+    }
+}
+
+TEST_F(VerticalRemapTest, Land)
+{
+    // Land columns, here every column with i = 2, have no source thickness and are left unchanged
+    const PointFunction source = [](int i, int, int, int) { return i == 2 ? 0.0 : 1.0; };
+    const PointFunction target = [](int i, int, int k, int) { return i == 2 ? 0.0 : (k % 2 == 0 ? 0.5 : 1.5); };
+    const PointFunction values = [](int i, int j, int k, int) { return i == 2 ? -99.0 : 1.0 + j + k; };
+    const PointFunction land   = [](int i, int, int, int) { return i == 2 ? 1.0 : 0.0; };
+    const CellField tracer     = MakeField("tracer", values);
+    RemapColumns(MakeField("source_thickness", source), MakeField("target_thickness", target), {tracer.GetField()},
+                 RemapScheme::PPM);
+    EXPECT_LT(MaxError(tracer, values, land), 1.0e-14);
+}
+
+TEST_F(VerticalRemapTest, Errors)
+{
+    // The checks themselves are tested with CheckOperand and CheckWholeColumns, these are the ones the remapping
+    // applies
+    const PointFunction one   = [](int, int, int, int) { return 1.0; };
+    const CellField thickness = MakeField("thickness", one);
+    const CellField tracer    = MakeField("tracer", one, 2);
+    const CellField split     = MakeField("split", one, 1, MakeTestBoxDecomposition(2));
+    const RemapScheme scheme  = RemapScheme::PPM;
+
+    // Null or staggered tracers
+    EXPECT_THROW(RemapColumns(thickness, thickness, {nullptr}, scheme), std::invalid_argument);
+    const StaggeredField<FieldGridStagger::IFace> u("u", grid, 1, 0, FoldParity::Scalar,
+                                                    MakeTestBoxDecomposition(n_level));
+    EXPECT_THROW(RemapColumns(thickness, thickness, {u.GetField()}, scheme), std::invalid_argument);
+
+    // Thickness with several components
+    EXPECT_THROW(RemapColumns(tracer, thickness, {}, scheme), std::invalid_argument);
+    EXPECT_THROW(RemapColumns(thickness, tracer, {}, scheme), std::invalid_argument);
+
+    // A target thickness or a tracer on another layout
+    EXPECT_THROW(RemapColumns(thickness, split, {}, scheme), std::invalid_argument);
+    EXPECT_THROW(RemapColumns(thickness, thickness, {split.GetField()}, scheme), std::invalid_argument);
+
+    // Columns split over boxes
+    EXPECT_THROW(RemapColumns(split, split, {}, scheme), std::invalid_argument);
+
+    EXPECT_NO_THROW(RemapColumns(thickness, thickness, {tracer.GetField()}, scheme));
+}
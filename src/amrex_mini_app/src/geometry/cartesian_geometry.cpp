@@ -1,5 +1,6 @@
 #include "cartesian_geometry.h"
 
+#include <set>
 #include <stdexcept>
 #include <string>
 
@@ -7,7 +8,14 @@ namespace turbo
 {
 
 CartesianGeometry::CartesianGeometry(double x_min, double x_max, double y_min, double y_max, double z_min, double z_max)
-    : Geometry({"x_min", "x_max", "y_min", "y_max", "z_min", "z_max"}),
+    : CartesianGeometry(x_min, x_max, y_min, y_max, z_min, z_max,
+                        {"x_min", "x_max", "y_min", "y_max", "z_min", "z_max"})
+{
+}
+
+CartesianGeometry::CartesianGeometry(double x_min, double x_max, double y_min, double y_max, double z_min, double z_max,
+                                     std::set<Boundary> boundaries)
+    : Geometry(boundaries),
       x_min_(x_min),
       x_max_(x_max),
       y_min_(y_min),
@@ -88,6 +88,26 @@ class CartesianGeometry : public Geometry
      */
     double LZ() const noexcept;
 
+   protected:
+    //-----------------------------------------------------------------------//
+    // Protected Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct a CartesianGeometry object with domain extents and custom boundaries, for derived geometries
+     * that connect some of the domain faces (e.g. periodic or folded boundaries).
+     * @param x_min Minimum x-coordinate
+     * @param x_max Maximum x-coordinate
+     * @param y_min Minimum y-coordinate
+     * @param y_max Maximum y-coordinate
+     * @param z_min Minimum z-coordinate
+     * @param z_max Maximum z-coordinate
+     * @param boundaries Set of boundary names for the geometry
+     * @throws std::invalid_argument if any coordinate minimum >= maximum
+     */
+    CartesianGeometry(double x_min, double x_max, double y_min, double y_max, double z_min, double z_max,
+                      std::set<Boundary> boundaries);
+
    private:
     //-----------------------------------------------------------------------//
     // Private Data Members
@@ -0,0 +1,13 @@
+#include "tripolar_geometry.h"
+
+#include "cartesian_geometry.h"
+
+namespace turbo
+{
+
+TripolarGeometry::TripolarGeometry(double x_min, double x_max, double y_min, double y_max, double z_min, double z_max)
+    : CartesianGeometry(x_min, x_max, y_min, y_max, z_min, z_max, {"x_periodic", "y_min", "y_fold", "z_min", "z_max"})
+{
+}
+
+}  // namespace turbo
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "cartesian_geometry.h"
+
+namespace turbo
+{
+
+/**
+ * @brief Logically rectangular geometry of a tripolar ocean grid.
+ *
+ * The domain is a Cartesian box in index space, where x is periodic and the y_max boundary is the tripolar fold: the
+ * top row is folded onto itself about the middle of the x extent, so the point at x on the fold neighbors the point
+ * at x_min + x_max - x. The remaining boundaries (y_min, z_min, z_max) are physical boundaries.
+ */
+class TripolarGeometry : public CartesianGeometry
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+
+    /**
+     * @brief Construct a TripolarGeometry object with domain extents.
+     * @param x_min Minimum x-coordinate
+     * @param x_max Maximum x-coordinate
+     * @param y_min Minimum y-coordinate
+     * @param y_max Maximum y-coordinate, the location of the fold
+     * @param z_min Minimum z-coordinate
+     * @param z_max Maximum z-coordinate
+     * @throws std::invalid_argument if any coordinate minimum >= maximum
+     */
+    TripolarGeometry(double x_min, double x_max, double y_min, double y_max, double z_min, double z_max);
+};
+
+}  // namespace turbo
@@ -0,0 +1,38 @@
+#include "tripolar_geometry.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace turbo;
+
+TEST(TripolarGeometry, Constructor)
+{
+    const double x_min = 0.0;
+    const double x_max = 360.0;
+    const double y_min = -80.0;
+    const double y_max = 90.0;
+    const double z_min = 0.0;
+    const double z_max = 5000.0;
+
+    // Invalid domain extents should throw
+    EXPECT_THROW(TripolarGeometry geom_invalid(x_max, x_min, y_min, y_max, z_min, z_max), std::invalid_argument);
+    EXPECT_THROW(TripolarGeometry geom_invalid(x_min, x_max, y_max, y_min, z_min, z_max), std::invalid_argument);
+    EXPECT_THROW(TripolarGeometry geom_invalid(x_min, x_max, y_min, y_max, z_max, z_min), std::invalid_argument);
+
+    TripolarGeometry geom(x_min, x_max, y_min, y_max, z_min, z_max);
+
+    // Check that domain extents are set correctly
+    EXPECT_DOUBLE_EQ(geom.XMin(), x_min);
+    EXPECT_DOUBLE_EQ(geom.XMax(), x_max);
+    EXPECT_DOUBLE_EQ(geom.YMin(), y_min);
+    EXPECT_DOUBLE_EQ(geom.YMax(), y_max);
+    EXPECT_DOUBLE_EQ(geom.ZMin(), z_min);
+    EXPECT_DOUBLE_EQ(geom.ZMax(), z_max);
+
+    // x is periodic and y_max is the fold, so those do not show up as x_min, x_max, y_max boundaries
+    std::set<Geometry::Boundary> boundary_expected = {"x_periodic", "y_min", "y_fold", "z_min", "z_max"};
+    EXPECT_EQ(boundary_expected, geom.Boundaries());
+}
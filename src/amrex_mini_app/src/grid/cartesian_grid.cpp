@@ -1,5 +1,8 @@
 #include "cartesian_grid.h"
 
+#include <H5DSpublic.h>
+#include <hdf5.h>
+
 #include <cstddef>
 #include <stdexcept>
 #include <string>
@@ -19,9 +22,46 @@ CartesianGrid::CartesianGrid(const std::shared_ptr<CartesianGeometry>& geometry,
         throw std::invalid_argument("Number of cells in each direction must be greater than zero.");
     }
 
-    dx_ = static_cast<double>(GetGeometry()->LX()) / n_cell_x_;
-    dy_ = static_cast<double>(GetGeometry()->LY()) / n_cell_y_;
-    dz_ = static_cast<double>(GetGeometry()->LZ()) / n_cell_z_;
+    const std::shared_ptr<CartesianGeometry> cartesian_geometry = GetGeometry();
+
+    dx_ = static_cast<double>(cartesian_geometry->LX()) / n_cell_x_;
+    dy_ = static_cast<double>(cartesian_geometry->LY()) / n_cell_y_;
+    dz_ = static_cast<double>(cartesian_geometry->LZ()) / n_cell_z_;
+
+    // Cartesian coordinates are separable, so every location only needs 1D node and cell center axes
+    auto node_axis = [](const double min, const double d, const std::size_t n_node)
+    {
+        std::vector<double> axis(n_node);
+        for (std::size_t n = 0; n < n_node; ++n)
+        {
+            axis[n] = min + n * d;
+        }
+        return axis;
+    };
+    auto cell_center_axis = [](const std::vector<double>& node_axis, const double d)
+    {
+        std::vector<double> axis(node_axis.size() - 1);
+        for (std::size_t n = 0; n < axis.size(); ++n)
+        {
+            axis[n] = node_axis[n] + d * 0.5;
+        }
+        return axis;
+    };
+    auto separable_table = [](const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z)
+    { return CoordinateTable{x, y, z, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}}; };
+
+    const std::vector<double> node_x = node_axis(cartesian_geometry->XMin(), dx_, NNodeX());
+    const std::vector<double> node_y = node_axis(cartesian_geometry->YMin(), dy_, NNodeY());
+    const std::vector<double> node_z = node_axis(cartesian_geometry->ZMin(), dz_, NNodeZ());
+    const std::vector<double> cell_x = cell_center_axis(node_x, dx_);
+    const std::vector<double> cell_y = cell_center_axis(node_y, dy_);
+    const std::vector<double> cell_z = cell_center_axis(node_z, dz_);
+
+    node_coordinates_        = separable_table(node_x, node_y, node_z);
+    cell_center_coordinates_ = separable_table(cell_x, cell_y, cell_z);
+    i_face_coordinates_      = separable_table(node_x, cell_y, cell_z);
+    j_face_coordinates_      = separable_table(cell_x, node_y, cell_z);
+    k_face_coordinates_      = separable_table(cell_x, cell_y, node_z);
 }
 
 std::size_t CartesianGrid::NCell() const noexcept { return NCellI() * NCellJ() * NCellK(); }
@@ -40,7 +80,7 @@ CartesianGrid::Point CartesianGrid::Node(const Index i, const Index j, const Ind
     {
         throw std::out_of_range("Node index out of bounds");
     }
-    return Point({GetGeometry()->XMin() + i * dx_, GetGeometry()->YMin() + j * dy_, GetGeometry()->ZMin() + k * dz_});
+    return node_coordinates_(i, j, k);
 }
 
 CartesianGrid::Point CartesianGrid::CellCenter(const Index i, const Index j, const Index k) const
@@ -49,7 +89,7 @@ CartesianGrid::Point CartesianGrid::CellCenter(const Index i, const Index j, con
     {
         throw std::out_of_range("Cell index out of bounds");
     }
-    return Node(i, j, k) + Point{dx_ * 0.5, dy_ * 0.5, dz_ * 0.5};
+    return cell_center_coordinates_(i, j, k);
 }
 
 CartesianGrid::Point CartesianGrid::IFace(const Index i, const Index j, const Index k) const
@@ -58,7 +98,7 @@ CartesianGrid::Point CartesianGrid::IFace(const Index i, const Index j, const In
     {
         throw std::out_of_range("IFace index out of bounds");
     }
-    return Node(i, j, k) + Point{0.0, dy_ * 0.5, dz_ * 0.5};
+    return i_face_coordinates_(i, j, k);
 }
 
 CartesianGrid::Point CartesianGrid::JFace(const Index i, const Index j, const Index k) const
@@ -67,7 +107,7 @@ CartesianGrid::Point CartesianGrid::JFace(const Index i, const Index j, const In
     {
         throw std::out_of_range("JFace index out of bounds");
     }
-    return Node(i, j, k) + Point{dx_ * 0.5, 0.0, dz_ * 0.5};
+    return j_face_coordinates_(i, j, k);
 }
 
 CartesianGrid::Point CartesianGrid::KFace(const Index i, const Index j, const Index k) const
@@ -76,7 +116,7 @@ CartesianGrid::Point CartesianGrid::KFace(const Index i, const Index j, const In
     {
         throw std::out_of_range("KFace index out of bounds");
     }
-    return Node(i, j, k) + Point{dx_ * 0.5, dy_ * 0.5, 0.0};
+    return k_face_coordinates_(i, j, k);
 }
 
 std::size_t CartesianGrid::NNodeX() const noexcept { return NNodeI(); }
@@ -107,88 +147,86 @@ void CartesianGrid::WriteHDF5(const hid_t file_id) const
         throw std::runtime_error("Invalid HDF5 file_id passed to WriteHDF5.");
     }
 
-    // Helper lambda for writing the grid points for a given location (cell center, node, face, etc)
-    auto write_grid_point_dataset =
-        [file_id](const std::string& name, std::size_t nx, std::size_t ny, std::size_t nz, auto&& location_func)
+    // The coordinates of a uniform Cartesian grid are separable, so for every grid location (cell center, node,
+    // face, etc) we only write the 1D x, y, and z axes. Each axis is an HDF5 dimension scale that Field::WriteHDF5
+    // attaches to the matching dimension of the field datasets.
+    auto write_axis = [](const hid_t group_id, const std::string& group_name, const std::string& axis_name,
+                         const std::vector<double>& axis)
     {
-        const int n_component     = 3;  // Assuming here grid points will always have three components: x,y,z
-        std::vector<hsize_t> dims = {static_cast<hsize_t>(nx), static_cast<hsize_t>(ny), static_cast<hsize_t>(nz),
-                                     static_cast<hsize_t>(n_component)};
+        const std::string name = group_name + "/" + axis_name;
+        const hsize_t dims[1]  = {static_cast<hsize_t>(axis.size())};
 
-        const hid_t dataspace_id  = H5Screate_simple(dims.size(), dims.data(), NULL);
+        const hid_t dataspace_id = H5Screate_simple(1, dims, NULL);
         if (dataspace_id < 0)
         {
             throw std::runtime_error("Failed to create HDF5 dataspace for dataset '" + name + "'.");
         }
 
-        const hid_t dataset_id =
-            H5Dcreate(file_id, name.c_str(), H5T_NATIVE_DOUBLE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        const hid_t dataset_id = H5Dcreate(group_id, axis_name.c_str(), H5T_NATIVE_DOUBLE, dataspace_id, H5P_DEFAULT,
+                                           H5P_DEFAULT, H5P_DEFAULT);
+        H5Sclose(dataspace_id);
         if (dataset_id < 0)
         {
-            H5Sclose(dataspace_id);
             throw std::runtime_error("Failed to create HDF5 dataset '" + name + "'.");
         }
 
+        if (WriteHDF5Data(dataset_id, axis.data()) < 0)
         {
-            // Add an attribute to specify the data layout of the following datasets (row-major or column-major)
-            std::string data_layout_str = "row_major";
-            hid_t attr_type             = H5Tcopy(H5T_C_S1);
-            H5Tset_size(attr_type, data_layout_str.size() + 1);
-            hid_t attr_space = H5Screate(H5S_SCALAR);
-            hid_t attr_id    = H5Acreate2(dataset_id, "data_layout", attr_type, attr_space, H5P_DEFAULT, H5P_DEFAULT);
-            H5Awrite(attr_id, attr_type, data_layout_str.c_str());
-            H5Aclose(attr_id);
-            H5Sclose(attr_space);
-            H5Tclose(attr_type);
-        }
-
-        std::vector<double> data(nx * ny * nz * n_component);
-        std::size_t idx = 0;
-        for (std::size_t i = 0; i < nx; ++i)
-        {
-            for (std::size_t j = 0; j < ny; ++j)
-            {
-                for (std::size_t k = 0; k < nz; ++k)
-                {
-                    const Grid::Point location = location_func(i, j, k);
-                    data[idx++]                = location.x;
-                    data[idx++]                = location.y;
-                    data[idx++]                = location.z;
-                }
-            }
+            H5Dclose(dataset_id);
+            throw std::runtime_error("Failed to write data to HDF5 dataset '" + name + "'.");
         }
 
-        herr_t status = H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
-        if (status < 0)
+        if (H5DSset_scale(dataset_id, axis_name.c_str()) < 0)
         {
             H5Dclose(dataset_id);
-            H5Sclose(dataspace_id);
-            throw std::runtime_error("Failed to write data to HDF5 dataset '" + name + "'.");
+            throw std::runtime_error("Failed to make HDF5 dataset '" + name + "' a dimension scale.");
         }
 
         if (H5Dclose(dataset_id) < 0)
         {
-            H5Sclose(dataspace_id);
             throw std::runtime_error("Failed to close HDF5 dataset '" + name + "'.");
         }
+    };
+
+    // Helper lambda for writing the x, y, z axes of a location's coordinate table into a group of the same name
+    auto write_grid_axes = [file_id, &write_axis](const std::string& name, const CoordinateTable& coordinates)
+    {
+        const hid_t group_id = H5Gcreate2(file_id, name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        if (group_id < 0)
+        {
+            throw std::runtime_error("Failed to create HDF5 group '" + name + "'.");
+        }
 
-        if (H5Sclose(dataspace_id) < 0)
+        write_axis(group_id, name, "x", coordinates.x);
+        write_axis(group_id, name, "y", coordinates.y);
+        write_axis(group_id, name, "z", coordinates.z);
+
+        if (H5Gclose(group_id) < 0)
         {
-            throw std::runtime_error("Failed to close HDF5 dataspace for dataset '" + name + "'.");
+            throw std::runtime_error("Failed to close HDF5 group '" + name + "'.");
         }
     };
 
-    // Write datasets for all the grid stagger locations
-    write_grid_point_dataset("cell_center", NCellX(), NCellY(), NCellZ(),
-                             [this](const Index i, const Index j, const Index k) { return this->CellCenter(i, j, k); });
-    write_grid_point_dataset("node", NNodeX(), NNodeY(), NNodeZ(),
-                             [this](const Index i, const Index j, const Index k) { return this->Node(i, j, k); });
-    write_grid_point_dataset("x_face", NNodeX(), NCellY(), NCellZ(),
-                             [this](const Index i, const Index j, const Index k) { return this->XFace(i, j, k); });
-    write_grid_point_dataset("y_face", NCellX(), NNodeY(), NCellZ(),
-                             [this](const Index i, const Index j, const Index k) { return this->YFace(i, j, k); });
-    write_grid_point_dataset("z_face", NCellX(), NCellY(), NNodeZ(),
-                             [this](const Index i, const Index j, const Index k) { return this->ZFace(i, j, k); });
+    // Write axes for all the grid stagger locations
+    write_grid_axes("cell_center", cell_center_coordinates_);
+    write_grid_axes("node", node_coordinates_);
+    write_grid_axes("x_face", i_face_coordinates_);
+    write_grid_axes("y_face", j_face_coordinates_);
+    write_grid_axes("z_face", k_face_coordinates_);
+}
+
+CartesianGridView CartesianGrid::NodeView() const noexcept { return MakeView(0.0, 0.0, 0.0); }
+CartesianGridView CartesianGrid::CellCenterView() const noexcept { return MakeView(0.5, 0.5, 0.5); }
+CartesianGridView CartesianGrid::XFaceView() const noexcept { return MakeView(0.0, 0.5, 0.5); }
+CartesianGridView CartesianGrid::YFaceView() const noexcept { return MakeView(0.5, 0.0, 0.5); }
+CartesianGridView CartesianGrid::ZFaceView() const noexcept { return MakeView(0.5, 0.5, 0.0); }
+
+CartesianGridView CartesianGrid::MakeView(const double x_offset, const double y_offset,
+                                          const double z_offset) const noexcept
+{
+    const std::shared_ptr<CartesianGeometry> cartesian_geometry = GetGeometry();
+    return CartesianGridView{cartesian_geometry->XMin(), cartesian_geometry->YMin(), cartesian_geometry->ZMin(),
+                             dx_, dy_, dz_, x_offset, y_offset, z_offset};
 }
 
 bool CartesianGrid::ValidNode(const Index i, const Index j, const Index k) const noexcept
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "cartesian_geometry.h"
+#include "cartesian_grid_view.h"
 #include "grid.h"
 
 namespace turbo
@@ -156,7 +157,49 @@ class CartesianGrid : public Grid
      */
     bool ValidZFace(const Index i, const Index j, const Index k) const noexcept;
 
+    /**
+     * @brief Get a trivially-copyable view of the node locations for use in device kernels.
+     * @return View of the node locations
+     */
+    CartesianGridView NodeView() const noexcept;
+
+    /**
+     * @brief Get a trivially-copyable view of the cell center locations for use in device kernels.
+     * @return View of the cell center locations
+     */
+    CartesianGridView CellCenterView() const noexcept;
+
+    /**
+     * @brief Get a trivially-copyable view of the X-face center locations for use in device kernels.
+     * @return View of the X-face center locations
+     */
+    CartesianGridView XFaceView() const noexcept;
+
+    /**
+     * @brief Get a trivially-copyable view of the Y-face center locations for use in device kernels.
+     * @return View of the Y-face center locations
+     */
+    CartesianGridView YFaceView() const noexcept;
+
+    /**
+     * @brief Get a trivially-copyable view of the Z-face center locations for use in device kernels.
+     * @return View of the Z-face center locations
+     */
+    CartesianGridView ZFaceView() const noexcept;
+
    private:
+    //-----------------------------------------------------------------------//
+    // Private Member Functions
+    //-----------------------------------------------------------------------//
+    /**
+     * @brief Make a view of the grid location with the given stagger offsets.
+     * @param x_offset Offset in units of cells in X (0 for nodal, 0.5 for cell centered)
+     * @param y_offset Offset in units of cells in Y (0 for nodal, 0.5 for cell centered)
+     * @param z_offset Offset in units of cells in Z (0 for nodal, 0.5 for cell centered)
+     * @return View of the grid location
+     */
+    CartesianGridView MakeView(const double x_offset, const double y_offset, const double z_offset) const noexcept;
+
     //-----------------------------------------------------------------------//
     // Private Data Members
     //-----------------------------------------------------------------------//
@@ -1,12 +1,17 @@
 #include "cartesian_grid.h"
 
+#include <H5DSpublic.h>
 #include <gtest/gtest.h>
 #include <hdf5.h>
 
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 
+#include "cartesian_grid_view.h"
 #include "geometry.h"
 
 using namespace turbo;
@@ -257,6 +262,94 @@ TEST_F(CartesianGridTest, GridLocations)
     EXPECT_THROW(grid.KFace(0, 0, grid.NNodeK()), std::out_of_range);
 }
 
+TEST_F(CartesianGridTest, CoordinateTables)
+{
+    // Use a different number of cells in each direction so mixed up strides or axes would be caught
+    const std::size_t n_cell_x = 3;
+    const std::size_t n_cell_y = 4;
+    const std::size_t n_cell_z = 5;
+    CartesianGrid grid(geom, n_cell_x, n_cell_y, n_cell_z);
+
+    // Helper lambda to compare the unchecked table lookups against the checked grid location functions
+    auto CheckTable = [](const Grid::CoordinateTable& coordinates, std::size_t ni, std::size_t nj, std::size_t nk,
+                         auto&& location_func)
+    {
+        for (std::size_t i = 0; i < ni; ++i)
+        {
+            for (std::size_t j = 0; j < nj; ++j)
+            {
+                for (std::size_t k = 0; k < nk; ++k)
+                {
+                    EXPECT_EQ(coordinates(i, j, k), location_func(i, j, k))
+                        << "Coordinate table does not match at indices (" << i << "," << j << "," << k << ")";
+                }
+            }
+        }
+    };
+
+    CheckTable(grid.NodeCoordinates(), grid.NNodeX(), grid.NNodeY(), grid.NNodeZ(),
+               [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.Node(i, j, k); });
+    CheckTable(grid.CellCenterCoordinates(), grid.NCellX(), grid.NCellY(), grid.NCellZ(),
+               [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.CellCenter(i, j, k); });
+    CheckTable(grid.IFaceCoordinates(), grid.NNodeX(), grid.NCellY(), grid.NCellZ(),
+               [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.IFace(i, j, k); });
+    CheckTable(grid.JFaceCoordinates(), grid.NCellX(), grid.NNodeY(), grid.NCellZ(),
+               [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.JFace(i, j, k); });
+    CheckTable(grid.KFaceCoordinates(), grid.NCellX(), grid.NCellY(), grid.NNodeZ(),
+               [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.KFace(i, j, k); });
+
+    // Cartesian coordinates are separable, so the tables only store 1D axes
+    EXPECT_EQ(grid.NodeCoordinates().x.size(), grid.NNodeX());
+    EXPECT_EQ(grid.NodeCoordinates().y.size(), grid.NNodeY());
+    EXPECT_EQ(grid.NodeCoordinates().z.size(), grid.NNodeZ());
+    EXPECT_EQ(grid.CellCenterCoordinates().x.size(), grid.NCellX());
+    EXPECT_EQ(grid.CellCenterCoordinates().y.size(), grid.NCellY());
+    EXPECT_EQ(grid.CellCenterCoordinates().z.size(), grid.NCellZ());
+}
+
+TEST_F(CartesianGridTest, GridViews)
+{
+    const std::size_t n_cell_x = 3;
+    const std::size_t n_cell_y = 4;
+    const std::size_t n_cell_z = 5;
+    CartesianGrid grid(geom, n_cell_x, n_cell_y, n_cell_z);
+
+    static_assert(std::is_trivially_copyable_v<CartesianGridView>);
+
+    // Helper lambda to compare the view against the checked grid location functions
+    auto CheckView = [](const CartesianGridView& view, std::size_t ni, std::size_t nj, std::size_t nk,
+                        auto&& location_func)
+    {
+        for (std::size_t i = 0; i < ni; ++i)
+        {
+            for (std::size_t j = 0; j < nj; ++j)
+            {
+                for (std::size_t k = 0; k < nk; ++k)
+                {
+                    EXPECT_EQ(view(i, j, k), location_func(i, j, k))
+                        << "Grid view does not match at indices (" << i << "," << j << "," << k << ")";
+                }
+            }
+        }
+    };
+
+    CheckView(grid.NodeView(), grid.NNodeX(), grid.NNodeY(), grid.NNodeZ(),
+              [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.Node(i, j, k); });
+    CheckView(grid.CellCenterView(), grid.NCellX(), grid.NCellY(), grid.NCellZ(),
+              [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.CellCenter(i, j, k); });
+    CheckView(grid.XFaceView(), grid.NNodeX(), grid.NCellY(), grid.NCellZ(),
+              [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.XFace(i, j, k); });
+    CheckView(grid.YFaceView(), grid.NCellX(), grid.NNodeY(), grid.NCellZ(),
+              [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.YFace(i, j, k); });
+    CheckView(grid.ZFaceView(), grid.NCellX(), grid.NCellY(), grid.NNodeZ(),
+              [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.ZFace(i, j, k); });
+
+    // Views extrapolate outside of the grid, e.g. into ghost cells
+    const CartesianGridView cell_center_view = grid.CellCenterView();
+    EXPECT_DOUBLE_EQ(cell_center_view.X(-1), grid.CellCenter(0, 0, 0).x - 1.0 / n_cell_x);
+    EXPECT_DOUBLE_EQ(cell_center_view.Y(n_cell_y), grid.CellCenter(0, n_cell_y - 1, 0).y + 1.0 / n_cell_y);
+}
+
 TEST_F(CartesianGridTest, WriteHDF5)
 {
     // Grid with 2 cells in each direction
@@ -278,4 +371,95 @@ TEST_F(CartesianGridTest, WriteHDF5)
         const std::string filename = "Test_Output_CartesianGrid_WriteHDF5_via_filename.h5";
         grid.WriteHDF5(filename);
     }
+
+    // Read back the 1D coordinate axes for every grid location and compare against the grid location functions
+    {
+        const std::string filename = "Test_Output_CartesianGrid_WriteHDF5_via_filename.h5";
+        const hid_t file_id        = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+
+        auto ReadAxis = [file_id](const std::string& name) -> std::vector<double>
+        {
+            const hid_t dataset_id = H5Dopen2(file_id, name.c_str(), H5P_DEFAULT);
+            EXPECT_GT(H5DSis_scale(dataset_id), 0) << "Axis '" << name << "' is not a dimension scale";
+            const hid_t space_id = H5Dget_space(dataset_id);
+            EXPECT_EQ(H5Sget_simple_extent_ndims(space_id), 1);
+            std::vector<double> axis(H5Sget_simple_extent_npoints(space_id));
+            H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, axis.data());
+            H5Sclose(space_id);
+            H5Dclose(dataset_id);
+            return axis;
+        };
+
+        auto CheckAxes = [&ReadAxis](const std::string& location, std::size_t nx, std::size_t ny, std::size_t nz,
+                                     auto&& location_func)
+        {
+            const std::vector<double> x = ReadAxis(location + "/x");
+            const std::vector<double> y = ReadAxis(location + "/y");
+            const std::vector<double> z = ReadAxis(location + "/z");
+            ASSERT_EQ(x.size(), nx);
+            ASSERT_EQ(y.size(), ny);
+            ASSERT_EQ(z.size(), nz);
+            for (std::size_t i = 0; i < nx; ++i)
+            {
+                for (std::size_t j = 0; j < ny; ++j)
+                {
+                    for (std::size_t k = 0; k < nz; ++k)
+                    {
+                        EXPECT_EQ(Grid::Point({x[i], y[j], z[k]}), location_func(i, j, k))
+                            << location << " coordinates do not match at indices (" << i << "," << j << "," << k
+                            << ")";
+                    }
+                }
+            }
+        };
+
+        CheckAxes("cell_center", grid.NCellX(), grid.NCellY(), grid.NCellZ(),
+                  [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.CellCenter(i, j, k); });
+        CheckAxes("node", grid.NNodeX(), grid.NNodeY(), grid.NNodeZ(),
+                  [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.Node(i, j, k); });
+        CheckAxes("x_face", grid.NNodeX(), grid.NCellY(), grid.NCellZ(),
+                  [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.XFace(i, j, k); });
+        CheckAxes("y_face", grid.NCellX(), grid.NNodeY(), grid.NCellZ(),
+                  [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.YFace(i, j, k); });
+        CheckAxes("z_face", grid.NCellX(), grid.NCellY(), grid.NNodeZ(),
+                  [&grid](std::size_t i, std::size_t j, std::size_t k) { return grid.ZFace(i, j, k); });
+
+        H5Fclose(file_id);
+    }
+}
+
+TEST_F(CartesianGridTest, WriteHDF5FullCoordinates)
+{
+    const std::size_t n_cell_x = 2;
+    const std::size_t n_cell_y = 3;
+    const std::size_t n_cell_z = 4;
+    CartesianGrid grid(geom, n_cell_x, n_cell_y, n_cell_z);
+
+    const std::string filename = "Test_Output_CartesianGrid_WriteHDF5FullCoordinates.h5";
+    {
+        const hid_t file_id = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+        grid.WriteHDF5FullCoordinates(file_id);
+        H5Fclose(file_id);
+    }
+
+    // The full coordinate arrays are (ni, nj, nk, 3) in row-major order
+    const hid_t file_id    = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset_id = H5Dopen2(file_id, "node", H5P_DEFAULT);
+    std::vector<double> node(grid.NNode() * 3);
+    H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, node.data());
+    H5Dclose(dataset_id);
+    H5Fclose(file_id);
+
+    std::size_t idx = 0;
+    for (std::size_t i = 0; i < grid.NNodeX(); ++i)
+    {
+        for (std::size_t j = 0; j < grid.NNodeY(); ++j)
+        {
+            for (std::size_t k = 0; k < grid.NNodeZ(); ++k)
+            {
+                EXPECT_EQ(Grid::Point({node[idx], node[idx + 1], node[idx + 2]}), grid.Node(i, j, k));
+                idx += 3;
+            }
+        }
+    }
 }
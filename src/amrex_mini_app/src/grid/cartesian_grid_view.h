@@ -0,0 +1,75 @@
+#pragma once
+
+#include <AMReX_Extension.H>
+#include <AMReX_GpuQualifiers.H>
+
+#include <type_traits>
+
+#include "grid.h"
+
+namespace turbo
+{
+
+/**
+ * @brief Lightweight, trivially-copyable view of one grid location (nodes, cell centers, or faces) of a
+ * CartesianGrid.
+ *
+ * Holds only the domain origin, the grid spacing, and the stagger offset (0 or 1/2 cell) in each direction, so it can
+ * be captured by value in amrex::ParallelFor kernels, including on the device, instead of a Field or Grid pointer.
+ * The coordinate functions do no bounds checking and extrapolate linearly for indices outside of the grid, e.g. ghost
+ * cells. Obtain a view from CartesianGrid::NodeView and friends, or Field::GetGridView.
+ */
+struct CartesianGridView
+{
+    double x_origin, y_origin, z_origin; /**< Minimum coordinate of the domain in X, Y, Z */
+    double dx, dy, dz;                   /**< Grid spacing in X, Y, Z */
+    double x_offset, y_offset, z_offset; /**< Stagger offset of the location in units of cells in X, Y, Z */
+
+    /**
+     * @brief Get the X coordinate of index i.
+     * @param i I index
+     * @return X coordinate
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE double X(const int i) const noexcept
+    {
+        return x_origin + i * dx + x_offset * dx;
+    }
+
+    /**
+     * @brief Get the Y coordinate of index j.
+     * @param j J index
+     * @return Y coordinate
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE double Y(const int j) const noexcept
+    {
+        return y_origin + j * dy + y_offset * dy;
+    }
+
+    /**
+     * @brief Get the Z coordinate of index k.
+     * @param k K index
+     * @return Z coordinate
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE double Z(const int k) const noexcept
+    {
+        return z_origin + k * dz + z_offset * dz;
+    }
+
+    /**
+     * @brief Get the location of a grid point.
+     * @param i I index
+     * @param j J index
+     * @param k K index
+     * @return Grid point location
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE Grid::Point operator()(const int i, const int j,
+                                                                    const int k) const noexcept
+    {
+        return {X(i), Y(j), Z(k)};
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<CartesianGridView>,
+              "CartesianGridView must be trivially copyable to be captured in device kernels.");
+
+}  // namespace turbo
@@ -0,0 +1,121 @@
+#include "grid.h"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <hdf5.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace turbo
+{
+
+void Grid::WriteHDF5FullCoordinates(const hid_t file_id) const
+{
+    if (file_id < 0)
+    {
+        throw std::runtime_error("Invalid HDF5 file_id passed to WriteHDF5FullCoordinates.");
+    }
+
+    // Helper lambda for writing the grid points for a given location (cell center, node, face, etc)
+    auto write_grid_point_dataset = [file_id](const std::string& name, std::size_t nx, std::size_t ny, std::size_t nz,
+                                              const CoordinateTable& coordinates)
+    {
+        const int n_component     = 3;  // Assuming here grid points will always have three components: x,y,z
+        std::vector<hsize_t> dims = {static_cast<hsize_t>(nx), static_cast<hsize_t>(ny), static_cast<hsize_t>(nz),
+                                     static_cast<hsize_t>(n_component)};
+
+        const hid_t dataspace_id  = H5Screate_simple(dims.size(), dims.data(), NULL);
+        if (dataspace_id < 0)
+        {
+            throw std::runtime_error("Failed to create HDF5 dataspace for dataset '" + name + "'.");
+        }
+
+        const hid_t dataset_id =
+            H5Dcreate(file_id, name.c_str(), H5T_NATIVE_DOUBLE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        if (dataset_id < 0)
+        {
+            H5Sclose(dataspace_id);
+            throw std::runtime_error("Failed to create HDF5 dataset '" + name + "'.");
+        }
+
+        {
+            // Add an attribute to specify the data layout of the following datasets (row-major or column-major)
+            std::string data_layout_str = "row_major";
+            hid_t attr_type             = H5Tcopy(H5T_C_S1);
+            H5Tset_size(attr_type, data_layout_str.size() + 1);
+            hid_t attr_space = H5Screate(H5S_SCALAR);
+            hid_t attr_id    = H5Acreate2(dataset_id, "data_layout", attr_type, attr_space, H5P_DEFAULT, H5P_DEFAULT);
+            H5Awrite(attr_id, attr_type, data_layout_str.c_str());
+            H5Aclose(attr_id);
+            H5Sclose(attr_space);
+            H5Tclose(attr_type);
+        }
+
+        std::vector<double> data(nx * ny * nz * n_component);
+        std::size_t idx = 0;
+        for (std::size_t i = 0; i < nx; ++i)
+        {
+            for (std::size_t j = 0; j < ny; ++j)
+            {
+                for (std::size_t k = 0; k < nz; ++k)
+                {
+                    const Grid::Point location = coordinates(i, j, k);
+                    data[idx++]                = location.x;
+                    data[idx++]                = location.y;
+                    data[idx++]                = location.z;
+                }
+            }
+        }
+
+        herr_t status = WriteHDF5Data(dataset_id, data.data());
+        if (status < 0)
+        {
+            H5Dclose(dataset_id);
+            H5Sclose(dataspace_id);
+            throw std::runtime_error("Failed to write data to HDF5 dataset '" + name + "'.");
+        }
+
+        if (H5Dclose(dataset_id) < 0)
+        {
+            H5Sclose(dataspace_id);
+            throw std::runtime_error("Failed to close HDF5 dataset '" + name + "'.");
+        }
+
+        if (H5Sclose(dataspace_id) < 0)
+        {
+            throw std::runtime_error("Failed to close HDF5 dataspace for dataset '" + name + "'.");
+        }
+    };
+
+    // Write datasets for all the grid stagger locations
+    write_grid_point_dataset("cell_center", NCellI(), NCellJ(), NCellK(), cell_center_coordinates_);
+    write_grid_point_dataset("node", NNodeI(), NNodeJ(), NNodeK(), node_coordinates_);
+    write_grid_point_dataset("x_face", NNodeI(), NCellJ(), NCellK(), i_face_coordinates_);
+    write_grid_point_dataset("y_face", NCellI(), NNodeJ(), NCellK(), j_face_coordinates_);
+    write_grid_point_dataset("z_face", NCellI(), NCellJ(), NNodeK(), k_face_coordinates_);
+}
+
+herr_t Grid::WriteHDF5Data(const hid_t dataset_id, const double* data)
+{
+#if defined(H5_HAVE_PARALLEL) && defined(AMREX_USE_MPI)
+    // Every rank holds the same grid, so with MPI-IO one write of the data is enough
+    const hid_t file_id      = H5Iget_file_id(dataset_id);
+    const hid_t access_plist = H5Fget_access_plist(file_id);
+    const bool is_mpio_file  = H5Pget_driver(access_plist) == H5FD_MPIO;
+    H5Pclose(access_plist);
+    H5Fclose(file_id);
+    if (is_mpio_file && !amrex::ParallelDescriptor::IOProcessor())
+    {
+        const hid_t space_id = H5Dget_space(dataset_id);
+        H5Sselect_none(space_id);
+        const herr_t status = H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, space_id, space_id, H5P_DEFAULT, data);
+        H5Sclose(space_id);
+        return status;
+    }
+#endif
+    return H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+}
+
+}  // namespace turbo
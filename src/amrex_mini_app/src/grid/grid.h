@@ -2,9 +2,11 @@
 
 #include <hdf5.h>
 
+#include <array>
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "geometry.h"
 
@@ -56,6 +58,38 @@ class Grid
         Point operator+(const Point& other) const noexcept { return {x + other.x, y + other.y, z + other.z}; }
     };
 
+    /**
+     * @brief Precomputed structure-of-arrays coordinates of one grid location (nodes, cell centers, or faces).
+     *
+     * Each coordinate is stored in its own contiguous array and addressed through per-direction strides, so grids
+     * with separable coordinates (e.g. Cartesian, where x only depends on i) store 1D axes by using zero strides,
+     * while curvilinear grids store full 3D arrays. Lookups are unchecked and inline, making the table suitable for
+     * hot loops over a field; use the checked Grid location functions when the indices are not known to be valid.
+     */
+    struct CoordinateTable
+    {
+        std::vector<double> x;               /**< X coordinates */
+        std::vector<double> y;               /**< Y coordinates */
+        std::vector<double> z;               /**< Z coordinates */
+        std::array<std::size_t, 3> x_stride; /**< Strides of the x array in the I, J, K index directions */
+        std::array<std::size_t, 3> y_stride; /**< Strides of the y array in the I, J, K index directions */
+        std::array<std::size_t, 3> z_stride; /**< Strides of the z array in the I, J, K index directions */
+
+        /**
+         * @brief Get the location of a grid point without bounds checking.
+         * @param i I index
+         * @param j J index
+         * @param k K index
+         * @return Grid point location
+         */
+        Point operator()(const Index i, const Index j, const Index k) const noexcept
+        {
+            return {x[i * x_stride[0] + j * x_stride[1] + k * x_stride[2]],
+                    y[i * y_stride[0] + j * y_stride[1] + k * y_stride[2]],
+                    z[i * z_stride[0] + j * z_stride[1] + k * z_stride[2]]};
+        }
+    };
+
     //-----------------------------------------------------------------------//
     // Public Member Functions
     //-----------------------------------------------------------------------//
@@ -222,6 +256,36 @@ class Grid
      */
     virtual bool ValidKFace(const Index i, const Index j, const Index k) const noexcept = 0;
 
+    /**
+     * @brief Get the precomputed node coordinates.
+     * @return Coordinate table indexed by node (i,j,k)
+     */
+    const CoordinateTable& NodeCoordinates() const noexcept { return node_coordinates_; }
+
+    /**
+     * @brief Get the precomputed cell center coordinates.
+     * @return Coordinate table indexed by cell (i,j,k)
+     */
+    const CoordinateTable& CellCenterCoordinates() const noexcept { return cell_center_coordinates_; }
+
+    /**
+     * @brief Get the precomputed I-face center coordinates.
+     * @return Coordinate table indexed by I-face (i,j,k)
+     */
+    const CoordinateTable& IFaceCoordinates() const noexcept { return i_face_coordinates_; }
+
+    /**
+     * @brief Get the precomputed J-face center coordinates.
+     * @return Coordinate table indexed by J-face (i,j,k)
+     */
+    const CoordinateTable& JFaceCoordinates() const noexcept { return j_face_coordinates_; }
+
+    /**
+     * @brief Get the precomputed K-face center coordinates.
+     * @return Coordinate table indexed by K-face (i,j,k)
+     */
+    const CoordinateTable& KFaceCoordinates() const noexcept { return k_face_coordinates_; }
+
     /**
      * @brief Write grid data to an HDF5 file by filename. Overwrites the file if it already exists.
      * @param filename Name of the HDF5 file
@@ -234,15 +298,48 @@ class Grid
      */
     virtual void WriteHDF5(const hid_t file_id) const = 0;
 
+    /**
+     * @brief Write the full x,y,z coordinates of every node, cell center, and face of the grid to an HDF5 file.
+     *
+     * Writes one (ni, nj, nk, 3) dataset per grid location ("cell_center", "node", "x_face", "y_face", "z_face").
+     * This works for any structured grid, e.g. curvilinear grids whose coordinates are not separable, but stores 15
+     * values per cell. Grids with separable coordinates should prefer writing 1D coordinate axes in WriteHDF5.
+     *
+     * @param file_id HDF5 file identifier
+     */
+    void WriteHDF5FullCoordinates(const hid_t file_id) const;
+
    protected:
     //-----------------------------------------------------------------------//
     // Protected Member Functions
     //-----------------------------------------------------------------------//
 
+    /**
+     * @brief Write the whole data of a grid dataset. Must be called by all ranks that created the dataset.
+     *
+     * In a file opened through MPI-IO, every rank creates the dataset (a collective operation) but only the IO
+     * processor writes the data, the other ranks write an empty selection. The grid is the same on every rank.
+     *
+     * @param dataset_id HDF5 dataset identifier.
+     * @param data Data of the whole dataset, only read on the ranks that write it.
+     * @return Status of the write, negative on failure.
+     */
+    static herr_t WriteHDF5Data(const hid_t dataset_id, const double* data);
+
+    //-----------------------------------------------------------------------//
+    // Protected Data Members
+    //-----------------------------------------------------------------------//
+
     /**
      * @brief Shared pointer to the geometry associated with the grid.
      */
     const std::shared_ptr<Geometry> geometry_;
+
+    /**
+     * @brief Coordinate tables for every grid location. Filled in by the derived class constructor.
+     */
+    CoordinateTable node_coordinates_, cell_center_coordinates_, i_face_coordinates_, j_face_coordinates_,
+        k_face_coordinates_;
 };
 
 }  // namespace turbo
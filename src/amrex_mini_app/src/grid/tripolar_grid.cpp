@@ -0,0 +1,23 @@
+#include "tripolar_grid.h"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+#include "cartesian_grid.h"
+#include "tripolar_geometry.h"
+
+namespace turbo
+{
+
+TripolarGrid::TripolarGrid(const std::shared_ptr<TripolarGeometry>& geometry, const std::size_t n_cell_x,
+                           const std::size_t n_cell_y, const std::size_t n_cell_z)
+    : CartesianGrid(geometry, n_cell_x, n_cell_y, n_cell_z)
+{
+    if (n_cell_x % 2 != 0)
+    {
+        throw std::invalid_argument("Number of cells in the X direction of a tripolar grid must be even.");
+    }
+}
+
+}  // namespace turbo
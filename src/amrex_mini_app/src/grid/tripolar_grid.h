@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "cartesian_grid.h"
+#include "tripolar_geometry.h"
+
+namespace turbo
+{
+/**
+ * @brief Tripolar grid, a CartesianGrid in index space that is periodic in X and folded at the Y maximum.
+ *
+ * Grid locations are the same as the CartesianGrid ones. The grid only adds the topology: fields defined on a
+ * TripolarGrid fill their X ghost cells periodically and their Y maximum ghost cells across the fold, see
+ * Field::FillBoundary. The fold maps cell i onto cell NCellX() - 1 - i, so the number of cells in X must be even.
+ */
+class TripolarGrid : public CartesianGrid
+{
+   public:
+    //-----------------------------------------------------------------------//
+    // Public Member Functions
+    //-----------------------------------------------------------------------//
+    /**
+     * @brief Construct a TripolarGrid with the given geometry and cell counts.
+     * @param geometry Shared pointer to TripolarGeometry object
+     * @param n_cell_x Number of cells in X direction, must be even
+     * @param n_cell_y Number of cells in Y direction
+     * @param n_cell_z Number of cells in Z direction
+     * @throws std::invalid_argument if a cell count is zero or n_cell_x is odd.
+     */
+    TripolarGrid(const std::shared_ptr<TripolarGeometry>& geometry, const std::size_t n_cell_x,
+                 const std::size_t n_cell_y, const std::size_t n_cell_z);
+
+    /**
+     * @brief Get the geometry associated with the grid.
+     * @return Shared pointer to TripolarGeometry object
+     */
+    std::shared_ptr<TripolarGeometry> GetGeometry() const noexcept
+    {
+        return std::static_pointer_cast<TripolarGeometry>(geometry_);
+    }
+};
+
+}  // namespace turbo
@@ -0,0 +1,48 @@
+#include "tripolar_grid.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+#include "cartesian_grid.h"
+#include "tripolar_geometry.h"
+
+using namespace turbo;
+
+class TripolarGridTest : public ::testing::Test
+{
+   protected:
+    std::shared_ptr<TripolarGeometry> geom;
+
+    void SetUp() override { geom = std::make_shared<TripolarGeometry>(0.0, 360.0, -80.0, 90.0, 0.0, 5000.0); }
+};
+
+TEST_F(TripolarGridTest, Constructor)
+{
+    const std::size_t n_cell_x = 4;
+    const std::size_t n_cell_y = 3;
+    const std::size_t n_cell_z = 2;
+    TripolarGrid grid(geom, n_cell_x, n_cell_y, n_cell_z);
+
+    EXPECT_EQ(grid.NCellX(), n_cell_x);
+    EXPECT_EQ(grid.NCellY(), n_cell_y);
+    EXPECT_EQ(grid.NCellZ(), n_cell_z);
+    EXPECT_EQ(grid.GetGeometry(), geom);
+
+    // The fold pairs up cells i and n_cell_x - 1 - i, so an odd number of cells in x is invalid
+    EXPECT_THROW(TripolarGrid(geom, 3, n_cell_y, n_cell_z), std::invalid_argument);
+    EXPECT_THROW(TripolarGrid(geom, 0, n_cell_y, n_cell_z), std::invalid_argument);
+}
+
+TEST_F(TripolarGridTest, GridLocations)
+{
+    TripolarGrid grid(geom, 4, 2, 1);
+    const CartesianGrid& cartesian_grid = grid;
+
+    // Locations are the same as on a Cartesian grid over the same extents
+    EXPECT_EQ(cartesian_grid.Node(0, 0, 0), Grid::Point({0.0, -80.0, 0.0}));
+    EXPECT_EQ(cartesian_grid.Node(4, 2, 1), Grid::Point({360.0, 90.0, 5000.0}));
+    EXPECT_EQ(cartesian_grid.CellCenter(1, 0, 0), Grid::Point({135.0, -37.5, 2500.0}));
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+
+#include "box_decomposition.h"
+#include "cartesian_geometry.h"
+#include "cartesian_grid.h"
+#include "field.h"
+#include "staggered_field.h"
+
+/**
+ * @brief Function of the indices and the component of a point of a field.
+ */
+using PointFunction = std::function<double(int, int, int, int)>;
+
+/**
+ * @brief Make a grid of 8 x 6 columns of n_level cells on the unit cube, small enough to check every point.
+ * @param n_level Number of cells in k.
+ * @return The grid.
+ */
+inline std::shared_ptr<turbo::CartesianGrid> MakeTestGrid(const int n_level)
+{
+    return std::make_shared<turbo::CartesianGrid>(
+        std::make_shared<turbo::CartesianGeometry>(0.0, 1.0, 0.0, 1.0, 0.0, 1.0), 8, 6, n_level);
+}
+
+/**
+ * @brief Make a decomposition of an 8 x 6 test grid into 2 x 2 boxes in i and j, so the tests cross box boundaries.
+ * @param box_size_k Number of levels of a box, at least the number of levels of the grid for whole columns.
+ * @return The box decomposition.
+ */
+inline turbo::BoxDecomposition MakeTestBoxDecomposition(const int box_size_k)
+{
+    return turbo::BoxDecomposition::Chunked(amrex::IntVect(AMREX_D_DECL(4, 3, box_size_k)));
+}
+
+/**
+ * @brief Set the valid points of a field, and n_ghost ghost cells, to a function of the indices and the component.
+ * @param field Field to set.
+ * @param function Value of each point and component.
+ * @param n_ghost Number of ghost cells to set as well, at most the number of ghost cells of the field.
+ */
+template <turbo::FieldGridStagger S>
+void FillField(const turbo::StaggeredField<S>& field, const PointFunction& function, const int n_ghost = 0)
+{
+    amrex::MultiFab& mf = field.GetMultiFab();
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<amrex::Real> array = mf.array(mfi);
+        const amrex::Box box                   = amrex::grow(mfi.validbox(), n_ghost);
+        for (int n = 0; n < mf.nComp(); ++n)
+        {
+            for (int k = box.smallEnd(2); k <= box.bigEnd(2); ++k)
+            {
+                for (int j = box.smallEnd(1); j <= box.bigEnd(1); ++j)
+                {
+                    for (int i = box.smallEnd(0); i <= box.bigEnd(0); ++i)
+                    {
+                        array(i, j, k, n) = function(i, j, k, n);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the largest difference between the valid points of a field and a function, on all ranks.
+ * @param field Field to check.
+ * @param expected Expected value of each point and component.
+ * @param weight If set, only the points where the weight is nonzero are checked.
+ * @return Largest absolute difference.
+ */
+template <turbo::FieldGridStagger S>
+double MaxError(const turbo::StaggeredField<S>& field, const PointFunction& expected, const PointFunction& weight = {})
+{
+    const amrex::MultiFab& mf = field.GetMultiFab();
+    double max_error          = 0.0;
+    for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const amrex::Array4<const amrex::Real> array = mf.const_array(mfi);
+        const amrex::Box box                         = mfi.validbox();
+        for (int n = 0; n < mf.nComp(); ++n)
+        {
+            for (int k = box.smallEnd(2); k <= box.bigEnd(2); ++k)
+            {
+                for (int j = box.smallEnd(1); j <= box.bigEnd(1); ++j)
+                {
+                    for (int i = box.smallEnd(0); i <= box.bigEnd(0); ++i)
+                    {
+                        if (!weight || weight(i, j, k, n) != 0.0)
+                        {
+                            max_error = std::max(max_error, std::abs(array(i, j, k, n) - expected(i, j, k, n)));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    amrex::ParallelDescriptor::ReduceRealMax(max_error);
+    return max_error;
+}
+
+/**
+ * @brief Turn a function of the location of the points of a field into a function of their indices, for FillField
+ * and MaxError.
+ * @param field Field whose points the indices refer to, on a CartesianGrid.
+ * @param function Value at a location, for each component.
+ * @return Function of the indices and the component.
+ */
+template <turbo::FieldGridStagger S>
+PointFunction AtLocation(const turbo::StaggeredField<S>& field,
+                         const std::function<double(const turbo::Grid::Point&, int)>& function)
+{
+    const turbo::StaggeredGridView<S> view = field.GetGridView();
+    return [view, function](int i, int j, int k, int n) { return function(view(i, j, k), n); };
+}